@@ -16,16 +16,50 @@ DEFINE_ENUM_STRINGS(COND_RESULT, COND_RESULT_VALUES);
 pthread_cond_t* create_cond(void)
 {
     pthread_cond_t * cond = (pthread_cond_t*)malloc(sizeof(pthread_cond_t));
-    if (cond != NULL)
+    if (cond == NULL)
+    {
+        LogError("Failed to allocate the condition");
+    }
+    else
     {
 #ifdef __MACH__
-        pthread_cond_init(cond, NULL);
+        /*there is no pthread_condattr_setclock, the timed wait is relative instead, see Condition_Wait*/
+        if (pthread_cond_init(cond, NULL) != 0)
+        {
+            LogError("Failed to pthread_cond_init");
+            free(cond);
+            cond = NULL;
+        }
 #else
+        // Codes_SRS_CONDITION_11_005: [ Where the platform has a clock that does not jump when the system time is changed, Condition_Init shall make the timed Condition_Wait measure timeout_milliseconds on it ]
+        /*the deadline of pthread_cond_timedwait comes from get_time_ns, which reads time_basis. A condvar left on
+        CLOCK_REALTIME would read it as a 1970 date and time out at once, or wait through a jump of the wall clock*/
         pthread_condattr_t cattr;
-        pthread_condattr_init(&cattr);
-        pthread_condattr_setclock(&cattr, time_basis);
-        pthread_cond_init(cond, &cattr);
-        pthread_condattr_destroy(&cattr);
+        int init_result;
+        if (pthread_condattr_init(&cattr) != 0)
+        {
+            init_result = __FAILURE__;
+        }
+        else
+        {
+            if (pthread_condattr_setclock(&cattr, time_basis) != 0)
+            {
+                init_result = __FAILURE__;
+            }
+            else
+            {
+                init_result = pthread_cond_init(cond, &cattr);
+            }
+            (void)pthread_condattr_destroy(&cattr);
+        }
+
+        if (init_result != 0)
+        {
+            // Codes_SRS_CONDITION_11_006: [ Condition_Init shall return NULL if it fails to initialize the condition or to bind it to that clock ]
+            LogError("Failed to initialize the condition on clock %d", (int)time_basis);
+            free(cond);
+            cond = NULL;
+        }
 #endif
     }
 
@@ -51,6 +85,7 @@ COND_RESULT Condition_Post(COND_HANDLE handle)
     }
     else
     {
+        // Codes_SRS_CONDITION_11_004: [ Condition_Post shall unblock at most one of the threads waiting on the condition ]
         // Codes_SRS_CONDITION_18_003: [ Condition_Post shall return COND_OK if it succcessfully posts the condition ]
         if (pthread_cond_signal((pthread_cond_t*)handle) == 0)
         {
@@ -64,6 +99,31 @@ COND_RESULT Condition_Post(COND_HANDLE handle)
     return result;
 }
 
+COND_RESULT Condition_Broadcast(COND_HANDLE handle)
+{
+    COND_RESULT result;
+    // Codes_SRS_CONDITION_11_001: [ Condition_Broadcast shall return COND_INVALID_ARG if handle is NULL ]
+    if (handle == NULL)
+    {
+        result = COND_INVALID_ARG;
+    }
+    else
+    {
+        // Codes_SRS_CONDITION_11_002: [ Condition_Broadcast shall unblock all the threads waiting on the condition ]
+        // Codes_SRS_CONDITION_11_003: [ Condition_Broadcast shall return COND_OK if it succcessfully broadcasts the condition, also when no thread is waiting ]
+        if (pthread_cond_broadcast((pthread_cond_t*)handle) == 0)
+        {
+            result = COND_OK;
+        }
+        else
+        {
+            LogError("Failed to pthread_cond_broadcast");
+            result = COND_ERROR;
+        }
+    }
+    return result;
+}
+
 COND_RESULT Condition_Wait(COND_HANDLE handle, LOCK_HANDLE lock, int timeout_milliseconds)
 {
     COND_RESULT result;
@@ -80,6 +140,12 @@ COND_RESULT Condition_Wait(COND_HANDLE handle, LOCK_HANDLE lock, int timeout_mil
         {
             // Codes_SRS_CONDITION_18_013: [ Condition_Wait shall accept relative timeouts ]
             struct timespec tm;
+#ifdef __MACH__
+            /*the calendar clock of get_time_ns jumps with the system time, a relative wait does not*/
+            tm.tv_sec = timeout_milliseconds / MILLISECONDS_IN_1_SECOND;
+            tm.tv_nsec = (timeout_milliseconds % MILLISECONDS_IN_1_SECOND) * NANOSECONDS_IN_1_MILLISECOND;
+            int wait_result = pthread_cond_timedwait_relative_np((pthread_cond_t *)handle, (pthread_mutex_t *)lock, &tm);
+#else
             if (get_time_ns(&tm) != 0)
             {
                 LogError("Failed to get the current time");
@@ -92,6 +158,7 @@ COND_RESULT Condition_Wait(COND_HANDLE handle, LOCK_HANDLE lock, int timeout_mil
             tm.tv_sec+= tm.tv_nsec / NANOSECONDS_IN_1_SECOND;
             tm.tv_nsec %= NANOSECONDS_IN_1_SECOND;
             int wait_result = pthread_cond_timedwait((pthread_cond_t *)handle, (pthread_mutex_t *)lock, &tm);
+#endif
             if (wait_result == ETIMEDOUT)
             {
                 // Codes_SRS_CONDITION_18_011: [ Condition_Wait shall return COND_TIMEOUT if the condition is NOT triggered and timeout_milliseconds is not 0 ]
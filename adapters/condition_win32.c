@@ -10,10 +10,12 @@
 
 DEFINE_ENUM_STRINGS(COND_RESULT, COND_RESULT_VALUES);
 
+/*the LOCK_HANDLE of lock_win32.c is a SRWLOCK, so the condition is a CONDITION_VARIABLE slept on with
+SleepConditionVariableSRW. It wakes one or all the waiters like pthreads, and the timeout is measured on the
+tick count, which does not jump with the system time*/
 typedef struct CONDITION_TAG
 {
-    volatile LONG waiting_thread_count;
-    HANDLE event_handle;
+    CONDITION_VARIABLE condition_variable;
 }
 CONDITION;
 
@@ -26,19 +28,8 @@ COND_HANDLE Condition_Init(void)
     // Codes_SRS_CONDITION_18_008: [ Condition_Init shall return NULL if it fails to allocate the CONDITION_HANDLE ]
     if (cond != NULL)
     {
-        cond->event_handle = CreateEvent(NULL, FALSE, FALSE, NULL);
-
-        if (cond->event_handle == NULL)
-        {
-            LogError("CreateEvent failed with error %d", GetLastError());
-            free(cond);
-            cond = NULL;
-        }
-        else
-        {
-            /* Needed to emulate pthread_signal as we only signal the event when there are waiting threads */
-            cond->waiting_thread_count = 0;
-        }
+        // Codes_SRS_CONDITION_11_005: [ Where the platform has a clock that does not jump when the system time is changed, Condition_Init shall make the timed Condition_Wait measure timeout_milliseconds on it ]
+        InitializeConditionVariable(&cond->condition_variable);
     }
     else
     {
@@ -60,20 +51,32 @@ COND_RESULT Condition_Post(COND_HANDLE handle)
     }
     else
     {
-        CONDITION* cond = (CONDITION*)handle;
+        // Codes_SRS_CONDITION_11_004: [ Condition_Post shall unblock at most one of the threads waiting on the condition ]
+        WakeConditionVariable(&((CONDITION*)handle)->condition_variable);
 
-        /* Emulate pthreads signalling, by only unblocking *one* waiting thread if there is one waiting */
-        if (cond->waiting_thread_count == 0 || SetEvent(cond->event_handle))
-        {
-            // Codes_SRS_CONDITION_18_003: [ Condition_Post shall return COND_OK if it succcessfully posts the condition ]
-            result = COND_OK;
-        }
-        else
-        {
-            LogError("Failed SetEvent call with error %d", GetLastError());
+        // Codes_SRS_CONDITION_18_003: [ Condition_Post shall return COND_OK if it succcessfully posts the condition ]
+        result = COND_OK;
+    }
+    return result;
+}
 
-            result = COND_ERROR;
-        }
+COND_RESULT Condition_Broadcast(COND_HANDLE handle)
+{
+    COND_RESULT result;
+    if (handle == NULL)
+    {
+        LogError("Null argument handle passed to Condition_Broadcast");
+
+        // Codes_SRS_CONDITION_11_001: [ Condition_Broadcast shall return COND_INVALID_ARG if handle is NULL ]
+        result = COND_INVALID_ARG;
+    }
+    else
+    {
+        // Codes_SRS_CONDITION_11_002: [ Condition_Broadcast shall unblock all the threads waiting on the condition ]
+        WakeAllConditionVariable(&((CONDITION*)handle)->condition_variable);
+
+        // Codes_SRS_CONDITION_11_003: [ Condition_Broadcast shall return COND_OK if it succcessfully broadcasts the condition, also when no thread is waiting ]
+        result = COND_OK;
     }
     return result;
 }
@@ -93,50 +96,21 @@ COND_RESULT Condition_Wait(COND_HANDLE handle, LOCK_HANDLE lock, int timeout_mil
     {
         CONDITION* cond = (CONDITION*)handle;
 
-        /* Increment the waiting thread count, unlock the lock and wait */
-        cond->waiting_thread_count++;
-
-        if (Unlock(lock) == 0)
+        // Codes_SRS_CONDITION_18_013: [ Condition_Wait shall accept relative timeouts ]
+        if (SleepConditionVariableSRW(&cond->condition_variable, (PSRWLOCK)lock, timeout_milliseconds == 0 ? INFINITE : (DWORD)timeout_milliseconds, 0))
+        {
+            // Codes_SRS_CONDITION_18_010: [ Condition_Wait shall return COND_OK if the condition is triggered and timeout_milliseconds is 0 ]
+            // Codes_SRS_CONDITION_18_012: [ Condition_Wait shall return COND_OK if the condition is triggered and timeout_milliseconds is not 0 ]
+            result = COND_OK;
+        }
+        else if (GetLastError() == ERROR_TIMEOUT)
         {
-            DWORD wait_result;
-
-            // Codes_SRS_CONDITION_18_013: [ Condition_Wait shall accept relative timeouts ]
-            wait_result = WaitForSingleObject(cond->event_handle, timeout_milliseconds == 0 ? INFINITE : timeout_milliseconds);
-
-            /* If we unlocked ok, it means the lock handle is valid, lock must succeed since it wraps EnterCriticalSection */
-            (void)Lock(lock);
-
-            if (wait_result != WAIT_OBJECT_0 && wait_result != WAIT_TIMEOUT)
-            {
-                LogError("Failed wait, wait returned with %x", wait_result);
-
-                /* cond might be freed at this point, just return error and do not touch condition */
-                result = COND_ERROR;
-            }
-            else
-            {
-                /* To handle the chance of a race condition reset the event again when there are no more waiting threads */
-                if (--cond->waiting_thread_count == 0)
-                {
-                    (void)ResetEvent(cond->event_handle);
-                }
-
-                if (wait_result == WAIT_TIMEOUT)
-                {
-                    // Codes_SRS_CONDITION_18_011: [ Condition_Wait shall return COND_TIMEOUT if the condition is NOT triggered and timeout_milliseconds is not 0 ]
-                    result = COND_TIMEOUT;
-                }
-                else
-                {
-                    // Codes_SRS_CONDITION_18_012: [ Condition_Wait shall return COND_OK if the condition is triggered and timeout_milliseconds is not 0 ]
-                    result = COND_OK;
-                }
-            }
+            // Codes_SRS_CONDITION_18_011: [ Condition_Wait shall return COND_TIMEOUT if the condition is NOT triggered and timeout_milliseconds is not 0 ]
+            result = COND_TIMEOUT;
         }
         else
         {
-            cond->waiting_thread_count--;
-            LogError("Invalid lock passed which failed to unlock");
+            LogError("Failed SleepConditionVariableSRW with error %d", GetLastError());
             result = COND_ERROR;
         }
     }
@@ -149,12 +123,7 @@ void Condition_Deinit(COND_HANDLE handle)
     // Codes_SRS_CONDITION_18_009: [ Condition_Deinit will deallocate handle if it is not NULL
     if (handle != NULL)
     {
-        CONDITION* cond = (CONDITION*)handle;
-
-        (void)CloseHandle(cond->event_handle);
-        cond->event_handle = INVALID_HANDLE_VALUE;
-
-        free(cond);
+        /*a CONDITION_VARIABLE has nothing to release*/
+        free(handle);
     }
 }
-
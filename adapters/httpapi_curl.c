@@ -46,6 +46,7 @@ typedef struct HTTP_RESPONSE_CONTENT_BUFFER_TAG
 {
     unsigned char* buffer;
     size_t bufferSize;
+    size_t bufferCapacity; /*curl hands over the body in small chunks, the capacity doubles so a big download is not copied once per chunk*/
     unsigned char error;
 } HTTP_RESPONSE_CONTENT_BUFFER;
 
@@ -197,7 +198,26 @@ static size_t ContentWriteFunction(void *ptr, size_t size, size_t nmemb, void *u
         (ptr != NULL) &&
         (size * nmemb > 0))
     {
-        void* newBuffer = realloc(responseContentBuffer->buffer, responseContentBuffer->bufferSize + (size * nmemb));
+        size_t requiredSize = responseContentBuffer->bufferSize + (size * nmemb);
+        void* newBuffer;
+        if (requiredSize <= responseContentBuffer->bufferCapacity)
+        {
+            newBuffer = responseContentBuffer->buffer;
+        }
+        else
+        {
+            size_t newCapacity = responseContentBuffer->bufferCapacity * 2;
+            if (newCapacity < requiredSize)
+            {
+                newCapacity = requiredSize;
+            }
+            newBuffer = realloc(responseContentBuffer->buffer, newCapacity);
+            if (newBuffer != NULL)
+            {
+                responseContentBuffer->bufferCapacity = newCapacity;
+            }
+        }
+
         if (newBuffer != NULL)
         {
             responseContentBuffer->buffer = newBuffer;
@@ -206,11 +226,14 @@ static size_t ContentWriteFunction(void *ptr, size_t size, size_t nmemb, void *u
         }
         else
         {
-            LogError("Could not allocate buffer of size %lu", (unsigned long)(responseContentBuffer->bufferSize + (size * nmemb)));
+            LogError("Could not allocate buffer of size %lu", (unsigned long)requiredSize);
             responseContentBuffer->error = 1;
             if (responseContentBuffer->buffer != NULL)
             {
                 free(responseContentBuffer->buffer);
+                responseContentBuffer->buffer = NULL;
+                responseContentBuffer->bufferSize = 0;
+                responseContentBuffer->bufferCapacity = 0;
             }
         }
     }
@@ -584,6 +607,7 @@ HTTPAPI_RESULT HTTPAPI_ExecuteRequest(HTTP_HANDLE handle, HTTPAPI_REQUEST_TYPE r
                                     {
                                         responseContentBuffer.buffer = NULL;
                                         responseContentBuffer.bufferSize = 0;
+                                        responseContentBuffer.bufferCapacity = 0;
                                         responseContentBuffer.error = 0;
 
                                         if (curl_easy_setopt(httpHandleData->curl, CURLOPT_WRITEDATA, &responseContentBuffer) != CURLE_OK)
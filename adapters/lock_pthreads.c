@@ -1,11 +1,34 @@
 // Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+/*_GNU_SOURCE for pthread_rwlockattr_setkind_np, it also gives pthread_rwlock_t without -std=gnu*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
 #include <pthread.h>
 #include "azure_c_shared_utility/lock.h"
 #include "azure_c_shared_utility/xlogging.h"
 
+/*tells the CPU a spin-wait loop is running, so it does not speculate past it and leaves the pipeline to the other
+hyperthread*/
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__GNUC__) && defined(__aarch64__)
+#define CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define CPU_RELAX()
+#endif
+
+typedef struct ADAPTIVELOCK_TAG
+{
+    pthread_mutex_t mutex;
+    unsigned int spin_count;
+} ADAPTIVELOCK;
+
 LOCK_HANDLE Lock_Init(void)
 {
     /* Codes_SRS_LOCK_10_002: [Lock_Init on success shall return a valid lock handle which should be a non NULL value] */
@@ -109,3 +132,318 @@ LOCK_RESULT Lock_Deinit(LOCK_HANDLE handle)
 
     return result;
 }
+
+RWLOCK_HANDLE RWLock_Init(void)
+{
+    /* Codes_SRS_LOCK_11_001: [RWLock_Init on success shall return a valid reader-writer lock handle which should be a non NULL value] */
+    pthread_rwlock_t* result = (pthread_rwlock_t*)malloc(sizeof(pthread_rwlock_t));
+    if (result == NULL)
+    {
+        /* Codes_SRS_LOCK_11_002: [RWLock_Init on error shall return NULL] */
+        LogError("malloc failed.");
+    }
+    else
+    {
+        int init_result;
+#if defined(__GLIBC__)
+        /* Codes_SRS_LOCK_11_011: [Where the platform allows it, waiting writers shall go before new readers, so that a steady stream of readers does not starve the writers] */
+        /*glibc lets new readers in while a writer waits, unless it is told otherwise*/
+        pthread_rwlockattr_t attributes;
+        if (pthread_rwlockattr_init(&attributes) != 0)
+        {
+            init_result = __FAILURE__;
+        }
+        else
+        {
+            if (pthread_rwlockattr_setkind_np(&attributes, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP) != 0)
+            {
+                init_result = __FAILURE__;
+            }
+            else
+            {
+                init_result = pthread_rwlock_init(result, &attributes);
+            }
+            (void)pthread_rwlockattr_destroy(&attributes);
+        }
+#else
+        init_result = pthread_rwlock_init(result, NULL);
+#endif
+        if (init_result != 0)
+        {
+            /* Codes_SRS_LOCK_11_002: [RWLock_Init on error shall return NULL] */
+            LogError("pthread_rwlock_init failed.");
+            free(result);
+            result = NULL;
+        }
+    }
+
+    return (RWLOCK_HANDLE)result;
+}
+
+LOCK_RESULT ReadLock(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_003: [ReadLock shall acquire the lock shared with other readers, waiting while a writer holds it, and return LOCK_OK] */
+        if (pthread_rwlock_rdlock((pthread_rwlock_t*)handle) == 0)
+        {
+            result = LOCK_OK;
+        }
+        else
+        {
+            /* Codes_SRS_LOCK_11_008: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on error shall return LOCK_ERROR] */
+            LogError("pthread_rwlock_rdlock failed.");
+            result = LOCK_ERROR;
+        }
+    }
+
+    return result;
+}
+
+LOCK_RESULT ReadUnlock(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_004: [ReadUnlock shall release the lock acquired with ReadLock and return LOCK_OK] */
+        if (pthread_rwlock_unlock((pthread_rwlock_t*)handle) == 0)
+        {
+            result = LOCK_OK;
+        }
+        else
+        {
+            /* Codes_SRS_LOCK_11_008: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on error shall return LOCK_ERROR] */
+            LogError("pthread_rwlock_unlock failed.");
+            result = LOCK_ERROR;
+        }
+    }
+
+    return result;
+}
+
+LOCK_RESULT WriteLock(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_005: [WriteLock shall acquire the lock exclusively, waiting while readers or a writer hold it, and return LOCK_OK] */
+        if (pthread_rwlock_wrlock((pthread_rwlock_t*)handle) == 0)
+        {
+            result = LOCK_OK;
+        }
+        else
+        {
+            /* Codes_SRS_LOCK_11_008: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on error shall return LOCK_ERROR] */
+            LogError("pthread_rwlock_wrlock failed.");
+            result = LOCK_ERROR;
+        }
+    }
+
+    return result;
+}
+
+LOCK_RESULT WriteUnlock(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_006: [WriteUnlock shall release the lock acquired with WriteLock and return LOCK_OK] */
+        if (pthread_rwlock_unlock((pthread_rwlock_t*)handle) == 0)
+        {
+            result = LOCK_OK;
+        }
+        else
+        {
+            /* Codes_SRS_LOCK_11_008: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on error shall return LOCK_ERROR] */
+            LogError("pthread_rwlock_unlock failed.");
+            result = LOCK_ERROR;
+        }
+    }
+
+    return result;
+}
+
+LOCK_RESULT RWLock_Deinit(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_009: [RWLock_Deinit shall free all resources associated with handle and return LOCK_OK] */
+        if (pthread_rwlock_destroy((pthread_rwlock_t*)handle) == 0)
+        {
+            free(handle);
+            result = LOCK_OK;
+        }
+        else
+        {
+            /* Codes_SRS_LOCK_11_008: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on error shall return LOCK_ERROR] */
+            LogError("pthread_rwlock_destroy failed;");
+            result = LOCK_ERROR;
+        }
+    }
+
+    return result;
+}
+
+ADAPTIVELOCK_HANDLE AdaptiveLock_Init(unsigned int spin_count)
+{
+    /* Codes_SRS_LOCK_11_020: [AdaptiveLock_Init on success shall return a valid adaptive lock handle which should be a non NULL value] */
+    ADAPTIVELOCK* result = (ADAPTIVELOCK*)malloc(sizeof(ADAPTIVELOCK));
+    if (result == NULL)
+    {
+        /* Codes_SRS_LOCK_11_021: [AdaptiveLock_Init on error shall return NULL] */
+        LogError("malloc failed.");
+    }
+    else
+    {
+        if (pthread_mutex_init(&result->mutex, NULL) != 0)
+        {
+            /* Codes_SRS_LOCK_11_021: [AdaptiveLock_Init on error shall return NULL] */
+            LogError("pthread_mutex_init failed.");
+            free(result);
+            result = NULL;
+        }
+        else if (sysconf(_SC_NPROCESSORS_ONLN) <= 1)
+        {
+            /* Codes_SRS_LOCK_11_024: [On a single CPU AdaptiveLock shall block without spinning] */
+            /*the thread that holds the lock cannot release it while this one spins*/
+            result->spin_count = 0;
+        }
+        else
+        {
+            /* Codes_SRS_LOCK_11_022: [If spin_count is 0 AdaptiveLock_Init shall use ADAPTIVELOCK_DEFAULT_SPIN_COUNT] */
+            result->spin_count = (spin_count == 0) ? ADAPTIVELOCK_DEFAULT_SPIN_COUNT : spin_count;
+        }
+    }
+
+    return (ADAPTIVELOCK_HANDLE)result;
+}
+
+LOCK_RESULT AdaptiveLock(ADAPTIVELOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_026: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_023: [AdaptiveLock shall try to acquire the lock up to spin_count times before it waits for the lock to be released, and return LOCK_OK] */
+        ADAPTIVELOCK* adaptive_lock = (ADAPTIVELOCK*)handle;
+        unsigned int spins = adaptive_lock->spin_count;
+        int lock_result;
+
+        while (((lock_result = pthread_mutex_trylock(&adaptive_lock->mutex)) == EBUSY) &&
+            (spins > 0))
+        {
+            spins--;
+            CPU_RELAX();
+        }
+
+        if (lock_result == EBUSY)
+        {
+            lock_result = pthread_mutex_lock(&adaptive_lock->mutex);
+        }
+
+        if (lock_result == 0)
+        {
+            result = LOCK_OK;
+        }
+        else
+        {
+            /* Codes_SRS_LOCK_11_027: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on error shall return LOCK_ERROR] */
+            LogError("pthread_mutex_lock failed.");
+            result = LOCK_ERROR;
+        }
+    }
+
+    return result;
+}
+
+LOCK_RESULT AdaptiveUnlock(ADAPTIVELOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_026: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_025: [AdaptiveUnlock shall release the lock acquired with AdaptiveLock and return LOCK_OK] */
+        if (pthread_mutex_unlock(&((ADAPTIVELOCK*)handle)->mutex) == 0)
+        {
+            result = LOCK_OK;
+        }
+        else
+        {
+            /* Codes_SRS_LOCK_11_027: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on error shall return LOCK_ERROR] */
+            LogError("pthread_mutex_unlock failed.");
+            result = LOCK_ERROR;
+        }
+    }
+
+    return result;
+}
+
+LOCK_RESULT AdaptiveLock_Deinit(ADAPTIVELOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_026: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_028: [AdaptiveLock_Deinit shall free all resources associated with handle and return LOCK_OK] */
+        if (pthread_mutex_destroy(&((ADAPTIVELOCK*)handle)->mutex) == 0)
+        {
+            free(handle);
+            result = LOCK_OK;
+        }
+        else
+        {
+            /* Codes_SRS_LOCK_11_027: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on error shall return LOCK_ERROR] */
+            LogError("pthread_mutex_destroy failed;");
+            result = LOCK_ERROR;
+        }
+    }
+
+    return result;
+}
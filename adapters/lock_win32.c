@@ -88,3 +88,213 @@ LOCK_RESULT Unlock(LOCK_HANDLE handle)
 
     return result;
 }
+
+RWLOCK_HANDLE RWLock_Init(void)
+{
+    /* Codes_SRS_LOCK_11_001: [RWLock_Init on success shall return a valid reader-writer lock handle which should be a non NULL value] */
+    /* Codes_SRS_LOCK_11_002: [RWLock_Init on error shall return NULL] */
+    /* Codes_SRS_LOCK_11_011: [Where the platform allows it, waiting writers shall go before new readers, so that a steady stream of readers does not starve the writers] */
+    SRWLOCK* result = malloc(sizeof(SRWLOCK));
+    if (result == NULL)
+    {
+        LogError("Allocate SRWLOCK failed.");
+    }
+    else
+    {
+        InitializeSRWLock(result);
+    }
+
+    return (RWLOCK_HANDLE)result;
+}
+
+LOCK_RESULT RWLock_Deinit(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_009: [RWLock_Deinit shall free all resources associated with handle and return LOCK_OK] */
+        free(handle);
+        result = LOCK_OK;
+    }
+
+    return result;
+}
+
+LOCK_RESULT ReadLock(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_003: [ReadLock shall acquire the lock shared with other readers, waiting while a writer holds it, and return LOCK_OK] */
+        AcquireSRWLockShared((SRWLOCK*)handle);
+        result = LOCK_OK;
+
+        // Cannot fail
+        /* Codes_SRS_LOCK_11_008: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on error shall return LOCK_ERROR] */
+    }
+
+    return result;
+}
+
+LOCK_RESULT ReadUnlock(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_004: [ReadUnlock shall release the lock acquired with ReadLock and return LOCK_OK] */
+        ReleaseSRWLockShared((SRWLOCK*)handle);
+        result = LOCK_OK;
+
+        // Cannot fail
+    }
+
+    return result;
+}
+
+LOCK_RESULT WriteLock(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_005: [WriteLock shall acquire the lock exclusively, waiting while readers or a writer hold it, and return LOCK_OK] */
+        AcquireSRWLockExclusive((SRWLOCK*)handle);
+        result = LOCK_OK;
+
+        // Cannot fail
+    }
+
+    return result;
+}
+
+LOCK_RESULT WriteUnlock(RWLOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_006: [WriteUnlock shall release the lock acquired with WriteLock and return LOCK_OK] */
+        ReleaseSRWLockExclusive((SRWLOCK*)handle);
+        result = LOCK_OK;
+
+        // Cannot fail
+    }
+
+    return result;
+}
+
+ADAPTIVELOCK_HANDLE AdaptiveLock_Init(unsigned int spin_count)
+{
+    /* Codes_SRS_LOCK_11_020: [AdaptiveLock_Init on success shall return a valid adaptive lock handle which should be a non NULL value] */
+    /* Codes_SRS_LOCK_11_021: [AdaptiveLock_Init on error shall return NULL] */
+    CRITICAL_SECTION* result = malloc(sizeof(CRITICAL_SECTION));
+    if (result == NULL)
+    {
+        LogError("Allocate CRITICAL_SECTION failed.");
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_022: [If spin_count is 0 AdaptiveLock_Init shall use ADAPTIVELOCK_DEFAULT_SPIN_COUNT] */
+        /* Codes_SRS_LOCK_11_024: [On a single CPU AdaptiveLock shall block without spinning] */
+        /*the critical section spins before it waits on its event, and ignores the spin count on a single CPU*/
+        if (!InitializeCriticalSectionAndSpinCount(result, (spin_count == 0) ? ADAPTIVELOCK_DEFAULT_SPIN_COUNT : spin_count))
+        {
+            LogError("InitializeCriticalSectionAndSpinCount failed.");
+            free(result);
+            result = NULL;
+        }
+    }
+
+    return (ADAPTIVELOCK_HANDLE)result;
+}
+
+LOCK_RESULT AdaptiveLock_Deinit(ADAPTIVELOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_026: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_028: [AdaptiveLock_Deinit shall free all resources associated with handle and return LOCK_OK] */
+        DeleteCriticalSection((CRITICAL_SECTION*)handle);
+        free(handle);
+        result = LOCK_OK;
+    }
+
+    return result;
+}
+
+LOCK_RESULT AdaptiveLock(ADAPTIVELOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_026: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_023: [AdaptiveLock shall try to acquire the lock up to spin_count times before it waits for the lock to be released, and return LOCK_OK] */
+        EnterCriticalSection((CRITICAL_SECTION*)handle);
+        result = LOCK_OK;
+
+        // Cannot fail
+        /* Codes_SRS_LOCK_11_027: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on error shall return LOCK_ERROR] */
+    }
+
+    return result;
+}
+
+LOCK_RESULT AdaptiveUnlock(ADAPTIVELOCK_HANDLE handle)
+{
+    LOCK_RESULT result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_LOCK_11_026: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on NULL handle passed return LOCK_ERROR] */
+        LogError("Invalid argument; handle is NULL.");
+        result = LOCK_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_11_025: [AdaptiveUnlock shall release the lock acquired with AdaptiveLock and return LOCK_OK] */
+        LeaveCriticalSection((CRITICAL_SECTION*)handle);
+        result = LOCK_OK;
+
+        // Cannot fail
+    }
+
+    return result;
+}
@@ -25,6 +25,8 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/select.h>
+#include <sys/uio.h>
+#include <limits.h>
 #ifdef TIZENRT
 #include <net/lwip/tcp.h>
 #else
@@ -51,6 +53,12 @@
 #define INVALID_SOCKET                 -1
 #define MAC_ADDRESS_STRING_LENGTH      18
 
+/*buffers beyond this many are sent by socketio_send_vectored as if the first writev had been partial*/
+#ifndef IOV_MAX
+#define IOV_MAX                        16
+#endif
+#define SOCKETIO_STACK_IOVEC_COUNT     8
+
 #ifndef IFREQ_BUFFER_SIZE
 #define IFREQ_BUFFER_SIZE              1024
 #endif
@@ -183,6 +191,8 @@ static OPTIONHANDLER_HANDLE socketio_retrieveoptions(CONCRETE_IO_HANDLE handle)
     return result;
 }
 
+static int socketio_send_vectored(CONCRETE_IO_HANDLE socket_io, CONSTBUFFER_ARRAY_HANDLE buffers, ON_SEND_COMPLETE on_send_complete, void* callback_context);
+
 static const IO_INTERFACE_DESCRIPTION socket_io_interface_description =
 {
     socketio_retrieveoptions,
@@ -192,7 +202,8 @@ static const IO_INTERFACE_DESCRIPTION socket_io_interface_description =
     socketio_close,
     socketio_send,
     socketio_dowork,
-    socketio_setoption
+    socketio_setoption,
+    socketio_send_vectored
 };
 
 static void indicate_error(SOCKET_IO_INSTANCE* socket_io_instance)
@@ -204,7 +215,8 @@ static void indicate_error(SOCKET_IO_INSTANCE* socket_io_instance)
     }
 }
 
-static int add_pending_io(SOCKET_IO_INSTANCE* socket_io_instance, const unsigned char* buffer, size_t size, ON_SEND_COMPLETE on_send_complete, void* callback_context)
+/*queues bytes, which were allocated with malloc, as they are. On success the pending IO owns bytes*/
+static int add_pending_io_bytes(SOCKET_IO_INSTANCE* socket_io_instance, unsigned char* bytes, size_t size, ON_SEND_COMPLETE on_send_complete, void* callback_context)
 {
     int result;
     PENDING_SOCKET_IO* pending_socket_io = (PENDING_SOCKET_IO*)malloc(sizeof(PENDING_SOCKET_IO));
@@ -214,32 +226,47 @@ static int add_pending_io(SOCKET_IO_INSTANCE* socket_io_instance, const unsigned
     }
     else
     {
-        pending_socket_io->bytes = (unsigned char*)malloc(size);
-        if (pending_socket_io->bytes == NULL)
+        pending_socket_io->bytes = bytes;
+        pending_socket_io->size = size;
+        pending_socket_io->on_send_complete = on_send_complete;
+        pending_socket_io->callback_context = callback_context;
+        pending_socket_io->pending_io_list = socket_io_instance->pending_io_list;
+
+        if (singlylinkedlist_add(socket_io_instance->pending_io_list, pending_socket_io) == NULL)
         {
-            LogError("Allocation Failure: Unable to allocate pending list.");
+            LogError("Failure: Unable to add socket to pending list.");
             free(pending_socket_io);
             result = __FAILURE__;
         }
         else
         {
-            pending_socket_io->size = size;
-            pending_socket_io->on_send_complete = on_send_complete;
-            pending_socket_io->callback_context = callback_context;
-            pending_socket_io->pending_io_list = socket_io_instance->pending_io_list;
-            (void)memcpy(pending_socket_io->bytes, buffer, size);
+            result = 0;
+        }
+    }
+    return result;
+}
 
-            if (singlylinkedlist_add(socket_io_instance->pending_io_list, pending_socket_io) == NULL)
-            {
-                LogError("Failure: Unable to add socket to pending list.");
-                free(pending_socket_io->bytes);
-                free(pending_socket_io);
-                result = __FAILURE__;
-            }
-            else
-            {
-                result = 0;
-            }
+static int add_pending_io(SOCKET_IO_INSTANCE* socket_io_instance, const unsigned char* buffer, size_t size, ON_SEND_COMPLETE on_send_complete, void* callback_context)
+{
+    int result;
+    unsigned char* bytes = (unsigned char*)malloc(size);
+    if (bytes == NULL)
+    {
+        LogError("Allocation Failure: Unable to allocate pending list.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        (void)memcpy(bytes, buffer, size);
+
+        if (add_pending_io_bytes(socket_io_instance, bytes, size, on_send_complete, callback_context) != 0)
+        {
+            free(bytes);
+            result = __FAILURE__;
+        }
+        else
+        {
+            result = 0;
         }
     }
     return result;
@@ -909,6 +936,179 @@ int socketio_send(CONCRETE_IO_HANDLE socket_io, const void* buffer, size_t size,
     return result;
 }
 
+/*copies the bytes of buffers from offset on in one block and queues that block, the pending list needs them in one
+block and buffers is only borrowed for the call*/
+static int add_pending_io_from_buffers(SOCKET_IO_INSTANCE* socket_io_instance, CONSTBUFFER_ARRAY_HANDLE buffers, uint32_t buffer_count, size_t offset, size_t size, ON_SEND_COMPLETE on_send_complete, void* callback_context)
+{
+    int result;
+    unsigned char* bytes = (unsigned char*)malloc(size);
+    if (bytes == NULL)
+    {
+        LogError("Allocation Failure: Unable to allocate pending bytes.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        uint32_t i;
+        size_t copied = 0;
+        for (i = 0; i < buffer_count; i++)
+        {
+            const CONSTBUFFER* content = constbuffer_array_get_buffer_content(buffers, i);
+            if (content == NULL)
+            {
+                LogError("Failure: constbuffer_array_get_buffer_content failed.");
+                break;
+            }
+            else if (offset >= content->size)
+            {
+                offset -= content->size;
+            }
+            else
+            {
+                (void)memcpy(bytes + copied, content->buffer + offset, content->size - offset);
+                copied += content->size - offset;
+                offset = 0;
+            }
+        }
+
+        if ((i != buffer_count) ||
+            (add_pending_io_bytes(socket_io_instance, bytes, copied, on_send_complete, callback_context) != 0))
+        {
+            free(bytes);
+            result = __FAILURE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+/*hands all the buffers to the kernel with one writev, without copying them into one block first*/
+static int socketio_send_vectored(CONCRETE_IO_HANDLE socket_io, CONSTBUFFER_ARRAY_HANDLE buffers, ON_SEND_COMPLETE on_send_complete, void* callback_context)
+{
+    int result;
+    uint32_t buffer_count;
+    uint32_t all_buffers_size;
+
+    if ((socket_io == NULL) ||
+        (buffers == NULL) ||
+        (constbuffer_array_get_buffer_count(buffers, &buffer_count) != 0) ||
+        (constbuffer_array_get_all_buffers_size(buffers, &all_buffers_size) != 0) ||
+        (all_buffers_size == 0))
+    {
+        /* Codes_SRS_SOCKETIO_BERKELEY_11_001: [ If socket_io or buffers is NULL, or buffers holds no bytes, socketio_send_vectored shall fail and return a non-zero value. ]*/
+        /* Codes_SRS_SOCKETIO_BERKELEY_11_002: [ If constbuffer_array_get_buffer_count or constbuffer_array_get_all_buffers_size fails, socketio_send_vectored shall fail and return a non-zero value. ]*/
+        LogError("Invalid argument: send given invalid parameter");
+        result = __FAILURE__;
+    }
+    else
+    {
+        SOCKET_IO_INSTANCE* socket_io_instance = (SOCKET_IO_INSTANCE*)socket_io;
+        if (socket_io_instance->io_state != IO_STATE_OPEN)
+        {
+            /* Codes_SRS_SOCKETIO_BERKELEY_11_003: [ If the IO is not open, socketio_send_vectored shall fail and return a non-zero value. ]*/
+            LogError("Failure: socket state is not opened.");
+            result = __FAILURE__;
+        }
+        else if (singlylinkedlist_get_head_item(socket_io_instance->pending_io_list) != NULL)
+        {
+            /* Codes_SRS_SOCKETIO_BERKELEY_11_004: [ If IOs are pending already, socketio_send_vectored shall copy the content of all the buffers in one block, queue it behind them without calling writev and return 0. ]*/
+            if (add_pending_io_from_buffers(socket_io_instance, buffers, buffer_count, 0, all_buffers_size, on_send_complete, callback_context) != 0)
+            {
+                /* Codes_SRS_SOCKETIO_BERKELEY_11_009: [ If any other error occurs, socketio_send_vectored shall fail and return a non-zero value. ]*/
+                LogError("Failure: add_pending_io failed.");
+                result = __FAILURE__;
+            }
+            else
+            {
+                result = 0;
+            }
+        }
+        else
+        {
+            struct iovec stack_iov[SOCKETIO_STACK_IOVEC_COUNT];
+            uint32_t iov_count = (buffer_count > IOV_MAX) ? IOV_MAX : buffer_count;
+            struct iovec* iov = (iov_count <= SOCKETIO_STACK_IOVEC_COUNT) ? stack_iov : (struct iovec*)malloc(iov_count * sizeof(struct iovec));
+            if (iov == NULL)
+            {
+                /* Codes_SRS_SOCKETIO_BERKELEY_11_009: [ If any other error occurs, socketio_send_vectored shall fail and return a non-zero value. ]*/
+                LogError("Failure: allocating %lu iovecs.", (unsigned long)iov_count);
+                result = __FAILURE__;
+            }
+            else
+            {
+                ssize_t send_result;
+                uint32_t i;
+                for (i = 0; i < iov_count; i++)
+                {
+                    const CONSTBUFFER* content = constbuffer_array_get_buffer_content(buffers, i);
+                    if (content == NULL)
+                    {
+                        break;
+                    }
+                    iov[i].iov_base = (void*)content->buffer;
+                    iov[i].iov_len = content->size;
+                }
+
+                if (i != iov_count)
+                {
+                    /* Codes_SRS_SOCKETIO_BERKELEY_11_009: [ If any other error occurs, socketio_send_vectored shall fail and return a non-zero value. ]*/
+                    LogError("Failure: constbuffer_array_get_buffer_content failed.");
+                    result = __FAILURE__;
+                }
+                else
+                {
+                    signal(SIGPIPE, SIG_IGN);
+
+                    /* Codes_SRS_SOCKETIO_BERKELEY_11_005: [ Otherwise socketio_send_vectored shall send the content of the first IOV_MAX buffers with one writev. ]*/
+                    send_result = writev(socket_io_instance->socket, iov, (int)iov_count);
+                    if ((send_result < 0) && (errno != EAGAIN))
+                    {
+                        /* Codes_SRS_SOCKETIO_BERKELEY_11_008: [ If writev fails with any other error, socketio_send_vectored shall fail and return a non-zero value. ]*/
+                        LogError("Failure: sending socket failed. errno=%d (%s).", errno, strerror(errno));
+                        result = __FAILURE__;
+                    }
+                    else if ((send_result < 0) || ((size_t)send_result != all_buffers_size))
+                    {
+                        /* Codes_SRS_SOCKETIO_BERKELEY_11_007: [ If writev takes only part of the bytes of buffers, which it does when there are more than IOV_MAX buffers, or fails with EAGAIN, socketio_send_vectored shall copy the bytes it did not take in one block, queue it and return 0. ]*/
+                        /* queue what the socket did not take, EAGAIN means it took nothing */
+                        size_t sent = (send_result < 0) ? 0 : (size_t)send_result;
+                        if (add_pending_io_from_buffers(socket_io_instance, buffers, buffer_count, sent, all_buffers_size - sent, on_send_complete, callback_context) != 0)
+                        {
+                            /* Codes_SRS_SOCKETIO_BERKELEY_11_009: [ If any other error occurs, socketio_send_vectored shall fail and return a non-zero value. ]*/
+                            LogError("Failure: add_pending_io failed.");
+                            result = __FAILURE__;
+                        }
+                        else
+                        {
+                            result = 0;
+                        }
+                    }
+                    else
+                    {
+                        /* Codes_SRS_SOCKETIO_BERKELEY_11_006: [ If writev takes all the bytes of buffers, socketio_send_vectored shall call on_send_complete with IO_SEND_OK and return 0. ]*/
+                        if (on_send_complete != NULL)
+                        {
+                            on_send_complete(callback_context, IO_SEND_OK);
+                        }
+
+                        result = 0;
+                    }
+                }
+
+                if (iov != stack_iov)
+                {
+                    free(iov);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
 void socketio_dowork(CONCRETE_IO_HANDLE socket_io)
 {
     if (socket_io != NULL)
@@ -14,6 +14,12 @@ THREADAPI_RESULT ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC
     return THREADAPI_ERROR;
 }
 
+THREADAPI_RESULT ThreadAPI_CreateEx(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg, const THREADAPI_ATTRIBUTES* attributes)
+{
+    LogError("ESP8266 RTOS does not support multi-thread function.");
+    return THREADAPI_ERROR;
+}
+
 THREADAPI_RESULT ThreadAPI_Join(THREAD_HANDLE threadHandle, int* res)
 {
     LogError("ESP8266 RTOS does not support multi-thread function.");
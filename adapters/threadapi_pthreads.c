@@ -1,13 +1,18 @@
 // Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
-#define _DEFAULT_SOURCE
+/*_GNU_SOURCE for pthread_attr_setaffinity_np and pthread_setname_np, it also gives what _DEFAULT_SOURCE gives*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 
 #include "azure_c_shared_utility/threadapi.h"
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
+#include <limits.h>
 
 #ifdef TI_RTOS
 #include <ti/sysbios/knl/Task.h>
@@ -17,30 +22,128 @@
 
 #include <pthread.h>
 #include <time.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
 #include "azure_c_shared_utility/xlogging.h"
 
 DEFINE_ENUM_STRINGS(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
 
+/*pthread_setname_np takes at most 16 bytes with the terminating 0*/
+#define THREAD_NAME_SIZE 16
+/*nice value per THREADAPI_PRIORITY step, THREADAPI_PRIORITY_HIGHEST is nice -10 and THREADAPI_PRIORITY_LOWEST nice 10*/
+#define NICE_PER_PRIORITY 5
+
 typedef struct THREAD_INSTANCE_TAG
 {
     pthread_t Pthread_handle;
     THREAD_START_FUNC ThreadStartFunc;
     void* Arg;
+    int Priority;
+    char Name[THREAD_NAME_SIZE];
 } THREAD_INSTANCE;
 
 static void* ThreadWrapper(void* threadInstanceArg)
 {
     THREAD_INSTANCE* threadInstance = (THREAD_INSTANCE*)threadInstanceArg;
-    int result = threadInstance->ThreadStartFunc(threadInstance->Arg);
+    int result;
+
+    /*the thread names itself before it runs func, so the name is there for its whole life*/
+#if defined(__APPLE__)
+    if ((threadInstance->Name[0] != '\0') &&
+        (pthread_setname_np(threadInstance->Name) != 0))
+    {
+        LogError("failed setting the name of thread %s", threadInstance->Name);
+    }
+#elif defined(__linux__) && defined(__GLIBC__)
+    if ((threadInstance->Name[0] != '\0') &&
+        (pthread_setname_np(pthread_self(), threadInstance->Name) != 0))
+    {
+        LogError("failed setting the name of thread %s", threadInstance->Name);
+    }
+#endif
+
+#if defined(__linux__)
+    /*Linux keeps a nice value per thread, the priority of SCHED_OTHER threads is their nice value. Raising it
+    needs CAP_SYS_NICE or RLIMIT_NICE, without them the thread runs at the nice value of the process*/
+    if ((threadInstance->Priority != THREADAPI_PRIORITY_NORMAL) &&
+        (setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), getpriority(PRIO_PROCESS, 0) - (threadInstance->Priority * NICE_PER_PRIORITY)) != 0))
+    {
+        LogError("failed setting the priority of the thread to %d, errno = %d", threadInstance->Priority, errno);
+    }
+#endif
+
+    result = threadInstance->ThreadStartFunc(threadInstance->Arg);
     return (void*)(intptr_t)result;
 }
 
+/*returns 0 or an errno value like pthread_create, so both fail the same way*/
+static int set_attributes(pthread_attr_t* pthreadAttributes, const THREADAPI_ATTRIBUTES* attributes)
+{
+    int result = 0;
+
+    if (attributes->stack_size != 0)
+    {
+        size_t stackSize = attributes->stack_size;
+#ifdef PTHREAD_STACK_MIN
+        if (stackSize < (size_t)PTHREAD_STACK_MIN)
+        {
+            stackSize = (size_t)PTHREAD_STACK_MIN;
+        }
+#endif
+        if (pthread_attr_setstacksize(pthreadAttributes, stackSize) != 0)
+        {
+            LogError("invalid stack size %lu", (unsigned long)attributes->stack_size);
+            result = EINVAL;
+        }
+    }
+
+    if ((result == 0) &&
+        (attributes->affinity_mask != 0))
+    {
+#if defined(__linux__) && defined(__GLIBC__)
+        cpu_set_t cpuSet;
+        unsigned int cpu;
+
+        CPU_ZERO(&cpuSet);
+        for (cpu = 0; (cpu < 64) && (cpu < CPU_SETSIZE); cpu++)
+        {
+            if ((attributes->affinity_mask & ((uint64_t)1 << cpu)) != 0)
+            {
+                CPU_SET(cpu, &cpuSet);
+            }
+        }
+
+        if (pthread_attr_setaffinity_np(pthreadAttributes, sizeof(cpuSet), &cpuSet) != 0)
+        {
+            LogError("failed setting the affinity mask");
+            result = EINVAL;
+        }
+#else
+        LogError("thread affinity is not supported on this platform");
+        result = ENOTSUP;
+#endif
+    }
+
+    return result;
+}
+
 THREADAPI_RESULT ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg)
+{
+    return ThreadAPI_CreateEx(threadHandle, func, arg, NULL);
+}
+
+THREADAPI_RESULT ThreadAPI_CreateEx(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg, const THREADAPI_ATTRIBUTES* attributes)
 {
     THREADAPI_RESULT result;
 
     if ((threadHandle == NULL) ||
-        (func == NULL))
+        (func == NULL) ||
+        ((attributes != NULL) && ((attributes->priority < THREADAPI_PRIORITY_LOWEST) || (attributes->priority > THREADAPI_PRIORITY_HIGHEST))))
     {
         result = THREADAPI_INVALID_ARG;
         LogError("(result = %s)", ENUM_TO_STRING(THREADAPI_RESULT, result));
@@ -55,9 +158,46 @@ THREADAPI_RESULT ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC
         }
         else
         {
+            pthread_attr_t pthreadAttributes;
+            int createResult;
+
             threadInstance->ThreadStartFunc = func;
             threadInstance->Arg = arg;
-            int createResult = pthread_create(&threadInstance->Pthread_handle, NULL, ThreadWrapper, threadInstance);
+            threadInstance->Priority = THREADAPI_PRIORITY_NORMAL;
+            threadInstance->Name[0] = '\0';
+
+            if (attributes == NULL)
+            {
+                createResult = pthread_create(&threadInstance->Pthread_handle, NULL, ThreadWrapper, threadInstance);
+            }
+            else if (pthread_attr_init(&pthreadAttributes) != 0)
+            {
+                createResult = ENOMEM;
+            }
+            else
+            {
+                threadInstance->Priority = attributes->priority;
+                if (attributes->name != NULL)
+                {
+                    /*longer names are cut, pthread_setname_np would refuse them*/
+                    (void)strncpy(threadInstance->Name, attributes->name, THREAD_NAME_SIZE - 1);
+                    threadInstance->Name[THREAD_NAME_SIZE - 1] = '\0';
+                }
+#if !defined(__linux__)
+                if (attributes->priority != THREADAPI_PRIORITY_NORMAL)
+                {
+                    LogError("thread priority is not supported on this platform");
+                }
+#endif
+
+                createResult = set_attributes(&pthreadAttributes, attributes);
+                if (createResult == 0)
+                {
+                    createResult = pthread_create(&threadInstance->Pthread_handle, &pthreadAttributes, ThreadWrapper, threadInstance);
+                }
+                (void)pthread_attr_destroy(&pthreadAttributes);
+            }
+
             switch (createResult)
             {
             default:
@@ -72,7 +212,16 @@ THREADAPI_RESULT ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC
                 result = THREADAPI_OK;
                 break;
 
+            case EINVAL:
+                /*a stack size or an affinity mask the system refuses*/
+                free(threadInstance);
+
+                result = THREADAPI_INVALID_ARG;
+                LogError("(result = %s)", ENUM_TO_STRING(THREADAPI_RESULT, result));
+                break;
+
             case EAGAIN:
+            case ENOMEM:
                 free(threadInstance);
 
                 result = THREADAPI_NO_MEMORY;
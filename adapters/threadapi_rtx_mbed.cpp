@@ -35,11 +35,25 @@ static void thread_wrapper(const void* createParamArg)
 }
 
 THREADAPI_RESULT ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg)
+{
+    return ThreadAPI_CreateEx(threadHandle, func, arg, NULL);
+}
+
+THREADAPI_RESULT ThreadAPI_CreateEx(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg, const THREADAPI_ATTRIBUTES* attributes)
 {
     THREADAPI_RESULT result;
     if ((threadHandle == NULL) ||
-        (func == NULL))
+        (func == NULL) ||
+        ((attributes != NULL) && ((attributes->priority < THREADAPI_PRIORITY_LOWEST) || (attributes->priority > THREADAPI_PRIORITY_HIGHEST))))
+    {
+        result = THREADAPI_INVALID_ARG;
+        LogError("(result = %s)", ENUM_TO_STRING(THREADAPI_RESULT, result));
+    }
+    else if ((attributes != NULL) &&
+        (attributes->affinity_mask != 0) &&
+        ((attributes->affinity_mask & 1) == 0))
     {
+        /*mbed runs on one core, CPU 0*/
         result = THREADAPI_INVALID_ARG;
         LogError("(result = %s)", ENUM_TO_STRING(THREADAPI_RESULT, result));
     }
@@ -60,7 +74,10 @@ THREADAPI_RESULT ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC
                 param->func = func;
                 param->arg = arg;
                 param->p_thread = threads + slot;
-                threads[slot].thrd = new Thread(thread_wrapper, param, osPriorityNormal, STACK_SIZE);
+                /*THREADAPI_PRIORITY_* are the values of osPriorityLow to osPriorityHigh, RTX has no thread names*/
+                threads[slot].thrd = new Thread(thread_wrapper, param,
+                    (attributes == NULL) ? osPriorityNormal : (osPriority)attributes->priority,
+                    ((attributes == NULL) || (attributes->stack_size == 0)) ? STACK_SIZE : (uint32_t)attributes->stack_size);
                 *threadHandle = (THREAD_HANDLE)(threads + slot);
                 result = THREADAPI_OK;
             }
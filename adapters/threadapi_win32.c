@@ -1,22 +1,64 @@
 // Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+#include <stdlib.h>
+#include <stdint.h>
 #include "windows.h"
+#include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/threadapi.h"
 #include "azure_c_shared_utility/xlogging.h"
 
 DEFINE_ENUM_STRINGS(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
 
+/*SetThreadDescription is only in kernel32 from Windows 10 1607, it is looked up so older Windows still load the dll*/
+typedef HRESULT(WINAPI *SET_THREAD_DESCRIPTION)(HANDLE hThread, PCWSTR lpThreadDescription);
+
+static void set_thread_name(HANDLE thread, const char* name)
+{
+    SET_THREAD_DESCRIPTION set_thread_description = (SET_THREAD_DESCRIPTION)GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription");
+    if (set_thread_description == NULL)
+    {
+        LogError("thread names are not supported on this version of Windows");
+    }
+    else
+    {
+        int length = MultiByteToWideChar(CP_UTF8, 0, name, -1, NULL, 0);
+        WCHAR* wide_name;
+        if ((length <= 0) ||
+            ((wide_name = (WCHAR*)malloc(length * sizeof(WCHAR))) == NULL))
+        {
+            LogError("failed converting the name of thread %s", name);
+        }
+        else
+        {
+            if ((MultiByteToWideChar(CP_UTF8, 0, name, -1, wide_name, length) == 0) ||
+                FAILED(set_thread_description(thread, wide_name)))
+            {
+                LogError("failed setting the name of thread %s", name);
+            }
+            free(wide_name);
+        }
+    }
+}
+
 THREADAPI_RESULT ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg)
+{
+    return ThreadAPI_CreateEx(threadHandle, func, arg, NULL);
+}
+
+THREADAPI_RESULT ThreadAPI_CreateEx(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg, const THREADAPI_ATTRIBUTES* attributes)
 {
     THREADAPI_RESULT result;
     if ((threadHandle == NULL) ||
-        (func == NULL))
+        (func == NULL) ||
+        ((attributes != NULL) && ((attributes->priority < THREADAPI_PRIORITY_LOWEST) || (attributes->priority > THREADAPI_PRIORITY_HIGHEST))) ||
+        /*DWORD_PTR is 32 bits in a 32 bit process*/
+        ((attributes != NULL) && ((uint64_t)(DWORD_PTR)attributes->affinity_mask != attributes->affinity_mask)))
     {
         result = THREADAPI_INVALID_ARG;
         LogError("(result = %s)", ENUM_TO_STRING(THREADAPI_RESULT, result));
     }
-    else
+    else if (attributes == NULL)
     {
         *threadHandle = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, NULL);
         if(*threadHandle == NULL)
@@ -30,6 +72,57 @@ THREADAPI_RESULT ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC
             result = THREADAPI_OK;
         }
     }
+    else
+    {
+        /*created suspended so the affinity, priority and name are set before func runs. The stack size is what
+        the thread reserves, not what it commits, like the default stack of the exe*/
+        HANDLE thread = CreateThread(NULL, attributes->stack_size, (LPTHREAD_START_ROUTINE)func, arg,
+            CREATE_SUSPENDED | ((attributes->stack_size != 0) ? STACK_SIZE_PARAM_IS_A_RESERVATION : 0), NULL);
+        if (thread == NULL)
+        {
+            result = (GetLastError() == ERROR_OUTOFMEMORY) ? THREADAPI_NO_MEMORY : THREADAPI_ERROR;
+
+            LogError("(result = %s)", ENUM_TO_STRING(THREADAPI_RESULT, result));
+        }
+        else if ((attributes->affinity_mask != 0) &&
+            (SetThreadAffinityMask(thread, (DWORD_PTR)attributes->affinity_mask) == 0))
+        {
+            /*the thread never ran, terminating it does not leave anything behind*/
+            (void)TerminateThread(thread, 0);
+            (void)CloseHandle(thread);
+
+            result = THREADAPI_INVALID_ARG;
+            LogError("failed setting the affinity mask, GetLastError = %lu (result = %s)", (unsigned long)GetLastError(), ENUM_TO_STRING(THREADAPI_RESULT, result));
+        }
+        else
+        {
+            if ((attributes->priority != THREADAPI_PRIORITY_NORMAL) &&
+                /*THREADAPI_PRIORITY_* are the values of THREAD_PRIORITY_LOWEST to THREAD_PRIORITY_HIGHEST*/
+                !SetThreadPriority(thread, attributes->priority))
+            {
+                LogError("failed setting the priority of the thread to %d, GetLastError = %lu", attributes->priority, (unsigned long)GetLastError());
+            }
+
+            if (attributes->name != NULL)
+            {
+                set_thread_name(thread, attributes->name);
+            }
+
+            if (ResumeThread(thread) == (DWORD)-1)
+            {
+                (void)TerminateThread(thread, 0);
+                (void)CloseHandle(thread);
+
+                result = THREADAPI_ERROR;
+                LogError("(result = %s)", ENUM_TO_STRING(THREADAPI_RESULT, result));
+            }
+            else
+            {
+                *threadHandle = thread;
+                result = THREADAPI_OK;
+            }
+        }
+    }
 
     return result;
 }
@@ -54,3 +54,50 @@ int tickcounter_get_current_ms(TICK_COUNTER_HANDLE tick_counter, tickcounter_ms_
 
     return result;
 }
+
+/*there is no clock finer than milliseconds here, so microseconds and nanoseconds are the milliseconds scaled*/
+int tickcounter_get_current_us(TICK_COUNTER_HANDLE tick_counter, uint64_t* current_us)
+{
+    int result;
+    tickcounter_ms_t current_ms;
+
+    if (current_us == NULL)
+    {
+        LogError("tickcounter failed: Invalid Arguments.\r\n");
+        result = __LINE__;
+    }
+    else if (tickcounter_get_current_ms(tick_counter, &current_ms) != 0)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        *current_us = (uint64_t)current_ms * 1000;
+        result = 0;
+    }
+
+    return result;
+}
+
+int tickcounter_get_current_ns(TICK_COUNTER_HANDLE tick_counter, uint64_t* current_ns)
+{
+    int result;
+    tickcounter_ms_t current_ms;
+
+    if (current_ns == NULL)
+    {
+        LogError("tickcounter failed: Invalid Arguments.\r\n");
+        result = __LINE__;
+    }
+    else if (tickcounter_get_current_ms(tick_counter, &current_ms) != 0)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        *current_ns = (uint64_t)current_ms * 1000000;
+        result = 0;
+    }
+
+    return result;
+}
@@ -12,10 +12,48 @@
 
 typedef struct TICK_COUNTER_INSTANCE_TAG
 {
-    time_t init_time_value;
+    /*get_time_ns at tickcounter_create, on the time_basis clock (CLOCK_MONOTONIC where there is one)*/
+    uint64_t init_time_ns;
     tickcounter_ms_t current_ms;
 } TICK_COUNTER_INSTANCE;
 
+static int get_current_time_ns(uint64_t* time_ns)
+{
+    int result;
+    struct timespec ts;
+
+    if (get_time_ns(&ts) != 0)
+    {
+        LogError("tickcounter failed: get_time_ns failed.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        *time_ns = (uint64_t)ts.tv_sec * NANOSECONDS_IN_1_SECOND + (uint64_t)ts.tv_nsec;
+        result = 0;
+    }
+
+    return result;
+}
+
+static int get_elapsed_ns(TICK_COUNTER_HANDLE tick_counter, uint64_t* elapsed_ns)
+{
+    int result;
+    uint64_t time_ns;
+
+    if (get_current_time_ns(&time_ns) != 0)
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        *elapsed_ns = time_ns - ((TICK_COUNTER_INSTANCE*)tick_counter)->init_time_ns;
+        result = 0;
+    }
+
+    return result;
+}
+
 TICK_COUNTER_HANDLE tickcounter_create(void)
 {
     TICK_COUNTER_INSTANCE* result = (TICK_COUNTER_INSTANCE*)malloc(sizeof(TICK_COUNTER_INSTANCE));
@@ -23,8 +61,7 @@ TICK_COUNTER_HANDLE tickcounter_create(void)
     {
         set_time_basis();
 
-        result->init_time_value = get_time_s();
-        if (result->init_time_value == INVALID_TIME_VALUE)
+        if (get_current_time_ns(&result->init_time_ns) != 0)
         {
             LogError("tickcounter failed: time return INVALID_TIME.");
             free(result);
@@ -57,15 +94,15 @@ int tickcounter_get_current_ms(TICK_COUNTER_HANDLE tick_counter, tickcounter_ms_
     }
     else
     {
-        time_t time_value = get_time_s();
-        if (time_value == INVALID_TIME_VALUE)
+        uint64_t elapsed_ns;
+        if (get_elapsed_ns(tick_counter, &elapsed_ns) != 0)
         {
             result = __FAILURE__;
         }
         else
         {
             TICK_COUNTER_INSTANCE* tick_counter_instance = (TICK_COUNTER_INSTANCE*)tick_counter;
-            tick_counter_instance->current_ms = (tickcounter_ms_t)(difftime(time_value, tick_counter_instance->init_time_value) * 1000);
+            tick_counter_instance->current_ms = (tickcounter_ms_t)(elapsed_ns / NANOSECONDS_IN_1_MILLISECOND);
             *current_ms = tick_counter_instance->current_ms;
             result = 0;
         }
@@ -73,3 +110,46 @@ int tickcounter_get_current_ms(TICK_COUNTER_HANDLE tick_counter, tickcounter_ms_
 
     return result;
 }
+
+int tickcounter_get_current_us(TICK_COUNTER_HANDLE tick_counter, uint64_t* current_us)
+{
+    int result;
+
+    if (tick_counter == NULL || current_us == NULL)
+    {
+        LogError("tickcounter failed: Invalid Arguments.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        uint64_t elapsed_ns;
+        if (get_elapsed_ns(tick_counter, &elapsed_ns) != 0)
+        {
+            result = __FAILURE__;
+        }
+        else
+        {
+            *current_us = elapsed_ns / 1000;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+int tickcounter_get_current_ns(TICK_COUNTER_HANDLE tick_counter, uint64_t* current_ns)
+{
+    int result;
+
+    if (tick_counter == NULL || current_ns == NULL)
+    {
+        LogError("tickcounter failed: Invalid Arguments.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = get_elapsed_ns(tick_counter, current_ns);
+    }
+
+    return result;
+}
@@ -15,6 +15,7 @@ typedef struct TICK_COUNTER_INSTANCE_TAG
 {
     LARGE_INTEGER perf_freqency;
     LARGE_INTEGER last_perf_counter;
+    LARGE_INTEGER start_perf_counter;
     time_t backup_time_value;
     tickcounter_ms_t current_ms;
 } TICK_COUNTER_INSTANCE;
@@ -48,6 +49,7 @@ TICK_COUNTER_HANDLE tickcounter_create(void)
             }
             else
             {
+                result->start_perf_counter = result->last_perf_counter;
                 result->backup_time_value = INVALID_TIME_VALUE;
                 result->current_ms = 0;
             }
@@ -117,3 +119,80 @@ int tickcounter_get_current_ms(TICK_COUNTER_HANDLE tick_counter, tickcounter_ms_
     }
     return result;
 }
+
+static int get_elapsed_ns(TICK_COUNTER_INSTANCE* tick_counter_instance, uint64_t* elapsed_ns)
+{
+    int result;
+
+    if (tick_counter_instance->backup_time_value == INVALID_TIME_VALUE)
+    {
+        LARGE_INTEGER curr_perf_item;
+        if (!QueryPerformanceCounter(&curr_perf_item))
+        {
+            LogError("tickcounter failed: QueryPerformanceCounter failed %d.", GetLastError());
+            result = __FAILURE__;
+        }
+        else
+        {
+            /*whole seconds and the rest apart, so that the multiplication by 10^9 does not overflow*/
+            uint64_t ticks = (uint64_t)(curr_perf_item.QuadPart - tick_counter_instance->start_perf_counter.QuadPart);
+            uint64_t frequency = (uint64_t)tick_counter_instance->perf_freqency.QuadPart;
+            *elapsed_ns = (ticks / frequency) * 1000000000 + ((ticks % frequency) * 1000000000) / frequency;
+            result = 0;
+        }
+    }
+    else
+    {
+        time_t time_value = time(NULL);
+        if (time_value == INVALID_TIME_VALUE)
+        {
+            result = __FAILURE__;
+        }
+        else
+        {
+            *elapsed_ns = (uint64_t)difftime(time_value, tick_counter_instance->backup_time_value) * 1000000000;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+int tickcounter_get_current_us(TICK_COUNTER_HANDLE tick_counter, uint64_t* current_us)
+{
+    int result;
+    if (tick_counter == NULL || current_us == NULL)
+    {
+        LogError("tickcounter failed: Invalid Arguments.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        uint64_t elapsed_ns;
+        if (get_elapsed_ns((TICK_COUNTER_INSTANCE*)tick_counter, &elapsed_ns) != 0)
+        {
+            result = __FAILURE__;
+        }
+        else
+        {
+            *current_us = elapsed_ns / 1000;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int tickcounter_get_current_ns(TICK_COUNTER_HANDLE tick_counter, uint64_t* current_ns)
+{
+    int result;
+    if (tick_counter == NULL || current_ns == NULL)
+    {
+        LogError("tickcounter failed: Invalid Arguments.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = get_elapsed_ns((TICK_COUNTER_INSTANCE*)tick_counter, current_ns);
+    }
+    return result;
+}
@@ -964,7 +964,8 @@ static const IO_INTERFACE_DESCRIPTION tlsio_mbedtls_interface_description =
         tlsio_mbedtls_close,
         tlsio_mbedtls_send,
         tlsio_mbedtls_dowork,
-        tlsio_mbedtls_setoption};
+        tlsio_mbedtls_setoption,
+        NULL};
 
 const IO_INTERFACE_DESCRIPTION *tlsio_mbedtls_get_interface_description(void)
 {
@@ -78,7 +78,7 @@ typedef struct TLS_IO_INSTANCE_TAG
 
 struct CRYPTO_dynlock_value
 {
-    LOCK_HANDLE lock;
+    RWLOCK_HANDLE lock;
 };
 
 static const char* const OPTION_UNDERLYING_IO_OPTIONS = "underlying_io_options";
@@ -386,13 +386,14 @@ static const IO_INTERFACE_DESCRIPTION tlsio_openssl_interface_description =
     tlsio_openssl_close,
     tlsio_openssl_send,
     tlsio_openssl_dowork,
-    tlsio_openssl_setoption
+    tlsio_openssl_setoption,
+    NULL
 };
 
-static LOCK_HANDLE * openssl_locks = NULL;
+static RWLOCK_HANDLE * openssl_locks = NULL;
 
 
-static void openssl_lock_unlock_helper(LOCK_HANDLE lock, int lock_mode, const char* file, int line)
+static void openssl_lock_unlock_helper(RWLOCK_HANDLE lock, int lock_mode, const char* file, int line)
 {
 #ifdef NO_LOGGING
     // Avoid unused variable warning when logging not compiled in
@@ -400,16 +401,18 @@ static void openssl_lock_unlock_helper(LOCK_HANDLE lock, int lock_mode, const ch
     (void)line;
 #endif
 
+    /*most of the locking OpenSSL does is lookups that ask for CRYPTO_READ (the error string tables, the ex_data
+    classes), those run in parallel. The unlock carries the same CRYPTO_READ/CRYPTO_WRITE as the lock*/
     if (lock_mode & CRYPTO_LOCK)
     {
-        if (Lock(lock) != 0)
+        if (((lock_mode & CRYPTO_READ) ? ReadLock(lock) : WriteLock(lock)) != LOCK_OK)
         {
             LogError("Failed to lock openssl lock (%s:%d)", file, line);
         }
     }
     else
     {
-        if (Unlock(lock) != 0)
+        if (((lock_mode & CRYPTO_READ) ? ReadUnlock(lock) : WriteUnlock(lock)) != LOCK_OK)
         {
             LogError("Failed to unlock openssl lock (%s:%d)", file, line);
         }
@@ -455,7 +458,7 @@ static STATIC_VAR_UNUSED struct CRYPTO_dynlock_value* openssl_dynamic_locks_crea
     }
     else
     {
-        result->lock = Lock_Init();
+        result->lock = RWLock_Init();
         if (result->lock == NULL)
         {
             LogError("Failed to create lock for dynamic lock (%s:%d).", file, line);
@@ -477,7 +480,7 @@ static STATIC_VAR_UNUSED void openssl_dynamic_locks_destroy_cb(struct CRYPTO_dyn
 {
     (void)file;
     (void)line;
-    Lock_Deinit(dynlock_value->lock);
+    RWLock_Deinit(dynlock_value->lock);
     free(dynlock_value);
 }
 
@@ -522,7 +525,7 @@ static void openssl_static_locks_uninstall(void)
         {
             if (openssl_locks[i] != NULL)
             {
-                Lock_Deinit(openssl_locks[i]);
+                RWLock_Deinit(openssl_locks[i]);
             }
         }
 
@@ -546,7 +549,7 @@ static int openssl_static_locks_install(void)
     }
     else
     {
-        openssl_locks = malloc(CRYPTO_num_locks() * sizeof(LOCK_HANDLE));
+        openssl_locks = malloc(CRYPTO_num_locks() * sizeof(RWLOCK_HANDLE));
         if (openssl_locks == NULL)
         {
             LogError("Failed to allocate locks");
@@ -557,7 +560,7 @@ static int openssl_static_locks_install(void)
             int i;
             for (i = 0; i < CRYPTO_num_locks(); i++)
             {
-                openssl_locks[i] = Lock_Init();
+                openssl_locks[i] = RWLock_Init();
                 if (openssl_locks[i] == NULL)
                 {
                     LogError("Failed to allocate lock %d", i);
@@ -570,7 +573,7 @@ static int openssl_static_locks_install(void)
                 int j;
                 for (j = 0; j < i; j++)
                 {
-                    Lock_Deinit(openssl_locks[j]);
+                    RWLock_Deinit(openssl_locks[j]);
                 }
                 result = __FAILURE__;
             }
@@ -120,7 +120,8 @@ static const IO_INTERFACE_DESCRIPTION tlsio_openssl_interface_description =
     tlsio_openssl_close,
     tlsio_openssl_send,
     tlsio_openssl_dowork,
-    tlsio_openssl_setoption
+    tlsio_openssl_setoption,
+    NULL
 };
 
 static void indicate_open_complete(TLS_IO_INSTANCE* tls_io_instance, IO_OPEN_RESULT open_result)
@@ -91,7 +91,8 @@ static const IO_INTERFACE_DESCRIPTION tlsio_template_interface_description =
     tlsio_template_close,
     tlsio_template_send,
     tlsio_template_dowork,
-    tlsio_template_setoption
+    tlsio_template_setoption,
+    NULL
 };
 
 static void indicate_error(TLS_IO_INSTANCE* tls_io_instance)
@@ -202,7 +202,8 @@ static const IO_INTERFACE_DESCRIPTION tlsio_wolfssl_interface_description =
     tlsio_wolfssl_close,
     tlsio_wolfssl_send,
     tlsio_wolfssl_dowork,
-    tlsio_wolfssl_setoption
+    tlsio_wolfssl_setoption,
+    NULL
 };
 
 static void indicate_error(TLS_IO_INSTANCE* tls_io_instance)
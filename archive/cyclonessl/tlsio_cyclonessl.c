@@ -637,7 +637,8 @@ static const IO_INTERFACE_DESCRIPTION tlsio_cyclonessl_interface_description =
     tlsio_cyclonessl_close,
     tlsio_cyclonessl_send,
     tlsio_cyclonessl_dowork,
-    tlsio_cyclonessl_setoption
+    tlsio_cyclonessl_setoption,
+    NULL
 };
 
 /* Codes_SRS_TLSIO_CYCLONESSL_01_069: [ tlsio_cyclonessl_get_interface_description shall return a pointer to an IO_INTERFACE_DESCRIPTION structure that contains pointers to the functions: tlsio_cyclonessl_retrieve_options, tlsio_cyclonessl_create, tlsio_cyclonessl_destroy, tlsio_cyclonessl_open, tlsio_cyclonessl_close, tlsio_cyclonessl_send and tlsio_cyclonessl_dowork.  ]*/
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+/*an arena hands out memory for temporaries by bumping a pointer in big blocks, everything is given back at once by arena_reset/arena_destroy*/
+typedef struct ARENA_HANDLE_DATA_TAG* ARENA_HANDLE;
+
+/*create*/
+MOCKABLE_FUNCTION(, ARENA_HANDLE, arena_create, size_t, block_size);
+MOCKABLE_FUNCTION(, void, arena_destroy, ARENA_HANDLE, arena);
+
+/*allocate, the memory is aligned like malloc's and stays valid until the next arena_reset or arena_destroy*/
+MOCKABLE_FUNCTION(, void*, arena_alloc, ARENA_HANDLE, arena, size_t, size);
+MOCKABLE_FUNCTION(, char*, arena_strdup, ARENA_HANDLE, arena, const char*, source);
+
+/*gives back everything allocated so far, keeps the newest block for the next round unless it is bigger than 1MB*/
+MOCKABLE_FUNCTION(, void, arena_reset, ARENA_HANDLE, arena);
+
+/* getters */
+MOCKABLE_FUNCTION(, size_t, arena_get_peak_size, ARENA_HANDLE, arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*ARENA_H*/
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include "azure_c_shared_utility/buffer_.h"
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+/*a BUFFER_POOL hands out empty BUFFER_HANDLEs and takes them back when they are given to BUFFER_delete,
+so code that creates and deletes a buffer per packet reuses the same memory. Every thread keeps its own
+free lists, one per power of 2 capacity from 64 bytes to 64KB*/
+typedef struct BUFFER_POOL_TAG* BUFFER_POOL_HANDLE;
+
+typedef struct BUFFER_POOL_STATISTICS_TAG
+{
+    size_t hits; /*BUFFER_POOL_get calls that got a buffer from the pool*/
+    size_t misses; /*BUFFER_POOL_get calls that had to allocate a buffer*/
+    size_t recycled; /*buffers the pool took back from BUFFER_delete*/
+    size_t discarded; /*buffers BUFFER_delete freed because the pool was full or they did not fit in a free list*/
+    size_t cached_buffers; /*buffers waiting in the free lists of all the threads*/
+    size_t cached_bytes; /*capacity of those buffers*/
+} BUFFER_POOL_STATISTICS;
+
+/*max_cached_bytes is the capacity the pool keeps in the lists it shares between threads, on top of the few buffers every thread keeps for itself*/
+MOCKABLE_FUNCTION(, BUFFER_POOL_HANDLE, BUFFER_POOL_create, size_t, max_cached_bytes);
+/*all the buffers of the pool have to be deleted before the pool is destroyed*/
+MOCKABLE_FUNCTION(, void, BUFFER_POOL_destroy, BUFFER_POOL_HANDLE, pool);
+
+/*returns a buffer of length 0 that can hold at least capacity bytes, BUFFER_delete gives it back*/
+MOCKABLE_FUNCTION(, BUFFER_HANDLE, BUFFER_POOL_get, BUFFER_POOL_HANDLE, pool, size_t, capacity);
+
+MOCKABLE_FUNCTION(, int, BUFFER_POOL_get_statistics, BUFFER_POOL_HANDLE, pool, BUFFER_POOL_STATISTICS*, statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_POOL_H */
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef BUFFER_TYPES_INTERNAL_H
+#define BUFFER_TYPES_INTERNAL_H
+
+#ifdef __cplusplus
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif
+
+struct BUFFER_TAG;
+
+typedef struct BUFFER_RECYCLER_TAG BUFFER_RECYCLER;
+
+/*called by BUFFER_delete, returns 0 when the recycler kept the buffer, BUFFER_delete frees it otherwise*/
+typedef int(*BUFFER_RECYCLE)(BUFFER_RECYCLER* recycler, struct BUFFER_TAG* buffer);
+
+struct BUFFER_RECYCLER_TAG
+{
+    BUFFER_RECYCLE recycle;
+};
+
+typedef struct BUFFER_TAG
+{
+    unsigned char* buffer;
+    size_t size; /*bytes in use, this is what BUFFER_length returns*/
+    size_t capacity; /*bytes allocated for buffer*/
+    size_t headroom; /*bytes allocated in front of buffer, BUFFER_push_front fills them without moving the content*/
+    BUFFER_RECYCLER* recycler; /*NULL unless the buffer came from a BUFFER_POOL*/
+} BUFFER;
+
+#endif /* BUFFER_TYPES_INTERNAL_H */
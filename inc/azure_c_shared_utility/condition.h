@@ -33,16 +33,25 @@ DEFINE_ENUM(COND_RESULT, COND_RESULT_VALUES);
 MOCKABLE_FUNCTION(, COND_HANDLE, Condition_Init);
 
 /**
-* @brief    unblock all currently working condition.
+* @brief    unblock one of the threads waiting on the condition.
 *
-* @param    handle    A valid handle to the lock.
+* @param    handle    A valid handle to the condition.
 *
-* @return    Returns @c COND_OK when the condition object has been
-*             destroyed and @c COND_ERROR when an error occurs
-*             and @c COND_TIMEOUT when the handle times out.
+* @return    Returns @c COND_OK when the condition has been posted
+*             and @c COND_ERROR when an error occurs.
 */
 MOCKABLE_FUNCTION(, COND_RESULT, Condition_Post, COND_HANDLE, handle);
 
+/**
+* @brief    unblock all the threads waiting on the condition.
+*
+* @param    handle    A valid handle to the condition.
+*
+* @return    Returns @c COND_OK when the condition has been broadcast
+*             and @c COND_ERROR when an error occurs.
+*/
+MOCKABLE_FUNCTION(, COND_RESULT, Condition_Broadcast, COND_HANDLE, handle);
+
 /**
 * @brief    block on the condition handle unti the thread is signalled
 *           or until the timeout_milliseconds is reached.
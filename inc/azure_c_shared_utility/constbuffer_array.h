@@ -16,6 +16,9 @@ extern "C" {
 
 typedef struct CONSTBUFFER_ARRAY_HANDLE_DATA_TAG* CONSTBUFFER_ARRAY_HANDLE;
 
+/*a builder collects CONSTBUFFER_HANDLEs one at a time (with amortized O(1) append) and then seals them into a CONSTBUFFER_ARRAY_HANDLE*/
+typedef struct CONSTBUFFER_ARRAY_BUILDER_HANDLE_DATA_TAG* CONSTBUFFER_ARRAY_BUILDER_HANDLE;
+
 /*create*/
 MOCKABLE_FUNCTION(, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_create, const CONSTBUFFER_HANDLE*, buffers, uint32_t, buffer_count);
 MOCKABLE_FUNCTION(, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_create_empty);
@@ -27,6 +30,9 @@ MOCKABLE_FUNCTION(, void, constbuffer_array_dec_ref, CONSTBUFFER_ARRAY_HANDLE, c
 /*add in front*/
 MOCKABLE_FUNCTION(, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_add_front, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_handle, CONSTBUFFER_HANDLE, constbuffer_handle);
 
+/*add at the back*/
+MOCKABLE_FUNCTION(, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_add_back, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_handle, CONSTBUFFER_HANDLE, constbuffer_handle);
+
 /*remove front*/
 MOCKABLE_FUNCTION(, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_remove_front, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_handle, CONSTBUFFER_HANDLE *, constbuffer_handle);
 
@@ -37,6 +43,12 @@ MOCKABLE_FUNCTION(, const CONSTBUFFER*, constbuffer_array_get_buffer_content, CO
 MOCKABLE_FUNCTION(, int, constbuffer_array_get_all_buffers_size, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_handle, uint32_t*, all_buffers_size);
 MOCKABLE_FUNCTION(, const CONSTBUFFER_HANDLE*, constbuffer_array_get_const_buffer_handle_array, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_handle);
 
+/* builder */
+MOCKABLE_FUNCTION(, CONSTBUFFER_ARRAY_BUILDER_HANDLE, constbuffer_array_builder_create);
+MOCKABLE_FUNCTION(, void, constbuffer_array_builder_destroy, CONSTBUFFER_ARRAY_BUILDER_HANDLE, constbuffer_array_builder_handle);
+MOCKABLE_FUNCTION(, int, constbuffer_array_builder_append, CONSTBUFFER_ARRAY_BUILDER_HANDLE, constbuffer_array_builder_handle, CONSTBUFFER_HANDLE, constbuffer_handle);
+MOCKABLE_FUNCTION(, CONSTBUFFER_ARRAY_HANDLE, constbuffer_array_builder_seal, CONSTBUFFER_ARRAY_BUILDER_HANDLE, constbuffer_array_builder_handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef COUNTING_SEMAPHORE_H
+#define COUNTING_SEMAPHORE_H
+
+#include "azure_c_shared_utility/macro_utils.h"
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+/*a count of units. counting_semaphore_acquire takes one and blocks while there is none, counting_semaphore_release
+gives some back. Not named semaphore_* since the Mach headers on macOS already have a semaphore_create*/
+typedef struct COUNTING_SEMAPHORE_TAG* COUNTING_SEMAPHORE_HANDLE;
+
+#define COUNTING_SEMAPHORE_RESULT_VALUES \
+    COUNTING_SEMAPHORE_OK, \
+    COUNTING_SEMAPHORE_INVALID_ARG, \
+    COUNTING_SEMAPHORE_TIMEOUT, \
+    COUNTING_SEMAPHORE_ERROR
+
+DEFINE_ENUM(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_RESULT_VALUES);
+
+MOCKABLE_FUNCTION(, COUNTING_SEMAPHORE_HANDLE, counting_semaphore_create, size_t, initial_count);
+/*only once nothing waits on semaphore anymore*/
+MOCKABLE_FUNCTION(, void, counting_semaphore_destroy, COUNTING_SEMAPHORE_HANDLE, semaphore);
+
+/*timeout_milliseconds 0 waits for as long as it takes, like Condition_Wait*/
+MOCKABLE_FUNCTION(, COUNTING_SEMAPHORE_RESULT, counting_semaphore_acquire, COUNTING_SEMAPHORE_HANDLE, semaphore, int, timeout_milliseconds);
+MOCKABLE_FUNCTION(, COUNTING_SEMAPHORE_RESULT, counting_semaphore_release, COUNTING_SEMAPHORE_HANDLE, semaphore, size_t, count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COUNTING_SEMAPHORE_H */
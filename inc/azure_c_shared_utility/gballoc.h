@@ -4,6 +4,7 @@
 #ifndef GBALLOC_H
 #define GBALLOC_H
 
+#include "azure_c_shared_utility/macro_utils.h"
 #include "azure_c_shared_utility/umock_c_prod.h"
 
 #ifdef __cplusplus
@@ -16,6 +17,12 @@ extern "C"
 #include <stdlib.h>
 #endif
 
+#define GBALLOC_DUMP_FORMAT_VALUES \
+    GBALLOC_DUMP_TEXT, \
+    GBALLOC_DUMP_PPROF
+
+DEFINE_ENUM(GBALLOC_DUMP_FORMAT, GBALLOC_DUMP_FORMAT_VALUES);
+
 // GB_USE_CUSTOM_HEAP disables the implementations in gballoc.c and
 // requires that an external library implement the gballoc_malloc family
 // declared here.
@@ -46,6 +53,13 @@ MOCKABLE_FUNCTION(, size_t, gballoc_getCurrentMemoryUsed);
 MOCKABLE_FUNCTION(, size_t, gballoc_getAllocationCount);
 MOCKABLE_FUNCTION(, void, gballoc_resetMetrics);
 
+/* allocation site profiling: the _at functions also record the file and line they are called from */
+MOCKABLE_FUNCTION(, void*, gballoc_malloc_at, size_t, size, const char*, file, int, line);
+MOCKABLE_FUNCTION(, void*, gballoc_calloc_at, size_t, nmemb, size_t, size, const char*, file, int, line);
+MOCKABLE_FUNCTION(, void*, gballoc_realloc_at, void*, ptr, size_t, size, const char*, file, int, line);
+MOCKABLE_FUNCTION(, int, gballoc_setSiteSamplingRate, size_t, rate);
+MOCKABLE_FUNCTION(, int, gballoc_dumpSites, const char*, fileName, GBALLOC_DUMP_FORMAT, format);
+
 /* if GB_MEASURE_MEMORY_FOR_THIS is defined then we want to redirect memory allocation functions to gballoc_xxx functions */
 #ifdef GB_MEASURE_MEMORY_FOR_THIS
 /* Unfortunately this is still needed here for things to still compile when using _CRTDBG_MAP_ALLOC.
@@ -59,6 +73,12 @@ That is because there is a rogue component (most likely CppUnitTest) including c
 #define _calloc_dbg(nmemb, size, ...) gballoc_calloc(nmemb, size)
 #define _realloc_dbg(ptr, size, ...) gballoc_realloc(ptr, size)
 #define _free_dbg(ptr, ...) gballoc_free(ptr)
+#elif defined(GB_TRACK_ALLOCATION_SITES)
+/* GB_TRACK_ALLOCATION_SITES makes every allocation of the translation unit carry its file and line */
+#define malloc(size) gballoc_malloc_at(size, __FILE__, __LINE__)
+#define calloc(nmemb, size) gballoc_calloc_at(nmemb, size, __FILE__, __LINE__)
+#define realloc(ptr, size) gballoc_realloc_at(ptr, size, __FILE__, __LINE__)
+#define free gballoc_free
 #else
 #define malloc gballoc_malloc
 #define calloc gballoc_calloc
@@ -76,6 +96,8 @@ That is because there is a rogue component (most likely CppUnitTest) including c
 #define gballoc_getCurrentMemoryUsed() SIZE_MAX
 #define gballoc_getAllocationCount() SIZE_MAX
 #define gballoc_resetMetrics() ((void)0)
+#define gballoc_setSiteSamplingRate(rate) ((void)(rate), __LINE__)
+#define gballoc_dumpSites(fileName, format) ((void)(fileName), (void)(format), __LINE__)
 
 #endif /* GB_DEBUG_ALLOC */
 
@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef LATCH_H
+#define LATCH_H
+
+#include "azure_c_shared_utility/macro_utils.h"
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+/*a count set at latch_create that threads count down. latch_wait blocks until it is 0, once it is 0 it stays 0*/
+typedef struct LATCH_TAG* LATCH_HANDLE;
+
+#define LATCH_RESULT_VALUES \
+    LATCH_OK, \
+    LATCH_INVALID_ARG, \
+    LATCH_TIMEOUT, \
+    LATCH_ERROR
+
+DEFINE_ENUM(LATCH_RESULT, LATCH_RESULT_VALUES);
+
+MOCKABLE_FUNCTION(, LATCH_HANDLE, latch_create, size_t, count);
+/*only once nothing waits on latch anymore*/
+MOCKABLE_FUNCTION(, void, latch_destroy, LATCH_HANDLE, latch);
+
+/*counting down a latch that is already 0 is an error*/
+MOCKABLE_FUNCTION(, LATCH_RESULT, latch_count_down, LATCH_HANDLE, latch);
+/*timeout_milliseconds 0 waits for as long as it takes, like Condition_Wait*/
+MOCKABLE_FUNCTION(, LATCH_RESULT, latch_wait, LATCH_HANDLE, latch, int, timeout_milliseconds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LATCH_H */
@@ -70,6 +70,116 @@ MOCKABLE_FUNCTION(, LOCK_RESULT, Unlock, LOCK_HANDLE, handle);
  */
 MOCKABLE_FUNCTION(, LOCK_RESULT, Lock_Deinit, LOCK_HANDLE, handle);
 
+/*a lock that many readers can hold at the same time, or one writer. For state that is read far more often than it
+is changed, like option tables and certificate stores*/
+typedef void* RWLOCK_HANDLE;
+
+/**
+ * @brief    This API creates and returns a valid reader-writer lock handle.
+ *
+ * @return    A valid @c RWLOCK_HANDLE when successful or @c NULL otherwise.
+ */
+MOCKABLE_FUNCTION(, RWLOCK_HANDLE, RWLock_Init);
+
+/**
+ * @brief    Acquires the lock for reading. Other readers can hold it at the
+ *             same time, a writer waits until all the readers released it.
+ *
+ * @param    handle    A valid handle to the reader-writer lock.
+ *
+ * @return    Returns @c LOCK_OK when the lock has been acquired and
+ *             @c LOCK_ERROR when an error occurs.
+ */
+MOCKABLE_FUNCTION(, LOCK_RESULT, ReadLock, RWLOCK_HANDLE, handle);
+
+/**
+ * @brief    Releases the lock acquired with ::ReadLock.
+ *
+ * @param    handle    A valid handle to the reader-writer lock.
+ *
+ * @return    Returns @c LOCK_OK when the lock has been released and
+ *             @c LOCK_ERROR when an error occurs.
+ */
+MOCKABLE_FUNCTION(, LOCK_RESULT, ReadUnlock, RWLOCK_HANDLE, handle);
+
+/**
+ * @brief    Acquires the lock for writing, excluding readers and other
+ *             writers.
+ *
+ * @param    handle    A valid handle to the reader-writer lock.
+ *
+ * @return    Returns @c LOCK_OK when the lock has been acquired and
+ *             @c LOCK_ERROR when an error occurs.
+ */
+MOCKABLE_FUNCTION(, LOCK_RESULT, WriteLock, RWLOCK_HANDLE, handle);
+
+/**
+ * @brief    Releases the lock acquired with ::WriteLock.
+ *
+ * @param    handle    A valid handle to the reader-writer lock.
+ *
+ * @return    Returns @c LOCK_OK when the lock has been released and
+ *             @c LOCK_ERROR when an error occurs.
+ */
+MOCKABLE_FUNCTION(, LOCK_RESULT, WriteUnlock, RWLOCK_HANDLE, handle);
+
+/**
+ * @brief    The reader-writer lock instance is destroyed.
+ *
+ * @param    handle    A valid handle to the reader-writer lock.
+ *
+ * @return    Returns @c LOCK_OK when the lock object has been
+ *             destroyed and @c LOCK_ERROR when an error occurs.
+ */
+MOCKABLE_FUNCTION(, LOCK_RESULT, RWLock_Deinit, RWLOCK_HANDLE, handle);
+
+/*an exclusive lock that spins for a while before it blocks the thread, for locks that are held for a few instructions
+where blocking and waking costs more than the wait. On a single CPU it blocks right away*/
+typedef void* ADAPTIVELOCK_HANDLE;
+
+/*spins used when AdaptiveLock_Init is given 0*/
+#define ADAPTIVELOCK_DEFAULT_SPIN_COUNT 4000
+
+/**
+ * @brief    This API creates and returns a valid adaptive lock handle.
+ *
+ * @param    spin_count    How many times ::AdaptiveLock tries the lock before
+ *                         it blocks, 0 for ::ADAPTIVELOCK_DEFAULT_SPIN_COUNT.
+ *
+ * @return    A valid @c ADAPTIVELOCK_HANDLE when successful or @c NULL otherwise.
+ */
+MOCKABLE_FUNCTION(, ADAPTIVELOCK_HANDLE, AdaptiveLock_Init, unsigned int, spin_count);
+
+/**
+ * @brief    Acquires the lock, spinning before blocking when it is held.
+ *
+ * @param    handle    A valid handle to the adaptive lock.
+ *
+ * @return    Returns @c LOCK_OK when the lock has been acquired and
+ *             @c LOCK_ERROR when an error occurs.
+ */
+MOCKABLE_FUNCTION(, LOCK_RESULT, AdaptiveLock, ADAPTIVELOCK_HANDLE, handle);
+
+/**
+ * @brief    Releases the lock acquired with ::AdaptiveLock.
+ *
+ * @param    handle    A valid handle to the adaptive lock.
+ *
+ * @return    Returns @c LOCK_OK when the lock has been released and
+ *             @c LOCK_ERROR when an error occurs.
+ */
+MOCKABLE_FUNCTION(, LOCK_RESULT, AdaptiveUnlock, ADAPTIVELOCK_HANDLE, handle);
+
+/**
+ * @brief    The adaptive lock instance is destroyed.
+ *
+ * @param    handle    A valid handle to the adaptive lock.
+ *
+ * @return    Returns @c LOCK_OK when the lock object has been
+ *             destroyed and @c LOCK_ERROR when an error occurs.
+ */
+MOCKABLE_FUNCTION(, LOCK_RESULT, AdaptiveLock_Deinit, ADAPTIVELOCK_HANDLE, handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -55,6 +55,34 @@ typedef int (*MAP_FILTER_CALLBACK)(const char* mapProperty, const char* mapValue
  */
 MOCKABLE_FUNCTION(, MAP_HANDLE, Map_Create, MAP_FILTER_CALLBACK, mapFilterFunc);
 
+/**
+ * @brief   Creates a new, empty map with room for @p capacity keys and values.
+ *
+ * @param   mapFilterFunc   Same as for ::Map_Create.
+ * @param   capacity        The number of keys the map can hold before its
+ *                          storage needs to grow.
+ *
+ * @return  A valid @c MAP_HANDLE or @c NULL in case an error occurs.
+ */
+MOCKABLE_FUNCTION(, MAP_HANDLE, Map_CreateWithCapacity, MAP_FILTER_CALLBACK, mapFilterFunc, size_t, capacity);
+
+/**
+ * @brief   Creates a new, empty map that copies its keys and values into
+ *          shared blocks of memory instead of allocating each of them.
+ *
+ * @param   mapFilterFunc   Same as for ::Map_Create.
+ * @param   capacity        Same as for ::Map_CreateWithCapacity.
+ * @param   arenaBlockSize  The size in bytes of the first block of strings.
+ *                          Every new block is twice as big as the previous one.
+ *
+ *          Memory used by deleted keys and overwritten values is only released
+ *          when the map is destroyed, so this is meant for maps that are built
+ *          once and then mostly read.
+ *
+ * @return  A valid @c MAP_HANDLE or @c NULL in case an error occurs.
+ */
+MOCKABLE_FUNCTION(, MAP_HANDLE, Map_CreateWithStringArena, MAP_FILTER_CALLBACK, mapFilterFunc, size_t, capacity, size_t, arenaBlockSize);
+
 /**
  * @brief   Release all resources associated with the map.
  *
@@ -133,6 +161,18 @@ MOCKABLE_FUNCTION(, MAP_RESULT, Map_AddOrUpdate, MAP_HANDLE, handle, const char*
  */
 MOCKABLE_FUNCTION(, MAP_RESULT, Map_Delete, MAP_HANDLE, handle, const char*, key);
 
+/**
+ * @brief   Makes room in the map for at least @p capacity keys and values.
+ *
+ * @param   handle      The handle to an existing map.
+ * @param   capacity    The number of keys the map shall be able to hold
+ *                      without growing its storage.
+ *
+ * @return  Returns @c MAP_OK if the storage was grown successfully (or was
+ *          already big enough) or an error code otherwise.
+ */
+MOCKABLE_FUNCTION(, MAP_RESULT, Map_Reserve, MAP_HANDLE, handle, size_t, capacity);
+
 /**
  * @brief   This function returns a boolean value in @p keyExists if the map
  *          contains a key with the same value the parameter @p key.
@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include "azure_c_shared_utility/macro_utils.h"
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+/*a queue that any number of threads push to and one thread pops from, without a lock. It carries non-NULL pointers.
+The queue does not own the items, they have to be popped before the queue is destroyed*/
+typedef struct MPSC_QUEUE_TAG* MPSC_QUEUE_HANDLE;
+
+#define MPSC_QUEUE_RESULT_VALUES \
+    MPSC_QUEUE_OK, \
+    MPSC_QUEUE_FULL, \
+    MPSC_QUEUE_ERROR
+
+DEFINE_ENUM(MPSC_QUEUE_RESULT, MPSC_QUEUE_RESULT_VALUES);
+
+/*create, an unbounded queue allocates a node for every push, a bounded one keeps capacity items (rounded up to a power of 2) in a ring of at least 2 cells*/
+MOCKABLE_FUNCTION(, MPSC_QUEUE_HANDLE, mpsc_queue_create);
+MOCKABLE_FUNCTION(, MPSC_QUEUE_HANDLE, mpsc_queue_create_bounded, size_t, capacity);
+/*only the consumer thread, once no thread pushes anymore*/
+MOCKABLE_FUNCTION(, void, mpsc_queue_destroy, MPSC_QUEUE_HANDLE, queue);
+
+/*any thread*/
+MOCKABLE_FUNCTION(, MPSC_QUEUE_RESULT, mpsc_queue_push, MPSC_QUEUE_HANDLE, queue, void*, item);
+/*only the consumer thread, returns NULL when the queue is empty*/
+MOCKABLE_FUNCTION(, void*, mpsc_queue_pop, MPSC_QUEUE_HANDLE, queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPSC_QUEUE_H */
@@ -5,9 +5,11 @@
 #define SINGLYLINKEDLIST_H
 
 #ifdef __cplusplus
+#include <cstddef>
 extern "C" {
 #else
 #include "stdbool.h"
+#include <stddef.h>
 #endif /* __cplusplus */
 
 #include "azure_c_shared_utility/umock_c_prod.h"
@@ -39,6 +41,9 @@ typedef bool (*LIST_CONDITION_FUNCTION)(const void* item, const void* match_cont
 typedef void (*LIST_ACTION_FUNCTION)(const void* item, const void* action_context, bool* continue_processing);
 
 MOCKABLE_FUNCTION(, SINGLYLINKEDLIST_HANDLE, singlylinkedlist_create);
+/*the list keeps up to max_pooled_nodes removed nodes and reuses them in the next adds, so a queue that stays
+under that size does not allocate once it has warmed up*/
+MOCKABLE_FUNCTION(, SINGLYLINKEDLIST_HANDLE, singlylinkedlist_create_with_node_pool, size_t, max_pooled_nodes);
 MOCKABLE_FUNCTION(, void, singlylinkedlist_destroy, SINGLYLINKEDLIST_HANDLE, list);
 MOCKABLE_FUNCTION(, LIST_ITEM_HANDLE, singlylinkedlist_add, SINGLYLINKEDLIST_HANDLE, list, const void*, item);
 MOCKABLE_FUNCTION(, LIST_ITEM_HANDLE, singlylinkedlist_add_head, SINGLYLINKEDLIST_HANDLE, list, const void*, item);
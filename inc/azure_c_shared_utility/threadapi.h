@@ -13,7 +13,12 @@
 #include "azure_c_shared_utility/umock_c_prod.h"
 
 #ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
 extern "C" {
+#else
+#include <stddef.h>
+#include <stdint.h>
 #endif
 
 typedef int(*THREAD_START_FUNC)(void *);
@@ -31,6 +36,28 @@ DEFINE_ENUM(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
 
 typedef void* THREAD_HANDLE;
 
+#define THREADAPI_PRIORITY_LOWEST   -2
+#define THREADAPI_PRIORITY_NORMAL   0
+#define THREADAPI_PRIORITY_HIGHEST  2
+
+/** @brief Attributes of a thread created with ::ThreadAPI_CreateEx. A zeroed
+ *           struct creates the same thread as ::ThreadAPI_Create.
+ */
+typedef struct THREADAPI_ATTRIBUTES_TAG
+{
+    /** @brief Size of the stack in bytes, 0 for the platform default. The
+     *           platform can round it up to its minimum or page size. */
+    size_t stack_size;
+    /** @brief Bit n lets the thread run on CPU n, 0 lets it run on any CPU. */
+    uint64_t affinity_mask;
+    /** @brief Name shown by debuggers, perf and top, NULL for none. Linux
+     *           keeps the first 15 characters. */
+    const char* name;
+    /** @brief From ::THREADAPI_PRIORITY_LOWEST to ::THREADAPI_PRIORITY_HIGHEST,
+     *           relative to the other threads of the process. */
+    int priority;
+} THREADAPI_ATTRIBUTES;
+
 /**
  * @brief    Creates a thread with the entry point specified by the @p func
  *             argument.
@@ -47,6 +74,29 @@ typedef void* THREAD_HANDLE;
  */
 MOCKABLE_FUNCTION(, THREADAPI_RESULT, ThreadAPI_Create, THREAD_HANDLE*, threadHandle, THREAD_START_FUNC, func, void*, arg);
 
+/**
+ * @brief    Creates a thread like ::ThreadAPI_Create with the stack size,
+ *             CPU affinity, name and priority in @p attributes.
+ *
+ * @param   threadHandle    The handle to the new thread is returned in this
+ *                             pointer.
+ * @param    func            A function pointer that indicates the entry point
+ *                             to the new thread.
+ * @param   arg                A void pointer that must be passed to the function
+ *                             pointed to by @p func.
+ * @param   attributes      The attributes of the thread, NULL for the
+ *                             defaults of ::ThreadAPI_Create.
+ *
+ *            A stack size or an affinity the platform cannot give the thread
+ *            fails the call. The name and the priority are applied when the
+ *            platform and the privileges of the process allow it, otherwise
+ *            the failure is logged and the thread runs without them.
+ *
+ * @return    @c THREADAPI_OK if the API call is successful or an error
+ *             code in case it fails.
+ */
+MOCKABLE_FUNCTION(, THREADAPI_RESULT, ThreadAPI_CreateEx, THREAD_HANDLE*, threadHandle, THREAD_START_FUNC, func, void*, arg, const THREADAPI_ATTRIBUTES*, attributes);
+
 /**
  * @brief    Blocks the calling thread by waiting on the thread identified by
  *             the @p threadHandle argument to complete.
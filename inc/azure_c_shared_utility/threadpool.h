@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "azure_c_shared_utility/macro_utils.h"
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+/*a fixed number of worker threads, each with its own queue of work. A worker that runs out of work steals half
+of the work of another worker, so a few long items do not hold up the rest*/
+typedef struct THREADPOOL_TAG* THREADPOOL_HANDLE;
+/*counts the work submitted with it that did not run yet, threadpool_wait_group_wait blocks until it is 0*/
+typedef struct THREADPOOL_WAIT_GROUP_TAG* THREADPOOL_WAIT_GROUP_HANDLE;
+
+typedef void(*THREADPOOL_WORK_FUNCTION)(void* context);
+
+#define THREADPOOL_RESULT_VALUES \
+    THREADPOOL_OK, \
+    THREADPOOL_INVALID_ARG, \
+    THREADPOOL_ERROR
+
+DEFINE_ENUM(THREADPOOL_RESULT, THREADPOOL_RESULT_VALUES);
+
+MOCKABLE_FUNCTION(, THREADPOOL_HANDLE, threadpool_create, size_t, worker_count);
+/*runs the work that was submitted and joins the workers. Not from a work function*/
+MOCKABLE_FUNCTION(, void, threadpool_destroy, THREADPOOL_HANDLE, threadpool);
+
+/*any thread, including work functions*/
+MOCKABLE_FUNCTION(, THREADPOOL_RESULT, threadpool_submit, THREADPOOL_HANDLE, threadpool, THREADPOOL_WORK_FUNCTION, work_function, void*, context);
+MOCKABLE_FUNCTION(, THREADPOOL_RESULT, threadpool_submit_to_group, THREADPOOL_HANDLE, threadpool, THREADPOOL_WAIT_GROUP_HANDLE, wait_group, THREADPOOL_WORK_FUNCTION, work_function, void*, context);
+
+MOCKABLE_FUNCTION(, THREADPOOL_WAIT_GROUP_HANDLE, threadpool_wait_group_create);
+/*only once threadpool_wait_group_wait returned and nothing is submitted with it anymore*/
+MOCKABLE_FUNCTION(, void, threadpool_wait_group_destroy, THREADPOOL_WAIT_GROUP_HANDLE, wait_group);
+/*blocks until all the work submitted with wait_group ran. Not from a work function, the worker it blocks could be the one that has the work*/
+MOCKABLE_FUNCTION(, THREADPOOL_RESULT, threadpool_wait_group_wait, THREADPOOL_WAIT_GROUP_HANDLE, wait_group);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREADPOOL_H */
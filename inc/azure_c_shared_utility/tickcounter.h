@@ -24,6 +24,9 @@ extern "C"
     MOCKABLE_FUNCTION(, TICK_COUNTER_HANDLE, tickcounter_create);
     MOCKABLE_FUNCTION(, void, tickcounter_destroy, TICK_COUNTER_HANDLE, tick_counter);
     MOCKABLE_FUNCTION(, int, tickcounter_get_current_ms, TICK_COUNTER_HANDLE, tick_counter, tickcounter_ms_t *, current_ms);
+    /*the time elapsed since tickcounter_create in microseconds and nanoseconds. Platforms without a finer clock scale the milliseconds*/
+    MOCKABLE_FUNCTION(, int, tickcounter_get_current_us, TICK_COUNTER_HANDLE, tick_counter, uint64_t *, current_us);
+    MOCKABLE_FUNCTION(, int, tickcounter_get_current_ns, TICK_COUNTER_HANDLE, tick_counter, uint64_t *, current_ns);
 
 #ifdef __cplusplus
 }
@@ -19,24 +19,33 @@ extern "C"
 
 /* creation */
 MOCKABLE_FUNCTION(, VECTOR_HANDLE, VECTOR_create, size_t, elementSize);
+/*a sorted vector keeps its elements in the order given by compare, elements are added with VECTOR_insert_sorted and looked up with VECTOR_lower_bound*/
+MOCKABLE_FUNCTION(, VECTOR_HANDLE, VECTOR_create_sorted, size_t, elementSize, VECTOR_COMPARE_FUNCTION, compare);
 MOCKABLE_FUNCTION(, VECTOR_HANDLE, VECTOR_move, VECTOR_HANDLE, handle);
 MOCKABLE_FUNCTION(, void, VECTOR_destroy, VECTOR_HANDLE, handle);
 
 /* insertion */
 MOCKABLE_FUNCTION(, int, VECTOR_push_back, VECTOR_HANDLE, handle, const void*, elements, size_t, numElements);
+MOCKABLE_FUNCTION(, int, VECTOR_insert, VECTOR_HANDLE, handle, size_t, index, const void*, elements, size_t, numElements);
+MOCKABLE_FUNCTION(, int, VECTOR_insert_sorted, VECTOR_HANDLE, handle, const void*, element);
 
 /* removal */
 MOCKABLE_FUNCTION(, void, VECTOR_erase, VECTOR_HANDLE, handle, void*, elements, size_t, numElements);
 MOCKABLE_FUNCTION(, void, VECTOR_clear, VECTOR_HANDLE, handle);
+MOCKABLE_FUNCTION(, void, VECTOR_pop_back, VECTOR_HANDLE, handle);
 
 /* access */
 MOCKABLE_FUNCTION(, void*, VECTOR_element, VECTOR_HANDLE, handle, size_t, index);
 MOCKABLE_FUNCTION(, void*, VECTOR_front, VECTOR_HANDLE, handle);
 MOCKABLE_FUNCTION(, void*, VECTOR_back, VECTOR_HANDLE, handle);
 MOCKABLE_FUNCTION(, void*, VECTOR_find_if, VECTOR_HANDLE, handle, PREDICATE_FUNCTION, pred, const void*, value);
+MOCKABLE_FUNCTION(, void*, VECTOR_lower_bound, VECTOR_HANDLE, handle, const void*, value);
 
 /* capacity */
 MOCKABLE_FUNCTION(, size_t, VECTOR_size, VECTOR_HANDLE, handle);
+MOCKABLE_FUNCTION(, size_t, VECTOR_capacity, VECTOR_HANDLE, handle);
+MOCKABLE_FUNCTION(, int, VECTOR_reserve, VECTOR_HANDLE, handle, size_t, numElements);
+MOCKABLE_FUNCTION(, void, VECTOR_shrink_to_fit, VECTOR_HANDLE, handle);
 
 #ifdef __cplusplus
 }
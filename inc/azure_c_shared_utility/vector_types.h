@@ -15,6 +15,9 @@ typedef struct VECTOR_TAG* VECTOR_HANDLE;
 
 typedef bool(*PREDICATE_FUNCTION)(const void* element, const void* value);
 
+/*returns a negative value, 0 or a positive value when element is less than, equal to or greater than value*/
+typedef int(*VECTOR_COMPARE_FUNCTION)(const void* element, const void* value);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,11 +10,15 @@
 #include <stddef.h>
 #endif
 
+#include "azure_c_shared_utility/vector_types.h"
+
 typedef struct VECTOR_TAG
 {
     void* storage;
     size_t count;
+    size_t capacity; /*number of elements storage can hold*/
     size_t elementSize;
+    VECTOR_COMPARE_FUNCTION compare; /*not NULL for sorted vectors*/
 } VECTOR;
 
 #endif /* VECTOR_TYPES_INTERNAL_H */
@@ -5,6 +5,7 @@
 #define XIO_H
 
 #include "azure_c_shared_utility/optionhandler.h"
+#include "azure_c_shared_utility/constbuffer_array.h"
 
 #include "azure_c_shared_utility/umock_c_prod.h"
 #include "azure_c_shared_utility/macro_utils.h"
@@ -47,6 +48,8 @@ typedef int(*IO_CLOSE)(CONCRETE_IO_HANDLE concrete_io, ON_IO_CLOSE_COMPLETE on_i
 typedef int(*IO_SEND)(CONCRETE_IO_HANDLE concrete_io, const void* buffer, size_t size, ON_SEND_COMPLETE on_send_complete, void* callback_context);
 typedef void(*IO_DOWORK)(CONCRETE_IO_HANDLE concrete_io);
 typedef int(*IO_SETOPTION)(CONCRETE_IO_HANDLE concrete_io, const char* optionName, const void* value);
+/*sends the bytes of all the buffers in the array, in order, as one message. buffers is only borrowed for the call, a concrete IO that needs bytes after it returns (the ones the socket did not take yet) copies them*/
+typedef int(*IO_SEND_VECTORED)(CONCRETE_IO_HANDLE concrete_io, CONSTBUFFER_ARRAY_HANDLE buffers, ON_SEND_COMPLETE on_send_complete, void* callback_context);
 
 
 typedef struct IO_INTERFACE_DESCRIPTION_TAG
@@ -59,6 +62,7 @@ typedef struct IO_INTERFACE_DESCRIPTION_TAG
     IO_SEND concrete_io_send;
     IO_DOWORK concrete_io_dowork;
     IO_SETOPTION concrete_io_setoption;
+    IO_SEND_VECTORED concrete_io_send_vectored; /*optional, when NULL xio_send_vectored copies the buffers into one block and calls concrete_io_send*/
 } IO_INTERFACE_DESCRIPTION;
 
 MOCKABLE_FUNCTION(, XIO_HANDLE, xio_create, const IO_INTERFACE_DESCRIPTION*, io_interface_description, const void*, io_create_parameters);
@@ -66,6 +70,7 @@ MOCKABLE_FUNCTION(, void, xio_destroy, XIO_HANDLE, xio);
 MOCKABLE_FUNCTION(, int, xio_open, XIO_HANDLE, xio, ON_IO_OPEN_COMPLETE, on_io_open_complete, void*, on_io_open_complete_context, ON_BYTES_RECEIVED, on_bytes_received, void*, on_bytes_received_context, ON_IO_ERROR, on_io_error, void*, on_io_error_context);
 MOCKABLE_FUNCTION(, int, xio_close, XIO_HANDLE, xio, ON_IO_CLOSE_COMPLETE, on_io_close_complete, void*, callback_context);
 MOCKABLE_FUNCTION(, int, xio_send, XIO_HANDLE, xio, const void*, buffer, size_t, size, ON_SEND_COMPLETE, on_send_complete, void*, callback_context);
+MOCKABLE_FUNCTION(, int, xio_send_vectored, XIO_HANDLE, xio, CONSTBUFFER_ARRAY_HANDLE, buffers, ON_SEND_COMPLETE, on_send_complete, void*, callback_context);
 MOCKABLE_FUNCTION(, void, xio_dowork, XIO_HANDLE, xio);
 MOCKABLE_FUNCTION(, int, xio_setoption, XIO_HANDLE, xio, const char*, optionName, const void*, value);
 MOCKABLE_FUNCTION(, OPTIONHANDLER_HANDLE, xio_retrieveoptions, XIO_HANDLE, xio);
@@ -79,3 +79,49 @@ int tickcounter_get_current_ms(TICK_COUNTER_HANDLE tick_counter, tickcounter_ms_
 
     return result;
 }
+
+static uint64_t get_elapsed_ticks_scaled(TICK_COUNTER_HANDLE tick_counter, uint64_t units_per_second)
+{
+    // Same overflow handling as tickcounter_get_current_ms, scaled with integers so no precision is lost
+    return (uint64_t)((uint32_t)(xTaskGetTickCount() - tick_counter->original_tick_count)) * units_per_second / CONFIG_FREERTOS_HZ;
+}
+
+int tickcounter_get_current_us(TICK_COUNTER_HANDLE tick_counter, uint64_t* current_us)
+{
+    int result;
+
+    if (tick_counter == NULL || current_us == NULL)
+    {
+        /* Codes_SRS_TICKCOUNTER_FREERTOS_11_001: [ If the tick_counter or current_us parameter is NULL, tickcounter_get_current_us shall return a non-zero value to indicate error. ] */
+        LogError("Invalid Arguments.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_TICKCOUNTER_FREERTOS_11_002: [ tickcounter_get_current_us shall set *current_us to the number of ticks elapsed since the tickcounter_create call, scaled to microseconds, and return 0. A single overflow of xTaskGetTickCount shall be handled like in tickcounter_get_current_ms. ] */
+        *current_us = get_elapsed_ticks_scaled(tick_counter, 1000000);
+        result = 0;
+    }
+
+    return result;
+}
+
+int tickcounter_get_current_ns(TICK_COUNTER_HANDLE tick_counter, uint64_t* current_ns)
+{
+    int result;
+
+    if (tick_counter == NULL || current_ns == NULL)
+    {
+        /* Codes_SRS_TICKCOUNTER_FREERTOS_11_003: [ If the tick_counter or current_ns parameter is NULL, tickcounter_get_current_ns shall return a non-zero value to indicate error. ] */
+        LogError("Invalid Arguments.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_TICKCOUNTER_FREERTOS_11_004: [ tickcounter_get_current_ns shall set *current_ns to the number of ticks elapsed since the tickcounter_create call, scaled to nanoseconds, and return 0. A single overflow of xTaskGetTickCount shall be handled like in tickcounter_get_current_ms. ] */
+        *current_ns = get_elapsed_ticks_scaled(tick_counter, 1000000000);
+        result = 0;
+    }
+
+    return result;
+}
@@ -0,0 +1,274 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/xlogging.h"
+#include "azure_c_shared_utility/optimize_size.h"
+
+#include "azure_c_shared_utility/arena.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+/*blocks double in size until they reach this, bigger requests get a block of their own size*/
+#define ARENA_MAX_BLOCK_SIZE (1024 * 1024)
+
+/*the header of a block, the union keeps the memory after it aligned like malloc does*/
+typedef union ARENA_BLOCK_TAG
+{
+    struct
+    {
+        union ARENA_BLOCK_TAG* next;
+        size_t size; /*bytes available after the header*/
+        size_t used;
+    } block;
+    long double alignment1;
+    void* alignment2;
+    long long alignment3;
+} ARENA_BLOCK;
+
+/*every allocation is rounded up to this, so the next one is aligned too*/
+typedef union ARENA_ALIGNMENT_TAG
+{
+    long double alignment1;
+    void* alignment2;
+    long long alignment3;
+} ARENA_ALIGNMENT_TYPE;
+
+#define ARENA_ALIGNMENT sizeof(ARENA_ALIGNMENT_TYPE)
+
+typedef struct ARENA_HANDLE_DATA_TAG
+{
+    size_t first_block_size;
+    ARENA_BLOCK* blocks; /*newest first*/
+    size_t size; /*bytes held in all the blocks*/
+    size_t peak_size;
+} ARENA_HANDLE_DATA;
+
+static void free_blocks(ARENA_BLOCK* block)
+{
+    while (block != NULL)
+    {
+        ARENA_BLOCK* next = block->block.next;
+        free(block);
+        block = next;
+    }
+}
+
+static ARENA_BLOCK* add_block(ARENA_HANDLE_DATA* arena, size_t size)
+{
+    ARENA_BLOCK* result;
+    size_t block_size;
+
+    if (arena->blocks == NULL)
+    {
+        block_size = arena->first_block_size;
+    }
+    else if (arena->blocks->block.size >= ARENA_MAX_BLOCK_SIZE / 2)
+    {
+        block_size = ARENA_MAX_BLOCK_SIZE;
+    }
+    else
+    {
+        block_size = arena->blocks->block.size * 2;
+    }
+
+    if (block_size < size)
+    {
+        block_size = size;
+    }
+
+    if (block_size > SIZE_MAX - sizeof(ARENA_BLOCK))
+    {
+        LogError("block size too big: %lu", (unsigned long)block_size);
+        result = NULL;
+    }
+    else if ((result = (ARENA_BLOCK*)malloc(sizeof(ARENA_BLOCK) + block_size)) == NULL)
+    {
+        LogError("failure allocating an arena block of %lu bytes", (unsigned long)block_size);
+    }
+    else
+    {
+        result->block.next = arena->blocks;
+        result->block.size = block_size;
+        result->block.used = 0;
+        arena->blocks = result;
+
+        /* Codes_SRS_ARENA_11_014: [ arena_get_peak_size shall return the largest number of bytes that the blocks of arena held at any time since arena_create. ]*/
+        arena->size += block_size;
+        if (arena->size > arena->peak_size)
+        {
+            arena->peak_size = arena->size;
+        }
+    }
+
+    return result;
+}
+
+ARENA_HANDLE arena_create(size_t block_size)
+{
+    ARENA_HANDLE result;
+
+    if (block_size == 0)
+    {
+        /* Codes_SRS_ARENA_11_001: [ If block_size is 0, arena_create shall fail and return NULL. ]*/
+        LogError("Invalid arguments: size_t block_size=%lu", (unsigned long)block_size);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_ARENA_11_002: [ arena_create shall allocate memory for a new ARENA_HANDLE and return it. The blocks are only allocated when needed. ]*/
+        result = (ARENA_HANDLE)malloc(sizeof(ARENA_HANDLE_DATA));
+        if (result == NULL)
+        {
+            /* Codes_SRS_ARENA_11_003: [ If any error occurs, arena_create shall fail and return NULL. ]*/
+            LogError("failure allocating arena");
+        }
+        else
+        {
+            result->first_block_size = block_size;
+            result->blocks = NULL;
+            result->size = 0;
+            result->peak_size = 0;
+        }
+    }
+
+    return result;
+}
+
+void arena_destroy(ARENA_HANDLE arena)
+{
+    if (arena == NULL)
+    {
+        /* Codes_SRS_ARENA_11_004: [ If arena is NULL, arena_destroy shall return. ]*/
+        LogError("Invalid arguments: ARENA_HANDLE arena=%p", arena);
+    }
+    else
+    {
+        /* Codes_SRS_ARENA_11_005: [ arena_destroy shall free all the blocks of arena and arena itself. ]*/
+        free_blocks(arena->blocks);
+        free(arena);
+    }
+}
+
+void* arena_alloc(ARENA_HANDLE arena, size_t size)
+{
+    void* result;
+
+    if (
+        /* Codes_SRS_ARENA_11_006: [ If arena is NULL or size is 0, arena_alloc shall fail and return NULL. ]*/
+        (arena == NULL) ||
+        (size == 0)
+        )
+    {
+        LogError("Invalid arguments: ARENA_HANDLE arena=%p, size_t size=%lu", arena, (unsigned long)size);
+        result = NULL;
+    }
+    else if (size > SIZE_MAX - ARENA_ALIGNMENT)
+    {
+        LogError("size too big: %lu", (unsigned long)size);
+        result = NULL;
+    }
+    else
+    {
+        ARENA_BLOCK* block = arena->blocks;
+        size_t aligned_size = (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+
+        /* Codes_SRS_ARENA_11_007: [ arena_alloc shall return the next size bytes (rounded up to the alignment of malloc) of the newest block. ]*/
+        /* Codes_SRS_ARENA_11_008: [ If the newest block does not have size bytes left, arena_alloc shall allocate a new block twice as big as the previous one (block_size for the first one, at most 1MB, and at least size). ]*/
+        if ((block == NULL) || (block->block.size - block->block.used < aligned_size))
+        {
+            block = add_block(arena, aligned_size);
+        }
+
+        if (block == NULL)
+        {
+            /* Codes_SRS_ARENA_11_009: [ If allocating the block fails, arena_alloc shall fail and return NULL. ]*/
+            result = NULL;
+        }
+        else
+        {
+            result = (unsigned char*)(block + 1) + block->block.used;
+            block->block.used += aligned_size;
+        }
+    }
+
+    return result;
+}
+
+char* arena_strdup(ARENA_HANDLE arena, const char* source)
+{
+    char* result;
+
+    if (
+        /* Codes_SRS_ARENA_11_010: [ If arena or source is NULL, arena_strdup shall fail and return NULL. ]*/
+        (arena == NULL) ||
+        (source == NULL)
+        )
+    {
+        LogError("Invalid arguments: ARENA_HANDLE arena=%p, const char* source=%p", arena, source);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_ARENA_11_011: [ arena_strdup shall copy source in strlen(source) + 1 bytes obtained like arena_alloc and return them, or NULL if that fails. ]*/
+        size_t size = strlen(source) + 1;
+        result = (char*)arena_alloc(arena, size);
+        if (result != NULL)
+        {
+            (void)memcpy(result, source, size);
+        }
+    }
+
+    return result;
+}
+
+void arena_reset(ARENA_HANDLE arena)
+{
+    if (arena == NULL)
+    {
+        /* Codes_SRS_ARENA_11_012: [ If arena is NULL, arena_reset shall return. ]*/
+        LogError("Invalid arguments: ARENA_HANDLE arena=%p", arena);
+    }
+    else if (arena->blocks != NULL)
+    {
+        /* Codes_SRS_ARENA_11_013: [ arena_reset shall free all the blocks of arena except the newest one, which becomes empty, unless the newest one is bigger than 1MB, then it shall free it too. ]*/
+        if (arena->blocks->block.size <= ARENA_MAX_BLOCK_SIZE)
+        {
+            free_blocks(arena->blocks->block.next);
+            arena->blocks->block.next = NULL;
+            arena->blocks->block.used = 0;
+            arena->size = arena->blocks->block.size;
+        }
+        else
+        {
+            /*a block of its own for one big request, the next requests are not likely to need it*/
+            free_blocks(arena->blocks);
+            arena->blocks = NULL;
+            arena->size = 0;
+        }
+    }
+}
+
+size_t arena_get_peak_size(ARENA_HANDLE arena)
+{
+    size_t result;
+
+    if (arena == NULL)
+    {
+        /* Codes_SRS_ARENA_11_015: [ If arena is NULL, arena_get_peak_size shall return 0. ]*/
+        LogError("Invalid arguments: ARENA_HANDLE arena=%p", arena);
+        result = 0;
+    }
+    else
+    {
+        result = arena->peak_size;
+    }
+
+    return result;
+}
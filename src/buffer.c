@@ -7,14 +7,63 @@
 #include <stdbool.h>
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/buffer_.h"
+#include "azure_c_shared_utility/buffer_types_internal.h"
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
 
-typedef struct BUFFER_TAG
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+/*the start of the allocation, which is before buffer when there is headroom*/
+static unsigned char* BUFFER_memory(BUFFER* handleptr)
+{
+    return (handleptr->buffer == NULL) ? NULL : handleptr->buffer - handleptr->headroom;
+}
+
+/*moves the content to capacity bytes (plus the headroom), the headroom and the content are kept*/
+static int BUFFER_reallocate(BUFFER* handleptr, size_t capacity)
+{
+    int result;
+    unsigned char* temp;
+    if (capacity > SIZE_MAX - handleptr->headroom)
+    {
+        LogError("Buffer too big: %lu bytes", (unsigned long)capacity);
+        result = __FAILURE__;
+    }
+    else if ((temp = (unsigned char*)realloc(BUFFER_memory(handleptr), handleptr->headroom + capacity)) == NULL)
+    {
+        LogError("Failure reallocating buffer to %lu bytes", (unsigned long)capacity);
+        result = __FAILURE__;
+    }
+    else
+    {
+        handleptr->buffer = temp + handleptr->headroom;
+        handleptr->capacity = capacity;
+        result = 0;
+    }
+    return result;
+}
+
+/*makes room for required bytes, appending doubles the capacity so that N appends cost O(N) copies instead of O(N^2)*/
+static int BUFFER_grow(BUFFER* handleptr, size_t required)
 {
-    unsigned char* buffer;
-    size_t size;
-} BUFFER;
+    int result;
+    if (required <= handleptr->capacity)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t newCapacity = (handleptr->capacity > SIZE_MAX / 2) ? required : handleptr->capacity * 2;
+        if (newCapacity < required)
+        {
+            newCapacity = required;
+        }
+        result = BUFFER_reallocate(handleptr, newCapacity);
+    }
+    return result;
+}
 
 /* Codes_SRS_BUFFER_07_001: [BUFFER_new shall allocate a BUFFER_HANDLE that will contain a NULL unsigned char*.] */
 BUFFER_HANDLE BUFFER_new(void)
@@ -25,6 +74,9 @@ BUFFER_HANDLE BUFFER_new(void)
     {
         temp->buffer = NULL;
         temp->size = 0;
+        temp->capacity = 0;
+        temp->headroom = 0;
+        temp->recycler = NULL;
     }
     return (BUFFER_HANDLE)temp;
 }
@@ -48,6 +100,8 @@ static int BUFFER_safemalloc(BUFFER* handleptr, size_t size)
     {
         // we still consider the real buffer size is 0
         handleptr->size = size;
+        handleptr->capacity = sizetomalloc;
+        handleptr->headroom = 0;
         result = 0;
     }
     return result;
@@ -74,6 +128,8 @@ BUFFER_HANDLE BUFFER_create(const unsigned char* source, size_t size)
         }
         else
         {
+            result->recycler = NULL;
+
             /* Codes_SRS_BUFFER_02_005: [If size parameter is 0 then 1 byte of memory shall be allocated yet size of the buffer shall be set to 0.]*/
             if (BUFFER_safemalloc(result, size) != 0)
             {
@@ -98,16 +154,21 @@ BUFFER_HANDLE BUFFER_create_with_size(size_t buff_size)
     result = (BUFFER*)malloc(sizeof(BUFFER));
     if (result != NULL)
     {
+        result->recycler = NULL;
         if (buff_size == 0)
         {
             // Codes_SRS_BUFFER_07_030: [ If buff_size is 0 BUFFER_create_with_size shall create a valid non-NULL handle of zero size. ]
             result->size = 0;
+            result->capacity = 0;
+            result->headroom = 0;
             result->buffer = NULL;
         }
         else
         {
             // Codes_SRS_BUFFER_07_031: [ BUFFER_create_with_size shall allocate a buffer of buff_size. ]
             result->size = buff_size;
+            result->capacity = buff_size;
+            result->headroom = 0;
             if ((result->buffer = (unsigned char*)malloc(result->size)) == NULL)
             {
                 // Codes_SRS_BUFFER_07_032: [ If allocating memory fails, then BUFFER_create_with_size shall return NULL. ]
@@ -133,12 +194,16 @@ void BUFFER_delete(BUFFER_HANDLE handle)
     if (handle != NULL)
     {
         BUFFER* b = (BUFFER*)handle;
-        if (b->buffer != NULL)
+        /* Codes_SRS_BUFFER_11_017: [ If the buffer came from a BUFFER_POOL, BUFFER_delete shall give it back to the pool, and only free it if the pool does not keep it. ]*/
+        if ((b->recycler == NULL) || (b->recycler->recycle(b->recycler, b) != 0))
         {
-            /* Codes_SRS_BUFFER_07_003: [BUFFER_delete shall delete the data associated with the BUFFER_HANDLE along with the Buffer.] */
-            free(b->buffer);
+            if (b->buffer != NULL)
+            {
+                /* Codes_SRS_BUFFER_07_003: [BUFFER_delete shall delete the data associated with the BUFFER_HANDLE along with the Buffer.] */
+                free(BUFFER_memory(b));
+            }
+            free(b);
         }
-        free(b);
     }
 }
 
@@ -158,9 +223,11 @@ int BUFFER_build(BUFFER_HANDLE handle, const unsigned char* source, size_t size)
     {
         /* Codes_SRS_BUFFER_01_003: [If size is zero, source can be NULL.] */
         BUFFER* b = (BUFFER*)handle;
-        free(b->buffer);
+        free(BUFFER_memory(b));
         b->buffer = NULL;
         b->size = 0;
+        b->capacity = 0;
+        b->headroom = 0;
 
         result = 0;
     }
@@ -175,8 +242,7 @@ int BUFFER_build(BUFFER_HANDLE handle, const unsigned char* source, size_t size)
         {
             BUFFER* b = (BUFFER*)handle;
             /* Codes_SRS_BUFFER_07_011: [BUFFER_build shall overwrite previous contents if the buffer has been previously allocated.] */
-            unsigned char* newBuffer = (unsigned char*)realloc(b->buffer, size);
-            if (newBuffer == NULL)
+            if (BUFFER_reallocate(b, size) != 0)
             {
                 /* Codes_SRS_BUFFER_07_010: [BUFFER_build shall return nonzero if any error is encountered.] */
                 LogError("Failure reallocating buffer");
@@ -184,7 +250,6 @@ int BUFFER_build(BUFFER_HANDLE handle, const unsigned char* source, size_t size)
             }
             else
             {
-                b->buffer = newBuffer;
                 b->size = size;
                 /* Codes_SRS_BUFFER_01_002: [The size argument can be zero, in which case nothing shall be copied from source.] */
                 (void)memcpy(b->buffer, source, size);
@@ -228,8 +293,8 @@ int BUFFER_append_build(BUFFER_HANDLE handle, const unsigned char* source, size_
         else
         {
             /* Codes_SRS_BUFFER_07_032: [ if handle->buffer is not NULL BUFFER_append_build shall realloc the buffer to be the handle->size + size ] */
-            unsigned char* temp = (unsigned char*)realloc(handle->buffer, handle->size + size);
-            if (temp == NULL)
+            /* Codes_SRS_BUFFER_11_001: [ When the buffer needs more memory, BUFFER_append_build, BUFFER_enlarge and BUFFER_append shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+            if (BUFFER_grow(handle, handle->size + size) != 0)
             {
                 /* Codes_SRS_BUFFER_07_035: [ If any error is encountered BUFFER_append_build shall return a non-null value. ] */
                 LogError("Failure reallocating temporary buffer");
@@ -238,7 +303,6 @@ int BUFFER_append_build(BUFFER_HANDLE handle, const unsigned char* source, size_
             else
             {
                 /* Codes_SRS_BUFFER_07_033: [ ... and copy the contents of source to the end of the buffer. ] */
-                handle->buffer = temp;
                 // Append the BUFFER
                 (void)memcpy(&handle->buffer[handle->size], source, size);
                 handle->size += size;
@@ -286,6 +350,8 @@ int BUFFER_pre_build(BUFFER_HANDLE handle, size_t size)
             else
             {
                 b->size = size;
+                b->capacity = size;
+                b->headroom = 0;
                 result = 0;
             }
         }
@@ -327,9 +393,11 @@ extern int BUFFER_unbuild(BUFFER_HANDLE handle)
         if (b->buffer != NULL)
         {
             LogError("Failure buffer data is NULL");
-            free(b->buffer);
+            free(BUFFER_memory(b));
             b->buffer = NULL;
             b->size = 0;
+            b->capacity = 0;
+            b->headroom = 0;
             result = 0;
         }
         else
@@ -360,8 +428,8 @@ int BUFFER_enlarge(BUFFER_HANDLE handle, size_t enlargeSize)
     else
     {
         BUFFER* b = (BUFFER*)handle;
-        unsigned char* temp = (unsigned char*)realloc(b->buffer, b->size + enlargeSize);
-        if (temp == NULL)
+        /* Codes_SRS_BUFFER_11_001: [ When the buffer needs more memory, BUFFER_append_build, BUFFER_enlarge and BUFFER_append shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+        if (BUFFER_grow(b, b->size + enlargeSize) != 0)
         {
             /* Codes_SRS_BUFFER_07_018: [BUFFER_enlarge shall return a nonzero result if any error is encountered.] */
             LogError("Failure: allocating temp buffer.");
@@ -369,7 +437,6 @@ int BUFFER_enlarge(BUFFER_HANDLE handle, size_t enlargeSize)
         }
         else
         {
-            b->buffer = temp;
             b->size += enlargeSize;
             result = 0;
         }
@@ -405,9 +472,11 @@ int BUFFER_shrink(BUFFER_HANDLE handle, size_t decreaseSize, bool fromEnd)
         if (alloc_size == 0)
         {
             /* Codes_SRS_BUFFER_07_043: [ If the decreaseSize is equal the buffer size , BUFFER_shrink shall deallocate the buffer and set the size to zero. ] */
-            free(handle->buffer);
+            free(BUFFER_memory(handle));
             handle->buffer = NULL;
             handle->size = 0;
+            handle->capacity = 0;
+            handle->headroom = 0;
             result = 0;
         }
         else
@@ -425,18 +494,22 @@ int BUFFER_shrink(BUFFER_HANDLE handle, size_t decreaseSize, bool fromEnd)
                 {
                     /* Codes_SRS_BUFFER_07_040: [ if the fromEnd variable is true, BUFFER_shrink shall remove the end of the buffer of size decreaseSize. ] */
                     memcpy(tmp, handle->buffer, alloc_size);
-                    free(handle->buffer);
+                    free(BUFFER_memory(handle));
                     handle->buffer = tmp;
                     handle->size = alloc_size;
+                    handle->capacity = alloc_size;
+                    handle->headroom = 0;
                     result = 0;
                 }
                 else
                 {
                     /* Codes_SRS_BUFFER_07_041: [ if the fromEnd variable is false, BUFFER_shrink shall remove the beginning of the buffer of size decreaseSize. ] */
                     memcpy(tmp, handle->buffer + decreaseSize, alloc_size);
-                    free(handle->buffer);
+                    free(BUFFER_memory(handle));
                     handle->buffer = tmp;
                     handle->size = alloc_size;
+                    handle->capacity = alloc_size;
+                    handle->headroom = 0;
                     result = 0;
                 }
             }
@@ -496,8 +569,8 @@ int BUFFER_append(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
             else
             {
                 // b2->size != 0, whatever b1->size is
-                unsigned char* temp = (unsigned char*)realloc(b1->buffer, b1->size + b2->size);
-                if (temp == NULL)
+                /* Codes_SRS_BUFFER_11_001: [ When the buffer needs more memory, BUFFER_append_build, BUFFER_enlarge and BUFFER_append shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+                if (BUFFER_grow(b1, b1->size + b2->size) != 0)
                 {
                     /* Codes_SRS_BUFFER_07_023: [BUFFER_append shall return a nonzero upon any error that is encountered.] */
                     LogError("Failure: allocating temp buffer.");
@@ -506,7 +579,6 @@ int BUFFER_append(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
                 else
                 {
                     /* Codes_SRS_BUFFER_07_024: [BUFFER_append concatenates b2 onto b1 without modifying b2 and shall return zero on success.]*/
-                    b1->buffer = temp;
                     // Append the BUFFER
                     (void)memcpy(&b1->buffer[b1->size], b2->buffer, b2->size);
                     b1->size += b2->size;
@@ -548,6 +620,16 @@ int BUFFER_prepend(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
                 // do nothing
                 result = 0;
             }
+            else if (b2->size <= b1->headroom)
+            {
+                /* Codes_SRS_BUFFER_11_016: [ If handle1 has at least as much headroom as the size of handle2, BUFFER_prepend shall copy handle2 into the headroom without moving the content of handle1. ]*/
+                b1->buffer -= b2->size;
+                b1->headroom -= b2->size;
+                b1->size += b2->size;
+                b1->capacity += b2->size;
+                (void)memcpy(b1->buffer, b2->buffer, b2->size);
+                result = 0;
+            }
             else
             {
                 // b2->size != 0
@@ -565,9 +647,11 @@ int BUFFER_prepend(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
                     (void)memcpy(temp, b2->buffer, b2->size);
                     // start from b1->size to append b1
                     (void)memcpy(&temp[b2->size], b1->buffer, b1->size);
-                    free(b1->buffer);
+                    free(BUFFER_memory(b1));
                     b1->buffer = temp;
                     b1->size += b2->size;
+                    b1->capacity = b1->size;
+                    b1->headroom = 0;
                     result = 0;
                 }
             }
@@ -576,6 +660,150 @@ int BUFFER_prepend(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
     return result;
 }
 
+int BUFFER_reserve(BUFFER_HANDLE handle, size_t capacity)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_BUFFER_11_002: [ If handle is NULL, BUFFER_reserve shall fail and return a non-zero value. ]*/
+        LogError("Invalid parameter specified, handle == NULL.");
+        result = __FAILURE__;
+    }
+    else if (capacity <= handle->capacity)
+    {
+        /* Codes_SRS_BUFFER_11_004: [ If the buffer can already hold capacity bytes, BUFFER_reserve shall do nothing and return 0. ]*/
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_BUFFER_11_003: [ BUFFER_reserve shall grow the memory of the buffer to capacity bytes, keeping its content and its length, and return 0. ]*/
+        if (BUFFER_reallocate(handle, capacity) != 0)
+        {
+            /* Codes_SRS_BUFFER_11_005: [ If any error occurs, BUFFER_reserve shall fail, leave the buffer unchanged and return a non-zero value. ]*/
+            LogError("Failure reserving %lu bytes", (unsigned long)capacity);
+            result = __FAILURE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+size_t BUFFER_capacity(BUFFER_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_BUFFER_11_006: [ If handle is NULL, BUFFER_capacity shall return 0. ]*/
+        LogError("Invalid parameter specified, handle == NULL.");
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_BUFFER_11_007: [ BUFFER_capacity shall return the number of bytes the buffer can hold without allocating memory. ]*/
+        result = handle->capacity;
+    }
+    return result;
+}
+
+BUFFER_HANDLE BUFFER_create_with_headroom(const unsigned char* source, size_t size, size_t headroom)
+{
+    BUFFER* result;
+    if (source == NULL)
+    {
+        /* Codes_SRS_BUFFER_11_008: [ If source is NULL, BUFFER_create_with_headroom shall fail and return NULL. ]*/
+        LogError("invalid parameter source: %p", source);
+        result = NULL;
+    }
+    else if (size >= SIZE_MAX - headroom)
+    {
+        /* Codes_SRS_BUFFER_11_010: [ If any error occurs, BUFFER_create_with_headroom shall fail and return NULL. ]*/
+        LogError("Buffer too big: size=%lu, headroom=%lu", (unsigned long)size, (unsigned long)headroom);
+        result = NULL;
+    }
+    else
+    {
+        result = (BUFFER*)malloc(sizeof(BUFFER));
+        if (result == NULL)
+        {
+            /* Codes_SRS_BUFFER_11_010: [ If any error occurs, BUFFER_create_with_headroom shall fail and return NULL. ]*/
+            LogError("Failure allocating BUFFER structure");
+        }
+        else
+        {
+            /* Codes_SRS_BUFFER_11_009: [ BUFFER_create_with_headroom shall allocate headroom + size bytes in one block, copy size bytes from source after the first headroom bytes and return a non-NULL handle. ]*/
+            unsigned char* memory = (unsigned char*)malloc((headroom + size == 0) ? 1 : headroom + size);
+            if (memory == NULL)
+            {
+                /* Codes_SRS_BUFFER_11_010: [ If any error occurs, BUFFER_create_with_headroom shall fail and return NULL. ]*/
+                LogError("Failure allocating data");
+                free(result);
+                result = NULL;
+            }
+            else
+            {
+                result->buffer = memory + headroom;
+                result->size = size;
+                result->capacity = size;
+                result->headroom = headroom;
+                result->recycler = NULL;
+                (void)memcpy(result->buffer, source, size);
+            }
+        }
+    }
+    return (BUFFER_HANDLE)result;
+}
+
+unsigned char* BUFFER_push_front(BUFFER_HANDLE handle, size_t size)
+{
+    unsigned char* result;
+    if ((handle == NULL) || (size == 0))
+    {
+        /* Codes_SRS_BUFFER_11_011: [ If handle is NULL or size is 0, BUFFER_push_front shall fail and return NULL. ]*/
+        LogError("Invalid arguments: BUFFER_HANDLE handle=%p, size_t size=%lu", handle, (unsigned long)size);
+        result = NULL;
+    }
+    else if (size > handle->headroom)
+    {
+        /* Codes_SRS_BUFFER_11_012: [ If the buffer has less than size bytes of headroom, BUFFER_push_front shall fail and return NULL. ]*/
+        LogError("Not enough headroom: %lu bytes needed, %lu available", (unsigned long)size, (unsigned long)handle->headroom);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_BUFFER_11_013: [ BUFFER_push_front shall add size bytes taken from the headroom in front of the content, without moving it, and return a pointer to them so the caller can fill them. ]*/
+        handle->buffer -= size;
+        handle->headroom -= size;
+        handle->size += size;
+        handle->capacity += size;
+        result = handle->buffer;
+    }
+    return result;
+}
+
+int BUFFER_pull_front(BUFFER_HANDLE handle, size_t size)
+{
+    int result;
+    if ((handle == NULL) || (size == 0) || (size > handle->size))
+    {
+        /* Codes_SRS_BUFFER_11_014: [ If handle is NULL, size is 0 or size is bigger than the length of the buffer, BUFFER_pull_front shall fail and return a non-zero value. ]*/
+        LogError("Invalid arguments: BUFFER_HANDLE handle=%p, size_t size=%lu", handle, (unsigned long)size);
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_BUFFER_11_015: [ BUFFER_pull_front shall remove the first size bytes of the buffer by turning them into headroom, without moving the rest of the content, and return 0. ]*/
+        handle->buffer += size;
+        handle->headroom += size;
+        handle->size -= size;
+        handle->capacity -= size;
+        result = 0;
+    }
+    return result;
+}
+
 int BUFFER_fill(BUFFER_HANDLE handle, unsigned char fill_char)
 {
     int result;
@@ -648,6 +876,7 @@ BUFFER_HANDLE BUFFER_clone(BUFFER_HANDLE handle)
         BUFFER* b = (BUFFER*)malloc(sizeof(BUFFER));
         if (b != NULL)
         {
+            b->recycler = NULL;
             if (BUFFER_safemalloc(b, suppliedBuff->size) != 0)
             {
                 free(b);
@@ -0,0 +1,733 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*
+A BUFFER_POOL keeps the BUFFERs given to BUFFER_delete in free lists, one per power of 2 capacity, and hands
+them out again from BUFFER_POOL_get.
+
+Every thread that uses a pool gets its own cache of free lists, so most BUFFER_POOL_get/BUFFER_delete calls
+do not take any lock. A thread cache that grows too long gives half of a list to the lists the pool shares
+between threads, and an empty thread cache list takes a batch from them. The shared lists hold at most
+max_cached_bytes, buffers that do not fit are freed. When a thread exits, its caches go back to the shared lists.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+#include "azure_c_shared_utility/buffer_types_internal.h"
+#include "azure_c_shared_utility/buffer_pool.h"
+
+#if defined(_WIN32)
+#include "windows.h"
+#define BUFFER_POOL_TRY_LOCK(lock) (InterlockedExchange(&(lock), 1) == 0)
+#define BUFFER_POOL_UNLOCK(lock) ((void)InterlockedExchange(&(lock), 0))
+#define BUFFER_POOL_YIELD() ((void)SwitchToThread())
+#define BUFFER_POOL_NEXT_ID(id) ((size_t)InterlockedIncrement(&(id)))
+typedef volatile LONG BUFFER_POOL_SPINLOCK;
+typedef volatile LONG BUFFER_POOL_ID_COUNTER;
+#elif defined(__GNUC__)
+#include <sched.h>
+#include <pthread.h>
+#define BUFFER_POOL_TRY_LOCK(lock) (__sync_lock_test_and_set(&(lock), 1) == 0)
+#define BUFFER_POOL_UNLOCK(lock) __sync_lock_release(&(lock))
+#define BUFFER_POOL_YIELD() ((void)sched_yield())
+#define BUFFER_POOL_NEXT_ID(id) __sync_add_and_fetch(&(id), 1)
+typedef volatile int BUFFER_POOL_SPINLOCK;
+typedef volatile size_t BUFFER_POOL_ID_COUNTER;
+#else
+/*no atomic operations known for this compiler, same as REFCOUNT_ATOMIC_DONTCARE: only good for single threaded devices*/
+#define BUFFER_POOL_TRY_LOCK(lock) (((lock) == 0) ? ((lock) = 1, 1) : 0)
+#define BUFFER_POOL_UNLOCK(lock) ((void)((lock) = 0))
+#define BUFFER_POOL_YIELD() ((void)0)
+#define BUFFER_POOL_NEXT_ID(id) (++(id))
+typedef volatile int BUFFER_POOL_SPINLOCK;
+typedef volatile size_t BUFFER_POOL_ID_COUNTER;
+#endif
+
+#if defined(_MSC_VER)
+#define BUFFER_POOL_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define BUFFER_POOL_THREAD_LOCAL __thread
+#endif
+
+/*the free lists hold buffers of 2^6 (64) to 2^16 (64KB) bytes*/
+#define BUFFER_POOL_MIN_CAPACITY_BITS 6
+#define BUFFER_POOL_LIST_COUNT 11
+/*a thread cache keeps at most this many bytes per list, and never more than BUFFER_POOL_THREAD_CACHE_MAX_COUNT buffers*/
+#define BUFFER_POOL_THREAD_CACHE_BYTES (64 * 1024)
+#define BUFFER_POOL_THREAD_CACHE_MAX_COUNT 32
+
+/*free buffers are linked through the first bytes of their memory, every buffer in a list has at least 64 bytes*/
+typedef struct BUFFER_POOL_LIST_TAG
+{
+    BUFFER* head;
+    volatile size_t count;
+    volatile size_t bytes;
+} BUFFER_POOL_LIST;
+
+typedef struct BUFFER_POOL_COUNTERS_TAG
+{
+    volatile size_t hits;
+    volatile size_t misses;
+    volatile size_t recycled;
+    volatile size_t discarded;
+} BUFFER_POOL_COUNTERS;
+
+typedef struct BUFFER_POOL_THREAD_CACHE_TAG
+{
+    struct BUFFER_POOL_TAG* pool; /*NULL once the pool is destroyed, changes only under registry_lock*/
+    size_t pool_id; /*pools get a new id every time, so a cache of a destroyed pool never matches a new pool at the same address*/
+    struct BUFFER_POOL_THREAD_CACHE_TAG* next_in_thread;
+    struct BUFFER_POOL_THREAD_CACHE_TAG* next_in_pool;
+    BUFFER_POOL_LIST lists[BUFFER_POOL_LIST_COUNT];
+    BUFFER_POOL_COUNTERS counters;
+} BUFFER_POOL_THREAD_CACHE;
+
+typedef struct BUFFER_POOL_TAG
+{
+    BUFFER_RECYCLER recycler; /*first, so that BUFFER_delete's recycler is the pool*/
+    size_t id;
+    size_t max_cached_bytes;
+    BUFFER_POOL_SPINLOCK lock; /*protects everything below*/
+    BUFFER_POOL_LIST lists[BUFFER_POOL_LIST_COUNT];
+    size_t cached_bytes;
+    BUFFER_POOL_COUNTERS counters; /*of the threads that exited, and of the calls made without a thread cache*/
+    BUFFER_POOL_THREAD_CACHE* caches;
+} BUFFER_POOL;
+
+static BUFFER_POOL_ID_COUNTER next_pool_id = 0;
+
+static void spin_lock(BUFFER_POOL_SPINLOCK* lock)
+{
+    while (!BUFFER_POOL_TRY_LOCK(*lock))
+    {
+        BUFFER_POOL_YIELD();
+    }
+}
+
+static void spin_unlock(BUFFER_POOL_SPINLOCK* lock)
+{
+    BUFFER_POOL_UNLOCK(*lock);
+}
+
+static void list_push(BUFFER_POOL_LIST* list, BUFFER* buffer)
+{
+    (void)memcpy(buffer->buffer, &list->head, sizeof(BUFFER*));
+    list->head = buffer;
+    list->count++;
+    list->bytes += buffer->capacity;
+}
+
+static BUFFER* list_pop(BUFFER_POOL_LIST* list)
+{
+    BUFFER* result = list->head;
+    (void)memcpy(&list->head, result->buffer, sizeof(BUFFER*));
+    list->count--;
+    list->bytes -= result->capacity;
+    return result;
+}
+
+static void free_buffer(BUFFER* buffer)
+{
+    free(buffer->buffer);
+    free(buffer);
+}
+
+static void free_list(BUFFER_POOL_LIST* list)
+{
+    while (list->head != NULL)
+    {
+        free_buffer(list_pop(list));
+    }
+}
+
+/*the list whose buffers can all hold capacity bytes, BUFFER_POOL_LIST_COUNT if capacity is too big for the pool*/
+static size_t get_list_for_capacity(size_t capacity)
+{
+    size_t result = 0;
+    while ((result < BUFFER_POOL_LIST_COUNT) && (((size_t)1 << (result + BUFFER_POOL_MIN_CAPACITY_BITS)) < capacity))
+    {
+        result++;
+    }
+    return result;
+}
+
+/*the list a buffer goes back to, BUFFER_POOL_LIST_COUNT if it does not fit in any*/
+static size_t get_list_of_buffer(const BUFFER* buffer)
+{
+    size_t result;
+    if ((buffer->buffer == NULL) ||
+        (buffer->capacity < ((size_t)1 << BUFFER_POOL_MIN_CAPACITY_BITS)) ||
+        (buffer->capacity >= ((size_t)1 << (BUFFER_POOL_MIN_CAPACITY_BITS + BUFFER_POOL_LIST_COUNT))))
+    {
+        result = BUFFER_POOL_LIST_COUNT;
+    }
+    else
+    {
+        result = 0;
+        while (((size_t)1 << (result + 1 + BUFFER_POOL_MIN_CAPACITY_BITS)) <= buffer->capacity)
+        {
+            result++;
+        }
+    }
+    return result;
+}
+
+static size_t get_thread_cache_max_count(size_t list_index)
+{
+    size_t result = BUFFER_POOL_THREAD_CACHE_BYTES >> (list_index + BUFFER_POOL_MIN_CAPACITY_BITS);
+    if (result > BUFFER_POOL_THREAD_CACHE_MAX_COUNT)
+    {
+        result = BUFFER_POOL_THREAD_CACHE_MAX_COUNT;
+    }
+    else if (result == 0)
+    {
+        result = 1;
+    }
+    return result;
+}
+
+static BUFFER* allocate_buffer(BUFFER_POOL* pool, size_t list_index)
+{
+    size_t capacity = (size_t)1 << (list_index + BUFFER_POOL_MIN_CAPACITY_BITS);
+    BUFFER* result = (BUFFER*)malloc(sizeof(BUFFER));
+    if (result == NULL)
+    {
+        LogError("failure allocating BUFFER");
+    }
+    else if ((result->buffer = (unsigned char*)malloc(capacity)) == NULL)
+    {
+        LogError("failure allocating %lu bytes", (unsigned long)capacity);
+        free(result);
+        result = NULL;
+    }
+    else
+    {
+        result->size = 0;
+        result->capacity = capacity;
+        result->headroom = 0;
+        result->recycler = &pool->recycler;
+    }
+    return result;
+}
+
+/*moves count buffers from list to the shared list of the pool, the ones that do not fit in max_cached_bytes are freed. The pool lock has to be held*/
+static void give_to_pool(BUFFER_POOL* pool, size_t list_index, BUFFER_POOL_LIST* list, size_t count, BUFFER_POOL_COUNTERS* counters)
+{
+    while ((count > 0) && (list->head != NULL))
+    {
+        BUFFER* buffer = list_pop(list);
+        if (pool->cached_bytes + buffer->capacity > pool->max_cached_bytes)
+        {
+            /* Codes_SRS_BUFFER_POOL_11_014: [ Buffers that do not fit in the max_cached_bytes of the shared lists shall be freed. ]*/
+            free_buffer(buffer);
+            counters->discarded++;
+        }
+        else
+        {
+            list_push(&pool->lists[list_index], buffer);
+            pool->cached_bytes += buffer->capacity;
+        }
+        count--;
+    }
+}
+
+/*moves up to count buffers from the shared list of the pool to list. The pool lock has to be held*/
+static void take_from_pool(BUFFER_POOL* pool, size_t list_index, BUFFER_POOL_LIST* list, size_t count)
+{
+    while ((count > 0) && (pool->lists[list_index].head != NULL))
+    {
+        BUFFER* buffer = list_pop(&pool->lists[list_index]);
+        pool->cached_bytes -= buffer->capacity;
+        list_push(list, buffer);
+        count--;
+    }
+}
+
+static void add_counters(BUFFER_POOL_STATISTICS* statistics, const BUFFER_POOL_COUNTERS* counters, const BUFFER_POOL_LIST* lists)
+{
+    size_t i;
+    statistics->hits += counters->hits;
+    statistics->misses += counters->misses;
+    statistics->recycled += counters->recycled;
+    statistics->discarded += counters->discarded;
+    for (i = 0; i < BUFFER_POOL_LIST_COUNT; i++)
+    {
+        statistics->cached_buffers += lists[i].count;
+        statistics->cached_bytes += lists[i].bytes;
+    }
+}
+
+#ifdef BUFFER_POOL_THREAD_LOCAL
+static BUFFER_POOL_THREAD_LOCAL BUFFER_POOL_THREAD_CACHE* thread_caches = NULL;
+/*protects the pool field of all the thread caches, taken before any pool lock*/
+static BUFFER_POOL_SPINLOCK registry_lock = 0;
+
+/*gives the buffers of a cache back to its pool and unlinks it from the pool. registry_lock has to be held*/
+static void retire_thread_cache(BUFFER_POOL_THREAD_CACHE* cache)
+{
+    BUFFER_POOL* pool = cache->pool;
+    BUFFER_POOL_THREAD_CACHE** link;
+    size_t i;
+
+    spin_lock(&pool->lock);
+    for (link = &pool->caches; *link != NULL; link = &(*link)->next_in_pool)
+    {
+        if (*link == cache)
+        {
+            *link = cache->next_in_pool;
+            break;
+        }
+    }
+    for (i = 0; i < BUFFER_POOL_LIST_COUNT; i++)
+    {
+        give_to_pool(pool, i, &cache->lists[i], cache->lists[i].count, &cache->counters);
+    }
+    pool->counters.hits += cache->counters.hits;
+    pool->counters.misses += cache->counters.misses;
+    pool->counters.recycled += cache->counters.recycled;
+    pool->counters.discarded += cache->counters.discarded;
+    spin_unlock(&pool->lock);
+    cache->pool = NULL;
+}
+
+/* Codes_SRS_BUFFER_POOL_11_016: [ When a thread exits, the buffers in its free lists shall be moved to the shared lists of their pools, and the ones that do not fit in max_cached_bytes freed. ]*/
+static void release_thread_caches(void)
+{
+    BUFFER_POOL_THREAD_CACHE* cache;
+
+    spin_lock(&registry_lock);
+    cache = thread_caches;
+    thread_caches = NULL;
+    while (cache != NULL)
+    {
+        BUFFER_POOL_THREAD_CACHE* next = cache->next_in_thread;
+        if (cache->pool != NULL)
+        {
+            retire_thread_cache(cache);
+        }
+        free(cache);
+        cache = next;
+    }
+    spin_unlock(&registry_lock);
+}
+
+#if defined(_WIN32)
+static volatile LONG cache_key_state = 0; /*0 - not created, 1 - being created, 2 - created*/
+static DWORD cache_key = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI on_thread_exit(PVOID value)
+{
+    if (value != NULL)
+    {
+        release_thread_caches();
+    }
+}
+
+static int register_thread_exit(BUFFER_POOL_THREAD_CACHE* cache)
+{
+    int result;
+    if (InterlockedCompareExchange(&cache_key_state, 1, 0) == 0)
+    {
+        cache_key = FlsAlloc(on_thread_exit);
+        (void)InterlockedExchange(&cache_key_state, 2);
+    }
+    while (cache_key_state != 2)
+    {
+        BUFFER_POOL_YIELD();
+    }
+
+    if ((cache_key == FLS_OUT_OF_INDEXES) || !FlsSetValue(cache_key, cache))
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+#elif defined(__GNUC__)
+static pthread_once_t cache_key_once = PTHREAD_ONCE_INIT;
+static int cache_key_result = -1;
+static pthread_key_t cache_key;
+
+static void on_thread_exit(void* value)
+{
+    (void)value;
+    release_thread_caches();
+}
+
+static void create_cache_key(void)
+{
+    cache_key_result = pthread_key_create(&cache_key, on_thread_exit);
+}
+
+static int register_thread_exit(BUFFER_POOL_THREAD_CACHE* cache)
+{
+    int result;
+    if ((pthread_once(&cache_key_once, create_cache_key) != 0) ||
+        (cache_key_result != 0) ||
+        (pthread_setspecific(cache_key, cache) != 0))
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+#endif
+
+/*returns NULL when the thread cache cannot be created, in which case the shared lists are used directly*/
+static BUFFER_POOL_THREAD_CACHE* get_thread_cache(BUFFER_POOL* pool)
+{
+    BUFFER_POOL_THREAD_CACHE* result = thread_caches;
+    while ((result != NULL) && (result->pool_id != pool->id))
+    {
+        result = result->next_in_thread;
+    }
+
+    if (result == NULL)
+    {
+        /* Codes_SRS_BUFFER_POOL_11_006: [ The first time a thread uses a pool, BUFFER_POOL_get and BUFFER_delete shall allocate the free lists of that thread for that pool. ]*/
+        result = (BUFFER_POOL_THREAD_CACHE*)malloc(sizeof(BUFFER_POOL_THREAD_CACHE));
+        if (result == NULL)
+        {
+            LogError("failure allocating the thread cache");
+        }
+        else if (register_thread_exit(result) != 0)
+        {
+            LogError("failure registering the thread cache");
+            free(result);
+            result = NULL;
+        }
+        else
+        {
+            BUFFER_POOL_THREAD_CACHE** link = &thread_caches;
+
+            (void)memset(result, 0, sizeof(BUFFER_POOL_THREAD_CACHE));
+            result->pool = pool;
+            result->pool_id = pool->id;
+
+            spin_lock(&registry_lock);
+            /*the caches of pools destroyed by other threads are not needed anymore*/
+            while (*link != NULL)
+            {
+                BUFFER_POOL_THREAD_CACHE* cache = *link;
+                if (cache->pool == NULL)
+                {
+                    *link = cache->next_in_thread;
+                    free(cache);
+                }
+                else
+                {
+                    link = &cache->next_in_thread;
+                }
+            }
+
+            spin_lock(&pool->lock);
+            result->next_in_pool = pool->caches;
+            pool->caches = result;
+            spin_unlock(&pool->lock);
+            spin_unlock(&registry_lock);
+
+            result->next_in_thread = thread_caches;
+            thread_caches = result;
+        }
+    }
+
+    return result;
+}
+
+static void destroy_thread_caches(BUFFER_POOL* pool)
+{
+    BUFFER_POOL_THREAD_CACHE** link;
+    BUFFER_POOL_THREAD_CACHE* own_cache = NULL;
+    BUFFER_POOL_THREAD_CACHE* cache;
+
+    spin_lock(&registry_lock);
+    for (link = &thread_caches; *link != NULL; link = &(*link)->next_in_thread)
+    {
+        if ((*link)->pool == pool)
+        {
+            own_cache = *link;
+            *link = own_cache->next_in_thread;
+            break;
+        }
+    }
+
+    /*the caches of the other threads stay linked to their threads, which free them when they exit*/
+    cache = pool->caches;
+    while (cache != NULL)
+    {
+        BUFFER_POOL_THREAD_CACHE* next = cache->next_in_pool;
+        size_t i;
+        for (i = 0; i < BUFFER_POOL_LIST_COUNT; i++)
+        {
+            free_list(&cache->lists[i]);
+        }
+        cache->pool = NULL;
+        if (cache == own_cache)
+        {
+            free(cache);
+        }
+        cache = next;
+    }
+    pool->caches = NULL;
+    spin_unlock(&registry_lock);
+}
+#else
+static BUFFER_POOL_THREAD_CACHE* get_thread_cache(BUFFER_POOL* pool)
+{
+    /*no thread local storage, every call goes to the shared lists*/
+    (void)pool;
+    return NULL;
+}
+
+static void destroy_thread_caches(BUFFER_POOL* pool)
+{
+    (void)pool;
+}
+#endif
+
+static int recycle_buffer(BUFFER_RECYCLER* recycler, BUFFER* buffer)
+{
+    int result;
+    BUFFER_POOL* pool = (BUFFER_POOL*)recycler;
+    BUFFER_POOL_THREAD_CACHE* cache = get_thread_cache(pool);
+    BUFFER_POOL_COUNTERS* counters = (cache == NULL) ? &pool->counters : &cache->counters;
+    size_t list_index;
+
+    /* Codes_SRS_BUFFER_POOL_11_012: [ BUFFER_delete shall turn the headroom of a buffer of the pool back into capacity and put the buffer in the free list of the calling thread for the largest power of 2 that is not bigger than its capacity. ]*/
+    if ((buffer->buffer != NULL) && (buffer->headroom > 0))
+    {
+        buffer->buffer -= buffer->headroom;
+        buffer->capacity += buffer->headroom;
+        buffer->headroom = 0;
+    }
+    list_index = get_list_of_buffer(buffer);
+
+    if (list_index == BUFFER_POOL_LIST_COUNT)
+    {
+        /* Codes_SRS_BUFFER_POOL_11_013: [ If the buffer has no memory, less than 64 bytes or at least 128KB of capacity, the pool shall not keep it and BUFFER_delete shall free it. ]*/
+        if (cache == NULL)
+        {
+            spin_lock(&pool->lock);
+            counters->discarded++;
+            spin_unlock(&pool->lock);
+        }
+        else
+        {
+            counters->discarded++;
+        }
+        result = __FAILURE__;
+    }
+    else
+    {
+        buffer->size = 0;
+        if (cache == NULL)
+        {
+            spin_lock(&pool->lock);
+            if (pool->cached_bytes + buffer->capacity > pool->max_cached_bytes)
+            {
+                /* Codes_SRS_BUFFER_POOL_11_014: [ Buffers that do not fit in the max_cached_bytes of the shared lists shall be freed. ]*/
+                counters->discarded++;
+                result = __FAILURE__;
+            }
+            else
+            {
+                list_push(&pool->lists[list_index], buffer);
+                pool->cached_bytes += buffer->capacity;
+                counters->recycled++;
+                result = 0;
+            }
+            spin_unlock(&pool->lock);
+        }
+        else
+        {
+            BUFFER_POOL_LIST* list = &cache->lists[list_index];
+            size_t max_count = get_thread_cache_max_count(list_index);
+            if (list->count >= max_count)
+            {
+                /* Codes_SRS_BUFFER_POOL_11_015: [ If the free list of the calling thread is full, BUFFER_delete shall first move half of it to the shared list of the pool. ]*/
+                spin_lock(&pool->lock);
+                give_to_pool(pool, list_index, list, max_count - max_count / 2, counters);
+                spin_unlock(&pool->lock);
+            }
+            list_push(list, buffer);
+            counters->recycled++;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+BUFFER_POOL_HANDLE BUFFER_POOL_create(size_t max_cached_bytes)
+{
+    /* Codes_SRS_BUFFER_POOL_11_001: [ BUFFER_POOL_create shall allocate a new pool that keeps at most max_cached_bytes of capacity in the lists it shares between threads and return it. ]*/
+    BUFFER_POOL* result = (BUFFER_POOL*)malloc(sizeof(BUFFER_POOL));
+    if (result == NULL)
+    {
+        /* Codes_SRS_BUFFER_POOL_11_002: [ If any error occurs, BUFFER_POOL_create shall fail and return NULL. ]*/
+        LogError("failure allocating BUFFER_POOL");
+    }
+    else
+    {
+        (void)memset(result, 0, sizeof(BUFFER_POOL));
+        result->recycler.recycle = recycle_buffer;
+        result->id = BUFFER_POOL_NEXT_ID(next_pool_id);
+        result->max_cached_bytes = max_cached_bytes;
+    }
+    return result;
+}
+
+void BUFFER_POOL_destroy(BUFFER_POOL_HANDLE pool)
+{
+    if (pool == NULL)
+    {
+        /* Codes_SRS_BUFFER_POOL_11_003: [ If pool is NULL, BUFFER_POOL_destroy shall return. ]*/
+        LogError("Invalid arguments: BUFFER_POOL_HANDLE pool=%p", pool);
+    }
+    else
+    {
+        size_t i;
+
+        /* Codes_SRS_BUFFER_POOL_11_004: [ BUFFER_POOL_destroy shall free the buffers in the free lists of all the threads, the free lists of the calling thread and the pool. ]*/
+        destroy_thread_caches(pool);
+        for (i = 0; i < BUFFER_POOL_LIST_COUNT; i++)
+        {
+            free_list(&pool->lists[i]);
+        }
+        free(pool);
+    }
+}
+
+BUFFER_HANDLE BUFFER_POOL_get(BUFFER_POOL_HANDLE pool, size_t capacity)
+{
+    BUFFER* result;
+
+    if (pool == NULL)
+    {
+        /* Codes_SRS_BUFFER_POOL_11_005: [ If pool is NULL, BUFFER_POOL_get shall fail and return NULL. ]*/
+        LogError("Invalid arguments: BUFFER_POOL_HANDLE pool=%p, size_t capacity=%lu", pool, (unsigned long)capacity);
+        result = NULL;
+    }
+    else
+    {
+        size_t list_index = get_list_for_capacity(capacity);
+        if (list_index == BUFFER_POOL_LIST_COUNT)
+        {
+            /* Codes_SRS_BUFFER_POOL_11_011: [ If capacity is more than 64KB, BUFFER_POOL_get shall return a new buffer that does not belong to the pool. ]*/
+            result = (BUFFER*)BUFFER_new();
+            if (result == NULL)
+            {
+                LogError("failure creating a buffer");
+            }
+            else if (BUFFER_reserve(result, capacity) != 0)
+            {
+                LogError("failure reserving %lu bytes", (unsigned long)capacity);
+                BUFFER_delete(result);
+                result = NULL;
+            }
+            else
+            {
+                spin_lock(&pool->lock);
+                pool->counters.misses++;
+                spin_unlock(&pool->lock);
+            }
+        }
+        else
+        {
+            BUFFER_POOL_THREAD_CACHE* cache = get_thread_cache(pool);
+
+            /* Codes_SRS_BUFFER_POOL_11_007: [ BUFFER_POOL_get shall return a buffer of length 0 from the free list of the calling thread for the smallest power of 2 (at least 64) that is not smaller than capacity. ]*/
+            if (cache == NULL)
+            {
+                spin_lock(&pool->lock);
+                if (pool->lists[list_index].head == NULL)
+                {
+                    result = NULL;
+                    pool->counters.misses++;
+                }
+                else
+                {
+                    result = list_pop(&pool->lists[list_index]);
+                    pool->cached_bytes -= result->capacity;
+                    pool->counters.hits++;
+                }
+                spin_unlock(&pool->lock);
+            }
+            else
+            {
+                BUFFER_POOL_LIST* list = &cache->lists[list_index];
+                if (list->head == NULL)
+                {
+                    /* Codes_SRS_BUFFER_POOL_11_008: [ If the free list of the calling thread is empty, BUFFER_POOL_get shall first move up to half a thread free list of buffers from the shared list of the pool to it. ]*/
+                    size_t max_count = get_thread_cache_max_count(list_index);
+                    spin_lock(&pool->lock);
+                    take_from_pool(pool, list_index, list, max_count - max_count / 2);
+                    spin_unlock(&pool->lock);
+                }
+
+                if (list->head == NULL)
+                {
+                    result = NULL;
+                    cache->counters.misses++;
+                }
+                else
+                {
+                    result = list_pop(list);
+                    cache->counters.hits++;
+                }
+            }
+
+            if (result == NULL)
+            {
+                /* Codes_SRS_BUFFER_POOL_11_009: [ If there is no buffer in the free lists, BUFFER_POOL_get shall allocate a new buffer with that power of 2 as capacity. ]*/
+                result = allocate_buffer(pool, list_index);
+                if (result == NULL)
+                {
+                    /* Codes_SRS_BUFFER_POOL_11_010: [ If any error occurs, BUFFER_POOL_get shall fail and return NULL. ]*/
+                    LogError("failure allocating a buffer of the pool");
+                }
+            }
+        }
+    }
+
+    return (BUFFER_HANDLE)result;
+}
+
+int BUFFER_POOL_get_statistics(BUFFER_POOL_HANDLE pool, BUFFER_POOL_STATISTICS* statistics)
+{
+    int result;
+
+    if ((pool == NULL) || (statistics == NULL))
+    {
+        /* Codes_SRS_BUFFER_POOL_11_017: [ If pool or statistics is NULL, BUFFER_POOL_get_statistics shall fail and return a non-zero value. ]*/
+        LogError("Invalid arguments: BUFFER_POOL_HANDLE pool=%p, BUFFER_POOL_STATISTICS* statistics=%p", pool, statistics);
+        result = __FAILURE__;
+    }
+    else
+    {
+        BUFFER_POOL_THREAD_CACHE* cache;
+
+        /* Codes_SRS_BUFFER_POOL_11_018: [ BUFFER_POOL_get_statistics shall add up the counters and the free lists of the pool and of all the threads that use it, and return 0. The numbers of the other threads can be a few calls behind. ]*/
+        (void)memset(statistics, 0, sizeof(BUFFER_POOL_STATISTICS));
+        spin_lock(&pool->lock);
+        add_counters(statistics, &pool->counters, pool->lists);
+        for (cache = pool->caches; cache != NULL; cache = cache->next_in_pool)
+        {
+            add_counters(statistics, &cache->counters, cache->lists);
+        }
+        spin_unlock(&pool->lock);
+        result = 0;
+    }
+
+    return result;
+}
@@ -9,6 +9,25 @@
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
 
+/*upper bound of the number of key/value pairs in the connection string, used to size the result map*/
+static size_t count_key_value_pairs(STRING_HANDLE connection_string)
+{
+    size_t result = 0;
+    const char* iterator = STRING_c_str(connection_string);
+    if ((iterator != NULL) && (*iterator != '\0'))
+    {
+        result = 1;
+        while (*iterator != '\0')
+        {
+            if ((*iterator == ';') && (*(iterator + 1) != '\0'))
+            {
+                result++;
+            }
+            iterator++;
+        }
+    }
+    return result;
+}
 
 MAP_HANDLE connectionstringparser_parse_from_char(const char* connection_string)
 {
@@ -74,7 +93,8 @@ MAP_HANDLE connectionstringparser_parse(STRING_HANDLE connection_string)
                 }
                 else
                 {
-                    result = Map_Create(NULL);
+                    /* Codes_SRS_CONNECTIONSTRINGPARSER_11_001: [connectionstringparser_parse shall create the result map by calling Map_CreateWithCapacity with the number of ; separated segments of the connection string (obtained with STRING_c_str), so that adding the key/value pairs does not grow the map.] */
+                    result = Map_CreateWithCapacity(NULL, count_key_value_pairs(connection_string));
                     if (result == NULL)
                     {
                         /* Codes_SRS_CONNECTIONSTRINGPARSER_01_018: [If creating the result map fails, then connectionstringparser_parse shall return NULL.] */
@@ -9,10 +9,23 @@
 #include "azure_c_shared_utility/xlogging.h"
 #include "azure_c_shared_utility/refcount.h"
 
+#if defined(_WIN32)
+#include "windows.h"
+#define CONSTBUFFER_CAN_MAP_FILES
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define CONSTBUFFER_CAN_MAP_FILES
+#endif
+
 #define CONSTBUFFER_TYPE_VALUES \
     CONSTBUFFER_TYPE_COPIED, \
     CONSTBUFFER_TYPE_MEMORY_MOVED, \
-    CONSTBUFFER_TYPE_WITH_CUSTOM_FREE
+    CONSTBUFFER_TYPE_WITH_CUSTOM_FREE, \
+    CONSTBUFFER_TYPE_FROM_OFFSET_AND_SIZE, \
+    CONSTBUFFER_TYPE_MAPPED_FILE
 
 DEFINE_ENUM(CONSTBUFFER_TYPE, CONSTBUFFER_TYPE_VALUES)
 
@@ -23,6 +36,7 @@ typedef struct CONSTBUFFER_HANDLE_DATA_TAG
     CONSTBUFFER_TYPE buffer_type;
     CONSTBUFFER_CUSTOM_FREE_FUNC custom_free_func;
     void* custom_free_func_context;
+    struct CONSTBUFFER_HANDLE_DATA_TAG* originalHandle; /*the buffer that owns the memory of a CONSTBUFFER_TYPE_FROM_OFFSET_AND_SIZE buffer*/
 } CONSTBUFFER_HANDLE_DATA;
 
 static CONSTBUFFER_HANDLE CONSTBUFFER_Create_Internal(const unsigned char* source, size_t size)
@@ -180,6 +194,218 @@ CONSTBUFFER_HANDLE CONSTBUFFER_CreateWithCustomFree(const unsigned char* source,
     return result;
 }
 
+CONSTBUFFER_HANDLE CONSTBUFFER_CreateFromOffsetAndSize(CONSTBUFFER_HANDLE handle, size_t offset, size_t size)
+{
+    CONSTBUFFER_HANDLE result;
+
+    if (
+        /*Codes_SRS_CONSTBUFFER_11_001: [ If handle is NULL then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL. ]*/
+        (handle == NULL) ||
+        /*Codes_SRS_CONSTBUFFER_11_002: [ If offset is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL. ]*/
+        (offset > handle->alias.size) ||
+        /*Codes_SRS_CONSTBUFFER_11_003: [ If offset + size is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL. ]*/
+        (size > handle->alias.size - offset)
+        )
+    {
+        LogError("Invalid arguments: CONSTBUFFER_HANDLE handle=%p, size_t offset=%u, size_t size=%u",
+            handle, (unsigned int)offset, (unsigned int)size);
+        result = NULL;
+    }
+    else
+    {
+        result = (CONSTBUFFER_HANDLE)malloc(sizeof(CONSTBUFFER_HANDLE_DATA));
+        if (result == NULL)
+        {
+            /*Codes_SRS_CONSTBUFFER_11_007: [ If any error occurs, CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL. ]*/
+            LogError("malloc failed");
+        }
+        else
+        {
+            /*Codes_SRS_CONSTBUFFER_11_004: [ CONSTBUFFER_CreateFromOffsetAndSize shall return a non-NULL handle to a const buffer whose content is the size bytes of handle that start at offset, without copying them. ]*/
+            result->alias.buffer = (size == 0) ? NULL : handle->alias.buffer + offset;
+            result->alias.size = size;
+            result->buffer_type = CONSTBUFFER_TYPE_FROM_OFFSET_AND_SIZE;
+
+            /*Codes_SRS_CONSTBUFFER_11_005: [ CONSTBUFFER_CreateFromOffsetAndSize shall increment the reference count of the const buffer that owns the memory of handle, so that the memory lives as long as the new const buffer. ]*/
+            /*a slice of a slice refers to the buffer that owns the memory, so the chain never gets longer than 1*/
+            result->originalHandle = (handle->buffer_type == CONSTBUFFER_TYPE_FROM_OFFSET_AND_SIZE) ? handle->originalHandle : handle;
+            INC_REF_VAR(result->originalHandle->count);
+
+            /*Codes_SRS_CONSTBUFFER_11_006: [ The non-NULL handle returned by CONSTBUFFER_CreateFromOffsetAndSize shall have its ref count set to 1. ]*/
+            INIT_REF_VAR(result->count);
+        }
+    }
+
+    return result;
+}
+
+#ifdef CONSTBUFFER_CAN_MAP_FILES
+/*maps the whole file read only, the mapping stays valid after the file is closed. An empty file cannot be mapped and gives a NULL mapping of size 0*/
+static int map_file(const char* fileName, const unsigned char** mapping, size_t* size)
+{
+    int result;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LogError("CreateFileA failed for %s, error %lu", fileName, (unsigned long)GetLastError());
+        result = __FAILURE__;
+    }
+    else
+    {
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            LogError("GetFileSizeEx failed, error %lu", (unsigned long)GetLastError());
+            result = __FAILURE__;
+        }
+        else if ((unsigned long long)fileSize.QuadPart > (size_t)-1)
+        {
+            LogError("file %s is too big to be mapped", fileName);
+            result = __FAILURE__;
+        }
+        else if (fileSize.QuadPart == 0)
+        {
+            *mapping = NULL;
+            *size = 0;
+            result = 0;
+        }
+        else
+        {
+            HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (fileMapping == NULL)
+            {
+                LogError("CreateFileMappingA failed, error %lu", (unsigned long)GetLastError());
+                result = __FAILURE__;
+            }
+            else
+            {
+                void* view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+                if (view == NULL)
+                {
+                    LogError("MapViewOfFile failed, error %lu", (unsigned long)GetLastError());
+                    result = __FAILURE__;
+                }
+                else
+                {
+                    *mapping = (const unsigned char*)view;
+                    *size = (size_t)fileSize.QuadPart;
+                    result = 0;
+                }
+                (void)CloseHandle(fileMapping);
+            }
+        }
+        (void)CloseHandle(file);
+    }
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd == -1)
+    {
+        LogError("open failed for %s", fileName);
+        result = __FAILURE__;
+    }
+    else
+    {
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0)
+        {
+            LogError("fstat failed for %s", fileName);
+            result = __FAILURE__;
+        }
+        else if (!S_ISREG(fileStat.st_mode))
+        {
+            LogError("%s is not a regular file", fileName);
+            result = __FAILURE__;
+        }
+        else if ((unsigned long long)fileStat.st_size > (size_t)-1)
+        {
+            LogError("file %s is too big to be mapped", fileName);
+            result = __FAILURE__;
+        }
+        else if (fileStat.st_size == 0)
+        {
+            *mapping = NULL;
+            *size = 0;
+            result = 0;
+        }
+        else
+        {
+            void* view = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED)
+            {
+                LogError("mmap failed for %s", fileName);
+                result = __FAILURE__;
+            }
+            else
+            {
+                /*payloads are read once from start to end, this lets the kernel read ahead and drop the pages already sent*/
+                (void)posix_madvise(view, (size_t)fileStat.st_size, POSIX_MADV_SEQUENTIAL);
+                *mapping = (const unsigned char*)view;
+                *size = (size_t)fileStat.st_size;
+                result = 0;
+            }
+        }
+        (void)close(fd);
+    }
+#endif
+    return result;
+}
+
+static void unmap_file(const unsigned char* mapping, size_t size)
+{
+#if defined(_WIN32)
+    (void)size;
+    (void)UnmapViewOfFile(mapping);
+#else
+    (void)munmap((void*)mapping, size);
+#endif
+}
+#endif /* CONSTBUFFER_CAN_MAP_FILES */
+
+CONSTBUFFER_HANDLE CONSTBUFFER_CreateFromFile(const char* fileName)
+{
+    CONSTBUFFER_HANDLE result;
+
+    if (fileName == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_11_009: [ If fileName is NULL then CONSTBUFFER_CreateFromFile shall fail and return NULL. ]*/
+        LogError("Invalid arguments: const char* fileName=%p", fileName);
+        result = NULL;
+    }
+    else
+    {
+#ifdef CONSTBUFFER_CAN_MAP_FILES
+        result = (CONSTBUFFER_HANDLE)malloc(sizeof(CONSTBUFFER_HANDLE_DATA));
+        if (result == NULL)
+        {
+            /*Codes_SRS_CONSTBUFFER_11_012: [ If any error occurs, CONSTBUFFER_CreateFromFile shall fail and return NULL. ]*/
+            LogError("malloc failed");
+        }
+        /*Codes_SRS_CONSTBUFFER_11_010: [ CONSTBUFFER_CreateFromFile shall map the content of the file read only in memory and return a non-NULL handle to a const buffer with that content and the size of the file. ]*/
+        else if (map_file(fileName, &result->alias.buffer, &result->alias.size) != 0)
+        {
+            /*Codes_SRS_CONSTBUFFER_11_012: [ If any error occurs, CONSTBUFFER_CreateFromFile shall fail and return NULL. ]*/
+            LogError("unable to map %s", fileName);
+            free(result);
+            result = NULL;
+        }
+        else
+        {
+            result->buffer_type = CONSTBUFFER_TYPE_MAPPED_FILE;
+
+            /*Codes_SRS_CONSTBUFFER_11_011: [ The non-NULL handle returned by CONSTBUFFER_CreateFromFile shall have its ref count set to 1. ]*/
+            INIT_REF_VAR(result->count);
+        }
+#else
+        /*Codes_SRS_CONSTBUFFER_11_013: [ On platforms that cannot map files in memory, CONSTBUFFER_CreateFromFile shall fail and return NULL. ]*/
+        LogError("CONSTBUFFER_CreateFromFile is not supported on this platform");
+        result = NULL;
+#endif
+    }
+
+    return result;
+}
+
 void CONSTBUFFER_IncRef(CONSTBUFFER_HANDLE constbufferHandle)
 {
     if (constbufferHandle == NULL)
@@ -232,6 +458,18 @@ void CONSTBUFFER_DecRef(CONSTBUFFER_HANDLE constbufferHandle)
                 /* Codes_SRS_CONSTBUFFER_01_012: [ If the buffer was created by calling CONSTBUFFER_CreateWithCustomFree, the customFreeFunc function shall be called to free the memory, while passed customFreeFuncContext as argument. ]*/
                 constbufferHandle->custom_free_func(constbufferHandle->custom_free_func_context);
             }
+            else if (constbufferHandle->buffer_type == CONSTBUFFER_TYPE_FROM_OFFSET_AND_SIZE)
+            {
+                /*Codes_SRS_CONSTBUFFER_11_008: [ If the buffer was created by calling CONSTBUFFER_CreateFromOffsetAndSize, CONSTBUFFER_DecRef shall decrement the reference count of the const buffer that owns the memory. ]*/
+                CONSTBUFFER_DecRef(constbufferHandle->originalHandle);
+            }
+#ifdef CONSTBUFFER_CAN_MAP_FILES
+            else if ((constbufferHandle->buffer_type == CONSTBUFFER_TYPE_MAPPED_FILE) && (constbufferHandle->alias.buffer != NULL))
+            {
+                /*Codes_SRS_CONSTBUFFER_11_014: [ If the buffer was created by calling CONSTBUFFER_CreateFromFile, CONSTBUFFER_DecRef shall unmap the file. ]*/
+                unmap_file(constbufferHandle->alias.buffer, constbufferHandle->alias.size);
+            }
+#endif
 
             /*Codes_SRS_CONSTBUFFER_02_017: [If the refcount reaches zero, then CONSTBUFFER_DecRef shall deallocate all resources used by the CONSTBUFFER_HANDLE.]*/
             free(constbufferHandle);
@@ -2,6 +2,8 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 #include <inttypes.h>
 
 #include "azure_c_shared_utility/gballoc.h"
@@ -12,9 +14,15 @@
 #include "azure_c_shared_utility/constbuffer_array.h"
 #include "azure_c_shared_utility/refcount.h"
 
+/*all_buffers_size stops at this value, which means that the size does not fit in an uint32_t*/
+#define ALL_BUFFERS_SIZE_OVERFLOW ((uint64_t)UINT32_MAX + 1)
+
+#define BUILDER_INITIAL_CAPACITY 4
+
 typedef struct CONSTBUFFER_ARRAY_HANDLE_DATA_TAG
 {
     uint32_t nBuffers;
+    uint64_t all_buffers_size; /*computed when the array is created, the buffers never change*/
 #ifdef _MSC_VER
     /*warning C4200: nonstandard extension used: zero-sized array in struct/union : looks very standard in C99 and it is called flexible array. Documentation-wise is a flexible array, but called "unsized" in Microsoft's docs*/ /*https://msdn.microsoft.com/en-us/library/b6fae073.aspx*/
 #pragma warning(disable:4200)
@@ -24,6 +32,79 @@ typedef struct CONSTBUFFER_ARRAY_HANDLE_DATA_TAG
 
 DEFINE_REFCOUNT_TYPE(CONSTBUFFER_ARRAY_HANDLE_DATA);
 
+typedef struct CONSTBUFFER_ARRAY_BUILDER_HANDLE_DATA_TAG
+{
+    CONSTBUFFER_HANDLE* buffers;
+    uint32_t nBuffers;
+    uint32_t capacity;
+    uint64_t all_buffers_size;
+} CONSTBUFFER_ARRAY_BUILDER_HANDLE_DATA;
+
+static uint64_t add_buffer_size(uint64_t all_buffers_size, size_t size)
+{
+    return ((all_buffers_size == ALL_BUFFERS_SIZE_OVERFLOW) || ((uint64_t)size >= ALL_BUFFERS_SIZE_OVERFLOW - all_buffers_size)) ?
+        ALL_BUFFERS_SIZE_OVERFLOW :
+        all_buffers_size + size;
+}
+
+/*adds up the sizes of count buffers, returns non-zero if the content of a buffer cannot be obtained*/
+static int compute_all_buffers_size(const CONSTBUFFER_HANDLE* buffers, uint32_t count, uint64_t* all_buffers_size)
+{
+    int result;
+    uint32_t i;
+    uint64_t total_size = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(buffers[i]);
+        if (content == NULL)
+        {
+            LogError("failure in CONSTBUFFER_GetContent for buffer %" PRIu32, i);
+            break;
+        }
+        total_size = add_buffer_size(total_size, content->size);
+    }
+
+    if (i < count)
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        *all_buffers_size = total_size;
+        result = 0;
+    }
+
+    return result;
+}
+
+/*the size of all the buffers of an array except the first one, the first buffer is subtracted unless the size of the array is too big to be known*/
+static int compute_all_buffers_size_without_front(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle, uint64_t* all_buffers_size)
+{
+    int result;
+
+    if (constbuffer_array_handle->all_buffers_size == ALL_BUFFERS_SIZE_OVERFLOW)
+    {
+        result = compute_all_buffers_size(constbuffer_array_handle->buffers + 1, constbuffer_array_handle->nBuffers - 1, all_buffers_size);
+    }
+    else
+    {
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(constbuffer_array_handle->buffers[0]);
+        if (content == NULL)
+        {
+            LogError("failure in CONSTBUFFER_GetContent");
+            result = __FAILURE__;
+        }
+        else
+        {
+            *all_buffers_size = constbuffer_array_handle->all_buffers_size - content->size;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
 CONSTBUFFER_ARRAY_HANDLE constbuffer_array_create(const CONSTBUFFER_HANDLE* buffers, uint32_t buffer_count)
 {
     CONSTBUFFER_ARRAY_HANDLE result;
@@ -38,9 +119,16 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_create(const CONSTBUFFER_HANDLE* buff
     }
     else
     {
+        uint64_t all_buffers_size;
+
+        /* Codes_SRS_CONSTBUFFER_ARRAY_11_001: [ constbuffer_array_create shall add up the sizes of the buffers in buffers. ]*/
+        if (compute_all_buffers_size(buffers, buffer_count, &all_buffers_size) != 0)
+        {
+            /* Codes_SRS_CONSTBUFFER_ARRAY_01_014: [ If any error occurs, constbuffer_array_create shall fail and return NULL. ]*/
+            LogError("failure in computing the size of the buffers");
+        }
         /* Codes_SRS_CONSTBUFFER_ARRAY_01_009: [ constbuffer_array_create shall allocate memory for a new CONSTBUFFER_ARRAY_HANDLE that can hold buffer_count buffers. ]*/
-        result = REFCOUNT_TYPE_CREATE_WITH_EXTRA_SIZE(CONSTBUFFER_ARRAY_HANDLE_DATA, buffer_count * sizeof(CONSTBUFFER_HANDLE));
-        if (result == NULL)
+        else if ((result = REFCOUNT_TYPE_CREATE_WITH_EXTRA_SIZE(CONSTBUFFER_ARRAY_HANDLE_DATA, buffer_count * sizeof(CONSTBUFFER_HANDLE))) == NULL)
         {
             /* Codes_SRS_CONSTBUFFER_ARRAY_01_014: [ If any error occurs, constbuffer_array_create shall fail and return NULL. ]*/
             LogError("failure in allocating const buffer array");
@@ -56,6 +144,7 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_create(const CONSTBUFFER_HANDLE* buff
             }
 
             result->nBuffers = buffer_count;
+            result->all_buffers_size = all_buffers_size;
 
             /* Codes_SRS_CONSTBUFFER_ARRAY_01_011: [ On success constbuffer_array_create shall return a non-NULL handle. ]*/
             goto all_ok;
@@ -84,6 +173,7 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_create_empty(void)
     {
         /*Codes_SRS_CONSTBUFFER_ARRAY_02_041: [ constbuffer_array_create_empty shall succeed and return a non-NULL value. ]*/
         result->nBuffers = 0;
+        result->all_buffers_size = 0;
     }
     return result;
 }
@@ -118,6 +208,7 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_create_from_array_array(const CONSTBU
         else
         {
             uint32_t total_buffer_count = 0;
+            uint64_t all_buffers_size = 0;
             uint32_t i;
             for (i = 0; i < buffer_array_count; ++i)
             {
@@ -136,6 +227,11 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_create_from_array_array(const CONSTBU
                         LogError("Array size overflow while checking index %" PRIu32, i);
                         break;
                     }
+
+                    /*Codes_SRS_CONSTBUFFER_ARRAY_11_002: [ constbuffer_array_create_from_array_array shall add up the sizes of all the const buffer arrays in buffer_arrays. ]*/
+                    all_buffers_size = (buffer_arrays[i]->all_buffers_size == ALL_BUFFERS_SIZE_OVERFLOW) ?
+                        ALL_BUFFERS_SIZE_OVERFLOW :
+                        add_buffer_size(all_buffers_size, (size_t)buffer_arrays[i]->all_buffers_size);
                 }
             }
 
@@ -159,6 +255,7 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_create_from_array_array(const CONSTBU
                     uint32_t source_idx;
 
                     result->nBuffers = total_buffer_count;
+                    result->all_buffers_size = all_buffers_size;
 
                     for (dest_idx = 0, array_idx = 0; array_idx < buffer_array_count; ++array_idx)
                     {
@@ -195,9 +292,15 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_add_front(CONSTBUFFER_ARRAY_HANDLE co
     }
     else
     {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_003: [ constbuffer_array_add_front shall add the size of constbuffer_handle to the size of constbuffer_array_handle. ]*/
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(constbuffer_handle);
+        if (content == NULL)
+        {
+            /*Codes_SRS_CONSTBUFFER_ARRAY_02_011: [ If there any failures constbuffer_array_add_front shall fail and return NULL. ]*/
+            LogError("failure in CONSTBUFFER_GetContent");
+        }
         /*Codes_SRS_CONSTBUFFER_ARRAY_02_042: [ constbuffer_array_add_front shall allocate enough memory to hold all of constbuffer_array_handle existing CONSTBUFFER_HANDLE and constbuffer_handle. ]*/
-        result = REFCOUNT_TYPE_CREATE_WITH_EXTRA_SIZE(CONSTBUFFER_ARRAY_HANDLE_DATA, (constbuffer_array_handle->nBuffers + 1) * sizeof(CONSTBUFFER_HANDLE));
-        if (result == NULL)
+        else if ((result = REFCOUNT_TYPE_CREATE_WITH_EXTRA_SIZE(CONSTBUFFER_ARRAY_HANDLE_DATA, (constbuffer_array_handle->nBuffers + 1) * sizeof(CONSTBUFFER_HANDLE))) == NULL)
         {
             /*Codes_SRS_CONSTBUFFER_ARRAY_02_011: [ If there any failures constbuffer_array_add_front shall fail and return NULL. ]*/
             LogError("failure in malloc");
@@ -210,6 +313,7 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_add_front(CONSTBUFFER_ARRAY_HANDLE co
             /*Codes_SRS_CONSTBUFFER_ARRAY_02_043: [ constbuffer_array_add_front shall copy constbuffer_handle and all of constbuffer_array_handle existing CONSTBUFFER_HANDLE. ]*/
             /*Codes_SRS_CONSTBUFFER_ARRAY_02_044: [ constbuffer_array_add_front shall inc_ref all the CONSTBUFFER_HANDLE it had copied. ]*/
             result->nBuffers = constbuffer_array_handle->nBuffers + 1;
+            result->all_buffers_size = add_buffer_size(constbuffer_array_handle->all_buffers_size, content->size);
             CONSTBUFFER_IncRef(constbuffer_handle);
             result->buffers[0] = constbuffer_handle;
             for (i = 1; i < result->nBuffers; i++)
@@ -228,6 +332,59 @@ allOk:;
     return result;
 }
 
+CONSTBUFFER_ARRAY_HANDLE constbuffer_array_add_back(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle, CONSTBUFFER_HANDLE constbuffer_handle)
+{
+    CONSTBUFFER_ARRAY_HANDLE result;
+    if (
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_004: [ If constbuffer_array_handle is NULL then constbuffer_array_add_back shall fail and return NULL. ]*/
+        (constbuffer_array_handle == NULL) ||
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_005: [ If constbuffer_handle is NULL then constbuffer_array_add_back shall fail and return NULL. ]*/
+        (constbuffer_handle == NULL)
+        )
+    {
+        LogError("invalid arguments CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle=%p, CONSTBUFFER_HANDLE constbuffer_handle=%p", constbuffer_array_handle, constbuffer_handle);
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_006: [ constbuffer_array_add_back shall add the size of constbuffer_handle to the size of constbuffer_array_handle. ]*/
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(constbuffer_handle);
+        if (content == NULL)
+        {
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_010: [ If there any failures constbuffer_array_add_back shall fail and return NULL. ]*/
+            LogError("failure in CONSTBUFFER_GetContent");
+        }
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_007: [ constbuffer_array_add_back shall allocate enough memory to hold all of constbuffer_array_handle existing CONSTBUFFER_HANDLE and constbuffer_handle. ]*/
+        else if ((result = REFCOUNT_TYPE_CREATE_WITH_EXTRA_SIZE(CONSTBUFFER_ARRAY_HANDLE_DATA, (constbuffer_array_handle->nBuffers + 1) * sizeof(CONSTBUFFER_HANDLE))) == NULL)
+        {
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_010: [ If there any failures constbuffer_array_add_back shall fail and return NULL. ]*/
+            LogError("failure in malloc");
+            /*return as is*/
+        }
+        else
+        {
+            uint32_t i;
+
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_008: [ constbuffer_array_add_back shall copy all of constbuffer_array_handle existing CONSTBUFFER_HANDLE and then constbuffer_handle, and inc_ref all of them. ]*/
+            result->nBuffers = constbuffer_array_handle->nBuffers + 1;
+            result->all_buffers_size = add_buffer_size(constbuffer_array_handle->all_buffers_size, content->size);
+            for (i = 0; i < constbuffer_array_handle->nBuffers; i++)
+            {
+                CONSTBUFFER_IncRef(constbuffer_array_handle->buffers[i]);
+                result->buffers[i] = constbuffer_array_handle->buffers[i];
+            }
+            CONSTBUFFER_IncRef(constbuffer_handle);
+            result->buffers[constbuffer_array_handle->nBuffers] = constbuffer_handle;
+
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_009: [ constbuffer_array_add_back shall succeed and return a non-NULL value. ]*/
+            goto allOk;
+        }
+    }
+    /*Codes_SRS_CONSTBUFFER_ARRAY_11_010: [ If there any failures constbuffer_array_add_back shall fail and return NULL. ]*/
+    result = NULL;
+allOk:;
+    return result;
+}
+
 CONSTBUFFER_ARRAY_HANDLE constbuffer_array_remove_front(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle, CONSTBUFFER_HANDLE* constbuffer_handle)
 {
     CONSTBUFFER_ARRAY_HANDLE result;
@@ -252,9 +409,16 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_remove_front(CONSTBUFFER_ARRAY_HANDLE
         }
         else
         {
+            uint64_t all_buffers_size;
+
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_011: [ constbuffer_array_remove_front shall subtract the size of the front CONSTBUFFER_HANDLE from the size of constbuffer_array_handle, or add up the sizes of the other CONSTBUFFER_HANDLEs if that size does not fit in an uint32_t. ]*/
+            if (compute_all_buffers_size_without_front(constbuffer_array_handle, &all_buffers_size) != 0)
+            {
+                /*Codes_SRS_CONSTBUFFER_ARRAY_02_036: [ If there are any failures then constbuffer_array_remove_front shall fail and return NULL. ]*/
+                LogError("failure in computing the size of the buffers");
+            }
             /*Codes_SRS_CONSTBUFFER_ARRAY_02_046: [ constbuffer_array_remove_front shall allocate memory to hold all of constbuffer_array_handle CONSTBUFFER_HANDLEs except the front one. ]*/
-            result = REFCOUNT_TYPE_CREATE_WITH_EXTRA_SIZE(CONSTBUFFER_ARRAY_HANDLE_DATA, (constbuffer_array_handle->nBuffers - 1) * sizeof(CONSTBUFFER_HANDLE));
-            if (result == NULL)
+            else if ((result = REFCOUNT_TYPE_CREATE_WITH_EXTRA_SIZE(CONSTBUFFER_ARRAY_HANDLE_DATA, (constbuffer_array_handle->nBuffers - 1) * sizeof(CONSTBUFFER_HANDLE))) == NULL)
             {
                 /*Codes_SRS_CONSTBUFFER_ARRAY_02_036: [ If there are any failures then constbuffer_array_remove_front shall fail and return NULL. ]*/
                 LogError("failure in malloc");
@@ -267,6 +431,7 @@ CONSTBUFFER_ARRAY_HANDLE constbuffer_array_remove_front(CONSTBUFFER_ARRAY_HANDLE
                 /* Codes_SRS_CONSTBUFFER_ARRAY_01_001: [ constbuffer_array_remove_front shall inc_ref the removed buffer. ]*/
                 CONSTBUFFER_IncRef(constbuffer_array_handle->buffers[0]);
                 result->nBuffers = constbuffer_array_handle->nBuffers - 1;
+                result->all_buffers_size = all_buffers_size;
 
                 /*Codes_SRS_CONSTBUFFER_ARRAY_02_047: [ constbuffer_array_remove_front shall copy all of constbuffer_array_handle CONSTBUFFER_HANDLEs except the front one. ]*/
                 /*Codes_SRS_CONSTBUFFER_ARRAY_02_048: [ constbuffer_array_remove_front shall inc_ref all the copied CONSTBUFFER_HANDLEs. ]*/
@@ -421,38 +586,166 @@ int constbuffer_array_get_all_buffers_size(CONSTBUFFER_ARRAY_HANDLE constbuffer_
             constbuffer_array_handle, all_buffers_size);
         result = __FAILURE__;
     }
+    else if (constbuffer_array_handle->all_buffers_size == ALL_BUFFERS_SIZE_OVERFLOW)
+    {
+        /* Codes_SRS_CONSTBUFFER_ARRAY_01_021: [ If summing up the sizes results in an uint32_t overflow, shall fail and return a non-zero value. ]*/
+        LogError("Overflow in computing all buffers size");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_CONSTBUFFER_ARRAY_01_022: [ Otherwise constbuffer_array_get_all_buffers_size shall write in all_buffers_size the total size of all buffers in the array and return 0. ]*/
+        /* Codes_SRS_CONSTBUFFER_ARRAY_11_012: [ constbuffer_array_get_all_buffers_size shall return the size computed when the array was created, without calling CONSTBUFFER_GetContent. ]*/
+        *all_buffers_size = (uint32_t)constbuffer_array_handle->all_buffers_size;
+        result = 0;
+    }
+
+    return result;
+}
+
+const CONSTBUFFER_HANDLE* constbuffer_array_get_const_buffer_handle_array(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle)
+{
+    const CONSTBUFFER_HANDLE* result;
+
+    /* Codes_SRS_CONSTBUFFER_ARRAY_01_026: [ If `constbuffer_array_handle` is NULL, `constbuffer_array_get_const_buffer_handle_array` shall fail and return NULL. ]*/
+    if (constbuffer_array_handle == NULL)
+    {
+        LogError("CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle=%p", constbuffer_array_handle);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_CONSTBUFFER_ARRAY_01_027: [ Otherwise `constbuffer_array_get_const_buffer_handle_array` shall return the array of const buffer handles backing the const buffer array. ]*/
+        result = constbuffer_array_handle->buffers;
+    }
+
+    return result;
+}
+
+CONSTBUFFER_ARRAY_BUILDER_HANDLE constbuffer_array_builder_create(void)
+{
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE result;
+
+    /*Codes_SRS_CONSTBUFFER_ARRAY_11_013: [ constbuffer_array_builder_create shall allocate memory for a new empty CONSTBUFFER_ARRAY_BUILDER_HANDLE and return it. ]*/
+    result = (CONSTBUFFER_ARRAY_BUILDER_HANDLE)malloc(sizeof(CONSTBUFFER_ARRAY_BUILDER_HANDLE_DATA));
+    if (result == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_014: [ If there are any failures then constbuffer_array_builder_create shall fail and return NULL. ]*/
+        LogError("failure in malloc");
+    }
+    else
+    {
+        result->buffers = NULL;
+        result->nBuffers = 0;
+        result->capacity = 0;
+        result->all_buffers_size = 0;
+    }
+
+    return result;
+}
+
+void constbuffer_array_builder_destroy(CONSTBUFFER_ARRAY_BUILDER_HANDLE constbuffer_array_builder_handle)
+{
+    if (constbuffer_array_builder_handle == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_015: [ If constbuffer_array_builder_handle is NULL then constbuffer_array_builder_destroy shall return. ]*/
+        LogError("invalid argument CONSTBUFFER_ARRAY_BUILDER_HANDLE constbuffer_array_builder_handle=%p", constbuffer_array_builder_handle);
+    }
     else
     {
         uint32_t i;
-        uint32_t total_size = 0;
 
-        for (i = 0; i < constbuffer_array_handle->nBuffers; i++)
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_016: [ constbuffer_array_builder_destroy shall dec_ref all the CONSTBUFFER_HANDLEs that were appended and not sealed and free all used resources. ]*/
+        for (i = 0; i < constbuffer_array_builder_handle->nBuffers; i++)
         {
-            const CONSTBUFFER* content = CONSTBUFFER_GetContent(constbuffer_array_handle->buffers[i]);
-#if SIZE_MAX > UINT32_MAX
-            if (content->size > UINT32_MAX)
-            {
-                break;
-            }
-#endif
-            if (total_size + (uint32_t)content->size < total_size)
-            {
-                break;
-            }
+            CONSTBUFFER_DecRef(constbuffer_array_builder_handle->buffers[i]);
+        }
+        free(constbuffer_array_builder_handle->buffers);
+        free(constbuffer_array_builder_handle);
+    }
+}
+
+static int grow_builder(CONSTBUFFER_ARRAY_BUILDER_HANDLE constbuffer_array_builder_handle)
+{
+    int result;
+    uint32_t new_capacity = (constbuffer_array_builder_handle->capacity == 0) ? BUILDER_INITIAL_CAPACITY :
+        (constbuffer_array_builder_handle->capacity > UINT32_MAX / 2) ? UINT32_MAX :
+        constbuffer_array_builder_handle->capacity * 2;
+
+    size_t new_size = (size_t)new_capacity * sizeof(CONSTBUFFER_HANDLE);
 
-            total_size += (uint32_t)content->size;
+    if (new_size / sizeof(CONSTBUFFER_HANDLE) != new_capacity)
+    {
+        LogError("builder too big");
+        result = __FAILURE__;
+    }
+    else
+    {
+        CONSTBUFFER_HANDLE* new_buffers = (CONSTBUFFER_HANDLE*)realloc(constbuffer_array_builder_handle->buffers, new_size);
+        if (new_buffers == NULL)
+        {
+            LogError("failure in realloc");
+            result = __FAILURE__;
         }
+        else
+        {
+            constbuffer_array_builder_handle->buffers = new_buffers;
+            constbuffer_array_builder_handle->capacity = new_capacity;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+int constbuffer_array_builder_append(CONSTBUFFER_ARRAY_BUILDER_HANDLE constbuffer_array_builder_handle, CONSTBUFFER_HANDLE constbuffer_handle)
+{
+    int result;
 
-        if (i < constbuffer_array_handle->nBuffers)
+    if (
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_017: [ If constbuffer_array_builder_handle is NULL then constbuffer_array_builder_append shall fail and return a non-zero value. ]*/
+        (constbuffer_array_builder_handle == NULL) ||
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_018: [ If constbuffer_handle is NULL then constbuffer_array_builder_append shall fail and return a non-zero value. ]*/
+        (constbuffer_handle == NULL)
+        )
+    {
+        LogError("invalid arguments CONSTBUFFER_ARRAY_BUILDER_HANDLE constbuffer_array_builder_handle=%p, CONSTBUFFER_HANDLE constbuffer_handle=%p", constbuffer_array_builder_handle, constbuffer_handle);
+        result = __FAILURE__;
+    }
+    else if (constbuffer_array_builder_handle->nBuffers == UINT32_MAX)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_022: [ If there are any failures then constbuffer_array_builder_append shall fail and return a non-zero value. ]*/
+        LogError("too many buffers");
+        result = __FAILURE__;
+    }
+    else
+    {
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(constbuffer_handle);
+        if (content == NULL)
         {
-            /* Codes_SRS_CONSTBUFFER_ARRAY_01_021: [ If summing up the sizes results in an uint32_t overflow, shall fail and return a non-zero value. ]*/
-            LogError("Overflow in computing all buffers size");
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_022: [ If there are any failures then constbuffer_array_builder_append shall fail and return a non-zero value. ]*/
+            LogError("failure in CONSTBUFFER_GetContent");
+            result = __FAILURE__;
+        }
+        else if (
+            (constbuffer_array_builder_handle->nBuffers == constbuffer_array_builder_handle->capacity) &&
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_019: [ If the builder is full, constbuffer_array_builder_append shall double the number of CONSTBUFFER_HANDLEs it can hold (starting at 4). ]*/
+            (grow_builder(constbuffer_array_builder_handle) != 0)
+            )
+        {
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_022: [ If there are any failures then constbuffer_array_builder_append shall fail and return a non-zero value. ]*/
+            LogError("failure in growing the builder");
             result = __FAILURE__;
         }
         else
         {
-            /* Codes_SRS_CONSTBUFFER_ARRAY_01_022: [ Otherwise constbuffer_array_get_all_buffers_size shall write in all_buffers_size the total size of all buffers in the array and return 0. ]*/
-            *all_buffers_size = total_size;
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_020: [ constbuffer_array_builder_append shall inc_ref constbuffer_handle, store it after the CONSTBUFFER_HANDLEs already appended and add its size to the size of the builder. ]*/
+            CONSTBUFFER_IncRef(constbuffer_handle);
+            constbuffer_array_builder_handle->buffers[constbuffer_array_builder_handle->nBuffers] = constbuffer_handle;
+            constbuffer_array_builder_handle->nBuffers++;
+            constbuffer_array_builder_handle->all_buffers_size = add_buffer_size(constbuffer_array_builder_handle->all_buffers_size, content->size);
+
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_021: [ constbuffer_array_builder_append shall succeed and return 0. ]*/
             result = 0;
         }
     }
@@ -460,20 +753,39 @@ int constbuffer_array_get_all_buffers_size(CONSTBUFFER_ARRAY_HANDLE constbuffer_
     return result;
 }
 
-const CONSTBUFFER_HANDLE* constbuffer_array_get_const_buffer_handle_array(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle)
+CONSTBUFFER_ARRAY_HANDLE constbuffer_array_builder_seal(CONSTBUFFER_ARRAY_BUILDER_HANDLE constbuffer_array_builder_handle)
 {
-    const CONSTBUFFER_HANDLE* result;
+    CONSTBUFFER_ARRAY_HANDLE result;
 
-    /* Codes_SRS_CONSTBUFFER_ARRAY_01_026: [ If `constbuffer_array_handle` is NULL, `constbuffer_array_get_const_buffer_handle_array` shall fail and return NULL. ]*/
-    if (constbuffer_array_handle == NULL)
+    if (constbuffer_array_builder_handle == NULL)
     {
-        LogError("CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle=%p", constbuffer_array_handle);
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_023: [ If constbuffer_array_builder_handle is NULL then constbuffer_array_builder_seal shall fail and return NULL. ]*/
+        LogError("invalid argument CONSTBUFFER_ARRAY_BUILDER_HANDLE constbuffer_array_builder_handle=%p", constbuffer_array_builder_handle);
         result = NULL;
     }
     else
     {
-        /* Codes_SRS_CONSTBUFFER_ARRAY_01_027: [ Otherwise `constbuffer_array_get_const_buffer_handle_array` shall return the array of const buffer handles backing the const buffer array. ]*/
-        result = constbuffer_array_handle->buffers;
+        /*Codes_SRS_CONSTBUFFER_ARRAY_11_024: [ constbuffer_array_builder_seal shall allocate memory for a new CONSTBUFFER_ARRAY_HANDLE that holds the appended CONSTBUFFER_HANDLEs in the order they were appended. ]*/
+        result = REFCOUNT_TYPE_CREATE_WITH_EXTRA_SIZE(CONSTBUFFER_ARRAY_HANDLE_DATA, constbuffer_array_builder_handle->nBuffers * sizeof(CONSTBUFFER_HANDLE));
+        if (result == NULL)
+        {
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_027: [ If there are any failures then constbuffer_array_builder_seal shall fail, return NULL and keep the appended CONSTBUFFER_HANDLEs in the builder. ]*/
+            LogError("failure in malloc");
+        }
+        else
+        {
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_025: [ The references to the CONSTBUFFER_HANDLEs held by the builder shall move to the new array, without inc_ref'ing them. ]*/
+            if (constbuffer_array_builder_handle->nBuffers > 0)
+            {
+                (void)memcpy(result->buffers, constbuffer_array_builder_handle->buffers, constbuffer_array_builder_handle->nBuffers * sizeof(CONSTBUFFER_HANDLE));
+            }
+            result->nBuffers = constbuffer_array_builder_handle->nBuffers;
+            result->all_buffers_size = constbuffer_array_builder_handle->all_buffers_size;
+
+            /*Codes_SRS_CONSTBUFFER_ARRAY_11_026: [ constbuffer_array_builder_seal shall empty the builder, which keeps its memory so it can be used again, and return the new array. ]*/
+            constbuffer_array_builder_handle->nBuffers = 0;
+            constbuffer_array_builder_handle->all_buffers_size = 0;
+        }
     }
 
     return result;
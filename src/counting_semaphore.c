@@ -0,0 +1,214 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*
+A count under a lock. counting_semaphore_release adds to the count and posts the condition for 1 unit or broadcasts
+it for more, the waiters that find the count at 0 again go back to waiting. A timed counting_semaphore_acquire
+measures the time it waited with a tickcounter that is only read under the lock, like latch_wait.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/condition.h"
+#include "azure_c_shared_utility/tickcounter.h"
+#include "azure_c_shared_utility/counting_semaphore.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+typedef struct COUNTING_SEMAPHORE_TAG
+{
+    LOCK_HANDLE lock;
+    COND_HANDLE available;
+    TICK_COUNTER_HANDLE tick_counter;
+    size_t count;
+} COUNTING_SEMAPHORE;
+
+COUNTING_SEMAPHORE_HANDLE counting_semaphore_create(size_t initial_count)
+{
+    COUNTING_SEMAPHORE* result = (COUNTING_SEMAPHORE*)malloc(sizeof(COUNTING_SEMAPHORE));
+    if (result == NULL)
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_002: [ If any error occurs, counting_semaphore_create shall fail and return NULL. ]*/
+        LogError("failure allocating COUNTING_SEMAPHORE");
+    }
+    else if ((result->lock = Lock_Init()) == NULL)
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_002: [ If any error occurs, counting_semaphore_create shall fail and return NULL. ]*/
+        LogError("failure in Lock_Init");
+        free(result);
+        result = NULL;
+    }
+    else if ((result->available = Condition_Init()) == NULL)
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_002: [ If any error occurs, counting_semaphore_create shall fail and return NULL. ]*/
+        LogError("failure in Condition_Init");
+        (void)Lock_Deinit(result->lock);
+        free(result);
+        result = NULL;
+    }
+    else if ((result->tick_counter = tickcounter_create()) == NULL)
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_002: [ If any error occurs, counting_semaphore_create shall fail and return NULL. ]*/
+        LogError("failure in tickcounter_create");
+        Condition_Deinit(result->available);
+        (void)Lock_Deinit(result->lock);
+        free(result);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_001: [ counting_semaphore_create shall allocate a semaphore with a lock, a condition, a tickcounter and a count of initial_count and return it. ]*/
+        result->count = initial_count;
+    }
+
+    return result;
+}
+
+void counting_semaphore_destroy(COUNTING_SEMAPHORE_HANDLE semaphore)
+{
+    if (semaphore == NULL)
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_003: [ If semaphore is NULL, counting_semaphore_destroy shall return. ]*/
+        LogError("Invalid arguments: COUNTING_SEMAPHORE_HANDLE semaphore=%p", semaphore);
+    }
+    else
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_004: [ counting_semaphore_destroy shall free the tickcounter, the condition, the lock and the semaphore. ]*/
+        tickcounter_destroy(semaphore->tick_counter);
+        Condition_Deinit(semaphore->available);
+        (void)Lock_Deinit(semaphore->lock);
+        free(semaphore);
+    }
+}
+
+COUNTING_SEMAPHORE_RESULT counting_semaphore_acquire(COUNTING_SEMAPHORE_HANDLE semaphore, int timeout_milliseconds)
+{
+    COUNTING_SEMAPHORE_RESULT result;
+
+    if ((semaphore == NULL) || (timeout_milliseconds < 0))
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_005: [ If semaphore is NULL or timeout_milliseconds is negative, counting_semaphore_acquire shall fail and return COUNTING_SEMAPHORE_INVALID_ARG. ]*/
+        LogError("Invalid arguments: COUNTING_SEMAPHORE_HANDLE semaphore=%p, int timeout_milliseconds=%d", semaphore, timeout_milliseconds);
+        result = COUNTING_SEMAPHORE_INVALID_ARG;
+    }
+    else if (Lock(semaphore->lock) != LOCK_OK)
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_009: [ If any error occurs, counting_semaphore_acquire shall fail, leave the count as it was and return COUNTING_SEMAPHORE_ERROR. ]*/
+        LogError("failure locking the semaphore");
+        result = COUNTING_SEMAPHORE_ERROR;
+    }
+    else
+    {
+        tickcounter_ms_t start_ms = 0;
+
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_008: [ If timeout_milliseconds is not 0, counting_semaphore_acquire shall read the tickcounter of semaphore before it waits and after every wakeup, and return COUNTING_SEMAPHORE_TIMEOUT once timeout_milliseconds went by with the count at 0. ]*/
+        if ((timeout_milliseconds != 0) &&
+            (tickcounter_get_current_ms(semaphore->tick_counter, &start_ms) != 0))
+        {
+            /* Codes_SRS_COUNTING_SEMAPHORE_11_009: [ If any error occurs, counting_semaphore_acquire shall fail, leave the count as it was and return COUNTING_SEMAPHORE_ERROR. ]*/
+            LogError("failure in tickcounter_get_current_ms");
+            result = COUNTING_SEMAPHORE_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_COUNTING_SEMAPHORE_11_007: [ While the count of semaphore is 0, counting_semaphore_acquire shall wait on the condition of semaphore. ]*/
+            result = COUNTING_SEMAPHORE_OK;
+            while (semaphore->count == 0)
+            {
+                int wait_milliseconds = timeout_milliseconds;
+                COND_RESULT cond_result;
+
+                if (timeout_milliseconds != 0)
+                {
+                    tickcounter_ms_t now_ms;
+                    if (tickcounter_get_current_ms(semaphore->tick_counter, &now_ms) != 0)
+                    {
+                        /* Codes_SRS_COUNTING_SEMAPHORE_11_009: [ If any error occurs, counting_semaphore_acquire shall fail, leave the count as it was and return COUNTING_SEMAPHORE_ERROR. ]*/
+                        LogError("failure in tickcounter_get_current_ms");
+                        result = COUNTING_SEMAPHORE_ERROR;
+                        break;
+                    }
+                    else if (now_ms - start_ms >= (tickcounter_ms_t)timeout_milliseconds)
+                    {
+                        /* Codes_SRS_COUNTING_SEMAPHORE_11_008: [ If timeout_milliseconds is not 0, counting_semaphore_acquire shall read the tickcounter of semaphore before it waits and after every wakeup, and return COUNTING_SEMAPHORE_TIMEOUT once timeout_milliseconds went by with the count at 0. ]*/
+                        result = COUNTING_SEMAPHORE_TIMEOUT;
+                        break;
+                    }
+                    else
+                    {
+                        wait_milliseconds = timeout_milliseconds - (int)(now_ms - start_ms);
+                    }
+                }
+
+                /*COND_TIMEOUT goes around again, the tickcounter decides whether the whole timeout went by*/
+                cond_result = Condition_Wait(semaphore->available, semaphore->lock, wait_milliseconds);
+                if ((cond_result != COND_OK) && (cond_result != COND_TIMEOUT))
+                {
+                    /* Codes_SRS_COUNTING_SEMAPHORE_11_009: [ If any error occurs, counting_semaphore_acquire shall fail, leave the count as it was and return COUNTING_SEMAPHORE_ERROR. ]*/
+                    LogError("failure in Condition_Wait");
+                    result = COUNTING_SEMAPHORE_ERROR;
+                    break;
+                }
+            }
+
+            if (result == COUNTING_SEMAPHORE_OK)
+            {
+                /* Codes_SRS_COUNTING_SEMAPHORE_11_006: [ counting_semaphore_acquire shall decrement the count of semaphore under its lock and return COUNTING_SEMAPHORE_OK. ]*/
+                semaphore->count--;
+            }
+        }
+        (void)Unlock(semaphore->lock);
+    }
+
+    return result;
+}
+
+COUNTING_SEMAPHORE_RESULT counting_semaphore_release(COUNTING_SEMAPHORE_HANDLE semaphore, size_t count)
+{
+    COUNTING_SEMAPHORE_RESULT result;
+
+    if ((semaphore == NULL) || (count == 0))
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_010: [ If semaphore is NULL or count is 0, counting_semaphore_release shall fail and return COUNTING_SEMAPHORE_INVALID_ARG. ]*/
+        LogError("Invalid arguments: COUNTING_SEMAPHORE_HANDLE semaphore=%p, size_t count=%lu", semaphore, (unsigned long)count);
+        result = COUNTING_SEMAPHORE_INVALID_ARG;
+    }
+    else if (Lock(semaphore->lock) != LOCK_OK)
+    {
+        /* Codes_SRS_COUNTING_SEMAPHORE_11_014: [ If any other error occurs, counting_semaphore_release shall fail and return COUNTING_SEMAPHORE_ERROR. ]*/
+        LogError("failure locking the semaphore");
+        result = COUNTING_SEMAPHORE_ERROR;
+    }
+    else
+    {
+        if (count > SIZE_MAX - semaphore->count)
+        {
+            /* Codes_SRS_COUNTING_SEMAPHORE_11_011: [ If adding count would overflow the count of semaphore, counting_semaphore_release shall fail, leave the count as it was and return COUNTING_SEMAPHORE_ERROR. ]*/
+            LogError("releasing %lu would overflow the count of the semaphore", (unsigned long)count);
+            result = COUNTING_SEMAPHORE_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_COUNTING_SEMAPHORE_11_012: [ counting_semaphore_release shall add count to the count of semaphore under its lock and return COUNTING_SEMAPHORE_OK. ]*/
+            semaphore->count += count;
+            result = COUNTING_SEMAPHORE_OK;
+
+            /* Codes_SRS_COUNTING_SEMAPHORE_11_013: [ counting_semaphore_release shall post the condition of semaphore when count is 1 and broadcast it otherwise. ]*/
+            if (((count == 1) ? Condition_Post(semaphore->available) : Condition_Broadcast(semaphore->available)) != COND_OK)
+            {
+                /* Codes_SRS_COUNTING_SEMAPHORE_11_014: [ If any other error occurs, counting_semaphore_release shall fail and return COUNTING_SEMAPHORE_ERROR. ]*/
+                LogError("failure waking the waiters of the semaphore");
+                result = COUNTING_SEMAPHORE_ERROR;
+            }
+        }
+        (void)Unlock(semaphore->lock);
+    }
+
+    return result;
+}
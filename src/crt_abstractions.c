@@ -735,6 +735,63 @@ int mallocAndStrcpy_s(char** destination, const char* source)
     return result;
 }
 
+/*"00" "01" ... "99", lets the conversions below produce two digits per division*/
+static const char decimalDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/*writes the decimal digits of value at the end of a local buffer (so there is nothing to reverse) and copies them to destination only when they fit*/
+static int decimalToString(char* destination, size_t destinationSize, size_t value)
+{
+    int result;
+    char digits[3 * sizeof(size_t)]; /*a byte never needs more than 3 decimal digits*/
+    char* first = digits + sizeof(digits);
+    size_t length;
+
+    while (value >= 100)
+    {
+        size_t pair = (value % 100) * 2;
+        value /= 100;
+        first -= 2;
+        first[0] = decimalDigitPairs[pair];
+        first[1] = decimalDigitPairs[pair + 1];
+    }
+    if (value >= 10)
+    {
+        first -= 2;
+        first[0] = decimalDigitPairs[value * 2];
+        first[1] = decimalDigitPairs[value * 2 + 1];
+    }
+    else
+    {
+        *--first = (char)('0' + value);
+    }
+
+    length = (size_t)(digits + sizeof(digits) - first);
+    if (length >= destinationSize)
+    {
+        /*Codes_SRS_CRT_ABSTRACTIONS_02_002: [If the conversion fails for any reason (for example, insufficient buffer space), a non-zero return value shall be supplied and unsignedIntToString shall fail.] */
+        /*Codes_SRS_CRT_ABSTRACTIONS_11_001: [ If the conversion fails, unsignedIntToString and size_tToString shall not change destination. ]*/
+        result = __FAILURE__;
+    }
+    else
+    {
+        (void)memcpy(destination, first, length);
+        destination[length] = '\0';
+        /*Codes_SRS_CRT_ABSTRACTIONS_02_004: [If the conversion has been successfull then unsignedIntToString shall return 0.] */
+        result = 0;
+    }
+    return result;
+}
+
 /*takes "value" and transforms it into a decimal string*/
 /*10 => "10"*/
 /*return 0 when everything went ok*/
@@ -742,8 +799,6 @@ int mallocAndStrcpy_s(char** destination, const char* source)
 int unsignedIntToString(char* destination, size_t destinationSize, unsigned int value)
 {
     int result;
-    size_t pos;
-    /*the below loop gets the number in reverse order*/
     /*Codes_SRS_CRT_ABSTRACTIONS_02_003: [If destination is NULL then unsignedIntToString shall fail.] */
     /*Codes_SRS_CRT_ABSTRACTIONS_02_002: [If the conversion fails for any reason (for example, insufficient buffer space), a non-zero return value shall be supplied and unsignedIntToString shall fail.] */
     if (
@@ -755,33 +810,7 @@ int unsignedIntToString(char* destination, size_t destinationSize, unsigned int
     }
     else
     {
-        pos = 0;
-        do
-        {
-            destination[pos++] = '0' + (value % 10);
-            value /= 10;
-        } while ((value > 0) && (pos < (destinationSize-1)));
-
-        if (value == 0)
-        {
-            size_t w;
-            destination[pos] = '\0';
-            /*all converted and they fit*/
-            for (w = 0; w <= (pos-1) >> 1; w++)
-            {
-                char temp;
-                temp = destination[w];
-                destination[w] = destination[pos - 1 - w];
-                destination[pos -1 - w] = temp;
-            }
-            /*Codes_SRS_CRT_ABSTRACTIONS_02_004: [If the conversion has been successfull then unsignedIntToString shall return 0.] */
-            result = 0;
-        }
-        else
-        {
-            /*Codes_SRS_CRT_ABSTRACTIONS_02_002: [If the conversion fails for any reason (for example, insufficient buffer space), a non-zero return value shall be supplied and unsignedIntToString shall fail.] */
-            result = __FAILURE__;
-        }
+        result = decimalToString(destination, destinationSize, value);
     }
     return result;
 }
@@ -793,8 +822,6 @@ int unsignedIntToString(char* destination, size_t destinationSize, unsigned int
 int size_tToString(char* destination, size_t destinationSize, size_t value)
 {
     int result;
-    size_t pos;
-    /*the below loop gets the number in reverse order*/
     /*Codes_SRS_CRT_ABSTRACTIONS_02_003: [If destination is NULL then unsignedIntToString shall fail.] */
     /*Codes_SRS_CRT_ABSTRACTIONS_02_002: [If the conversion fails for any reason (for example, insufficient buffer space), a non-zero return value shall be supplied and unsignedIntToString shall fail.] */
     if (
@@ -806,33 +833,7 @@ int size_tToString(char* destination, size_t destinationSize, size_t value)
     }
     else
     {
-        pos = 0;
-        do
-        {
-            destination[pos++] = '0' + (value % 10);
-            value /= 10;
-        } while ((value > 0) && (pos < (destinationSize - 1)));
-
-        if (value == 0)
-        {
-            size_t w;
-            destination[pos] = '\0';
-            /*all converted and they fit*/
-            for (w = 0; w <= (pos - 1) >> 1; w++)
-            {
-                char temp;
-                temp = destination[w];
-                destination[w] = destination[pos - 1 - w];
-                destination[pos - 1 - w] = temp;
-            }
-            /*Codes_SRS_CRT_ABSTRACTIONS_02_004: [If the conversion has been successfull then unsignedIntToString shall return 0.] */
-            result = 0;
-        }
-        else
-        {
-            /*Codes_SRS_CRT_ABSTRACTIONS_02_002: [If the conversion fails for any reason (for example, insufficient buffer space), a non-zero return value shall be supplied and unsignedIntToString shall fail.] */
-            result = __FAILURE__;
-        }
+        result = decimalToString(destination, destinationSize, value);
     }
     return result;
 }
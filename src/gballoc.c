@@ -5,23 +5,48 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <stdio.h>
+#include <string.h>
 #include "azure_c_shared_utility/lock.h"
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
 
-#ifndef GB_USE_CUSTOM_HEAP
+#if !defined(GB_USE_CUSTOM_HEAP) && !defined(GB_SHARDED_TRACKING)
+
+/*gballoc.h declares the functions implemented here, but its malloc redirection must not apply to this file*/
+#undef GB_MEASURE_MEMORY_FOR_THIS
+#ifndef GB_DEBUG_ALLOC
+#define GB_DEBUG_ALLOC
+#endif
+#include "azure_c_shared_utility/gballoc.h"
 
 #ifndef SIZE_MAX
 #define SIZE_MAX ((size_t)~(size_t)0)
 #endif
 
+/*what was allocated at one file/line, counted only for the sampled allocations and scaled by the sampling rate*/
+typedef struct GBALLOC_SITE_TAG
+{
+    const char* file;
+    int line;
+    size_t allocationCount;
+    size_t allocationBytes;
+    size_t liveCount;
+    size_t liveBytes;
+    struct GBALLOC_SITE_TAG* next;
+} GBALLOC_SITE;
+
 typedef struct ALLOCATION_TAG
 {
     size_t size;
     void* ptr;
     void* next;
+    GBALLOC_SITE* site; /*NULL when the allocation was not sampled*/
+    size_t siteWeight; /*the sampling rate at the time the allocation was sampled*/
 } ALLOCATION;
 
+#define GBALLOC_SITE_BUCKET_COUNT 256
+
 typedef enum GBALLOC_STATE_TAG
 {
     GBALLOC_STATE_INIT,
@@ -36,6 +61,97 @@ static GBALLOC_STATE gballocState = GBALLOC_STATE_NOT_INIT;
 
 static LOCK_HANDLE gballocThreadSafeLock = NULL;
 
+static GBALLOC_SITE* siteBuckets[GBALLOC_SITE_BUCKET_COUNT];
+static size_t siteCount = 0;
+static size_t siteSamplingRate = 1;
+static size_t siteSampleCountdown = 1;
+
+/*the following site functions are called with the lock held*/
+static GBALLOC_SITE* get_site(const char* file, int line)
+{
+    GBALLOC_SITE* result;
+    size_t bucket = ((size_t)line * 31 + strlen(file)) % GBALLOC_SITE_BUCKET_COUNT;
+
+    result = siteBuckets[bucket];
+    while ((result != NULL) &&
+        ((result->line != line) || ((result->file != file) && (strcmp(result->file, file) != 0))))
+    {
+        result = result->next;
+    }
+
+    if (result == NULL)
+    {
+        result = (GBALLOC_SITE*)malloc(sizeof(GBALLOC_SITE));
+        if (result == NULL)
+        {
+            LogError("failure allocating the record for %s:%d", file, line);
+        }
+        else
+        {
+            result->file = file;
+            result->line = line;
+            result->allocationCount = 0;
+            result->allocationBytes = 0;
+            result->liveCount = 0;
+            result->liveBytes = 0;
+            result->next = siteBuckets[bucket];
+            siteBuckets[bucket] = result;
+            siteCount++;
+        }
+    }
+
+    return result;
+}
+
+static void track_site(ALLOCATION* allocation, const char* file, int line)
+{
+    allocation->site = NULL;
+    allocation->siteWeight = 0;
+
+    /* Codes_SRS_GBALLOC_11_006: [ Only 1 in every rate allocations made through gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall be recorded, and their counts and bytes shall be multiplied by rate. ]*/
+    if ((file != NULL) && (siteSamplingRate != 0) && (--siteSampleCountdown == 0))
+    {
+        siteSampleCountdown = siteSamplingRate;
+
+        /* Codes_SRS_GBALLOC_11_005: [ gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc and also add the allocation to the count, bytes, live count and live bytes of the file and line they were called from. ]*/
+        allocation->site = get_site(file, line);
+        if (allocation->site != NULL)
+        {
+            allocation->siteWeight = siteSamplingRate;
+            allocation->site->allocationCount += siteSamplingRate;
+            allocation->site->allocationBytes += allocation->size * siteSamplingRate;
+            allocation->site->liveCount += siteSamplingRate;
+            allocation->site->liveBytes += allocation->size * siteSamplingRate;
+        }
+    }
+}
+
+static void untrack_site(ALLOCATION* allocation)
+{
+    /* Codes_SRS_GBALLOC_11_007: [ When a recorded allocation is freed or reallocated, its live count and live bytes shall be taken out of the file and line it was allocated from. ]*/
+    if (allocation->site != NULL)
+    {
+        allocation->site->liveCount -= allocation->siteWeight;
+        allocation->site->liveBytes -= allocation->size * allocation->siteWeight;
+        allocation->site = NULL;
+    }
+}
+
+static void free_sites(void)
+{
+    size_t i;
+    for (i = 0; i < GBALLOC_SITE_BUCKET_COUNT; i++)
+    {
+        while (siteBuckets[i] != NULL)
+        {
+            GBALLOC_SITE* next = siteBuckets[i]->next;
+            free(siteBuckets[i]);
+            siteBuckets[i] = next;
+        }
+    }
+    siteCount = 0;
+}
+
 int gballoc_init(void)
 {
     int result;
@@ -59,6 +175,8 @@ int gballoc_init(void)
         totalSize = 0;
         maxSize = 0;
         g_allocations = 0;
+        siteSamplingRate = 1;
+        siteSampleCountdown = 1;
 
         /* Codes_SRS_GBALLOC_01_024: [gballoc_init shall initialize the gballoc module and return 0 upon success.] */
         result = 0;
@@ -73,12 +191,13 @@ void gballoc_deinit(void)
     {
         /* Codes_SRS_GBALLOC_01_028: [gballoc_deinit shall free all resources allocated by gballoc_init.] */
         (void)Lock_Deinit(gballocThreadSafeLock);
+        free_sites();
     }
 
     gballocState = GBALLOC_STATE_NOT_INIT;
 }
 
-void* gballoc_malloc(size_t size)
+static void* malloc_at(size_t size, const char* file, int line)
 {
     void* result;
 
@@ -117,6 +236,7 @@ void* gballoc_malloc(size_t size)
                 allocation->size = size;
                 allocation->next = head;
                 head = allocation;
+                track_site(allocation, file, line);
 
                 g_allocations++;
                 totalSize += size;
@@ -134,7 +254,7 @@ void* gballoc_malloc(size_t size)
     return result;
 }
 
-void* gballoc_calloc(size_t nmemb, size_t size)
+static void* calloc_at(size_t nmemb, size_t size, const char* file, int line)
 {
     void* result;
 
@@ -173,6 +293,7 @@ void* gballoc_calloc(size_t nmemb, size_t size)
                 allocation->size = nmemb * size;
                 allocation->next = head;
                 head = allocation;
+                track_site(allocation, file, line);
                 g_allocations++;
 
                 totalSize += allocation->size;
@@ -190,7 +311,7 @@ void* gballoc_calloc(size_t nmemb, size_t size)
     return result;
 }
 
-void* gballoc_realloc(void* ptr, size_t size)
+static void* realloc_at(void* ptr, size_t size, const char* file, int line)
 {
     ALLOCATION* curr;
     void* result;
@@ -256,7 +377,9 @@ void* gballoc_realloc(void* ptr, size_t size)
                     /* Codes_SRS_GBALLOC_01_006: [If the underlying realloc call is successful, gballoc_realloc shall look up the size associated with the pointer ptr and decrease the total memory used with that size.] */
                     allocation->ptr = result;
                     totalSize -= allocation->size;
+                    untrack_site(allocation);
                     allocation->size = size;
+                    track_site(allocation, file, line);
                 }
                 else
                 {
@@ -265,6 +388,7 @@ void* gballoc_realloc(void* ptr, size_t size)
                     allocation->size = size;
                     allocation->next = head;
                     head = allocation;
+                    track_site(allocation, file, line);
                 }
 
                 /* Codes_SRS_GBALLOC_01_007: [If realloc is successful, gballoc_realloc shall also increment the total memory used value tracked by this module.] */
@@ -285,6 +409,36 @@ void* gballoc_realloc(void* ptr, size_t size)
     return result;
 }
 
+void* gballoc_malloc(size_t size)
+{
+    return malloc_at(size, NULL, 0);
+}
+
+void* gballoc_calloc(size_t nmemb, size_t size)
+{
+    return calloc_at(nmemb, size, NULL, 0);
+}
+
+void* gballoc_realloc(void* ptr, size_t size)
+{
+    return realloc_at(ptr, size, NULL, 0);
+}
+
+void* gballoc_malloc_at(size_t size, const char* file, int line)
+{
+    return malloc_at(size, file, line);
+}
+
+void* gballoc_calloc_at(size_t nmemb, size_t size, const char* file, int line)
+{
+    return calloc_at(nmemb, size, file, line);
+}
+
+void* gballoc_realloc_at(void* ptr, size_t size, const char* file, int line)
+{
+    return realloc_at(ptr, size, file, line);
+}
+
 void gballoc_free(void* ptr)
 {
     ALLOCATION* curr = head;
@@ -311,6 +465,7 @@ void gballoc_free(void* ptr)
                 /* Codes_SRS_GBALLOC_01_008: [gballoc_free shall call the C99 free function.] */
                 free(ptr);
                 totalSize -= curr->size;
+                untrack_site(curr);
                 if (prev != NULL)
                 {
                     prev->next = curr->next;
@@ -443,4 +598,296 @@ void gballoc_resetMetrics()
     }
 }
 
-#endif // GB_USE_CUSTOM_HEAP
+int gballoc_setSiteSamplingRate(size_t rate)
+{
+    int result;
+
+    /* Codes_SRS_GBALLOC_11_008: [ If gballoc was not initialized gballoc_setSiteSamplingRate shall fail and return a non-zero value. ]*/
+    if (gballocState != GBALLOC_STATE_INIT)
+    {
+        LogError("gballoc is not initialized.");
+        result = __FAILURE__;
+    }
+    else if (LOCK_OK != Lock(gballocThreadSafeLock))
+    {
+        LogError("Failed to get the Lock.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_11_009: [ gballoc_setSiteSamplingRate shall record 1 in every rate allocations from then on, and none if rate is 0. ]*/
+        siteSamplingRate = rate;
+        siteSampleCountdown = rate;
+        (void)Unlock(gballocThreadSafeLock);
+        result = 0;
+    }
+
+    return result;
+}
+
+/*pprof reads the profile.proto protocol buffer (https://github.com/google/pprof/blob/master/proto/profile.proto), these write the few bits of it that are needed*/
+#define PPROF_WIRE_VARINT 0
+#define PPROF_WIRE_LENGTH_DELIMITED 2
+
+#define PPROF_PROFILE_SAMPLE_TYPE 1
+#define PPROF_PROFILE_SAMPLE 2
+#define PPROF_PROFILE_LOCATION 4
+#define PPROF_PROFILE_FUNCTION 5
+#define PPROF_PROFILE_STRING_TABLE 6
+#define PPROF_PROFILE_PERIOD_TYPE 11
+#define PPROF_PROFILE_PERIOD 12
+
+/*the strings every profile starts with, the file and line of every site follow them*/
+static const char* const pprofStrings[] = { "", "alloc_objects", "count", "alloc_space", "bytes", "inuse_objects", "inuse_space" };
+#define PPROF_STRING_SITES 7
+
+#define PPROF_MESSAGE_SIZE_MAX 128
+
+typedef struct PPROF_MESSAGE_TAG
+{
+    unsigned char bytes[PPROF_MESSAGE_SIZE_MAX];
+    size_t size;
+} PPROF_MESSAGE;
+
+static void pprof_add_varint(PPROF_MESSAGE* message, uint64_t value)
+{
+    do
+    {
+        unsigned char byte = (unsigned char)(value & 0x7F);
+        value >>= 7;
+        message->bytes[message->size++] = (unsigned char)(byte | ((value != 0) ? 0x80 : 0));
+    } while (value != 0);
+}
+
+static void pprof_add_uint(PPROF_MESSAGE* message, int field, uint64_t value)
+{
+    pprof_add_varint(message, ((uint64_t)field << 3) | PPROF_WIRE_VARINT);
+    pprof_add_varint(message, value);
+}
+
+static void pprof_add_message(PPROF_MESSAGE* message, int field, const PPROF_MESSAGE* inner)
+{
+    pprof_add_varint(message, ((uint64_t)field << 3) | PPROF_WIRE_LENGTH_DELIMITED);
+    pprof_add_varint(message, inner->size);
+    (void)memcpy(message->bytes + message->size, inner->bytes, inner->size);
+    message->size += inner->size;
+}
+
+static int pprof_write_message(FILE* file, int field, const PPROF_MESSAGE* inner)
+{
+    PPROF_MESSAGE message;
+    message.size = 0;
+    pprof_add_message(&message, field, inner);
+    return (fwrite(message.bytes, 1, message.size, file) == message.size) ? 0 : __FAILURE__;
+}
+
+static int pprof_write_string(FILE* file, const char* value)
+{
+    PPROF_MESSAGE header;
+    size_t length = strlen(value);
+    header.size = 0;
+    pprof_add_varint(&header, ((uint64_t)PPROF_PROFILE_STRING_TABLE << 3) | PPROF_WIRE_LENGTH_DELIMITED);
+    pprof_add_varint(&header, length);
+    return ((fwrite(header.bytes, 1, header.size, file) == header.size) && (fwrite(value, 1, length, file) == length)) ? 0 : __FAILURE__;
+}
+
+static int pprof_write_value_type(FILE* file, int field, size_t type, size_t unit)
+{
+    PPROF_MESSAGE valueType;
+    valueType.size = 0;
+    pprof_add_uint(&valueType, 1, type);
+    pprof_add_uint(&valueType, 2, unit);
+    return pprof_write_message(file, field, &valueType);
+}
+
+static int write_pprof(FILE* file, GBALLOC_SITE** sites, size_t count)
+{
+    int result = 0;
+    size_t i;
+
+    /*sample types, in the order of the values of every sample*/
+    result |= pprof_write_value_type(file, PPROF_PROFILE_SAMPLE_TYPE, 1, 2);
+    result |= pprof_write_value_type(file, PPROF_PROFILE_SAMPLE_TYPE, 3, 4);
+    result |= pprof_write_value_type(file, PPROF_PROFILE_SAMPLE_TYPE, 5, 2);
+    result |= pprof_write_value_type(file, PPROF_PROFILE_SAMPLE_TYPE, 6, 4);
+
+    for (i = 0; (i < count) && (result == 0); i++)
+    {
+        /*site i has the id i + 1 for its function, location and sample, its name is string PPROF_STRING_SITES + 2 * i and its file the one after*/
+        PPROF_MESSAGE sample;
+        PPROF_MESSAGE location;
+        PPROF_MESSAGE line;
+        PPROF_MESSAGE function;
+
+        sample.size = 0;
+        pprof_add_uint(&sample, 1, i + 1);
+        pprof_add_uint(&sample, 2, sites[i]->allocationCount);
+        pprof_add_uint(&sample, 2, sites[i]->allocationBytes);
+        pprof_add_uint(&sample, 2, sites[i]->liveCount);
+        pprof_add_uint(&sample, 2, sites[i]->liveBytes);
+
+        line.size = 0;
+        pprof_add_uint(&line, 1, i + 1);
+        pprof_add_uint(&line, 2, (uint64_t)sites[i]->line);
+        location.size = 0;
+        pprof_add_uint(&location, 1, i + 1);
+        pprof_add_message(&location, 4, &line);
+
+        function.size = 0;
+        pprof_add_uint(&function, 1, i + 1);
+        pprof_add_uint(&function, 2, PPROF_STRING_SITES + 2 * i);
+        pprof_add_uint(&function, 3, PPROF_STRING_SITES + 2 * i);
+        pprof_add_uint(&function, 4, PPROF_STRING_SITES + 2 * i + 1);
+
+        result |= pprof_write_message(file, PPROF_PROFILE_SAMPLE, &sample);
+        result |= pprof_write_message(file, PPROF_PROFILE_LOCATION, &location);
+        result |= pprof_write_message(file, PPROF_PROFILE_FUNCTION, &function);
+    }
+
+    for (i = 0; (i < sizeof(pprofStrings) / sizeof(pprofStrings[0])) && (result == 0); i++)
+    {
+        result |= pprof_write_string(file, pprofStrings[i]);
+    }
+
+    for (i = 0; (i < count) && (result == 0); i++)
+    {
+        /*the end of the file name tells the most*/
+        char name[64];
+        size_t fileLength = strlen(sites[i]->file);
+        (void)snprintf(name, sizeof(name), "%s:%d", sites[i]->file + ((fileLength > 48) ? fileLength - 48 : 0), sites[i]->line);
+        result |= pprof_write_string(file, name);
+        result |= pprof_write_string(file, sites[i]->file);
+    }
+
+    if (result == 0)
+    {
+        PPROF_MESSAGE period;
+        period.size = 0;
+        pprof_add_uint(&period, PPROF_PROFILE_PERIOD, (siteSamplingRate == 0) ? 1 : siteSamplingRate);
+        result |= pprof_write_value_type(file, PPROF_PROFILE_PERIOD_TYPE, 1, 2);
+        result |= (fwrite(period.bytes, 1, period.size, file) == period.size) ? 0 : __FAILURE__;
+    }
+
+    return result;
+}
+
+static int write_report(FILE* file, GBALLOC_SITE** sites, size_t count)
+{
+    int result = 0;
+    size_t i;
+
+    if (fprintf(file, "%12s %10s %14s %12s  %s\n", "live bytes", "live", "total bytes", "total", "site") < 0)
+    {
+        result = __FAILURE__;
+    }
+
+    for (i = 0; (i < count) && (result == 0); i++)
+    {
+        if (fprintf(file, "%12lu %10lu %14lu %12lu  %s:%d\n",
+            (unsigned long)sites[i]->liveBytes, (unsigned long)sites[i]->liveCount,
+            (unsigned long)sites[i]->allocationBytes, (unsigned long)sites[i]->allocationCount,
+            sites[i]->file, sites[i]->line) < 0)
+        {
+            result = __FAILURE__;
+        }
+    }
+
+    return result;
+}
+
+static int compare_sites(const void* left, const void* right)
+{
+    const GBALLOC_SITE* leftSite = *(const GBALLOC_SITE* const*)left;
+    const GBALLOC_SITE* rightSite = *(const GBALLOC_SITE* const*)right;
+    int result;
+
+    if (leftSite->liveBytes != rightSite->liveBytes)
+    {
+        result = (leftSite->liveBytes > rightSite->liveBytes) ? -1 : 1;
+    }
+    else if (leftSite->allocationBytes != rightSite->allocationBytes)
+    {
+        result = (leftSite->allocationBytes > rightSite->allocationBytes) ? -1 : 1;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+int gballoc_dumpSites(const char* fileName, GBALLOC_DUMP_FORMAT format)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_GBALLOC_11_010: [ If fileName is NULL or format is not GBALLOC_DUMP_TEXT or GBALLOC_DUMP_PPROF, gballoc_dumpSites shall fail and return a non-zero value. ]*/
+        (fileName == NULL) ||
+        ((format != GBALLOC_DUMP_TEXT) && (format != GBALLOC_DUMP_PPROF))
+        )
+    {
+        LogError("Invalid arguments: const char* fileName=%p, GBALLOC_DUMP_FORMAT format=%d", fileName, (int)format);
+        result = __FAILURE__;
+    }
+    /* Codes_SRS_GBALLOC_11_011: [ If gballoc was not initialized gballoc_dumpSites shall fail and return a non-zero value. ]*/
+    else if (gballocState != GBALLOC_STATE_INIT)
+    {
+        LogError("gballoc is not initialized.");
+        result = __FAILURE__;
+    }
+    else if (LOCK_OK != Lock(gballocThreadSafeLock))
+    {
+        LogError("Failed to get the Lock.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        GBALLOC_SITE** sites = (GBALLOC_SITE**)malloc((siteCount + 1) * sizeof(GBALLOC_SITE*));
+        FILE* file;
+        if (sites == NULL)
+        {
+            /* Codes_SRS_GBALLOC_11_014: [ If any error occurs, gballoc_dumpSites shall fail and return a non-zero value. ]*/
+            LogError("failure allocating the site list");
+            result = __FAILURE__;
+        }
+        else if ((file = fopen(fileName, (format == GBALLOC_DUMP_PPROF) ? "wb" : "w")) == NULL)
+        {
+            LogError("failure opening %s", fileName);
+            result = __FAILURE__;
+            free(sites);
+        }
+        else
+        {
+            size_t count = 0;
+            size_t i;
+            for (i = 0; i < GBALLOC_SITE_BUCKET_COUNT; i++)
+            {
+                GBALLOC_SITE* site;
+                for (site = siteBuckets[i]; site != NULL; site = site->next)
+                {
+                    sites[count++] = site;
+                }
+            }
+
+            /* Codes_SRS_GBALLOC_11_012: [ With GBALLOC_DUMP_TEXT, gballoc_dumpSites shall write to fileName one line per file and line with its live bytes, live count, bytes and count, sorted by live bytes and then by bytes, biggest first. ]*/
+            /* Codes_SRS_GBALLOC_11_013: [ With GBALLOC_DUMP_PPROF, gballoc_dumpSites shall write to fileName a pprof profile with the alloc_objects, alloc_space, inuse_objects and inuse_space of every file and line. ]*/
+            qsort(sites, count, sizeof(GBALLOC_SITE*), compare_sites);
+            result = (format == GBALLOC_DUMP_PPROF) ? write_pprof(file, sites, count) : write_report(file, sites, count);
+            if (fclose(file) != 0)
+            {
+                result = __FAILURE__;
+            }
+            if (result != 0)
+            {
+                LogError("failure writing %s", fileName);
+            }
+            free(sites);
+        }
+        (void)Unlock(gballocThreadSafeLock);
+    }
+
+    return result;
+}
+
+#endif // !defined(GB_USE_CUSTOM_HEAP) && !defined(GB_SHARDED_TRACKING)
@@ -0,0 +1,544 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*
+Size class pool heap, an implementation of the gballoc_malloc family for GB_USE_CUSTOM_HEAP builds.
+
+Blocks up to GBALLOC_POOL_MAX_SMALL_SIZE bytes are rounded up to a size class and carved out of
+slabs. Every thread keeps a short free list per size class, so most gballoc_malloc/gballoc_free
+calls do not touch any shared state. Thread caches that grow too long give a batch of blocks back
+to a global free list per size class, and empty thread caches refill from it (or from a new slab).
+Slabs are never given back to the system. Bigger blocks go straight to malloc.
+
+This file does not include gballoc.h, because with GB_USE_CUSTOM_HEAP that header turns malloc into
+gballoc_malloc.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+
+#if defined(GB_USE_CUSTOM_HEAP) && defined(GB_USE_POOL_HEAP)
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+#if defined(_WIN32)
+#include "windows.h"
+#define GBALLOC_POOL_TRY_LOCK(lock) (InterlockedExchange(&(lock), 1) == 0)
+#define GBALLOC_POOL_UNLOCK(lock) ((void)InterlockedExchange(&(lock), 0))
+#define GBALLOC_POOL_YIELD() ((void)SwitchToThread())
+typedef volatile LONG GBALLOC_POOL_SPINLOCK;
+#elif defined(__GNUC__)
+#include <sched.h>
+#include <pthread.h>
+#define GBALLOC_POOL_TRY_LOCK(lock) (__sync_lock_test_and_set(&(lock), 1) == 0)
+#define GBALLOC_POOL_UNLOCK(lock) __sync_lock_release(&(lock))
+#define GBALLOC_POOL_YIELD() ((void)sched_yield())
+typedef volatile int GBALLOC_POOL_SPINLOCK;
+#else
+/*no atomic operations known for this compiler, same as REFCOUNT_ATOMIC_DONTCARE: only good for single threaded devices*/
+#define GBALLOC_POOL_TRY_LOCK(lock) (((lock) == 0) ? ((lock) = 1, 1) : 0)
+#define GBALLOC_POOL_UNLOCK(lock) ((void)((lock) = 0))
+#define GBALLOC_POOL_YIELD() ((void)0)
+typedef volatile int GBALLOC_POOL_SPINLOCK;
+#endif
+
+#if defined(_MSC_VER)
+#define GBALLOC_POOL_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define GBALLOC_POOL_THREAD_LOCAL __thread
+#endif
+
+#define GBALLOC_POOL_MAX_SMALL_SIZE 1024
+#define GBALLOC_POOL_CLASS_COUNT 14
+#define GBALLOC_POOL_LARGE_CLASS GBALLOC_POOL_CLASS_COUNT
+#define GBALLOC_POOL_SLAB_SIZE 65536
+/*number of blocks moved at once between a thread cache and the global free list*/
+#define GBALLOC_POOL_BATCH_SIZE 32
+/*a thread cache gives a batch back once it holds more than this many blocks of a size class*/
+#define GBALLOC_POOL_CACHE_MAX (4 * GBALLOC_POOL_BATCH_SIZE)
+
+/*the library allocates mostly small fixed size structures (BUFFER, STRING, LIST_ITEM_INSTANCE, CONSTBUFFER_HANDLE_DATA, ...),
+so the classes are 16 bytes apart up to 128 and then grow by half*/
+static const size_t size_classes[GBALLOC_POOL_CLASS_COUNT] = { 16, 32, 48, 64, 80, 96, 112, 128, 192, 256, 384, 512, 768, 1024 };
+
+/*the header sits in front of every block handed out, the union keeps the block aligned like malloc does*/
+typedef union GBALLOC_POOL_HEADER_TAG
+{
+    struct
+    {
+        size_t sizeClass; /*GBALLOC_POOL_LARGE_CLASS for blocks that come straight from malloc*/
+        size_t size; /*the size the block was asked for*/
+    } block;
+    long double alignment1;
+    void* alignment2;
+    long long alignment3;
+} GBALLOC_POOL_HEADER;
+
+/*free blocks are linked through the memory that follows their header*/
+typedef struct GBALLOC_POOL_FREE_BLOCK_TAG
+{
+    struct GBALLOC_POOL_FREE_BLOCK_TAG* next;
+} GBALLOC_POOL_FREE_BLOCK;
+
+typedef struct GBALLOC_POOL_FREE_LIST_TAG
+{
+    GBALLOC_POOL_FREE_BLOCK* head;
+    size_t count;
+} GBALLOC_POOL_FREE_LIST;
+
+typedef struct GBALLOC_POOL_THREAD_CACHE_TAG
+{
+    GBALLOC_POOL_FREE_LIST lists[GBALLOC_POOL_CLASS_COUNT];
+} GBALLOC_POOL_THREAD_CACHE;
+
+typedef struct GBALLOC_POOL_CENTRAL_LIST_TAG
+{
+    GBALLOC_POOL_SPINLOCK lock;
+    GBALLOC_POOL_FREE_LIST list;
+} GBALLOC_POOL_CENTRAL_LIST;
+
+static GBALLOC_POOL_CENTRAL_LIST central_lists[GBALLOC_POOL_CLASS_COUNT];
+
+static void central_lock(GBALLOC_POOL_CENTRAL_LIST* central)
+{
+    while (!GBALLOC_POOL_TRY_LOCK(central->lock))
+    {
+        GBALLOC_POOL_YIELD();
+    }
+}
+
+static void central_unlock(GBALLOC_POOL_CENTRAL_LIST* central)
+{
+    GBALLOC_POOL_UNLOCK(central->lock);
+}
+
+static size_t get_size_class(size_t size)
+{
+    size_t result;
+    if (size <= 128)
+    {
+        result = (size == 0) ? 0 : (size - 1) / 16;
+    }
+    else
+    {
+        result = 8;
+        while ((result < GBALLOC_POOL_CLASS_COUNT) && (size_classes[result] < size))
+        {
+            result++;
+        }
+    }
+    return result;
+}
+
+static GBALLOC_POOL_FREE_BLOCK* block_from_header(GBALLOC_POOL_HEADER* header)
+{
+    return (GBALLOC_POOL_FREE_BLOCK*)(header + 1);
+}
+
+static GBALLOC_POOL_HEADER* header_from_block(void* block)
+{
+    return (GBALLOC_POOL_HEADER*)block - 1;
+}
+
+/*moves up to count blocks from the front of source to the front of destination*/
+static void move_blocks(GBALLOC_POOL_FREE_LIST* destination, GBALLOC_POOL_FREE_LIST* source, size_t count)
+{
+    while ((count > 0) && (source->head != NULL))
+    {
+        GBALLOC_POOL_FREE_BLOCK* block = source->head;
+        source->head = block->next;
+        source->count--;
+        block->next = destination->head;
+        destination->head = block;
+        destination->count++;
+        count--;
+    }
+}
+
+/*carves a new slab in blocks of the size class and puts them all in list, returns 0 on success*/
+static int carve_slab(GBALLOC_POOL_FREE_LIST* list, size_t sizeClass)
+{
+    int result;
+    size_t blockSize = sizeof(GBALLOC_POOL_HEADER) + size_classes[sizeClass];
+    size_t blockCount = GBALLOC_POOL_SLAB_SIZE / blockSize;
+    unsigned char* slab = (unsigned char*)malloc(blockCount * blockSize);
+    if (slab == NULL)
+    {
+        LogError("failure allocating a slab for size class %lu", (unsigned long)size_classes[sizeClass]);
+        result = __FAILURE__;
+    }
+    else
+    {
+        size_t i;
+        for (i = blockCount; i > 0; i--)
+        {
+            GBALLOC_POOL_HEADER* header = (GBALLOC_POOL_HEADER*)(slab + (i - 1) * blockSize);
+            GBALLOC_POOL_FREE_BLOCK* block = block_from_header(header);
+            header->block.sizeClass = sizeClass;
+            block->next = list->head;
+            list->head = block;
+            list->count++;
+        }
+        result = 0;
+    }
+    return result;
+}
+
+/*fills an empty thread cache list with a batch from the central list, carving a new slab if the central list is empty*/
+static int refill(GBALLOC_POOL_FREE_LIST* list, size_t sizeClass)
+{
+    int result;
+    GBALLOC_POOL_CENTRAL_LIST* central = &central_lists[sizeClass];
+
+    /* Codes_SRS_GBALLOC_POOL_11_002: [ When the free list of the calling thread is empty, gballoc_malloc shall move a batch of blocks from the global free list of the size class to it, and if that is empty too, carve a new 64KB slab. ]*/
+    /* Codes_SRS_GBALLOC_POOL_11_003: [ If allocating the slab fails, gballoc_malloc shall fail and return NULL. ]*/
+    central_lock(central);
+    if ((central->list.head == NULL) && (carve_slab(&central->list, sizeClass) != 0))
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        move_blocks(list, &central->list, GBALLOC_POOL_BATCH_SIZE);
+        result = 0;
+    }
+    central_unlock(central);
+
+    return result;
+}
+
+static void release(GBALLOC_POOL_FREE_LIST* list, size_t sizeClass, size_t count)
+{
+    GBALLOC_POOL_CENTRAL_LIST* central = &central_lists[sizeClass];
+    central_lock(central);
+    move_blocks(&central->list, list, count);
+    central_unlock(central);
+}
+
+#ifdef GBALLOC_POOL_THREAD_LOCAL
+static GBALLOC_POOL_THREAD_LOCAL GBALLOC_POOL_THREAD_CACHE* thread_cache = NULL;
+
+/* Codes_SRS_GBALLOC_POOL_11_014: [ When a thread exits, the blocks on its free lists shall be moved to the global free lists. ]*/
+static void destroy_thread_cache(GBALLOC_POOL_THREAD_CACHE* cache)
+{
+    size_t i;
+    for (i = 0; i < GBALLOC_POOL_CLASS_COUNT; i++)
+    {
+        release(&cache->lists[i], i, cache->lists[i].count);
+    }
+    free(cache);
+}
+
+#if defined(_WIN32)
+static volatile LONG cache_key_state = 0; /*0 - not created, 1 - being created, 2 - created*/
+static DWORD cache_key = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI on_thread_exit(PVOID value)
+{
+    if (value != NULL)
+    {
+        thread_cache = NULL;
+        destroy_thread_cache((GBALLOC_POOL_THREAD_CACHE*)value);
+    }
+}
+
+static int register_thread_cache(GBALLOC_POOL_THREAD_CACHE* cache)
+{
+    int result;
+    if (InterlockedCompareExchange(&cache_key_state, 1, 0) == 0)
+    {
+        cache_key = FlsAlloc(on_thread_exit);
+        (void)InterlockedExchange(&cache_key_state, 2);
+    }
+    while (cache_key_state != 2)
+    {
+        GBALLOC_POOL_YIELD();
+    }
+
+    if ((cache_key == FLS_OUT_OF_INDEXES) || !FlsSetValue(cache_key, cache))
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+#elif defined(__GNUC__)
+static pthread_once_t cache_key_once = PTHREAD_ONCE_INIT;
+static int cache_key_result = -1;
+static pthread_key_t cache_key;
+
+static void on_thread_exit(void* value)
+{
+    thread_cache = NULL;
+    destroy_thread_cache((GBALLOC_POOL_THREAD_CACHE*)value);
+}
+
+static void create_cache_key(void)
+{
+    cache_key_result = pthread_key_create(&cache_key, on_thread_exit);
+}
+
+static int register_thread_cache(GBALLOC_POOL_THREAD_CACHE* cache)
+{
+    int result;
+    if ((pthread_once(&cache_key_once, create_cache_key) != 0) ||
+        (cache_key_result != 0) ||
+        (pthread_setspecific(cache_key, cache) != 0))
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+#else
+static int register_thread_cache(GBALLOC_POOL_THREAD_CACHE* cache)
+{
+    /*no way of knowing when the thread exits, the blocks in its cache stay there*/
+    (void)cache;
+    return 0;
+}
+#endif
+
+/*returns NULL when the thread cache cannot be created, in which case the central lists are used directly*/
+static GBALLOC_POOL_THREAD_CACHE* get_thread_cache(void)
+{
+    GBALLOC_POOL_THREAD_CACHE* result = thread_cache;
+    if (result == NULL)
+    {
+        result = (GBALLOC_POOL_THREAD_CACHE*)calloc(1, sizeof(GBALLOC_POOL_THREAD_CACHE));
+        if (result == NULL)
+        {
+            LogError("failure allocating the thread cache");
+        }
+        else if (register_thread_cache(result) != 0)
+        {
+            LogError("failure registering the thread cache");
+            free(result);
+            result = NULL;
+        }
+        else
+        {
+            thread_cache = result;
+        }
+    }
+    return result;
+}
+#else
+static GBALLOC_POOL_THREAD_CACHE* get_thread_cache(void)
+{
+    return NULL;
+}
+#endif
+
+static void* allocate_small(size_t sizeClass)
+{
+    GBALLOC_POOL_FREE_BLOCK* result;
+    GBALLOC_POOL_THREAD_CACHE* cache = get_thread_cache();
+    if (cache == NULL)
+    {
+        GBALLOC_POOL_CENTRAL_LIST* central = &central_lists[sizeClass];
+        central_lock(central);
+        if ((central->list.head == NULL) && (carve_slab(&central->list, sizeClass) != 0))
+        {
+            result = NULL;
+        }
+        else
+        {
+            result = central->list.head;
+            central->list.head = result->next;
+            central->list.count--;
+        }
+        central_unlock(central);
+    }
+    else
+    {
+        GBALLOC_POOL_FREE_LIST* list = &cache->lists[sizeClass];
+        if ((list->head == NULL) && (refill(list, sizeClass) != 0))
+        {
+            result = NULL;
+        }
+        else
+        {
+            result = list->head;
+            list->head = result->next;
+            list->count--;
+        }
+    }
+    return result;
+}
+
+static void free_small(GBALLOC_POOL_FREE_BLOCK* block, size_t sizeClass)
+{
+    GBALLOC_POOL_THREAD_CACHE* cache = get_thread_cache();
+    GBALLOC_POOL_FREE_LIST* list;
+    if (cache == NULL)
+    {
+        GBALLOC_POOL_CENTRAL_LIST* central = &central_lists[sizeClass];
+        central_lock(central);
+        block->next = central->list.head;
+        central->list.head = block;
+        central->list.count++;
+        central_unlock(central);
+    }
+    else
+    {
+        /*blocks freed by another thread than the one that allocated them simply move to this thread's cache*/
+        list = &cache->lists[sizeClass];
+        block->next = list->head;
+        list->head = block;
+        list->count++;
+        /* Codes_SRS_GBALLOC_POOL_11_013: [ gballoc_free shall put small blocks on the free list of the calling thread and move a batch of them to the global free list when it holds more than 128 blocks. ]*/
+        if (list->count > GBALLOC_POOL_CACHE_MAX)
+        {
+            release(list, sizeClass, GBALLOC_POOL_BATCH_SIZE);
+        }
+    }
+}
+
+void* gballoc_malloc(size_t size)
+{
+    void* result;
+    if (size <= GBALLOC_POOL_MAX_SMALL_SIZE)
+    {
+        /* Codes_SRS_GBALLOC_POOL_11_001: [ gballoc_malloc shall round a size of up to 1024 bytes up to its size class and take a block of that class from the free list of the calling thread. ]*/
+        size_t sizeClass = get_size_class(size);
+        GBALLOC_POOL_FREE_BLOCK* block = (GBALLOC_POOL_FREE_BLOCK*)allocate_small(sizeClass);
+        if (block == NULL)
+        {
+            result = NULL;
+        }
+        else
+        {
+            header_from_block(block)->block.size = size;
+            result = block;
+        }
+    }
+    else if (size > SIZE_MAX - sizeof(GBALLOC_POOL_HEADER))
+    {
+        LogError("size too big: %lu", (unsigned long)size);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_POOL_11_004: [ gballoc_malloc shall allocate blocks bigger than 1024 bytes with malloc and return NULL if malloc fails. ]*/
+        GBALLOC_POOL_HEADER* header = (GBALLOC_POOL_HEADER*)malloc(sizeof(GBALLOC_POOL_HEADER) + size);
+        if (header == NULL)
+        {
+            result = NULL;
+        }
+        else
+        {
+            header->block.sizeClass = GBALLOC_POOL_LARGE_CLASS;
+            header->block.size = size;
+            result = header + 1;
+        }
+    }
+    return result;
+}
+
+void gballoc_free(void* ptr)
+{
+    /* Codes_SRS_GBALLOC_POOL_11_011: [ If ptr is NULL, gballoc_free shall do nothing. ]*/
+    if (ptr != NULL)
+    {
+        GBALLOC_POOL_HEADER* header = header_from_block(ptr);
+        if (header->block.sizeClass == GBALLOC_POOL_LARGE_CLASS)
+        {
+            /* Codes_SRS_GBALLOC_POOL_11_012: [ gballoc_free shall give blocks bigger than 1024 bytes back with free. ]*/
+            free(header);
+        }
+        else
+        {
+            free_small((GBALLOC_POOL_FREE_BLOCK*)ptr, header->block.sizeClass);
+        }
+    }
+}
+
+void* gballoc_calloc(size_t nmemb, size_t size)
+{
+    void* result;
+    if ((size != 0) && (nmemb > SIZE_MAX / size))
+    {
+        /* Codes_SRS_GBALLOC_POOL_11_005: [ If nmemb * size overflows, gballoc_calloc shall fail and return NULL. ]*/
+        LogError("size too big: %lu * %lu", (unsigned long)nmemb, (unsigned long)size);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_POOL_11_006: [ Otherwise gballoc_calloc shall allocate nmemb * size bytes like gballoc_malloc and set them to 0. ]*/
+        result = gballoc_malloc(nmemb * size);
+        if (result != NULL)
+        {
+            (void)memset(result, 0, nmemb * size);
+        }
+    }
+    return result;
+}
+
+void* gballoc_realloc(void* ptr, size_t size)
+{
+    void* result;
+    if (ptr == NULL)
+    {
+        /* Codes_SRS_GBALLOC_POOL_11_007: [ If ptr is NULL, gballoc_realloc shall behave like gballoc_malloc. ]*/
+        result = gballoc_malloc(size);
+    }
+    else
+    {
+        GBALLOC_POOL_HEADER* header = header_from_block(ptr);
+        size_t sizeClass = header->block.sizeClass;
+        if ((sizeClass != GBALLOC_POOL_LARGE_CLASS) && (size <= size_classes[sizeClass]))
+        {
+            /* Codes_SRS_GBALLOC_POOL_11_008: [ If the new size still fits the size class of ptr, gballoc_realloc shall return ptr. ]*/
+            header->block.size = size;
+            result = ptr;
+        }
+        else if ((sizeClass == GBALLOC_POOL_LARGE_CLASS) && (size > GBALLOC_POOL_MAX_SMALL_SIZE))
+        {
+            if (size > SIZE_MAX - sizeof(GBALLOC_POOL_HEADER))
+            {
+                LogError("size too big: %lu", (unsigned long)size);
+                result = NULL;
+            }
+            else
+            {
+                GBALLOC_POOL_HEADER* newHeader = (GBALLOC_POOL_HEADER*)realloc(header, sizeof(GBALLOC_POOL_HEADER) + size);
+                if (newHeader == NULL)
+                {
+                    result = NULL;
+                }
+                else
+                {
+                    newHeader->block.size = size;
+                    result = newHeader + 1;
+                }
+            }
+        }
+        else
+        {
+            /* Codes_SRS_GBALLOC_POOL_11_009: [ Otherwise gballoc_realloc shall allocate a new block, copy the contents of ptr to it, free ptr and return the new block. ]*/
+            /* Codes_SRS_GBALLOC_POOL_11_010: [ If allocating the new block fails, gballoc_realloc shall return NULL and leave ptr untouched. ]*/
+            result = gballoc_malloc(size);
+            if (result != NULL)
+            {
+                (void)memcpy(result, ptr, (header->block.size < size) ? header->block.size : size);
+                gballoc_free(ptr);
+            }
+        }
+    }
+    return result;
+}
+
+#endif /* defined(GB_USE_CUSTOM_HEAP) && defined(GB_USE_POOL_HEAP) */
@@ -0,0 +1,450 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*
+gballoc with GB_SHARDED_TRACKING: instead of keeping every allocation in a list protected by a lock,
+each block carries a small header with its size and the counters are split in shards that threads
+update independently. The shards are only added up when somebody asks for the metrics.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+
+#if defined(GB_SHARDED_TRACKING) && !defined(GB_USE_CUSTOM_HEAP)
+
+/*gballoc.h declares the functions implemented here, but its malloc redirection must not apply to this file*/
+#undef GB_MEASURE_MEMORY_FOR_THIS
+#ifndef GB_DEBUG_ALLOC
+#define GB_DEBUG_ALLOC
+#endif
+#include "azure_c_shared_utility/gballoc.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+#if defined(_WIN32)
+#include "windows.h"
+#ifdef _WIN64
+#define GBALLOC_ATOMIC_ADD(var, value) ((void)InterlockedExchangeAdd64((volatile LONG64*)&(var), (LONG64)(value)))
+#define GBALLOC_ATOMIC_CAS(var, expected, desired) (InterlockedCompareExchange64((volatile LONG64*)&(var), (LONG64)(desired), (LONG64)(expected)) == (LONG64)(expected))
+#else
+#define GBALLOC_ATOMIC_ADD(var, value) ((void)InterlockedExchangeAdd((volatile LONG*)&(var), (LONG)(value)))
+#define GBALLOC_ATOMIC_CAS(var, expected, desired) (InterlockedCompareExchange((volatile LONG*)&(var), (LONG)(desired), (LONG)(expected)) == (LONG)(expected))
+#endif
+#elif defined(__GNUC__)
+#define GBALLOC_ATOMIC_ADD(var, value) ((void)__sync_fetch_and_add(&(var), (value)))
+#define GBALLOC_ATOMIC_CAS(var, expected, desired) __sync_bool_compare_and_swap(&(var), (expected), (desired))
+#else
+/*no atomic operations known for this compiler, same as REFCOUNT_ATOMIC_DONTCARE: only good for single threaded devices*/
+#define GBALLOC_ATOMIC_ADD(var, value) ((void)((var) += (value)))
+#define GBALLOC_ATOMIC_CAS(var, expected, desired) (((var) == (expected)) ? ((var) = (desired), 1) : 0)
+#endif
+
+#if defined(_MSC_VER)
+#define GBALLOC_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define GBALLOC_THREAD_LOCAL __thread
+#endif
+
+/*number of counter shards, a power of 2. Threads are spread over the shards round robin*/
+#define GBALLOC_SHARD_COUNT 64
+/*a shard moves its bytes to the global total once they exceed this (in either direction)*/
+#define GBALLOC_SHARD_FLUSH_BYTES 16384
+#define GBALLOC_CACHE_LINE_SIZE 64
+
+/*the header sits in front of every block handed out, the union keeps the block aligned like malloc does*/
+typedef union GBALLOC_HEADER_TAG
+{
+    struct
+    {
+        size_t size;
+        intptr_t generation; /*the metrics generation the block was counted in, 0 if it was not counted*/
+    } block;
+    long double alignment1;
+    void* alignment2;
+    long long alignment3;
+} GBALLOC_HEADER;
+
+typedef struct GBALLOC_SHARD_TAG
+{
+    volatile intptr_t bytes; /*bytes allocated (or freed when negative) through this shard and not yet added to totalSize*/
+    volatile intptr_t allocations;
+    unsigned char padding[GBALLOC_CACHE_LINE_SIZE - 2 * sizeof(intptr_t)];
+} GBALLOC_SHARD;
+
+typedef struct GBALLOC_GLOBAL_COUNTER_TAG
+{
+    volatile intptr_t value;
+    unsigned char padding[GBALLOC_CACHE_LINE_SIZE - sizeof(intptr_t)];
+} GBALLOC_GLOBAL_COUNTER;
+
+static GBALLOC_SHARD shards[GBALLOC_SHARD_COUNT];
+static GBALLOC_GLOBAL_COUNTER totalSize;
+static GBALLOC_GLOBAL_COUNTER maxSize;
+static GBALLOC_GLOBAL_COUNTER nextShard;
+/*0 while gballoc is not initialized, changes with every gballoc_init and gballoc_resetMetrics*/
+static volatile intptr_t currentGeneration = 0;
+static intptr_t lastGeneration = 0;
+
+#ifdef GBALLOC_THREAD_LOCAL
+static GBALLOC_THREAD_LOCAL size_t threadShard = 0; /*1 + the shard of this thread, 0 until the thread allocates*/
+#endif
+
+static GBALLOC_SHARD* get_shard(void)
+{
+#ifdef GBALLOC_THREAD_LOCAL
+    if (threadShard == 0)
+    {
+        GBALLOC_ATOMIC_ADD(nextShard.value, 1);
+        threadShard = 1 + ((size_t)nextShard.value & (GBALLOC_SHARD_COUNT - 1));
+    }
+    return &shards[threadShard - 1];
+#else
+    return &shards[0];
+#endif
+}
+
+static void reset_counters(void)
+{
+    size_t i;
+    for (i = 0; i < GBALLOC_SHARD_COUNT; i++)
+    {
+        shards[i].bytes = 0;
+        shards[i].allocations = 0;
+    }
+    totalSize.value = 0;
+    maxSize.value = 0;
+}
+
+/*adds "bytes" (which can be negative) to the current memory used and keeps track of the maximum*/
+static void count_bytes(intptr_t bytes, intptr_t allocations)
+{
+    GBALLOC_SHARD* shard = get_shard();
+    intptr_t shardBytes;
+    intptr_t total;
+    intptr_t maximum;
+
+    GBALLOC_ATOMIC_ADD(shard->bytes, bytes);
+    GBALLOC_ATOMIC_ADD(shard->allocations, allocations);
+
+    shardBytes = shard->bytes;
+    if ((shardBytes > GBALLOC_SHARD_FLUSH_BYTES) || (shardBytes < -GBALLOC_SHARD_FLUSH_BYTES))
+    {
+        GBALLOC_ATOMIC_ADD(shard->bytes, -shardBytes);
+        GBALLOC_ATOMIC_ADD(totalSize.value, shardBytes);
+        shardBytes = 0;
+    }
+
+    /*Codes_SRS_GBALLOC_01_011: [The maximum total memory used shall be the maximum of the total memory used at any point.] */
+    /*the bytes still sitting in the other shards are not seen here, so with many threads the maximum can be short by up to GBALLOC_SHARD_FLUSH_BYTES per shard*/
+    total = totalSize.value + shardBytes;
+    maximum = maxSize.value;
+    while ((total > maximum) && !GBALLOC_ATOMIC_CAS(maxSize.value, maximum, total))
+    {
+        maximum = maxSize.value;
+    }
+}
+
+static void* track_block(GBALLOC_HEADER* header, size_t size)
+{
+    void* result;
+    if (header == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        intptr_t generation = currentGeneration;
+        header->block.size = size;
+        header->block.generation = generation;
+        if (generation != 0)
+        {
+            count_bytes((intptr_t)size, 1);
+        }
+        result = header + 1;
+    }
+    return result;
+}
+
+static size_t total_block_size(size_t size)
+{
+    /*Codes_SRS_GBALLOC_11_002: [ If size is too big to fit the size header, gballoc_malloc, gballoc_calloc and gballoc_realloc shall fail and return NULL. ]*/
+    return (size > SIZE_MAX - sizeof(GBALLOC_HEADER)) ? 0 : size + sizeof(GBALLOC_HEADER);
+}
+
+int gballoc_init(void)
+{
+    int result;
+
+    if (currentGeneration != 0)
+    {
+        /* Codes_SRS_GBALLOC_01_025: [Init after Init shall fail and return a non-zero value.] */
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_ SRS_GBALLOC_01_002: [Upon initialization the total memory used and maximum total memory used tracked by the module shall be set to 0.] */
+        reset_counters();
+
+        /* Codes_SRS_GBALLOC_11_001: [ With GB_SHARDED_TRACKING, gballoc shall not create a lock; every block shall carry a header with its size and the counters shall be kept in shards that are added up when the metrics are read. ]*/
+        currentGeneration = ++lastGeneration;
+
+        /* Codes_SRS_GBALLOC_01_024: [gballoc_init shall initialize the gballoc module and return 0 upon success.] */
+        result = 0;
+    }
+
+    return result;
+}
+
+void gballoc_deinit(void)
+{
+    /* Codes_SRS_GBALLOC_01_029: [if gballoc is not initialized gballoc_deinit shall do nothing.] */
+    currentGeneration = 0;
+}
+
+void* gballoc_malloc(size_t size)
+{
+    void* result;
+    size_t blockSize = total_block_size(size);
+    if (blockSize == 0)
+    {
+        LogError("size too big: %lu", (unsigned long)size);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_01_003: [gb_malloc shall call the C99 malloc function and return its result.] */
+        /* Codes_SRS_GBALLOC_01_012: [When the underlying malloc call fails, gballoc_malloc shall return NULL and size should not be counted towards total memory used.] */
+        /* Codes_SRS_GBALLOC_01_004: [If the underlying malloc call is successful, gb_malloc shall increment the total memory used with the amount indicated by size.] */
+        /* Codes_SRS_GBALLOC_01_039: [If gballoc was not initialized gballoc_malloc shall simply call malloc without any memory tracking being performed.] */
+        result = track_block((GBALLOC_HEADER*)malloc(blockSize), size);
+    }
+    return result;
+}
+
+void* gballoc_calloc(size_t nmemb, size_t size)
+{
+    void* result;
+    size_t blockSize;
+    if ((size != 0) && (nmemb > SIZE_MAX / size))
+    {
+        LogError("size too big: %lu * %lu", (unsigned long)nmemb, (unsigned long)size);
+        result = NULL;
+    }
+    else if ((blockSize = total_block_size(nmemb * size)) == 0)
+    {
+        LogError("size too big: %lu * %lu", (unsigned long)nmemb, (unsigned long)size);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_01_020: [gballoc_calloc shall call the C99 calloc function and return its result.] */
+        /* Codes_SRS_GBALLOC_01_022: [When the underlying calloc call fails, gballoc_calloc shall return NULL and size should not be counted towards total memory used.] */
+        /* Codes_SRS_GBALLOC_01_021: [If the underlying calloc call is successful, gballoc_calloc shall increment the total memory used with nmemb*size.] */
+        /* Codes_SRS_GBALLOC_01_040: [If gballoc was not initialized gballoc_calloc shall simply call calloc without any memory tracking being performed.] */
+        result = track_block((GBALLOC_HEADER*)calloc(1, blockSize), nmemb * size);
+    }
+    return result;
+}
+
+void* gballoc_realloc(void* ptr, size_t size)
+{
+    void* result;
+    size_t blockSize = total_block_size(size);
+    if (blockSize == 0)
+    {
+        LogError("size too big: %lu", (unsigned long)size);
+        result = NULL;
+    }
+    else if (ptr == NULL)
+    {
+        /* Codes_SRS_GBALLOC_01_017: [When ptr is NULL, gballoc_realloc shall call the underlying realloc with ptr being NULL and the realloc result shall be tracked by gballoc.] */
+        result = track_block((GBALLOC_HEADER*)realloc(NULL, blockSize), size);
+    }
+    else
+    {
+        GBALLOC_HEADER* header = (GBALLOC_HEADER*)ptr - 1;
+        size_t oldSize = header->block.size;
+        intptr_t oldGeneration = header->block.generation;
+
+        /* Codes_SRS_GBALLOC_01_005: [gballoc_realloc shall call the C99 realloc function and return its result.] */
+        GBALLOC_HEADER* newHeader = (GBALLOC_HEADER*)realloc(header, blockSize);
+        if (newHeader == NULL)
+        {
+            /* Codes_SRS_GBALLOC_01_014: [When the underlying realloc call fails, gballoc_realloc shall return NULL and no change should be made to the counted total memory usage.] */
+            result = NULL;
+        }
+        else
+        {
+            intptr_t generation = currentGeneration;
+            newHeader->block.size = size;
+            newHeader->block.generation = generation;
+            if (generation != 0)
+            {
+                /* Codes_SRS_GBALLOC_01_006: [If the underlying realloc call is successful, gballoc_realloc shall look up the size associated with the pointer ptr and decrease the total memory used with that size.] */
+                /* Codes_SRS_GBALLOC_01_007: [If realloc is successful, gballoc_realloc shall also increment the total memory used value tracked by this module.] */
+                /* Codes_SRS_GBALLOC_11_003: [ Blocks that were not counted in the current metrics (allocated before gballoc_init or gballoc_resetMetrics) shall not decrease the total memory used when they are reallocated or freed. ]*/
+                count_bytes((intptr_t)size - ((oldGeneration == generation) ? (intptr_t)oldSize : 0), 1);
+            }
+            result = newHeader + 1;
+        }
+    }
+    return result;
+}
+
+void gballoc_free(void* ptr)
+{
+    if (ptr != NULL)
+    {
+        GBALLOC_HEADER* header = (GBALLOC_HEADER*)ptr - 1;
+        intptr_t generation = currentGeneration;
+
+        /* Codes_SRS_GBALLOC_01_009: [gballoc_free shall also look up the size associated with the ptr pointer and decrease the total memory used with the associated size amount.] */
+        /* Codes_SRS_GBALLOC_11_003: [ Blocks that were not counted in the current metrics (allocated before gballoc_init or gballoc_resetMetrics) shall not decrease the total memory used when they are reallocated or freed. ]*/
+        if ((generation != 0) && (header->block.generation == generation))
+        {
+            count_bytes(-(intptr_t)header->block.size, 0);
+        }
+
+        /* Codes_SRS_GBALLOC_01_008: [gballoc_free shall call the C99 free function.] */
+        free(header);
+    }
+}
+
+static intptr_t sum_shard_bytes(void)
+{
+    intptr_t result = totalSize.value;
+    size_t i;
+    for (i = 0; i < GBALLOC_SHARD_COUNT; i++)
+    {
+        result += shards[i].bytes;
+    }
+    return result;
+}
+
+size_t gballoc_getMaximumMemoryUsed(void)
+{
+    size_t result;
+
+    /* Codes_SRS_GBALLOC_01_038: [If gballoc was not initialized gballoc_getMaximumMemoryUsed shall return MAX_INT_SIZE.] */
+    if (currentGeneration == 0)
+    {
+        LogError("gballoc is not initialized.");
+        result = SIZE_MAX;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_01_010: [gballoc_getMaximumMemoryUsed shall return the maximum amount of total memory used recorded since the module initialization.] */
+        intptr_t current = sum_shard_bytes();
+        intptr_t maximum = maxSize.value;
+        result = (size_t)((current > maximum) ? current : maximum);
+    }
+
+    return result;
+}
+
+size_t gballoc_getCurrentMemoryUsed(void)
+{
+    size_t result;
+
+    /* Codes_SRS_GBALLOC_01_044: [If gballoc was not initialized gballoc_getCurrentMemoryUsed shall return SIZE_MAX.] */
+    if (currentGeneration == 0)
+    {
+        LogError("gballoc is not initialized.");
+        result = SIZE_MAX;
+    }
+    else
+    {
+        /*Codes_SRS_GBALLOC_02_001: [gballoc_getCurrentMemoryUsed shall return the currently used memory size.] */
+        result = (size_t)sum_shard_bytes();
+    }
+
+    return result;
+}
+
+size_t gballoc_getAllocationCount(void)
+{
+    size_t result;
+
+    /* Codes_SRS_GBALLOC_07_001: [ If gballoc was not initialized gballoc_getAllocationCount shall return 0. ] */
+    if (currentGeneration == 0)
+    {
+        LogError("gballoc is not initialized.");
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_07_004: [ gballoc_getAllocationCount shall return the currently number of allocations. ] */
+        size_t i;
+        result = 0;
+        for (i = 0; i < GBALLOC_SHARD_COUNT; i++)
+        {
+            result += (size_t)shards[i].allocations;
+        }
+    }
+
+    return result;
+}
+
+void gballoc_resetMetrics()
+{
+    /* Codes_SRS_GBALLOC_07_005: [ If gballoc was not initialized gballoc_reset Metrics shall do nothing.] */
+    if (currentGeneration == 0)
+    {
+        LogError("gballoc is not initialized.");
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_07_008: [ gballoc_resetMetrics shall reset the total allocation size, max allocation size and number of allocation to zero. ] */
+        /* Codes_SRS_GBALLOC_11_004: [ With GB_SHARDED_TRACKING, gballoc_resetMetrics shall start a new metrics generation so that blocks allocated before it are not counted when freed. ]*/
+        currentGeneration = 0;
+        reset_counters();
+        currentGeneration = ++lastGeneration;
+    }
+}
+
+/*allocation sites need a table shared by all threads, which is what this implementation avoids. The _at functions only count the totals*/
+void* gballoc_malloc_at(size_t size, const char* file, int line)
+{
+    /* Codes_SRS_GBALLOC_11_015: [ With GB_SHARDED_TRACKING, gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc and not record the site. ]*/
+    (void)file;
+    (void)line;
+    return gballoc_malloc(size);
+}
+
+void* gballoc_calloc_at(size_t nmemb, size_t size, const char* file, int line)
+{
+    (void)file;
+    (void)line;
+    return gballoc_calloc(nmemb, size);
+}
+
+void* gballoc_realloc_at(void* ptr, size_t size, const char* file, int line)
+{
+    (void)file;
+    (void)line;
+    return gballoc_realloc(ptr, size);
+}
+
+int gballoc_setSiteSamplingRate(size_t rate)
+{
+    /* Codes_SRS_GBALLOC_11_016: [ With GB_SHARDED_TRACKING, gballoc_setSiteSamplingRate and gballoc_dumpSites shall fail and return a non-zero value. ]*/
+    (void)rate;
+    LogError("allocation sites are not recorded with GB_SHARDED_TRACKING");
+    return __FAILURE__;
+}
+
+int gballoc_dumpSites(const char* fileName, GBALLOC_DUMP_FORMAT format)
+{
+    (void)fileName;
+    (void)format;
+    LogError("allocation sites are not recorded with GB_SHARDED_TRACKING");
+    return __FAILURE__;
+}
+
+#endif /* defined(GB_SHARDED_TRACKING) && !defined(GB_USE_CUSTOM_HEAP) */
@@ -957,7 +957,8 @@ static const IO_INTERFACE_DESCRIPTION http_proxy_io_interface_description =
     http_proxy_io_close,
     http_proxy_io_send,
     http_proxy_io_dowork,
-    http_proxy_io_set_option
+    http_proxy_io_set_option,
+    NULL
 };
 
 const IO_INTERFACE_DESCRIPTION* http_proxy_io_get_interface_description(void)
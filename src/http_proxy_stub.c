@@ -114,7 +114,8 @@ static const IO_INTERFACE_DESCRIPTION http_proxy_stub_interface_description =
     http_proxy_stub_close,
     http_proxy_stub_send,
     http_proxy_stub_dowork,
-    http_proxy_stub_set_option
+    http_proxy_stub_set_option,
+    NULL
 };
 
 const IO_INTERFACE_DESCRIPTION* http_proxy_io_get_interface_description(void)
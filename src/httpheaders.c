@@ -11,6 +11,9 @@
 
 DEFINE_ENUM_STRINGS(HTTP_HEADERS_RESULT, HTTP_HEADERS_RESULT_VALUES);
 
+/*most requests carry fewer headers than this, so the map does not need to grow while they are added*/
+#define HTTP_HEADERS_INITIAL_CAPACITY 8
+
 typedef struct HTTP_HEADERS_HANDLE_DATA_TAG
 {
     MAP_HANDLE headers;
@@ -29,10 +32,11 @@ HTTP_HEADERS_HANDLE HTTPHeaders_Alloc(void)
     else
     {
         /*Codes_SRS_HTTP_HEADERS_99_004:[ After a successful init, HTTPHeaders_GetHeaderCount shall report 0 existing headers.]*/
-        result->headers = Map_Create(NULL);
+        /*Codes_SRS_HTTP_HEADERS_11_001: [ HTTPHeaders_Alloc shall create the map holding the headers by calling Map_CreateWithCapacity with room for 8 headers. ]*/
+        result->headers = Map_CreateWithCapacity(NULL, HTTP_HEADERS_INITIAL_CAPACITY);
         if (result->headers == NULL)
         {
-            LogError("Map_Create failed");
+            LogError("Map_CreateWithCapacity failed");
             free(result);
             result = NULL;
         }
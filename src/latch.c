@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*
+A count under a lock. latch_count_down broadcasts the condition when the count gets to 0 and latch_wait waits on the
+condition until the count is 0. A timed latch_wait measures the time it waited with a tickcounter that is only read
+under the lock, so a wakeup that finds the count not at 0 yet waits only for the rest of timeout_milliseconds.
+*/
+
+#include <stdlib.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/condition.h"
+#include "azure_c_shared_utility/tickcounter.h"
+#include "azure_c_shared_utility/latch.h"
+
+typedef struct LATCH_TAG
+{
+    LOCK_HANDLE lock;
+    COND_HANDLE zero;
+    TICK_COUNTER_HANDLE tick_counter;
+    size_t count;
+} LATCH;
+
+LATCH_HANDLE latch_create(size_t count)
+{
+    LATCH* result = (LATCH*)malloc(sizeof(LATCH));
+    if (result == NULL)
+    {
+        /* Codes_SRS_LATCH_11_002: [ If any error occurs, latch_create shall fail and return NULL. ]*/
+        LogError("failure allocating LATCH");
+    }
+    else if ((result->lock = Lock_Init()) == NULL)
+    {
+        /* Codes_SRS_LATCH_11_002: [ If any error occurs, latch_create shall fail and return NULL. ]*/
+        LogError("failure in Lock_Init");
+        free(result);
+        result = NULL;
+    }
+    else if ((result->zero = Condition_Init()) == NULL)
+    {
+        /* Codes_SRS_LATCH_11_002: [ If any error occurs, latch_create shall fail and return NULL. ]*/
+        LogError("failure in Condition_Init");
+        (void)Lock_Deinit(result->lock);
+        free(result);
+        result = NULL;
+    }
+    else if ((result->tick_counter = tickcounter_create()) == NULL)
+    {
+        /* Codes_SRS_LATCH_11_002: [ If any error occurs, latch_create shall fail and return NULL. ]*/
+        LogError("failure in tickcounter_create");
+        Condition_Deinit(result->zero);
+        (void)Lock_Deinit(result->lock);
+        free(result);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_LATCH_11_001: [ latch_create shall allocate a latch with a lock, a condition, a tickcounter and a count of count and return it. ]*/
+        result->count = count;
+    }
+
+    return result;
+}
+
+void latch_destroy(LATCH_HANDLE latch)
+{
+    if (latch == NULL)
+    {
+        /* Codes_SRS_LATCH_11_003: [ If latch is NULL, latch_destroy shall return. ]*/
+        LogError("Invalid arguments: LATCH_HANDLE latch=%p", latch);
+    }
+    else
+    {
+        /* Codes_SRS_LATCH_11_004: [ latch_destroy shall free the tickcounter, the condition, the lock and the latch. ]*/
+        tickcounter_destroy(latch->tick_counter);
+        Condition_Deinit(latch->zero);
+        (void)Lock_Deinit(latch->lock);
+        free(latch);
+    }
+}
+
+LATCH_RESULT latch_count_down(LATCH_HANDLE latch)
+{
+    LATCH_RESULT result;
+
+    if (latch == NULL)
+    {
+        /* Codes_SRS_LATCH_11_005: [ If latch is NULL, latch_count_down shall fail and return LATCH_INVALID_ARG. ]*/
+        LogError("Invalid arguments: LATCH_HANDLE latch=%p", latch);
+        result = LATCH_INVALID_ARG;
+    }
+    else if (Lock(latch->lock) != LOCK_OK)
+    {
+        /* Codes_SRS_LATCH_11_009: [ If any other error occurs, latch_count_down shall fail and return LATCH_ERROR. ]*/
+        LogError("failure locking the latch");
+        result = LATCH_ERROR;
+    }
+    else
+    {
+        if (latch->count == 0)
+        {
+            /* Codes_SRS_LATCH_11_006: [ If the count of latch is already 0, latch_count_down shall fail and return LATCH_ERROR. ]*/
+            LogError("latch counted down more times than its count");
+            result = LATCH_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_LATCH_11_007: [ latch_count_down shall decrement the count of latch under its lock and return LATCH_OK. ]*/
+            latch->count--;
+            result = LATCH_OK;
+
+            /* Codes_SRS_LATCH_11_008: [ When the count gets to 0, latch_count_down shall broadcast the condition of latch. ]*/
+            if ((latch->count == 0) &&
+                (Condition_Broadcast(latch->zero) != COND_OK))
+            {
+                /* Codes_SRS_LATCH_11_009: [ If any other error occurs, latch_count_down shall fail and return LATCH_ERROR. ]*/
+                LogError("failure in Condition_Broadcast");
+                result = LATCH_ERROR;
+            }
+        }
+        (void)Unlock(latch->lock);
+    }
+
+    return result;
+}
+
+LATCH_RESULT latch_wait(LATCH_HANDLE latch, int timeout_milliseconds)
+{
+    LATCH_RESULT result;
+
+    if ((latch == NULL) || (timeout_milliseconds < 0))
+    {
+        /* Codes_SRS_LATCH_11_010: [ If latch is NULL or timeout_milliseconds is negative, latch_wait shall fail and return LATCH_INVALID_ARG. ]*/
+        LogError("Invalid arguments: LATCH_HANDLE latch=%p, int timeout_milliseconds=%d", latch, timeout_milliseconds);
+        result = LATCH_INVALID_ARG;
+    }
+    else if (Lock(latch->lock) != LOCK_OK)
+    {
+        /* Codes_SRS_LATCH_11_014: [ If any error occurs, latch_wait shall fail and return LATCH_ERROR. ]*/
+        LogError("failure locking the latch");
+        result = LATCH_ERROR;
+    }
+    else
+    {
+        tickcounter_ms_t start_ms = 0;
+
+        /* Codes_SRS_LATCH_11_013: [ If timeout_milliseconds is not 0, latch_wait shall read the tickcounter of latch before it waits and after every wakeup, and return LATCH_TIMEOUT once timeout_milliseconds went by with the count not at 0. ]*/
+        if ((timeout_milliseconds != 0) &&
+            (tickcounter_get_current_ms(latch->tick_counter, &start_ms) != 0))
+        {
+            /* Codes_SRS_LATCH_11_014: [ If any error occurs, latch_wait shall fail and return LATCH_ERROR. ]*/
+            LogError("failure in tickcounter_get_current_ms");
+            result = LATCH_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_LATCH_11_011: [ latch_wait shall return LATCH_OK when the count of latch is 0. ]*/
+            /* Codes_SRS_LATCH_11_012: [ Otherwise latch_wait shall wait on the condition of latch until the count is 0. ]*/
+            result = LATCH_OK;
+            while (latch->count != 0)
+            {
+                int wait_milliseconds = timeout_milliseconds;
+                COND_RESULT cond_result;
+
+                if (timeout_milliseconds != 0)
+                {
+                    tickcounter_ms_t now_ms;
+                    if (tickcounter_get_current_ms(latch->tick_counter, &now_ms) != 0)
+                    {
+                        /* Codes_SRS_LATCH_11_014: [ If any error occurs, latch_wait shall fail and return LATCH_ERROR. ]*/
+                        LogError("failure in tickcounter_get_current_ms");
+                        result = LATCH_ERROR;
+                        break;
+                    }
+                    else if (now_ms - start_ms >= (tickcounter_ms_t)timeout_milliseconds)
+                    {
+                        /* Codes_SRS_LATCH_11_013: [ If timeout_milliseconds is not 0, latch_wait shall read the tickcounter of latch before it waits and after every wakeup, and return LATCH_TIMEOUT once timeout_milliseconds went by with the count not at 0. ]*/
+                        result = LATCH_TIMEOUT;
+                        break;
+                    }
+                    else
+                    {
+                        wait_milliseconds = timeout_milliseconds - (int)(now_ms - start_ms);
+                    }
+                }
+
+                /*COND_TIMEOUT goes around again, the tickcounter decides whether the whole timeout went by*/
+                cond_result = Condition_Wait(latch->zero, latch->lock, wait_milliseconds);
+                if ((cond_result != COND_OK) && (cond_result != COND_TIMEOUT))
+                {
+                    /* Codes_SRS_LATCH_11_014: [ If any error occurs, latch_wait shall fail and return LATCH_ERROR. ]*/
+                    LogError("failure in Condition_Wait");
+                    result = LATCH_ERROR;
+                    break;
+                }
+            }
+        }
+        (void)Unlock(latch->lock);
+    }
+
+    return result;
+}
@@ -10,16 +10,320 @@
 
 DEFINE_ENUM_STRINGS(MAP_RESULT, MAP_RESULT_VALUES);
 
+/*maps with at most this many keys are searched linearly, bigger maps get a hash index*/
+#define MAP_INDEX_MIN_COUNT 8
+/*smallest number of slots of the hash index, always a power of 2*/
+#define MAP_INDEX_MIN_SIZE 32
+
+typedef struct MAP_INDEX_ENTRY_TAG
+{
+    size_t hash;
+    size_t position; /*1 + the position of the key in keys/values, 0 marks an empty slot*/
+}MAP_INDEX_ENTRY;
+
+/*string arena blocks never grow past this size (unless a single string needs more)*/
+#define MAP_ARENA_MAX_BLOCK_SIZE 65536
+
+typedef struct MAP_STRING_ARENA_BLOCK_TAG
+{
+    struct MAP_STRING_ARENA_BLOCK_TAG* next;
+    size_t size; /*number of characters that follow this header*/
+    size_t used;
+}MAP_STRING_ARENA_BLOCK;
+
 typedef struct MAP_HANDLE_DATA_TAG
 {
     char** keys;
     char** values;
     size_t count;
+    size_t capacity; /*number of slots allocated in keys and values*/
+    size_t reservedCapacity; /*set by Map_CreateWithCapacity and Map_Reserve, deleting keys never shrinks capacity below it*/
     MAP_FILTER_CALLBACK mapFilterCallback;
+    MAP_INDEX_ENTRY* index; /*open addressing (linear probing) table, NULL while the map is small*/
+    size_t indexSize;
+    size_t arenaBlockSize; /*0 when every key and value is a separate allocation*/
+    MAP_STRING_ARENA_BLOCK* arena; /*newest block first*/
 }MAP_HANDLE_DATA;
 
 #define LOG_MAP_ERROR LogError("result = %s", ENUM_TO_STRING(MAP_RESULT, result));
 
+/*FNV-1a*/
+static size_t Map_HashKey(const char* key)
+{
+    size_t result = (size_t)2166136261U;
+    while (*key != '\0')
+    {
+        result ^= (unsigned char)(*key);
+        result *= (size_t)16777619U;
+        key++;
+    }
+    return result;
+}
+
+static void Map_DestroyIndex(MAP_HANDLE_DATA* handleData)
+{
+    if (handleData->index != NULL)
+    {
+        free(handleData->index);
+        handleData->index = NULL;
+        handleData->indexSize = 0;
+    }
+}
+
+/*places the key at "position" in the index. The index is assumed to have at least 1 empty slot*/
+static void Map_IndexInsert(MAP_HANDLE_DATA* handleData, size_t hash, size_t position)
+{
+    size_t mask = handleData->indexSize - 1;
+    size_t slot = hash & mask;
+    while (handleData->index[slot].position != 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    handleData->index[slot].hash = hash;
+    handleData->index[slot].position = position + 1;
+}
+
+/*(re)builds the index with indexSize slots from the content of keys. On failure the map falls back to linear search*/
+static void Map_BuildIndex(MAP_HANDLE_DATA* handleData, size_t indexSize)
+{
+    MAP_INDEX_ENTRY* newIndex;
+    Map_DestroyIndex(handleData);
+    if (indexSize > ((size_t)-1) / sizeof(MAP_INDEX_ENTRY))
+    {
+        LogError("index size too big");
+    }
+    else if ((newIndex = (MAP_INDEX_ENTRY*)malloc(indexSize * sizeof(MAP_INDEX_ENTRY))) == NULL)
+    {
+        /*Codes_SRS_MAP_11_002: [ If building the hash index fails, the map shall keep operating by searching the keys linearly. ]*/
+        LogError("unable to malloc the index, the map will be searched linearly");
+    }
+    else
+    {
+        size_t i;
+        (void)memset(newIndex, 0, indexSize * sizeof(MAP_INDEX_ENTRY));
+        handleData->index = newIndex;
+        handleData->indexSize = indexSize;
+        for (i = 0; i < handleData->count; i++)
+        {
+            Map_IndexInsert(handleData, Map_HashKey(handleData->keys[i]), i);
+        }
+    }
+}
+
+/*the load factor of the index is kept under 1/2, so probe sequences stay short*/
+static size_t Map_IndexSizeFor(size_t count)
+{
+    size_t result = MAP_INDEX_MIN_SIZE;
+    while (result < 2 * count)
+    {
+        result *= 2;
+    }
+    return result;
+}
+
+/*keeps the index in sync after a key has been appended at position count - 1*/
+static void Map_IndexAppendedKey(MAP_HANDLE_DATA* handleData)
+{
+    if (handleData->count > MAP_INDEX_MIN_COUNT)
+    {
+        if (handleData->index == NULL)
+        {
+            Map_BuildIndex(handleData, Map_IndexSizeFor(handleData->capacity));
+        }
+        else if (2 * handleData->count > handleData->indexSize)
+        {
+            Map_BuildIndex(handleData, 2 * handleData->indexSize);
+        }
+        else
+        {
+            Map_IndexInsert(handleData, Map_HashKey(handleData->keys[handleData->count - 1]), handleData->count - 1);
+        }
+    }
+}
+
+/*removes the key at "position" from the index and renumbers the positions of the keys that follow it*/
+static void Map_IndexRemove(MAP_HANDLE_DATA* handleData, size_t hash, size_t position)
+{
+    if (handleData->index != NULL)
+    {
+        size_t mask = handleData->indexSize - 1;
+        size_t slot = hash & mask;
+        size_t next;
+        size_t i;
+
+        while (handleData->index[slot].position != position + 1)
+        {
+            slot = (slot + 1) & mask;
+        }
+        handleData->index[slot].position = 0;
+
+        /*backward shift deletion: move up the entries of the cluster that would not be found anymore because of the hole*/
+        next = (slot + 1) & mask;
+        while (handleData->index[next].position != 0)
+        {
+            size_t home = handleData->index[next].hash & mask;
+            if (((next - home) & mask) >= ((next - slot) & mask))
+            {
+                handleData->index[slot] = handleData->index[next];
+                handleData->index[next].position = 0;
+                slot = next;
+            }
+            next = (next + 1) & mask;
+        }
+
+        for (i = 0; i < handleData->indexSize; i++)
+        {
+            if (handleData->index[i].position > position + 1)
+            {
+                handleData->index[i].position--;
+            }
+        }
+    }
+}
+
+static char* Map_ArenaAlloc(MAP_HANDLE_DATA* handleData, size_t size)
+{
+    char* result;
+    if ((handleData->arena != NULL) && (handleData->arena->size - handleData->arena->used >= size))
+    {
+        result = (char*)(handleData->arena + 1) + handleData->arena->used;
+        handleData->arena->used += size;
+    }
+    else
+    {
+        /*blocks double in size so that the number of blocks stays logarithmic in the amount of text*/
+        size_t blockSize = (handleData->arena == NULL) ? handleData->arenaBlockSize : 2 * handleData->arena->size;
+        MAP_STRING_ARENA_BLOCK* newBlock;
+        if (blockSize > MAP_ARENA_MAX_BLOCK_SIZE)
+        {
+            blockSize = MAP_ARENA_MAX_BLOCK_SIZE;
+        }
+        if (blockSize < size)
+        {
+            blockSize = size;
+        }
+
+        if (blockSize > ((size_t)-1) - sizeof(MAP_STRING_ARENA_BLOCK))
+        {
+            LogError("string too big for the arena");
+            result = NULL;
+        }
+        else if ((newBlock = (MAP_STRING_ARENA_BLOCK*)malloc(sizeof(MAP_STRING_ARENA_BLOCK) + blockSize)) == NULL)
+        {
+            LogError("unable to malloc an arena block");
+            result = NULL;
+        }
+        else
+        {
+            newBlock->next = handleData->arena;
+            newBlock->size = blockSize;
+            newBlock->used = size;
+            handleData->arena = newBlock;
+            result = (char*)(newBlock + 1);
+        }
+    }
+    return result;
+}
+
+static void Map_ArenaDestroy(MAP_HANDLE_DATA* handleData)
+{
+    while (handleData->arena != NULL)
+    {
+        MAP_STRING_ARENA_BLOCK* next = handleData->arena->next;
+        free(handleData->arena);
+        handleData->arena = next;
+    }
+}
+
+/*copies a key or a value into the storage owned by the map*/
+static int Map_CopyString(MAP_HANDLE_DATA* handleData, char** destination, const char* source)
+{
+    int result;
+    if (handleData->arenaBlockSize == 0)
+    {
+        result = mallocAndStrcpy_s(destination, source);
+    }
+    else
+    {
+        size_t size = strlen(source) + 1;
+        char* copy = Map_ArenaAlloc(handleData, size);
+        if (copy == NULL)
+        {
+            result = __FAILURE__;
+        }
+        else
+        {
+            (void)memcpy(copy, source, size);
+            *destination = copy;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+/*strings living in the arena are only released when the map is destroyed*/
+static void Map_FreeString(MAP_HANDLE_DATA* handleData, char* string)
+{
+    if (handleData->arenaBlockSize == 0)
+    {
+        free(string);
+    }
+}
+
+static void Map_InitData(MAP_HANDLE_DATA* handleData, MAP_FILTER_CALLBACK mapFilterFunc, size_t arenaBlockSize)
+{
+    handleData->keys = NULL;
+    handleData->values = NULL;
+    handleData->count = 0;
+    handleData->capacity = 0;
+    handleData->reservedCapacity = 0;
+    handleData->mapFilterCallback = mapFilterFunc;
+    handleData->index = NULL;
+    handleData->indexSize = 0;
+    handleData->arenaBlockSize = arenaBlockSize;
+    handleData->arena = NULL;
+}
+
+static MAP_HANDLE_DATA* Map_CreateInternal(MAP_FILTER_CALLBACK mapFilterFunc, size_t capacity, size_t arenaBlockSize)
+{
+    MAP_HANDLE_DATA* result;
+    if (capacity > ((size_t)-1) / sizeof(char*))
+    {
+        LogError("capacity too big");
+        result = NULL;
+    }
+    else if ((result = (MAP_HANDLE_DATA*)malloc(sizeof(MAP_HANDLE_DATA))) == NULL)
+    {
+        LogError("unable to malloc");
+    }
+    else
+    {
+        Map_InitData(result, mapFilterFunc, arenaBlockSize);
+        if (capacity > 0)
+        {
+            if ((result->keys = (char**)malloc(capacity * sizeof(char*))) == NULL)
+            {
+                LogError("unable to malloc keys");
+                free(result);
+                result = NULL;
+            }
+            else if ((result->values = (char**)malloc(capacity * sizeof(char*))) == NULL)
+            {
+                LogError("unable to malloc values");
+                free(result->keys);
+                free(result);
+                result = NULL;
+            }
+            else
+            {
+                result->capacity = capacity;
+                result->reservedCapacity = capacity;
+            }
+        }
+    }
+    return result;
+}
+
 MAP_HANDLE Map_Create(MAP_FILTER_CALLBACK mapFilterFunc)
 {
     /*Codes_SRS_MAP_02_001: [Map_Create shall create a new, empty map.]*/
@@ -28,10 +332,32 @@ MAP_HANDLE Map_Create(MAP_FILTER_CALLBACK mapFilterFunc)
     if (result != NULL)
     {
         /*Codes_SRS_MAP_02_003: [Otherwise, it shall return a non-NULL handle that can be used in subsequent calls.] */
-        result->keys = NULL;
-        result->values = NULL;
-        result->count = 0;
-        result->mapFilterCallback = mapFilterFunc;
+        Map_InitData(result, mapFilterFunc, 0);
+    }
+    return (MAP_HANDLE)result;
+}
+
+MAP_HANDLE Map_CreateWithCapacity(MAP_FILTER_CALLBACK mapFilterFunc, size_t capacity)
+{
+    /*Codes_SRS_MAP_11_005: [ Map_CreateWithCapacity shall create a new, empty map that can hold capacity keys and values without reallocating its storage. ]*/
+    /*Codes_SRS_MAP_11_006: [ If any error occurs, Map_CreateWithCapacity shall return NULL. ]*/
+    return (MAP_HANDLE)Map_CreateInternal(mapFilterFunc, capacity, 0);
+}
+
+MAP_HANDLE Map_CreateWithStringArena(MAP_FILTER_CALLBACK mapFilterFunc, size_t capacity, size_t arenaBlockSize)
+{
+    MAP_HANDLE_DATA* result;
+    if (arenaBlockSize == 0)
+    {
+        /*Codes_SRS_MAP_11_008: [ If arenaBlockSize is 0 then Map_CreateWithStringArena shall fail and return NULL. ]*/
+        LogError("invalid arg arenaBlockSize=0");
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_MAP_11_007: [ Map_CreateWithStringArena shall create a new, empty map with room for capacity keys and values that copies keys and values into shared blocks of at least arenaBlockSize characters instead of allocating each of them. ]*/
+        /*Codes_SRS_MAP_11_009: [ If any other error occurs, Map_CreateWithStringArena shall return NULL. ]*/
+        result = Map_CreateInternal(mapFilterFunc, capacity, arenaBlockSize);
     }
     return (MAP_HANDLE)result;
 }
@@ -47,11 +373,13 @@ void Map_Destroy(MAP_HANDLE handle)
 
         for (i = 0; i < handleData->count; i++)
         {
-            free(handleData->keys[i]);
-            free(handleData->values[i]);
+            Map_FreeString(handleData, handleData->keys[i]);
+            Map_FreeString(handleData, handleData->values[i]);
         }
         free(handleData->keys);
         free(handleData->values);
+        Map_DestroyIndex(handleData);
+        Map_ArenaDestroy(handleData);
         free(handleData);
     }
 }
@@ -95,6 +423,44 @@ static char** Map_CloneVector(const char*const * source, size_t count)
     return result;
 }
 
+static MAP_HANDLE_DATA* Map_CloneIntoArena(MAP_HANDLE_DATA* handleData)
+{
+    MAP_HANDLE_DATA* result = Map_CreateInternal(handleData->mapFilterCallback, handleData->count, handleData->arenaBlockSize);
+    if (result == NULL)
+    {
+        LogError("unable to create the clone");
+    }
+    else
+    {
+        size_t i;
+
+        /*like any other clone the storage is sized for the keys, it is not reserved*/
+        result->reservedCapacity = 0;
+        for (i = 0; i < handleData->count; i++)
+        {
+            if (
+                (Map_CopyString(result, &(result->keys[i]), handleData->keys[i]) != 0) ||
+                (Map_CopyString(result, &(result->values[i]), handleData->values[i]) != 0)
+                )
+            {
+                break;
+            }
+        }
+
+        if (i < handleData->count)
+        {
+            LogError("unable to copy the keys and values of the clone");
+            Map_Destroy((MAP_HANDLE)result);
+            result = NULL;
+        }
+        else
+        {
+            result->count = handleData->count;
+        }
+    }
+    return result;
+}
+
 /*Codes_SRS_MAP_02_039: [Map_Clone shall make a copy of the map indicated by parameter handle and return a non-NULL handle to it.]*/
 MAP_HANDLE Map_Clone(MAP_HANDLE handle)
 {
@@ -105,6 +471,12 @@ MAP_HANDLE Map_Clone(MAP_HANDLE handle)
         result = NULL;
         LogError("invalid arg to Map_Clone (NULL)");
     }
+    else if (((MAP_HANDLE_DATA*)handle)->arenaBlockSize != 0)
+    {
+        /*Codes_SRS_MAP_11_010: [ Map_Clone of a map created by Map_CreateWithStringArena shall produce a map that also stores its keys and values in a string arena. ]*/
+        /*Codes_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
+        result = Map_CloneIntoArena((MAP_HANDLE_DATA*)handle);
+    }
     else
     {
         MAP_HANDLE_DATA * handleData = (MAP_HANDLE_DATA *)handle;
@@ -117,17 +489,16 @@ MAP_HANDLE Map_Clone(MAP_HANDLE handle)
         }
         else
         {
+            Map_InitData(result, NULL, 0);
             if (handleData->count == 0)
             {
-                result->count = 0;
-                result->keys = NULL;
-                result->values = NULL;
-                result->mapFilterCallback = NULL;
+                /*nothing to copy*/
             }
             else
             {
                 result->mapFilterCallback = handleData->mapFilterCallback;
                 result->count = handleData->count;
+                result->capacity = handleData->count;
                 if( (result->keys = Map_CloneVector((const char* const*)handleData->keys, handleData->count))==NULL)
                 {
                     /*Codes_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
@@ -155,14 +526,26 @@ MAP_HANDLE Map_Clone(MAP_HANDLE handle)
             }
         }
     }
+
+    if ((result != NULL) && (result->count > MAP_INDEX_MIN_COUNT))
+    {
+        /*Codes_SRS_MAP_11_004: [ Map_Clone shall build a hash index for the clone when it holds more than 8 keys. ]*/
+        Map_BuildIndex(result, Map_IndexSizeFor(result->count));
+    }
     return (MAP_HANDLE)result;
 }
 
-static int Map_IncreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
+/*grows keys and values to newCapacity slots. On failure the content of the map is unchanged*/
+static int Map_SetCapacity(MAP_HANDLE_DATA* handleData, size_t newCapacity)
 {
     int result;
-    char** newKeys = (char**)realloc(handleData->keys, (handleData->count + 1) * sizeof(char*));
-    if (newKeys == NULL)
+    char** newKeys;
+    if (newCapacity > ((size_t)-1) / sizeof(char*))
+    {
+        LogError("capacity too big");
+        result = __FAILURE__;
+    }
+    else if ((newKeys = (char**)realloc(handleData->keys, newCapacity * sizeof(char*))) == NULL)
     {
         LogError("realloc error");
         result = __FAILURE__;
@@ -171,8 +554,7 @@ static int Map_IncreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
     {
         char** newValues;
         handleData->keys = newKeys;
-        handleData->keys[handleData->count] = NULL;
-        newValues = (char**)realloc(handleData->values, (handleData->count + 1) * sizeof(char*));
+        newValues = (char**)realloc(handleData->values, newCapacity * sizeof(char*));
         if (newValues == NULL)
         {
             LogError("realloc error");
@@ -180,68 +562,97 @@ static int Map_IncreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
             {
                 free(handleData->keys);
                 handleData->keys = NULL;
+                handleData->capacity = 0;
             }
             else
             {
-                char** undoneKeys = (char**)realloc(handleData->keys, (handleData->count) * sizeof(char*));
-                if (undoneKeys == NULL)
-                {
-                    LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
-                }
-                else
-                {
-                    handleData->keys = undoneKeys;
-                }
+                /*keys is bigger than needed, that is harmless: capacity still describes the smaller of the 2 arrays*/
             }
             result = __FAILURE__;
         }
         else
         {
             handleData->values = newValues;
-            handleData->values[handleData->count] = NULL;
-            handleData->count++;
+            handleData->capacity = newCapacity;
             result = 0;
         }
     }
     return result;
 }
 
+static int Map_IncreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
+{
+    int result;
+    if (
+        (handleData->count == handleData->capacity) &&
+        (Map_SetCapacity(handleData, (handleData->capacity == 0) ? 1 : 2 * handleData->capacity) != 0)
+        )
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        handleData->keys[handleData->count] = NULL;
+        handleData->values[handleData->count] = NULL;
+        handleData->count++;
+        result = 0;
+    }
+    return result;
+}
+
 static void Map_DecreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
 {
-    if (handleData->count == 1)
+    if ((handleData->count == 1) && (handleData->reservedCapacity > 0))
+    {
+        /*Codes_SRS_MAP_11_018: [ Map_Delete shall not shrink the storage of the map below the capacity given to Map_CreateWithCapacity, Map_CreateWithStringArena or Map_Reserve, not even when it deletes the last key. ]*/
+        handleData->count = 0;
+        handleData->mapFilterCallback = NULL;
+        Map_DestroyIndex(handleData);
+    }
+    else if (handleData->count == 1)
     {
         free(handleData->keys);
         handleData->keys = NULL;
         free(handleData->values);
         handleData->values = NULL;
         handleData->count = 0;
+        handleData->capacity = 0;
         handleData->mapFilterCallback = NULL;
+        Map_DestroyIndex(handleData);
     }
     else
     {
         /*certainly > 1...*/
-        char** undoneValues;
-        char** undoneKeys = (char**)realloc(handleData->keys, sizeof(char*)* (handleData->count - 1));
-        if (undoneKeys == NULL)
-        {
-            LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
-        }
-        else
-        {
-            handleData->keys = undoneKeys;
-        }
+        handleData->count--;
 
-        undoneValues = (char**)realloc(handleData->values, sizeof(char*)* (handleData->count - 1));
-        if (undoneValues == NULL)
+        /*only shrink when the map is down to a quarter of its capacity, so alternating adds and deletes do not realloc every time*/
+        /*Codes_SRS_MAP_11_018: [ Map_Delete shall not shrink the storage of the map below the capacity given to Map_CreateWithCapacity, Map_CreateWithStringArena or Map_Reserve, not even when it deletes the last key. ]*/
+        if ((handleData->count <= handleData->capacity / 4) &&
+            (handleData->capacity / 2 >= handleData->reservedCapacity))
         {
-            LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
-        }
-        else
-        {
-            handleData->values = undoneValues;
-        }
+            size_t newCapacity = handleData->capacity / 2;
+            char** undoneKeys = (char**)realloc(handleData->keys, sizeof(char*) * newCapacity);
+            char** undoneValues;
+            if (undoneKeys != NULL)
+            {
+                handleData->keys = undoneKeys;
+            }
 
-        handleData->count--;
+            undoneValues = (char**)realloc(handleData->values, sizeof(char*) * newCapacity);
+            if (undoneValues != NULL)
+            {
+                handleData->values = undoneValues;
+            }
+
+            if ((undoneKeys == NULL) && (undoneValues == NULL))
+            {
+                LogError("unable to shrink the storage of the map, keeping the current capacity");
+            }
+            else
+            {
+                handleData->capacity = newCapacity;
+            }
+        }
     }
 }
 
@@ -252,6 +663,25 @@ static char** findKey(MAP_HANDLE_DATA* handleData, const char* key)
     {
         result = NULL;
     }
+    else if (handleData->index != NULL)
+    {
+        size_t hash = Map_HashKey(key);
+        size_t mask = handleData->indexSize - 1;
+        size_t slot = hash & mask;
+        result = NULL;
+        while (handleData->index[slot].position != 0)
+        {
+            if (
+                (handleData->index[slot].hash == hash) &&
+                (strcmp(handleData->keys[handleData->index[slot].position - 1], key) == 0)
+                )
+            {
+                result = handleData->keys + (handleData->index[slot].position - 1);
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
     else
     {
         size_t i;
@@ -300,23 +730,25 @@ static int insertNewKeyValue(MAP_HANDLE_DATA* handleData, const char* key, const
     }
     else
     {
-        if (mallocAndStrcpy_s(&(handleData->keys[handleData->count - 1]), key) != 0)
+        if (Map_CopyString(handleData, &(handleData->keys[handleData->count - 1]), key) != 0)
         {
             Map_DecreaseStorageKeysValues(handleData);
-            LogError("unable to mallocAndStrcpy_s");
+            LogError("unable to copy the key");
             result = __FAILURE__;
         }
         else
         {
-            if (mallocAndStrcpy_s(&(handleData->values[handleData->count - 1]), value) != 0)
+            if (Map_CopyString(handleData, &(handleData->values[handleData->count - 1]), value) != 0)
             {
-                free(handleData->keys[handleData->count - 1]);
+                Map_FreeString(handleData, handleData->keys[handleData->count - 1]);
                 Map_DecreaseStorageKeysValues(handleData);
-                LogError("unable to mallocAndStrcpy_s");
+                LogError("unable to copy the value");
                 result = __FAILURE__;
             }
             else
             {
+                /*Codes_SRS_MAP_11_001: [ When the map holds more than 8 keys, Map_Add and Map_AddOrUpdate shall maintain a hash index of the keys. ]*/
+                Map_IndexAppendedKey(handleData);
                 result = 0;
             }
         }
@@ -419,8 +851,22 @@ MAP_RESULT Map_AddOrUpdate(MAP_HANDLE handle, const char* key, const char* value
                 /*Codes_SRS_MAP_02_016: [If the key already exists, then Map_AddOrUpdate shall overwrite the value of the existing key with parameter value.]*/
                 size_t index = whereIsIt - handleData->keys;
                 size_t valueLength = strlen(value);
-                /*try to realloc value of this key*/
-                char* newValue = (char*)realloc(handleData->values[index],valueLength  + 1);
+                char* newValue;
+                if (handleData->arenaBlockSize == 0)
+                {
+                    /*try to realloc value of this key*/
+                    newValue = (char*)realloc(handleData->values[index], valueLength + 1);
+                }
+                else if (strlen(handleData->values[index]) >= valueLength)
+                {
+                    /*Codes_SRS_MAP_11_011: [ When the map stores its strings in an arena, Map_AddOrUpdate shall overwrite the old value in place if the new value fits in it, otherwise it shall copy the new value into the arena. ]*/
+                    newValue = handleData->values[index];
+                }
+                else
+                {
+                    newValue = Map_ArenaAlloc(handleData, valueLength + 1);
+                }
+
                 if (newValue == NULL)
                 {
                     result = MAP_ERROR;
@@ -465,8 +911,10 @@ MAP_RESULT Map_Delete(MAP_HANDLE handle, const char* key)
         {
             /*Codes_SRS_MAP_02_023: [Otherwise, Map_Delete shall remove the key and its associated value from the map and return MAP_OK.]*/
             size_t index = whereIsIt - handleData->keys;
-            free(handleData->keys[index]);
-            free(handleData->values[index]);
+            /*Codes_SRS_MAP_11_003: [ Map_Delete shall remove the key from the hash index and preserve the order of the remaining keys. ]*/
+            Map_IndexRemove(handleData, Map_HashKey(key), index);
+            Map_FreeString(handleData, handleData->keys[index]);
+            Map_FreeString(handleData, handleData->values[index]);
             memmove(handleData->keys + index, handleData->keys + index + 1, (handleData->count - index - 1)*sizeof(char*)); /*if order doesn't matter... then this can be optimized*/
             memmove(handleData->values + index, handleData->values + index + 1, (handleData->count - index - 1)*sizeof(char*));
             Map_DecreaseStorageKeysValues(handleData);
@@ -477,6 +925,49 @@ MAP_RESULT Map_Delete(MAP_HANDLE handle, const char* key)
     return result;
 }
 
+MAP_RESULT Map_Reserve(MAP_HANDLE handle, size_t capacity)
+{
+    MAP_RESULT result;
+    if (handle == NULL)
+    {
+        /*Codes_SRS_MAP_11_012: [ If parameter handle is NULL then Map_Reserve shall return MAP_INVALIDARG. ]*/
+        result = MAP_INVALIDARG;
+        LOG_MAP_ERROR;
+    }
+    else
+    {
+        MAP_HANDLE_DATA* handleData = (MAP_HANDLE_DATA*)handle;
+        if (capacity <= handleData->capacity)
+        {
+            /*Codes_SRS_MAP_11_013: [ If the map can already hold capacity keys, Map_Reserve shall not reallocate the storage, it shall only keep Map_Delete from shrinking it below capacity keys, and return MAP_OK. ]*/
+            if (capacity > handleData->reservedCapacity)
+            {
+                handleData->reservedCapacity = capacity;
+            }
+            result = MAP_OK;
+        }
+        /*Codes_SRS_MAP_11_014: [ Otherwise, Map_Reserve shall grow the storage of the map so that it can hold capacity keys and values without reallocating it. ]*/
+        else if (Map_SetCapacity(handleData, capacity) != 0)
+        {
+            /*Codes_SRS_MAP_11_015: [ If growing the storage fails, Map_Reserve shall return MAP_ERROR and leave the map unchanged. ]*/
+            result = MAP_ERROR;
+            LOG_MAP_ERROR;
+        }
+        else
+        {
+            if ((handleData->index != NULL) && (Map_IndexSizeFor(capacity) > handleData->indexSize))
+            {
+                /*Codes_SRS_MAP_11_016: [ If the map has a hash index, Map_Reserve shall also size the index for capacity keys. ]*/
+                Map_BuildIndex(handleData, Map_IndexSizeFor(capacity));
+            }
+            handleData->reservedCapacity = capacity;
+            /*Codes_SRS_MAP_11_017: [ Otherwise Map_Reserve shall return MAP_OK. ]*/
+            result = MAP_OK;
+        }
+    }
+    return result;
+}
+
 MAP_RESULT Map_ContainsKey(MAP_HANDLE handle, const char* key, bool* keyExists)
 {
     MAP_RESULT result;
@@ -0,0 +1,342 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*
+A multi producer single consumer queue without locks.
+
+The unbounded queue is a linked list of nodes with a stub node in front. A producer swaps its node into head
+with one atomic exchange and then links the previous head to it. The consumer only follows the next pointers
+from tail, so it never competes with the producers.
+
+The bounded queue is a ring of cells, each with a sequence number. A producer claims the cell at the enqueue
+position with a compare and swap on the position, stores its item and publishes it by moving the sequence of
+the cell. The consumer takes the item when the sequence says it was published and moves the sequence one lap
+ahead, which hands the cell back to the producers. With a single cell a published cell (sequence position + 1)
+would look free to the next enqueue position, so the ring has at least 2 cells and a queue of capacity 1 also
+checks that the previous cell was popped.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+#include "azure_c_shared_utility/mpsc_queue.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+/*the same atomic operations refcount_os.h picks for the platform, with the pointer exchange and compare and swap the queue needs*/
+#if defined(_WIN32)
+#include "windows.h"
+#define MPSC_QUEUE_EXCHANGE_POINTER(var, value) InterlockedExchangePointer((PVOID volatile*)&(var), (PVOID)(value))
+#ifdef _WIN64
+#define MPSC_QUEUE_CAS(var, expected, desired) (InterlockedCompareExchange64((volatile LONG64*)&(var), (LONG64)(desired), (LONG64)(expected)) == (LONG64)(expected))
+#else
+#define MPSC_QUEUE_CAS(var, expected, desired) (InterlockedCompareExchange((volatile LONG*)&(var), (LONG)(desired), (LONG)(expected)) == (LONG)(expected))
+#endif
+#define MPSC_QUEUE_BARRIER() MemoryBarrier()
+#elif defined(__GNUC__)
+/*__sync_lock_test_and_set is only an acquire barrier, the node has to be visible before it is swapped in*/
+#define MPSC_QUEUE_EXCHANGE_POINTER(var, value) (__sync_synchronize(), __sync_lock_test_and_set(&(var), (value)))
+#define MPSC_QUEUE_CAS(var, expected, desired) __sync_bool_compare_and_swap(&(var), (expected), (desired))
+#define MPSC_QUEUE_BARRIER() __sync_synchronize()
+#else
+/*no atomic operations known for this compiler, same as REFCOUNT_ATOMIC_DONTCARE: only good for single threaded devices*/
+static void* mpsc_queue_exchange_pointer(void* volatile* var, void* value)
+{
+    void* result = *var;
+    *var = value;
+    return result;
+}
+#define MPSC_QUEUE_EXCHANGE_POINTER(var, value) mpsc_queue_exchange_pointer((void* volatile*)&(var), (value))
+#define MPSC_QUEUE_CAS(var, expected, desired) (((var) == (expected)) ? ((var) = (desired), 1) : 0)
+#define MPSC_QUEUE_BARRIER() ((void)0)
+#endif
+
+#define MPSC_QUEUE_CACHE_LINE_SIZE 64
+
+typedef struct MPSC_QUEUE_NODE_TAG
+{
+    struct MPSC_QUEUE_NODE_TAG* volatile next;
+    void* item;
+} MPSC_QUEUE_NODE;
+
+typedef struct MPSC_QUEUE_CELL_TAG
+{
+    volatile size_t sequence;
+    void* item;
+} MPSC_QUEUE_CELL;
+
+typedef struct MPSC_QUEUE_TAG
+{
+    /*consumer side*/
+    MPSC_QUEUE_NODE* tail;
+    size_t dequeue_position;
+    MPSC_QUEUE_CELL* cells; /*NULL for an unbounded queue*/
+    size_t mask;
+    size_t capacity; /*items the ring holds, only smaller than mask + 1 for a capacity of 1*/
+    /*keeps the producers off the cache line the consumer writes*/
+    unsigned char padding[MPSC_QUEUE_CACHE_LINE_SIZE];
+    /*producer side*/
+    MPSC_QUEUE_NODE* volatile head;
+    volatile size_t enqueue_position;
+} MPSC_QUEUE;
+
+MPSC_QUEUE_HANDLE mpsc_queue_create(void)
+{
+    MPSC_QUEUE* result = (MPSC_QUEUE*)malloc(sizeof(MPSC_QUEUE));
+    if (result == NULL)
+    {
+        /* Codes_SRS_MPSC_QUEUE_11_002: [ If any error occurs, mpsc_queue_create shall fail and return NULL. ]*/
+        LogError("failure allocating MPSC_QUEUE");
+    }
+    else
+    {
+        MPSC_QUEUE_NODE* stub = (MPSC_QUEUE_NODE*)malloc(sizeof(MPSC_QUEUE_NODE));
+        if (stub == NULL)
+        {
+            /* Codes_SRS_MPSC_QUEUE_11_002: [ If any error occurs, mpsc_queue_create shall fail and return NULL. ]*/
+            LogError("failure allocating MPSC_QUEUE_NODE");
+            free(result);
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_MPSC_QUEUE_11_001: [ mpsc_queue_create shall allocate an unbounded queue with an empty stub node as head and tail and return it. ]*/
+            stub->next = NULL;
+            stub->item = NULL;
+            result->tail = stub;
+            result->dequeue_position = 0;
+            result->cells = NULL;
+            result->mask = 0;
+            result->head = stub;
+            result->enqueue_position = 0;
+        }
+    }
+
+    return result;
+}
+
+MPSC_QUEUE_HANDLE mpsc_queue_create_bounded(size_t capacity)
+{
+    MPSC_QUEUE* result;
+
+    if ((capacity == 0) ||
+        (capacity > (SIZE_MAX / 4) / sizeof(MPSC_QUEUE_CELL)))
+    {
+        /* Codes_SRS_MPSC_QUEUE_11_003: [ If capacity is 0, or too big to be rounded up to a power of 2 and allocated, mpsc_queue_create_bounded shall fail and return NULL. ]*/
+        LogError("Invalid arguments: size_t capacity=%lu", (unsigned long)capacity);
+        result = NULL;
+    }
+    else
+    {
+        size_t rounded_capacity = 1;
+        size_t cell_count;
+        while (rounded_capacity < capacity)
+        {
+            rounded_capacity *= 2;
+        }
+        cell_count = (rounded_capacity < 2) ? 2 : rounded_capacity;
+
+        /* Codes_SRS_MPSC_QUEUE_11_004: [ mpsc_queue_create_bounded shall allocate a queue that holds capacity items, rounded up to a power of 2, in a ring of at least 2 cells, set the sequence of every cell to its index and return it. ]*/
+        result = (MPSC_QUEUE*)malloc(sizeof(MPSC_QUEUE) + cell_count * sizeof(MPSC_QUEUE_CELL));
+        if (result == NULL)
+        {
+            /* Codes_SRS_MPSC_QUEUE_11_005: [ If any error occurs, mpsc_queue_create_bounded shall fail and return NULL. ]*/
+            LogError("failure allocating a queue of %lu cells", (unsigned long)cell_count);
+        }
+        else
+        {
+            size_t i;
+
+            result->tail = NULL;
+            result->dequeue_position = 0;
+            result->cells = (MPSC_QUEUE_CELL*)(result + 1);
+            result->mask = cell_count - 1;
+            result->capacity = rounded_capacity;
+            result->head = NULL;
+            result->enqueue_position = 0;
+            for (i = 0; i < cell_count; i++)
+            {
+                result->cells[i].sequence = i;
+                result->cells[i].item = NULL;
+            }
+        }
+    }
+
+    return result;
+}
+
+void mpsc_queue_destroy(MPSC_QUEUE_HANDLE queue)
+{
+    if (queue == NULL)
+    {
+        /* Codes_SRS_MPSC_QUEUE_11_006: [ If queue is NULL, mpsc_queue_destroy shall return. ]*/
+        LogError("Invalid arguments: MPSC_QUEUE_HANDLE queue=%p", queue);
+    }
+    else
+    {
+        /* Codes_SRS_MPSC_QUEUE_11_007: [ mpsc_queue_destroy shall free the nodes of an unbounded queue and the queue. The items left in the queue are not freed. ]*/
+        while (queue->tail != NULL)
+        {
+            MPSC_QUEUE_NODE* node = queue->tail;
+            queue->tail = node->next;
+            free(node);
+        }
+        free(queue);
+    }
+}
+
+static MPSC_QUEUE_RESULT push_node(MPSC_QUEUE* queue, void* item)
+{
+    MPSC_QUEUE_RESULT result;
+    MPSC_QUEUE_NODE* node = (MPSC_QUEUE_NODE*)malloc(sizeof(MPSC_QUEUE_NODE));
+
+    if (node == NULL)
+    {
+        /* Codes_SRS_MPSC_QUEUE_11_010: [ If allocating the node fails, mpsc_queue_push shall fail and return MPSC_QUEUE_ERROR. ]*/
+        LogError("failure allocating MPSC_QUEUE_NODE");
+        result = MPSC_QUEUE_ERROR;
+    }
+    else
+    {
+        MPSC_QUEUE_NODE* previous;
+
+        /* Codes_SRS_MPSC_QUEUE_11_009: [ For an unbounded queue, mpsc_queue_push shall allocate a node for item, swap it into the head of the queue with an atomic exchange, link the previous head to it and return MPSC_QUEUE_OK. ]*/
+        node->next = NULL;
+        node->item = item;
+        previous = (MPSC_QUEUE_NODE*)MPSC_QUEUE_EXCHANGE_POINTER(queue->head, node);
+        /*until this store the consumer sees the queue end at previous*/
+        previous->next = node;
+        result = MPSC_QUEUE_OK;
+    }
+
+    return result;
+}
+
+static MPSC_QUEUE_RESULT push_cell(MPSC_QUEUE* queue, void* item)
+{
+    MPSC_QUEUE_RESULT result;
+    size_t position = queue->enqueue_position;
+
+    for (;;)
+    {
+        MPSC_QUEUE_CELL* cell = &queue->cells[position & queue->mask];
+        size_t sequence = cell->sequence;
+
+        if ((sequence == position) &&
+            (queue->capacity <= queue->mask) &&
+            (queue->cells[(position - queue->capacity) & queue->mask].sequence == position - queue->capacity + 1))
+        {
+            /*the ring has a free cell but the queue already holds capacity items*/
+            /* Codes_SRS_MPSC_QUEUE_11_012: [ If the queue already holds capacity items (rounded up to a power of 2), mpsc_queue_push shall return MPSC_QUEUE_FULL. ]*/
+            result = MPSC_QUEUE_FULL;
+            break;
+        }
+        else if (sequence == position)
+        {
+            if (MPSC_QUEUE_CAS(queue->enqueue_position, position, position + 1))
+            {
+                /* Codes_SRS_MPSC_QUEUE_11_011: [ For a bounded queue, mpsc_queue_push shall claim the cell at the enqueue position by moving the position with a compare and swap, store item in it, publish it by setting its sequence to the position plus 1 and return MPSC_QUEUE_OK. ]*/
+                cell->item = item;
+                MPSC_QUEUE_BARRIER();
+                cell->sequence = position + 1;
+                result = MPSC_QUEUE_OK;
+                break;
+            }
+            /*another producer took it, try the next position*/
+            position = queue->enqueue_position;
+        }
+        else if ((intptr_t)(sequence - position) < 0)
+        {
+            /* Codes_SRS_MPSC_QUEUE_11_012: [ If the queue already holds capacity items (rounded up to a power of 2), mpsc_queue_push shall return MPSC_QUEUE_FULL. ]*/
+            result = MPSC_QUEUE_FULL;
+            break;
+        }
+        else
+        {
+            /*the position moved since it was read*/
+            position = queue->enqueue_position;
+        }
+    }
+
+    return result;
+}
+
+MPSC_QUEUE_RESULT mpsc_queue_push(MPSC_QUEUE_HANDLE queue, void* item)
+{
+    MPSC_QUEUE_RESULT result;
+
+    if ((queue == NULL) ||
+        (item == NULL))
+    {
+        /* Codes_SRS_MPSC_QUEUE_11_008: [ If queue or item is NULL, mpsc_queue_push shall fail and return MPSC_QUEUE_ERROR. ]*/
+        LogError("Invalid arguments: MPSC_QUEUE_HANDLE queue=%p, void* item=%p", queue, item);
+        result = MPSC_QUEUE_ERROR;
+    }
+    else if (queue->cells == NULL)
+    {
+        result = push_node(queue, item);
+    }
+    else
+    {
+        result = push_cell(queue, item);
+    }
+
+    return result;
+}
+
+void* mpsc_queue_pop(MPSC_QUEUE_HANDLE queue)
+{
+    void* result;
+
+    if (queue == NULL)
+    {
+        /* Codes_SRS_MPSC_QUEUE_11_013: [ If queue is NULL, mpsc_queue_pop shall return NULL. ]*/
+        LogError("Invalid arguments: MPSC_QUEUE_HANDLE queue=%p", queue);
+        result = NULL;
+    }
+    else if (queue->cells == NULL)
+    {
+        MPSC_QUEUE_NODE* tail = queue->tail;
+        MPSC_QUEUE_NODE* next = tail->next;
+
+        if (next == NULL)
+        {
+            /* Codes_SRS_MPSC_QUEUE_11_016: [ Otherwise mpsc_queue_pop shall return NULL. A push that has not linked its node or published its cell yet is not seen. ]*/
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_MPSC_QUEUE_11_014: [ For an unbounded queue, if the tail node has a next node, mpsc_queue_pop shall return the item of the next node, make the next node the tail and free the old tail. ]*/
+            MPSC_QUEUE_BARRIER();
+            result = next->item;
+            queue->tail = next;
+            free(tail);
+        }
+    }
+    else
+    {
+        size_t position = queue->dequeue_position;
+        MPSC_QUEUE_CELL* cell = &queue->cells[position & queue->mask];
+
+        if (cell->sequence != position + 1)
+        {
+            /* Codes_SRS_MPSC_QUEUE_11_016: [ Otherwise mpsc_queue_pop shall return NULL. A push that has not linked its node or published its cell yet is not seen. ]*/
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_MPSC_QUEUE_11_015: [ For a bounded queue, if the cell at the dequeue position was published, mpsc_queue_pop shall return its item and set the sequence of the cell one lap ahead so producers can reuse it. ]*/
+            MPSC_QUEUE_BARRIER();
+            result = cell->item;
+            MPSC_QUEUE_BARRIER();
+            cell->sequence = position + queue->mask + 1;
+            queue->dequeue_position = position + 1;
+        }
+    }
+
+    return result;
+}
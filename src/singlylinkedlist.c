@@ -17,19 +17,75 @@ typedef struct SINGLYLINKEDLIST_INSTANCE_TAG
 {
     LIST_ITEM_INSTANCE* head;
     LIST_ITEM_INSTANCE* tail;
+    /*removed nodes kept for the next add, chained through next*/
+    LIST_ITEM_INSTANCE* free_nodes;
+    size_t free_node_count;
+    size_t max_free_nodes;
 } LIST_INSTANCE;
 
+static LIST_ITEM_INSTANCE* allocate_node(LIST_INSTANCE* list_instance)
+{
+    LIST_ITEM_INSTANCE* result;
+
+    if (list_instance->free_nodes != NULL)
+    {
+        /* Codes_SRS_LIST_11_004: [ singlylinkedlist_add and singlylinkedlist_add_head shall take the node from the nodes kept by the list when there is one. ] */
+        result = list_instance->free_nodes;
+        list_instance->free_nodes = (LIST_ITEM_INSTANCE*)result->next;
+        list_instance->free_node_count--;
+    }
+    else
+    {
+        /* Codes_SRS_LIST_11_005: [ Otherwise singlylinkedlist_add and singlylinkedlist_add_head shall allocate a new node. ] */
+        result = (LIST_ITEM_INSTANCE*)malloc(sizeof(LIST_ITEM_INSTANCE));
+    }
+
+    return result;
+}
+
+static void release_node(LIST_INSTANCE* list_instance, LIST_ITEM_INSTANCE* node)
+{
+    if (list_instance->free_node_count < list_instance->max_free_nodes)
+    {
+        /* Codes_SRS_LIST_11_006: [ singlylinkedlist_remove and singlylinkedlist_remove_if shall keep the removed node for reuse when the list keeps fewer than max_pooled_nodes nodes. ] */
+        node->item = NULL;
+        node->next = list_instance->free_nodes;
+        list_instance->free_nodes = node;
+        list_instance->free_node_count++;
+    }
+    else
+    {
+        /* Codes_SRS_LIST_11_007: [ Otherwise singlylinkedlist_remove and singlylinkedlist_remove_if shall free the removed node. ] */
+        free(node);
+    }
+}
+
 SINGLYLINKEDLIST_HANDLE singlylinkedlist_create(void)
+{
+    /* Codes_SRS_LIST_11_003: [ singlylinkedlist_create shall create a list that does not keep removed nodes, as singlylinkedlist_create_with_node_pool with max_pooled_nodes 0 does. ] */
+    return singlylinkedlist_create_with_node_pool(0);
+}
+
+SINGLYLINKEDLIST_HANDLE singlylinkedlist_create_with_node_pool(size_t max_pooled_nodes)
 {
     LIST_INSTANCE* result;
 
     /* Codes_SRS_LIST_01_001: [singlylinkedlist_create shall create a new list and return a non-NULL handle on success.] */
+    /* Codes_SRS_LIST_11_001: [ singlylinkedlist_create_with_node_pool shall create a new list that keeps up to max_pooled_nodes removed nodes for reuse and return a non-NULL handle on success. ] */
     result = (LIST_INSTANCE*)malloc(sizeof(LIST_INSTANCE));
-    if (result != NULL)
+    if (result == NULL)
     {
         /* Codes_SRS_LIST_01_002: [If any error occurs during the list creation, singlylinkedlist_create shall return NULL.] */
+        /* Codes_SRS_LIST_11_002: [ If any error occurs, singlylinkedlist_create_with_node_pool shall return NULL. ] */
+        LogError("failure in malloc");
+    }
+    else
+    {
         result->head = NULL;
         result->tail = NULL;
+        result->free_nodes = NULL;
+        result->free_node_count = 0;
+        result->max_free_nodes = max_pooled_nodes;
     }
 
     return result;
@@ -49,6 +105,14 @@ void singlylinkedlist_destroy(SINGLYLINKEDLIST_HANDLE list)
             free(current_item);
         }
 
+        /* Codes_SRS_LIST_11_008: [ singlylinkedlist_destroy shall also free the nodes kept by the list for reuse. ] */
+        while (list_instance->free_nodes != NULL)
+        {
+            LIST_ITEM_INSTANCE* current_item = list_instance->free_nodes;
+            list_instance->free_nodes = (LIST_ITEM_INSTANCE*)current_item->next;
+            free(current_item);
+        }
+
         /* Codes_SRS_LIST_01_003: [singlylinkedlist_destroy shall free all resources associated with the list identified by the handle argument.] */
         free(list_instance);
     }
@@ -68,7 +132,7 @@ LIST_ITEM_HANDLE singlylinkedlist_add(SINGLYLINKEDLIST_HANDLE list, const void*
     else
     {
         LIST_INSTANCE* list_instance = (LIST_INSTANCE*)list;
-        result = (LIST_ITEM_INSTANCE*)malloc(sizeof(LIST_ITEM_INSTANCE));
+        result = allocate_node(list_instance);
 
         if (result == NULL)
         {
@@ -132,7 +196,7 @@ int singlylinkedlist_remove(SINGLYLINKEDLIST_HANDLE list, LIST_ITEM_HANDLE item)
                     list_instance->tail = previous_item;
                 }
 
-                free(current_item);
+                release_node(list_instance, current_item);
 
                 break;
             }
@@ -303,7 +367,7 @@ int singlylinkedlist_remove_if(SINGLYLINKEDLIST_HANDLE list, LIST_CONDITION_FUNC
                     list_instance->tail = previous_item;
                 }
 
-                free(current_item);
+                release_node(list_instance, current_item);
             }
             /* Codes_SRS_LIST_09_005: [ If the condition function returns false, singlylinkedlist_find shall consider that item as not to be removed. ] */
             else
@@ -378,7 +442,7 @@ LIST_ITEM_HANDLE singlylinkedlist_add_head(SINGLYLINKEDLIST_HANDLE list, const v
     }
     else
     {
-        result = malloc(sizeof(LIST_ITEM_INSTANCE));
+        result = allocate_node(list);
 
         if (result == NULL)
         {
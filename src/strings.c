@@ -21,31 +21,190 @@
 
 static const char hexToASCII[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
 
+/*strings that fit here (including the '\0') are kept in the STRING itself and need no second allocation*/
+#ifndef STRINGS_C_INLINE_BUFFER_SIZE
+#define STRINGS_C_INLINE_BUFFER_SIZE 24
+#endif
+
 typedef struct STRING_TAG
 {
-    char* s;
+    char* s; /*inlineBuffer or a heap block*/
+    size_t length; /*strlen(s), every function that changes s keeps it up to date*/
+    size_t capacity; /*bytes available in s, including the '\0'*/
+    char inlineBuffer[STRINGS_C_INLINE_BUFFER_SIZE];
 } STRING;
 
-/*this function will allocate a new string with just '\0' in it*/
-/*return NULL if it fails*/
-/* Codes_SRS_STRING_07_001: [STRING_new shall allocate a new STRING_HANDLE pointing to an empty string.] */
-STRING_HANDLE STRING_new(void)
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+/*allocates a STRING with room for capacity bytes (including the '\0'), the content is left to the caller*/
+static STRING* string_allocate(size_t capacity)
 {
-    STRING* result;
-    if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
+    STRING* result = (STRING*)malloc(sizeof(STRING));
+    if (result == NULL)
+    {
+        LogError("Failure allocating STRING.");
+    }
+    else if (capacity <= STRINGS_C_INLINE_BUFFER_SIZE)
+    {
+        result->s = result->inlineBuffer;
+        result->capacity = STRINGS_C_INLINE_BUFFER_SIZE;
+    }
+    else if ((result->s = (char*)malloc(capacity)) == NULL)
     {
-        if ((result->s = (char*)malloc(1)) != NULL)
+        LogError("Failure allocating value.");
+        free(result);
+        result = NULL;
+    }
+    else
+    {
+        result->capacity = capacity;
+    }
+    return result;
+}
+
+static void string_free(STRING* str)
+{
+    if (str->s != str->inlineBuffer)
+    {
+        free(str->s);
+    }
+    free(str);
+}
+
+/*moves the content to a buffer of capacity bytes, which can be the inline one when the content fits there*/
+static int string_resize(STRING* str, size_t capacity)
+{
+    int result;
+    if (capacity <= STRINGS_C_INLINE_BUFFER_SIZE)
+    {
+        if (str->s != str->inlineBuffer)
         {
-            result->s[0] = '\0';
+            (void)memcpy(str->inlineBuffer, str->s, str->length + 1);
+            free(str->s);
+            str->s = str->inlineBuffer;
+            str->capacity = STRINGS_C_INLINE_BUFFER_SIZE;
+        }
+        result = 0;
+    }
+    else if (str->s == str->inlineBuffer)
+    {
+        char* temp = (char*)malloc(capacity);
+        if (temp == NULL)
+        {
+            LogError("Failure allocating value.");
+            result = __FAILURE__;
         }
         else
         {
-            /* Codes_SRS_STRING_07_002: [STRING_new shall return an NULL STRING_HANDLE on any error that is encountered.] */
-            LogError("Failure allocating in STRING_new.");
-            free(result);
-            result = NULL;
+            (void)memcpy(temp, str->s, str->length + 1);
+            str->s = temp;
+            str->capacity = capacity;
+            result = 0;
         }
     }
+    else
+    {
+        char* temp = (char*)realloc(str->s, capacity);
+        if (temp == NULL)
+        {
+            LogError("Failure reallocating value.");
+            result = __FAILURE__;
+        }
+        else
+        {
+            str->s = temp;
+            str->capacity = capacity;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+/*makes room for required bytes (including the '\0'), appending doubles the capacity so that N appends cost O(N) copies instead of O(N^2)*/
+static int string_grow(STRING* str, size_t required)
+{
+    int result;
+    if (required <= str->capacity)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t newCapacity = (str->capacity > SIZE_MAX / 2) ? required : str->capacity * 2;
+        if (newCapacity < required)
+        {
+            newCapacity = required;
+        }
+        result = string_resize(str, newCapacity);
+    }
+    return result;
+}
+
+/*compilers that predate C99 copy a va_list by assignment*/
+#ifndef va_copy
+#define va_copy(destination, source) ((destination) = (source))
+#endif
+
+/*formats at the end of str straight into its spare capacity, only when the result does not fit there the capacity is grown and the formatting is done again*/
+static int string_append_vsprintf(STRING* str, const char* format, va_list arg_list)
+{
+    int result;
+    int appendLength;
+    va_list retry_arg_list;
+
+    va_copy(retry_arg_list, arg_list);
+    appendLength = vsnprintf(str->s + str->length, str->capacity - str->length, format, arg_list);
+    if (appendLength < 0)
+    {
+        LogError("Failure vsnprintf return < 0");
+        str->s[str->length] = '\0';
+        result = __FAILURE__;
+    }
+    else if ((size_t)appendLength < str->capacity - str->length)
+    {
+        str->length += appendLength;
+        result = 0;
+    }
+    else if (string_grow(str, str->length + appendLength + 1) != 0)
+    {
+        LogError("Failure unable to reallocate memory");
+        str->s[str->length] = '\0';
+        result = __FAILURE__;
+    }
+    else if (vsnprintf(str->s + str->length, appendLength + 1, format, retry_arg_list) != appendLength)
+    {
+        LogError("Failure vsnprintf formatting error");
+        str->s[str->length] = '\0';
+        result = __FAILURE__;
+    }
+    else
+    {
+        str->length += appendLength;
+        result = 0;
+    }
+    va_end(retry_arg_list);
+    return result;
+}
+
+/*this function will allocate a new string with just '\0' in it*/
+/*return NULL if it fails*/
+/* Codes_SRS_STRING_07_001: [STRING_new shall allocate a new STRING_HANDLE pointing to an empty string.] */
+STRING_HANDLE STRING_new(void)
+{
+    /* Codes_SRS_STRING_11_013: [ Strings that fit in STRINGS_C_INLINE_BUFFER_SIZE bytes (24 by default) including the '\0' shall be kept in the STRING itself, so that creating them takes a single allocation. ]*/
+    STRING* result = string_allocate(1);
+    if (result == NULL)
+    {
+        /* Codes_SRS_STRING_07_002: [STRING_new shall return an NULL STRING_HANDLE on any error that is encountered.] */
+        LogError("Failure allocating in STRING_new.");
+    }
+    else
+    {
+        result->s[0] = '\0';
+        result->length = 0;
+    }
     return (STRING_HANDLE)result;
 }
 
@@ -60,26 +219,16 @@ STRING_HANDLE STRING_clone(STRING_HANDLE handle)
     }
     else
     {
+        STRING* source = (STRING*)handle;
         /*Codes_SRS_STRING_02_003: [If STRING_clone fails for any reason, it shall return NULL.] */
-        if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
+        if ((result = string_allocate(source->length + 1)) == NULL)
         {
-            STRING* source = (STRING*)handle;
-            /*Codes_SRS_STRING_02_003: [If STRING_clone fails for any reason, it shall return NULL.] */
-            size_t sourceLen = strlen(source->s);
-            if ((result->s = (char*)malloc(sourceLen + 1)) == NULL)
-            {
-                LogError("Failure allocating clone value.");
-                free(result);
-                result = NULL;
-            }
-            else
-            {
-                (void)memcpy(result->s, source->s, sourceLen + 1);
-            }
+            LogError("Failure allocating clone value.");
         }
         else
         {
-            /*not much to do, result is NULL from malloc*/
+            (void)memcpy(result->s, source->s, source->length + 1);
+            result->length = source->length;
         }
     }
     return (STRING_HANDLE)result;
@@ -96,28 +245,19 @@ STRING_HANDLE STRING_construct(const char* psz)
     }
     else
     {
-        STRING* str;
-        if ((str = (STRING*)malloc(sizeof(STRING))) != NULL)
+        size_t nLen = strlen(psz) + 1;
+        STRING* str = string_allocate(nLen);
+        if (str == NULL)
         {
-            size_t nLen = strlen(psz) + 1;
-            if ((str->s = (char*)malloc(nLen)) != NULL)
-            {
-                (void)memcpy(str->s, psz, nLen);
-                result = (STRING_HANDLE)str;
-            }
             /* Codes_SRS_STRING_07_032: [STRING_construct encounters any error it shall return a NULL value.] */
-            else
-            {
-                LogError("Failure allocating constructed value.");
-                free(str);
-                result = NULL;
-            }
+            LogError("Failure allocating constructed value.");
+            result = NULL;
         }
         else
         {
-            /* Codes_SRS_STRING_07_032: [STRING_construct encounters any error it shall return a NULL value.] */
-            LogError("Failure allocating value.");
-            result = NULL;
+            (void)memcpy(str->s, psz, nLen);
+            str->length = nLen - 1;
+            result = (STRING_HANDLE)str;
         }
     }
     return result;
@@ -130,68 +270,36 @@ STRING_HANDLE STRING_construct_sprintf(const char* format, ...)
 {
     STRING* result;
 
-#ifdef STRINGS_C_SPRINTF_BUFFER_SIZE
-    size_t maxBufSize = STRINGS_C_SPRINTF_BUFFER_SIZE;
-    char buf[STRINGS_C_SPRINTF_BUFFER_SIZE];
-#else
-    size_t maxBufSize = 0;
-    char* buf = NULL;
-#endif
-
     if (format != NULL)
     {
-        va_list arg_list;
-        int length;
-        va_start(arg_list, format);
-
         /* Codes_SRS_STRING_07_041: [STRING_construct_sprintf shall determine the size of the resulting string and allocate the necessary memory.] */
-        length = vsnprintf(buf, maxBufSize, format, arg_list);
-        va_end(arg_list);
-        if (length > 0)
+        /* Codes_SRS_STRING_11_015: [ STRING_construct_sprintf and STRING_sprintf shall format directly into the memory the STRING already has and only when the result does not fit there grow it and format again. ]*/
+        result = string_allocate(0);
+        if (result != NULL)
         {
-            result = (STRING*)malloc(sizeof(STRING));
-            if (result != NULL)
-            {
-                result->s = (char*)malloc(length+1);
-                if (result->s != NULL)
-                {
-                    va_start(arg_list, format);
-                    if (vsnprintf(result->s, length+1, format, arg_list) < 0)
-                    {
-                        /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
-                        free(result->s);
-                        free(result);
-                        result = NULL;
-                        LogError("Failure: vsnprintf formatting failed.");
-                    }
-                    va_end(arg_list);
-                }
-                else
-                {
-                    /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
-                    free(result);
-                    result = NULL;
-                    LogError("Failure: allocation sprintf value failed.");
-                }
-            }
-            else
+            va_list arg_list;
+            result->length = 0;
+            result->s[0] = '\0';
+
+            va_start(arg_list, format);
+            if (string_append_vsprintf(result, format, arg_list) != 0)
             {
-                LogError("Failure: allocation failed.");
+                /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
+                LogError("Failure: formatting sprintf value failed.");
+                string_free(result);
+                result = NULL;
             }
-        }
-        else if (length == 0)
-        {
-            result = (STRING*)STRING_new();
+            va_end(arg_list);
         }
         else
         {
-            /* Codes_SRS_STRING_07_039: [If the parameter format is NULL then STRING_construct_sprintf shall return NULL.] */
-            result = NULL;
-            LogError("Failure: vsnprintf return 0 length");
+            /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
+            LogError("Failure: allocation sprintf value failed.");
         }
     }
     else
     {
+        /* Codes_SRS_STRING_07_039: [If the parameter format is NULL then STRING_construct_sprintf shall return NULL.] */
         LogError("Failure: invalid argument.");
         result = NULL;
     }
@@ -216,6 +324,8 @@ STRING_HANDLE STRING_new_with_memory(const char* memory)
         if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
         {
             result->s = (char*)memory;
+            result->length = strlen(memory);
+            result->capacity = result->length + 1;
         }
         else
         {
@@ -234,22 +344,21 @@ STRING_HANDLE STRING_new_quoted(const char* source)
         /* Codes_SRS_STRING_07_009: [STRING_new_quoted shall return a NULL STRING_HANDLE if the supplied const char* is NULL.] */
         result = NULL;
     }
-    else if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
+    else
     {
         size_t sourceLength = strlen(source);
-        if ((result->s = (char*)malloc(sourceLength + 3)) != NULL)
+        if ((result = string_allocate(sourceLength + 3)) != NULL)
         {
             result->s[0] = '"';
             (void)memcpy(result->s + 1, source, sourceLength);
             result->s[sourceLength + 1] = '"';
             result->s[sourceLength + 2] = '\0';
+            result->length = sourceLength + 2;
         }
         else
         {
             /* Codes_SRS_STRING_07_031: [STRING_new_quoted shall return a NULL STRING_HANDLE if any error is encountered.] */
             LogError("Failure allocating quoted string value.");
-            free(result);
-            result = NULL;
         }
     }
     return (STRING_HANDLE)result;
@@ -305,18 +414,11 @@ STRING_HANDLE STRING_new_JSON(const char* source)
         }
         else
         {
-            if ((result = (STRING*)malloc(sizeof(STRING))) == NULL)
+            if ((result = string_allocate(vlen + 5 * nControlCharacters + nEscapeCharacters + 3)) == NULL)
             {
                 /*Codes_SRS_STRING_02_021: [If the complete JSON representation cannot be produced, then STRING_new_JSON shall fail and return NULL.] */
                 LogError("malloc json failure");
             }
-            else if ((result->s = (char*)malloc(vlen + 5 * nControlCharacters + nEscapeCharacters + 3)) == NULL)
-            {
-                /*Codes_SRS_STRING_02_021: [If the complete JSON representation cannot be produced, then STRING_new_JSON shall fail and return NULL.] */
-                free(result);
-                result = NULL;
-                LogError("malloc failed");
-            }
             else
             {
                 size_t pos = 0;
@@ -362,6 +464,7 @@ STRING_HANDLE STRING_new_JSON(const char* source)
                 result->s[pos++] = '"';
                 /*zero terminating it*/
                 result->s[pos] = '\0';
+                result->length = pos;
             }
         }
 
@@ -384,19 +487,18 @@ int STRING_concat(STRING_HANDLE handle, const char* s2)
     else
     {
         STRING* s1 = (STRING*)handle;
-        size_t s1Length = strlen(s1->s);
+        size_t s1Length = s1->length;
         size_t s2Length = strlen(s2);
-        char* temp = (char*)realloc(s1->s, s1Length + s2Length + 1);
-        if (temp == NULL)
+        /* Codes_SRS_STRING_11_001: [ When the string needs more memory, STRING_concat, STRING_concat_with_STRING, STRING_quote and STRING_sprintf shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+        if (string_grow(s1, s1Length + s2Length + 1) != 0)
         {
             /* Codes_SRS_STRING_07_013: [STRING_concat shall return a nonzero number if an error is encountered.] */
-            LogError("Failure reallocating value.");
             result = __FAILURE__;
         }
         else
         {
-            s1->s = temp;
             (void)memcpy(s1->s + s1Length, s2, s2Length + 1);
+            s1->length = s1Length + s2Length;
             result = 0;
         }
     }
@@ -421,20 +523,19 @@ int STRING_concat_with_STRING(STRING_HANDLE s1, STRING_HANDLE s2)
         STRING* dest = (STRING*)s1;
         STRING* src = (STRING*)s2;
 
-        size_t s1Length = strlen(dest->s);
-        size_t s2Length = strlen(src->s);
-        char* temp = (char*)realloc(dest->s, s1Length + s2Length + 1);
-        if (temp == NULL)
+        size_t s1Length = dest->length;
+        size_t s2Length = src->length;
+        /* Codes_SRS_STRING_11_001: [ When the string needs more memory, STRING_concat, STRING_concat_with_STRING, STRING_quote and STRING_sprintf shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+        if (string_grow(dest, s1Length + s2Length + 1) != 0)
         {
             /* Codes_SRS_STRING_07_035: [String_Concat_with_STRING shall return a nonzero number if an error is encountered.] */
-            LogError("Failure reallocating value");
             result = __FAILURE__;
         }
         else
         {
-            dest->s = temp;
             /* Codes_SRS_STRING_07_034: [String_Concat_with_STRING shall concatenate a given STRING_HANDLE variable with a source STRING_HANDLE.] */
             (void)memcpy(dest->s + s1Length, src->s, s2Length + 1);
+            dest->length = s1Length + s2Length;
             result = 0;
         }
     }
@@ -460,17 +561,16 @@ int STRING_copy(STRING_HANDLE handle, const char* s2)
         if (s1->s != s2)
         {
             size_t s2Length = strlen(s2);
-            char* temp = (char*)realloc(s1->s, s2Length + 1);
-            if (temp == NULL)
+            /* Codes_SRS_STRING_11_002: [ STRING_copy, STRING_copy_n and STRING_empty shall keep the memory of the string when it is big enough and otherwise grow it to the needed size. ]*/
+            if ((s2Length + 1 > s1->capacity) && (string_resize(s1, s2Length + 1) != 0))
             {
-                LogError("Failure reallocating value.");
                 /* Codes_SRS_STRING_07_027: [STRING_copy shall return a nonzero value if any error is encountered.] */
                 result = __FAILURE__;
             }
             else
             {
-                s1->s = temp;
                 memmove(s1->s, s2, s2Length + 1);
+                s1->length = s2Length;
                 result = 0;
             }
         }
@@ -499,24 +599,22 @@ int STRING_copy_n(STRING_HANDLE handle, const char* s2, size_t n)
     {
         STRING* s1 = (STRING*)handle;
         size_t s2Length = strlen(s2);
-        char* temp;
         if (s2Length > n)
         {
             s2Length = n;
         }
 
-        temp = (char*)realloc(s1->s, s2Length + 1);
-        if (temp == NULL)
+        /* Codes_SRS_STRING_11_002: [ STRING_copy, STRING_copy_n and STRING_empty shall keep the memory of the string when it is big enough and otherwise grow it to the needed size. ]*/
+        if ((s2Length + 1 > s1->capacity) && (string_resize(s1, s2Length + 1) != 0))
         {
-            LogError("Failure reallocating value.");
             /* Codes_SRS_STRING_07_028: [STRING_copy_n shall return a nonzero value if any error is encountered.] */
             result = __FAILURE__;
         }
         else
         {
-            s1->s = temp;
             (void)memcpy(s1->s, s2, s2Length);
             s1->s[s2Length] = 0;
+            s1->length = s2Length;
             result = 0;
         }
 
@@ -531,14 +629,6 @@ int STRING_sprintf(STRING_HANDLE handle, const char* format, ...)
 {
     int result;
 
-#ifdef STRINGS_C_SPRINTF_BUFFER_SIZE
-    size_t maxBufSize = STRINGS_C_SPRINTF_BUFFER_SIZE;
-    char buf[STRINGS_C_SPRINTF_BUFFER_SIZE];
-#else
-    size_t maxBufSize = 0;
-    char* buf = NULL;
-#endif
-
     if (handle == NULL || format == NULL)
     {
         /* Codes_SRS_STRING_07_042: [if the parameters s1 or format are NULL then STRING_sprintf shall return non zero value.] */
@@ -548,53 +638,22 @@ int STRING_sprintf(STRING_HANDLE handle, const char* format, ...)
     else
     {
         va_list arg_list;
-        int s2Length;
         va_start(arg_list, format);
-
-        s2Length = vsnprintf(buf, maxBufSize, format, arg_list);
-        va_end(arg_list);
-        if (s2Length < 0)
+        /* Codes_SRS_STRING_11_001: [ When the string needs more memory, STRING_concat, STRING_concat_with_STRING, STRING_quote and STRING_sprintf shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+        /* Codes_SRS_STRING_11_015: [ STRING_construct_sprintf and STRING_sprintf shall format directly into the memory the STRING already has and only when the result does not fit there grow it and format again. ]*/
+        if (string_append_vsprintf((STRING*)handle, format, arg_list) != 0)
         {
             /* Codes_SRS_STRING_07_043: [If any error is encountered STRING_sprintf shall return a non zero value.] */
-            LogError("Failure vsnprintf return < 0");
+            /* Codes_SRS_STRING_11_016: [ If STRING_sprintf fails, the content of the string shall be left unchanged. ]*/
+            LogError("Failure appending the formatted value");
             result = __FAILURE__;
         }
-        else if (s2Length == 0)
-        {
-            // Don't need to reallocate and nothing should be added
-            result = 0;
-        }
         else
         {
-            STRING* s1 = (STRING*)handle;
-            char* temp;
-            size_t s1Length = strlen(s1->s);
-            temp = (char*)realloc(s1->s, s1Length + s2Length + 1);
-            if (temp != NULL)
-            {
-                s1->s = temp;
-                va_start(arg_list, format);
-                if (vsnprintf(s1->s + s1Length, s1Length + s2Length + 1, format, arg_list) < 0)
-                {
-                    /* Codes_SRS_STRING_07_043: [If any error is encountered STRING_sprintf shall return a non zero value.] */
-                    LogError("Failure vsnprintf formatting error");
-                    s1->s[s1Length] = '\0';
-                    result = __FAILURE__;
-                }
-                else
-                {
-                    /* Codes_SRS_STRING_07_044: [On success STRING_sprintf shall return 0.]*/
-                    result = 0;
-                }
-                va_end(arg_list);
-            }
-            else
-            {
-                /* Codes_SRS_STRING_07_043: [If any error is encountered STRING_sprintf shall return a non zero value.] */
-                LogError("Failure unable to reallocate memory");
-                result = __FAILURE__;
-            }
+            /* Codes_SRS_STRING_07_044: [On success STRING_sprintf shall return 0.]*/
+            result = 0;
         }
+        va_end(arg_list);
     }
     return result;
 }
@@ -614,21 +673,20 @@ int STRING_quote(STRING_HANDLE handle)
     else
     {
         STRING* s1 = (STRING*)handle;
-        size_t s1Length = strlen(s1->s);
-        char* temp = (char*)realloc(s1->s, s1Length + 2 + 1);/*2 because 2 quotes, 1 because '\0'*/
-        if (temp == NULL)
+        size_t s1Length = s1->length;
+        /* Codes_SRS_STRING_11_001: [ When the string needs more memory, STRING_concat, STRING_concat_with_STRING, STRING_quote and STRING_sprintf shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+        if (string_grow(s1, s1Length + 2 + 1) != 0)/*2 because 2 quotes, 1 because '\0'*/
         {
-            LogError("Failure reallocating value.");
             /* Codes_SRS_STRING_07_029: [STRING_quote shall return a nonzero value if any error is encountered.] */
             result = __FAILURE__;
         }
         else
         {
-            s1->s = temp;
             memmove(s1->s + 1, s1->s, s1Length);
             s1->s[0] = '"';
             s1->s[s1Length + 1] = '"';
             s1->s[s1Length + 2] = '\0';
+            s1->length = s1Length + 2;
             result = 0;
         }
     }
@@ -647,20 +705,11 @@ int STRING_empty(STRING_HANDLE handle)
     }
     else
     {
+        /* Codes_SRS_STRING_11_002: [ STRING_copy, STRING_copy_n and STRING_empty shall keep the memory of the string when it is big enough and otherwise grow it to the needed size. ]*/
         STRING* s1 = (STRING*)handle;
-        char* temp = (char*)realloc(s1->s, 1);
-        if (temp == NULL)
-        {
-            LogError("Failure reallocating value.");
-            /* Codes_SRS_STRING_07_030: [STRING_empty shall return a nonzero value if the STRING_HANDLE is NULL.] */
-            result = __FAILURE__;
-        }
-        else
-        {
-            s1->s = temp;
-            s1->s[0] = '\0';
-            result = 0;
-        }
+        s1->s[0] = '\0';
+        s1->length = 0;
+        result = 0;
     }
     return result;
 }
@@ -673,9 +722,7 @@ void STRING_delete(STRING_HANDLE handle)
     if (handle != NULL)
     {
         STRING* value = (STRING*)handle;
-        free(value->s);
-        value->s = NULL;
-        free(value);
+        string_free(value);
     }
 }
 
@@ -703,7 +750,8 @@ size_t STRING_length(STRING_HANDLE handle)
     if (handle != NULL)
     {
         STRING* value = (STRING*)handle;
-        result = strlen(value->s);
+        /* Codes_SRS_STRING_11_011: [ STRING_length shall return the length kept by the string without scanning it. ]*/
+        result = value->length;
     }
     return result;
 }
@@ -730,25 +778,17 @@ STRING_HANDLE STRING_construct_n(const char* psz, size_t n)
         else
         {
             STRING* str;
-            if ((str = (STRING*)malloc(sizeof(STRING))) != NULL)
+            if ((str = string_allocate(n + 1)) != NULL)
             {
-                if ((str->s = (char*)malloc(len + 1)) != NULL)
-                {
-                    (void)memcpy(str->s, psz, n);
-                    str->s[n] = '\0';
-                    result = (STRING_HANDLE)str;
-                }
-                /* Codes_SRS_STRING_02_010: [In all other error cases, STRING_construct_n shall return NULL.]  */
-                else
-                {
-                    LogError("Failure allocating value.");
-                    free(str);
-                    result = NULL;
-                }
+                (void)memcpy(str->s, psz, n);
+                str->s[n] = '\0';
+                str->length = n;
+                result = (STRING_HANDLE)str;
             }
             else
             {
                 /* Codes_SRS_STRING_02_010: [In all other error cases, STRING_construct_n shall return NULL.]  */
+                LogError("Failure allocating value.");
                 result = NULL;
             }
         }
@@ -780,7 +820,10 @@ int STRING_compare(STRING_HANDLE s1, STRING_HANDLE s2)
         /* Codes_SRS_STRING_07_038: [STRING_compare shall compare the char s variable using the strcmp function.] */
         STRING* value1 = (STRING*)s1;
         STRING* value2 = (STRING*)s2;
-        result = strcmp(value1->s, value2->s);
+        /* Codes_SRS_STRING_11_012: [ STRING_compare shall compare the strings with memcmp up to the '\0' of the shorter one, which gives the same result as strcmp without scanning for the lengths. ]*/
+        size_t length = (value1->length < value2->length) ? value1->length : value2->length;
+        result = memcmp(value1->s, value2->s, length + 1);
+        result = (result < 0) ? -1 : ((result > 0) ? 1 : 0);
     }
     return result;
 }
@@ -797,7 +840,7 @@ STRING_HANDLE STRING_from_byte_array(const unsigned char* source, size_t size)
     else
     {
         /*Codes_SRS_STRING_02_023: [ Otherwise, STRING_from_BUFFER shall build a string that has the same content (byte-by-byte) as source and return a non-NULL handle. ]*/
-        result = (STRING*)malloc(sizeof(STRING));
+        result = string_allocate(size + 1);
         if (result == NULL)
         {
             /*Codes_SRS_STRING_02_024: [ If building the string fails, then STRING_from_BUFFER shall fail and return NULL. ]*/
@@ -806,20 +849,10 @@ STRING_HANDLE STRING_from_byte_array(const unsigned char* source, size_t size)
         }
         else
         {
-            /*Codes_SRS_STRING_02_023: [ Otherwise, STRING_from_BUFFER shall build a string that has the same content (byte-by-byte) as source and return a non-NULL handle. ]*/
-            result->s = (char*)malloc(size + 1);
-            if (result->s == NULL)
-            {
-                /*Codes_SRS_STRING_02_024: [ If building the string fails, then STRING_from_BUFFER shall fail and return NULL. ]*/
-                LogError("oom - unable to malloc");
-                free(result);
-                result = NULL;
-            }
-            else
-            {
-                (void)memcpy(result->s, source, size);
-                result->s[size] = '\0'; /*all is fine*/
-            }
+            (void)memcpy(result->s, source, size);
+            result->s[size] = '\0'; /*all is fine*/
+            /*source can contain '\0', the string ends at the first one*/
+            result->length = strlen(result->s);
         }
     }
     return (STRING_HANDLE)result;
@@ -844,7 +877,7 @@ int STRING_replace(STRING_HANDLE handle, char target, char replace)
         size_t index;
         /* Codes_SRS_STRING_07_047: [ STRING_replace shall replace all instances of target with replace. ] */
         STRING* str_value = (STRING*)handle;
-        length = strlen(str_value->s);
+        length = str_value->length;
         for (index = 0; index < length; index++)
         {
             if (str_value->s[index] == target)
@@ -852,8 +885,83 @@ int STRING_replace(STRING_HANDLE handle, char target, char replace)
                 str_value->s[index] = replace;
             }
         }
+        if (replace == '\0')
+        {
+            /*the string now ends at the first replaced character*/
+            str_value->length = strlen(str_value->s);
+        }
         /* Codes_SRS_STRING_07_049: [ On success STRING_replace shall return zero. ] */
         result = 0;
     }
     return result;
 }
+
+int STRING_reserve(STRING_HANDLE handle, size_t capacity)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_STRING_11_003: [ If handle is NULL, STRING_reserve shall fail and return a non-zero value. ]*/
+        LogError("Invalid arg (NULL)");
+        result = __FAILURE__;
+    }
+    else if (capacity == SIZE_MAX)
+    {
+        /* Codes_SRS_STRING_11_006: [ If any error occurs, STRING_reserve shall fail, leave the string unchanged and return a non-zero value. ]*/
+        LogError("Invalid arg (capacity too big)");
+        result = __FAILURE__;
+    }
+    else
+    {
+        STRING* str = (STRING*)handle;
+        if (capacity + 1 <= str->capacity)
+        {
+            /* Codes_SRS_STRING_11_005: [ If the string can already hold capacity characters, STRING_reserve shall do nothing and return 0. ]*/
+            result = 0;
+        }
+        /* Codes_SRS_STRING_11_004: [ STRING_reserve shall grow the memory of the string so that it can hold capacity characters without reallocating, and return 0. ]*/
+        else if (string_resize(str, capacity + 1) != 0)
+        {
+            /* Codes_SRS_STRING_11_006: [ If any error occurs, STRING_reserve shall fail, leave the string unchanged and return a non-zero value. ]*/
+            result = __FAILURE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int STRING_shrink_to_fit(STRING_HANDLE handle)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_STRING_11_007: [ If handle is NULL, STRING_shrink_to_fit shall fail and return a non-zero value. ]*/
+        LogError("Invalid arg (NULL)");
+        result = __FAILURE__;
+    }
+    else
+    {
+        STRING* str = (STRING*)handle;
+        size_t length = str->length;
+        if ((str->s == str->inlineBuffer) || (length + 1 == str->capacity))
+        {
+            /* Codes_SRS_STRING_11_009: [ If the string has no spare memory, STRING_shrink_to_fit shall do nothing and return 0. ]*/
+            result = 0;
+        }
+        /* Codes_SRS_STRING_11_008: [ STRING_shrink_to_fit shall reallocate the memory of the string to the length of the string plus the '\0' and return 0. ]*/
+        /* Codes_SRS_STRING_11_014: [ When the string fits in the STRING again, STRING_shrink_to_fit shall move it there and free its memory. ]*/
+        else if (string_resize(str, length + 1) != 0)
+        {
+            /* Codes_SRS_STRING_11_010: [ If reallocating fails, STRING_shrink_to_fit shall leave the string unchanged and return a non-zero value. ]*/
+            result = __FAILURE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,673 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*
+A thread pool with a queue of work per worker.
+
+threadpool_submit hands the work to the workers in turn, so submitting threads spread their locking over all the
+queues. A worker takes the oldest work from its own queue. When its queue is empty it steals half of the work at
+the end of the queue of another worker (the newest work, the victim keeps the oldest) and runs it. Every queue has
+its own lock, which is only contended when a thief and the owner meet.
+
+A worker that finds no work anywhere parks on a condition. The pool counts the work that was submitted and not
+taken yet (pending) and the parked workers (sleeping). A submitter increments pending before it reads sleeping and
+a worker increments sleeping before it reads pending, both with full barriers, so either the submitter sees the
+worker and wakes it or the worker sees the work and does not park.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/condition.h"
+#include "azure_c_shared_utility/threadapi.h"
+#include "azure_c_shared_utility/threadpool.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+/*the same atomic operations refcount_os.h picks for the platform, on a long since that is what Interlocked works on*/
+#if defined(_WIN32)
+#include "windows.h"
+#define THREADPOOL_INCREMENT(var) InterlockedIncrement(&(var))
+#define THREADPOOL_DECREMENT(var) InterlockedDecrement(&(var))
+#define THREADPOOL_ADD(var, value) (InterlockedExchangeAdd(&(var), (value)) + (value))
+#elif defined(__GNUC__)
+#define THREADPOOL_INCREMENT(var) __sync_add_and_fetch(&(var), 1)
+#define THREADPOOL_DECREMENT(var) __sync_sub_and_fetch(&(var), 1)
+#define THREADPOOL_ADD(var, value) __sync_add_and_fetch(&(var), (value))
+#else
+/*no atomic operations known for this compiler, same as REFCOUNT_ATOMIC_DONTCARE: only good for single threaded devices*/
+#define THREADPOOL_INCREMENT(var) (++(var))
+#define THREADPOOL_DECREMENT(var) (--(var))
+#define THREADPOOL_ADD(var, value) ((var) += (value))
+#endif
+
+#define THREADPOOL_CACHE_LINE_SIZE 64
+#define THREADPOOL_INITIAL_QUEUE_CAPACITY 16
+/*a thief runs what it stole before it looks again, so it takes no more than this at once*/
+#define THREADPOOL_MAX_STEAL 16
+
+typedef struct THREADPOOL_WORK_ITEM_TAG
+{
+    THREADPOOL_WORK_FUNCTION work_function;
+    void* context;
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group;
+} THREADPOOL_WORK_ITEM;
+
+typedef struct THREADPOOL_WORKER_TAG
+{
+    struct THREADPOOL_TAG* threadpool;
+    size_t index;
+    THREAD_HANDLE thread;
+    LOCK_HANDLE lock;
+    /*ring of capacity items (a power of 2), the oldest at head*/
+    THREADPOOL_WORK_ITEM* items;
+    size_t capacity;
+    size_t head;
+    volatile size_t count;
+    /*keeps the workers off each others cache lines*/
+    unsigned char padding[THREADPOOL_CACHE_LINE_SIZE];
+} THREADPOOL_WORKER;
+
+typedef struct THREADPOOL_TAG
+{
+    THREADPOOL_WORKER* workers;
+    size_t worker_count;
+    volatile long next_worker;
+    volatile long pending;
+    volatile long sleeping;
+    /*lock and condition the workers park on*/
+    LOCK_HANDLE lock;
+    COND_HANDLE work_available;
+    volatile int stopping;
+} THREADPOOL;
+
+typedef struct THREADPOOL_WAIT_GROUP_TAG
+{
+    LOCK_HANDLE lock;
+    COND_HANDLE done;
+    size_t outstanding;
+} THREADPOOL_WAIT_GROUP;
+
+static int push_work_item(THREADPOOL_WORKER* worker, const THREADPOOL_WORK_ITEM* work_item)
+{
+    int result;
+
+    if (worker->count == worker->capacity)
+    {
+        /* Codes_SRS_THREADPOOL_11_008: [ If the queue is full, threadpool_submit shall double its capacity. ]*/
+        size_t new_capacity = worker->capacity * 2;
+        THREADPOOL_WORK_ITEM* new_items = (new_capacity < worker->capacity) ? NULL : (THREADPOOL_WORK_ITEM*)malloc(new_capacity * sizeof(THREADPOOL_WORK_ITEM));
+        if (new_items == NULL)
+        {
+            LogError("failure growing the queue of worker %lu to %lu items", (unsigned long)worker->index, (unsigned long)new_capacity);
+            result = __FAILURE__;
+        }
+        else
+        {
+            size_t i;
+            for (i = 0; i < worker->count; i++)
+            {
+                new_items[i] = worker->items[(worker->head + i) & (worker->capacity - 1)];
+            }
+            free(worker->items);
+            worker->items = new_items;
+            worker->capacity = new_capacity;
+            worker->head = 0;
+            result = 0;
+        }
+    }
+    else
+    {
+        result = 0;
+    }
+
+    if (result == 0)
+    {
+        worker->items[(worker->head + worker->count) & (worker->capacity - 1)] = *work_item;
+        worker->count++;
+    }
+
+    return result;
+}
+
+/*takes the oldest item of the worker's own queue*/
+static int pop_own_work_item(THREADPOOL_WORKER* worker, THREADPOOL_WORK_ITEM* work_item)
+{
+    int result;
+
+    if (worker->count == 0)
+    {
+        result = __FAILURE__;
+    }
+    else if (Lock(worker->lock) != LOCK_OK)
+    {
+        LogError("failure locking the queue of worker %lu", (unsigned long)worker->index);
+        result = __FAILURE__;
+    }
+    else
+    {
+        if (worker->count == 0)
+        {
+            result = __FAILURE__;
+        }
+        else
+        {
+            *work_item = worker->items[worker->head];
+            worker->head = (worker->head + 1) & (worker->capacity - 1);
+            worker->count--;
+            result = 0;
+        }
+        (void)Unlock(worker->lock);
+    }
+
+    return result;
+}
+
+/*takes half of the items (at least 1, at most THREADPOOL_MAX_STEAL) at the end of the victim's queue, returns how many*/
+static size_t steal_work_items(THREADPOOL_WORKER* victim, THREADPOOL_WORK_ITEM* work_items)
+{
+    size_t result;
+
+    /*a read without the lock is only a hint, it saves locking the queues that are empty*/
+    if (victim->count == 0)
+    {
+        result = 0;
+    }
+    else if (Lock(victim->lock) != LOCK_OK)
+    {
+        LogError("failure locking the queue of worker %lu", (unsigned long)victim->index);
+        result = 0;
+    }
+    else if (victim->count == 0)
+    {
+        (void)Unlock(victim->lock);
+        result = 0;
+    }
+    else
+    {
+        size_t i;
+
+        result = (victim->count + 1) / 2;
+        if (result > THREADPOOL_MAX_STEAL)
+        {
+            result = THREADPOOL_MAX_STEAL;
+        }
+
+        victim->count -= result;
+        for (i = 0; i < result; i++)
+        {
+            work_items[i] = victim->items[(victim->head + victim->count + i) & (victim->capacity - 1)];
+        }
+        (void)Unlock(victim->lock);
+    }
+
+    return result;
+}
+
+static void complete_wait_group(THREADPOOL_WAIT_GROUP* wait_group)
+{
+    /*the waiter can destroy the wait group as soon as it sees 0, so the count only changes under the lock*/
+    if (Lock(wait_group->lock) != LOCK_OK)
+    {
+        LogError("failure locking the wait group");
+    }
+    else
+    {
+        wait_group->outstanding--;
+        if (wait_group->outstanding == 0)
+        {
+            /*any number of threads can be in threadpool_wait_group_wait*/
+            (void)Condition_Broadcast(wait_group->done);
+        }
+        (void)Unlock(wait_group->lock);
+    }
+}
+
+static void run_work_item(const THREADPOOL_WORK_ITEM* work_item)
+{
+    work_item->work_function(work_item->context);
+
+    if (work_item->wait_group != NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_014: [ After running work submitted with a wait group, the worker shall decrement the count of the wait group under its lock and broadcast its condition when the count reaches 0. ]*/
+        complete_wait_group(work_item->wait_group);
+    }
+}
+
+static int worker_thread(void* arg)
+{
+    THREADPOOL_WORKER* worker = (THREADPOOL_WORKER*)arg;
+    THREADPOOL* threadpool = worker->threadpool;
+
+    for (;;)
+    {
+        THREADPOOL_WORK_ITEM work_items[THREADPOOL_MAX_STEAL];
+        size_t taken;
+
+        /* Codes_SRS_THREADPOOL_11_012: [ A worker shall take the oldest work from its own queue and run it. ]*/
+        if (pop_own_work_item(worker, &work_items[0]) == 0)
+        {
+            taken = 1;
+        }
+        else
+        {
+            /* Codes_SRS_THREADPOOL_11_013: [ When its own queue is empty, a worker shall look at the queues of the other workers, starting with the next one, steal half of the work at the end of the first queue that has any (at most THREADPOOL_MAX_STEAL items) and run it. ]*/
+            size_t i;
+            taken = 0;
+            for (i = 1; (i < threadpool->worker_count) && (taken == 0); i++)
+            {
+                taken = steal_work_items(&threadpool->workers[(worker->index + i) % threadpool->worker_count], work_items);
+            }
+        }
+
+        if (taken > 0)
+        {
+            size_t i;
+            (void)THREADPOOL_ADD(threadpool->pending, -(long)taken);
+            for (i = 0; i < taken; i++)
+            {
+                run_work_item(&work_items[i]);
+            }
+        }
+        else if (Lock(threadpool->lock) != LOCK_OK)
+        {
+            LogError("failure locking the threadpool");
+            ThreadAPI_Sleep(1);
+        }
+        else
+        {
+            int stop = 0;
+
+            (void)THREADPOOL_INCREMENT(threadpool->sleeping);
+            if (threadpool->pending == 0)
+            {
+                if (threadpool->stopping)
+                {
+                    /* Codes_SRS_THREADPOOL_11_016: [ When the pool is stopping and there is no work left, the worker shall return. ]*/
+                    stop = 1;
+                }
+                else
+                {
+                    /* Codes_SRS_THREADPOOL_11_015: [ When there is no work in any queue, the worker shall wait on the condition of the pool. ]*/
+                    (void)Condition_Wait(threadpool->work_available, threadpool->lock, 0);
+                }
+                (void)THREADPOOL_DECREMENT(threadpool->sleeping);
+                (void)Unlock(threadpool->lock);
+            }
+            else
+            {
+                /*the work was counted and is not in a queue yet*/
+                (void)THREADPOOL_DECREMENT(threadpool->sleeping);
+                (void)Unlock(threadpool->lock);
+                ThreadAPI_Sleep(0);
+            }
+
+            if (stop)
+            {
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static void stop_workers(THREADPOOL* threadpool, size_t started)
+{
+    size_t i;
+
+    if (Lock(threadpool->lock) != LOCK_OK)
+    {
+        LogError("failure locking the threadpool, the workers are joined without being woken");
+        threadpool->stopping = 1;
+    }
+    else
+    {
+        threadpool->stopping = 1;
+        (void)Condition_Broadcast(threadpool->work_available);
+        (void)Unlock(threadpool->lock);
+    }
+
+    for (i = 0; i < started; i++)
+    {
+        int thread_result;
+        if (ThreadAPI_Join(threadpool->workers[i].thread, &thread_result) != THREADAPI_OK)
+        {
+            LogError("failure joining worker %lu", (unsigned long)i);
+        }
+    }
+}
+
+static void free_workers(THREADPOOL* threadpool, size_t initialized)
+{
+    size_t i;
+    for (i = 0; i < initialized; i++)
+    {
+        (void)Lock_Deinit(threadpool->workers[i].lock);
+        free(threadpool->workers[i].items);
+    }
+    free(threadpool->workers);
+}
+
+THREADPOOL_HANDLE threadpool_create(size_t worker_count)
+{
+    THREADPOOL* result;
+
+    if ((worker_count == 0) ||
+        (worker_count > SIZE_MAX / sizeof(THREADPOOL_WORKER)))
+    {
+        /* Codes_SRS_THREADPOOL_11_001: [ If worker_count is 0 or too big to allocate, threadpool_create shall fail and return NULL. ]*/
+        LogError("Invalid arguments: size_t worker_count=%lu", (unsigned long)worker_count);
+        result = NULL;
+    }
+    else if ((result = (THREADPOOL*)malloc(sizeof(THREADPOOL))) == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_003: [ If any error occurs, threadpool_create shall fail and return NULL. ]*/
+        LogError("failure allocating THREADPOOL");
+    }
+    else if ((result->workers = (THREADPOOL_WORKER*)malloc(worker_count * sizeof(THREADPOOL_WORKER))) == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_003: [ If any error occurs, threadpool_create shall fail and return NULL. ]*/
+        LogError("failure allocating %lu workers", (unsigned long)worker_count);
+        free(result);
+        result = NULL;
+    }
+    else if ((result->lock = Lock_Init()) == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_003: [ If any error occurs, threadpool_create shall fail and return NULL. ]*/
+        LogError("failure in Lock_Init");
+        free(result->workers);
+        free(result);
+        result = NULL;
+    }
+    else if ((result->work_available = Condition_Init()) == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_003: [ If any error occurs, threadpool_create shall fail and return NULL. ]*/
+        LogError("failure in Condition_Init");
+        (void)Lock_Deinit(result->lock);
+        free(result->workers);
+        free(result);
+        result = NULL;
+    }
+    else
+    {
+        size_t initialized;
+        size_t started;
+
+        result->worker_count = worker_count;
+        result->next_worker = 0;
+        result->pending = 0;
+        result->sleeping = 0;
+        result->stopping = 0;
+
+        /* Codes_SRS_THREADPOOL_11_002: [ threadpool_create shall allocate worker_count workers, each with a lock and an empty queue, a lock and a condition the workers wait on when there is no work, start a thread for every worker with ThreadAPI_Create and return the pool. ]*/
+        for (initialized = 0; initialized < worker_count; initialized++)
+        {
+            THREADPOOL_WORKER* worker = &result->workers[initialized];
+            worker->threadpool = result;
+            worker->index = initialized;
+            worker->thread = NULL;
+            worker->capacity = THREADPOOL_INITIAL_QUEUE_CAPACITY;
+            worker->head = 0;
+            worker->count = 0;
+            if ((worker->items = (THREADPOOL_WORK_ITEM*)malloc(THREADPOOL_INITIAL_QUEUE_CAPACITY * sizeof(THREADPOOL_WORK_ITEM))) == NULL)
+            {
+                LogError("failure allocating the queue of worker %lu", (unsigned long)initialized);
+                break;
+            }
+            else if ((worker->lock = Lock_Init()) == NULL)
+            {
+                LogError("failure in Lock_Init for worker %lu", (unsigned long)initialized);
+                free(worker->items);
+                break;
+            }
+        }
+
+        started = 0;
+        if (initialized == worker_count)
+        {
+            for (started = 0; started < worker_count; started++)
+            {
+                if (ThreadAPI_Create(&result->workers[started].thread, worker_thread, &result->workers[started]) != THREADAPI_OK)
+                {
+                    LogError("failure in ThreadAPI_Create for worker %lu", (unsigned long)started);
+                    break;
+                }
+            }
+        }
+
+        if (started < worker_count)
+        {
+            /* Codes_SRS_THREADPOOL_11_003: [ If any error occurs, threadpool_create shall fail and return NULL. ]*/
+            stop_workers(result, started);
+            free_workers(result, initialized);
+            Condition_Deinit(result->work_available);
+            (void)Lock_Deinit(result->lock);
+            free(result);
+            result = NULL;
+        }
+    }
+
+    return result;
+}
+
+void threadpool_destroy(THREADPOOL_HANDLE threadpool)
+{
+    if (threadpool == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_004: [ If threadpool is NULL, threadpool_destroy shall return. ]*/
+        LogError("Invalid arguments: THREADPOOL_HANDLE threadpool=%p", threadpool);
+    }
+    else
+    {
+        /* Codes_SRS_THREADPOOL_11_005: [ threadpool_destroy shall mark the pool as stopping, broadcast the condition of the pool, join the workers, which run all the submitted work before they return, and free the pool. ]*/
+        stop_workers(threadpool, threadpool->worker_count);
+        free_workers(threadpool, threadpool->worker_count);
+        Condition_Deinit(threadpool->work_available);
+        (void)Lock_Deinit(threadpool->lock);
+        free(threadpool);
+    }
+}
+
+static THREADPOOL_RESULT submit_work_item(THREADPOOL* threadpool, const THREADPOOL_WORK_ITEM* work_item)
+{
+    THREADPOOL_RESULT result;
+    THREADPOOL_WORKER* worker = &threadpool->workers[(size_t)(unsigned long)THREADPOOL_INCREMENT(threadpool->next_worker) % threadpool->worker_count];
+
+    /*counted before it is queued, a worker that sees it before it can take it tries again instead of parking*/
+    (void)THREADPOOL_INCREMENT(threadpool->pending);
+
+    if (Lock(worker->lock) != LOCK_OK)
+    {
+        /* Codes_SRS_THREADPOOL_11_009: [ If any error occurs, threadpool_submit shall fail and return THREADPOOL_ERROR. ]*/
+        LogError("failure locking the queue of worker %lu", (unsigned long)worker->index);
+        (void)THREADPOOL_DECREMENT(threadpool->pending);
+        result = THREADPOOL_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_THREADPOOL_11_007: [ threadpool_submit shall add the work at the end of the queue of the next worker in turn. ]*/
+        int push_result = push_work_item(worker, work_item);
+        (void)Unlock(worker->lock);
+
+        if (push_result != 0)
+        {
+            /* Codes_SRS_THREADPOOL_11_009: [ If any error occurs, threadpool_submit shall fail and return THREADPOOL_ERROR. ]*/
+            (void)THREADPOOL_DECREMENT(threadpool->pending);
+            result = THREADPOOL_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_THREADPOOL_11_010: [ If a worker is waiting for work, threadpool_submit shall post the condition of the pool. ]*/
+            if (threadpool->sleeping > 0)
+            {
+                if (Lock(threadpool->lock) != LOCK_OK)
+                {
+                    LogError("failure locking the threadpool, the work waits for a worker that is awake");
+                }
+                else
+                {
+                    (void)Condition_Post(threadpool->work_available);
+                    (void)Unlock(threadpool->lock);
+                }
+            }
+
+            /* Codes_SRS_THREADPOOL_11_011: [ threadpool_submit shall return THREADPOOL_OK. ]*/
+            result = THREADPOOL_OK;
+        }
+    }
+
+    return result;
+}
+
+THREADPOOL_RESULT threadpool_submit(THREADPOOL_HANDLE threadpool, THREADPOOL_WORK_FUNCTION work_function, void* context)
+{
+    THREADPOOL_RESULT result;
+
+    if ((threadpool == NULL) ||
+        (work_function == NULL))
+    {
+        /* Codes_SRS_THREADPOOL_11_006: [ If threadpool or work_function is NULL, threadpool_submit shall fail and return THREADPOOL_INVALID_ARG. ]*/
+        LogError("Invalid arguments: THREADPOOL_HANDLE threadpool=%p, THREADPOOL_WORK_FUNCTION work_function=%p", threadpool, work_function);
+        result = THREADPOOL_INVALID_ARG;
+    }
+    else
+    {
+        THREADPOOL_WORK_ITEM work_item;
+        work_item.work_function = work_function;
+        work_item.context = context;
+        work_item.wait_group = NULL;
+        result = submit_work_item(threadpool, &work_item);
+    }
+
+    return result;
+}
+
+THREADPOOL_RESULT threadpool_submit_to_group(THREADPOOL_HANDLE threadpool, THREADPOOL_WAIT_GROUP_HANDLE wait_group, THREADPOOL_WORK_FUNCTION work_function, void* context)
+{
+    THREADPOOL_RESULT result;
+
+    if ((threadpool == NULL) ||
+        (wait_group == NULL) ||
+        (work_function == NULL))
+    {
+        /* Codes_SRS_THREADPOOL_11_017: [ If threadpool, wait_group or work_function is NULL, threadpool_submit_to_group shall fail and return THREADPOOL_INVALID_ARG. ]*/
+        LogError("Invalid arguments: THREADPOOL_HANDLE threadpool=%p, THREADPOOL_WAIT_GROUP_HANDLE wait_group=%p, THREADPOOL_WORK_FUNCTION work_function=%p", threadpool, wait_group, work_function);
+        result = THREADPOOL_INVALID_ARG;
+    }
+    else if (Lock(wait_group->lock) != LOCK_OK)
+    {
+        /* Codes_SRS_THREADPOOL_11_019: [ If any error occurs, threadpool_submit_to_group shall fail, leave the count of wait_group as it was and return THREADPOOL_ERROR. ]*/
+        LogError("failure locking the wait group");
+        result = THREADPOOL_ERROR;
+    }
+    else
+    {
+        THREADPOOL_WORK_ITEM work_item;
+
+        /* Codes_SRS_THREADPOOL_11_018: [ threadpool_submit_to_group shall increment the count of wait_group under its lock and submit the work like threadpool_submit. ]*/
+        wait_group->outstanding++;
+        (void)Unlock(wait_group->lock);
+
+        work_item.work_function = work_function;
+        work_item.context = context;
+        work_item.wait_group = wait_group;
+        result = submit_work_item(threadpool, &work_item);
+        if (result != THREADPOOL_OK)
+        {
+            /* Codes_SRS_THREADPOOL_11_019: [ If any error occurs, threadpool_submit_to_group shall fail, leave the count of wait_group as it was and return THREADPOOL_ERROR. ]*/
+            complete_wait_group(wait_group);
+        }
+    }
+
+    return result;
+}
+
+THREADPOOL_WAIT_GROUP_HANDLE threadpool_wait_group_create(void)
+{
+    THREADPOOL_WAIT_GROUP* result = (THREADPOOL_WAIT_GROUP*)malloc(sizeof(THREADPOOL_WAIT_GROUP));
+    if (result == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_021: [ If any error occurs, threadpool_wait_group_create shall fail and return NULL. ]*/
+        LogError("failure allocating THREADPOOL_WAIT_GROUP");
+    }
+    else if ((result->lock = Lock_Init()) == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_021: [ If any error occurs, threadpool_wait_group_create shall fail and return NULL. ]*/
+        LogError("failure in Lock_Init");
+        free(result);
+        result = NULL;
+    }
+    else if ((result->done = Condition_Init()) == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_021: [ If any error occurs, threadpool_wait_group_create shall fail and return NULL. ]*/
+        LogError("failure in Condition_Init");
+        (void)Lock_Deinit(result->lock);
+        free(result);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_THREADPOOL_11_020: [ threadpool_wait_group_create shall allocate a wait group with a lock, a condition and a count of 0 and return it. ]*/
+        result->outstanding = 0;
+    }
+
+    return result;
+}
+
+void threadpool_wait_group_destroy(THREADPOOL_WAIT_GROUP_HANDLE wait_group)
+{
+    if (wait_group == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_022: [ If wait_group is NULL, threadpool_wait_group_destroy shall return. ]*/
+        LogError("Invalid arguments: THREADPOOL_WAIT_GROUP_HANDLE wait_group=%p", wait_group);
+    }
+    else
+    {
+        /* Codes_SRS_THREADPOOL_11_023: [ threadpool_wait_group_destroy shall free the condition, the lock and the wait group. ]*/
+        Condition_Deinit(wait_group->done);
+        (void)Lock_Deinit(wait_group->lock);
+        free(wait_group);
+    }
+}
+
+THREADPOOL_RESULT threadpool_wait_group_wait(THREADPOOL_WAIT_GROUP_HANDLE wait_group)
+{
+    THREADPOOL_RESULT result;
+
+    if (wait_group == NULL)
+    {
+        /* Codes_SRS_THREADPOOL_11_024: [ If wait_group is NULL, threadpool_wait_group_wait shall fail and return THREADPOOL_INVALID_ARG. ]*/
+        LogError("Invalid arguments: THREADPOOL_WAIT_GROUP_HANDLE wait_group=%p", wait_group);
+        result = THREADPOOL_INVALID_ARG;
+    }
+    else if (Lock(wait_group->lock) != LOCK_OK)
+    {
+        /* Codes_SRS_THREADPOOL_11_026: [ If any error occurs, threadpool_wait_group_wait shall fail and return THREADPOOL_ERROR. ]*/
+        LogError("failure locking the wait group");
+        result = THREADPOOL_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_THREADPOOL_11_025: [ threadpool_wait_group_wait shall wait on the condition of wait_group until its count is 0 and return THREADPOOL_OK. ]*/
+        result = THREADPOOL_OK;
+        while (wait_group->outstanding != 0)
+        {
+            if (Condition_Wait(wait_group->done, wait_group->lock, 0) != COND_OK)
+            {
+                /* Codes_SRS_THREADPOOL_11_026: [ If any error occurs, threadpool_wait_group_wait shall fail and return THREADPOOL_ERROR. ]*/
+                LogError("failure in Condition_Wait");
+                result = THREADPOOL_ERROR;
+                break;
+            }
+        }
+        (void)Unlock(wait_group->lock);
+    }
+
+    return result;
+}
@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #include <stdlib.h>
+#include <stdint.h>
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/vector.h"
 #include "azure_c_shared_utility/optimize_size.h"
@@ -9,6 +10,106 @@
 
 #include "azure_c_shared_utility/vector_types_internal.h"
 
+/*makes room for at least minCapacity elements, the capacity at least doubles so a sequence of push_backs is amortized O(1)*/
+static int grow_storage(VECTOR_HANDLE handle, size_t minCapacity)
+{
+    int result;
+    size_t newCapacity = (handle->capacity > SIZE_MAX / 2) ? SIZE_MAX : handle->capacity * 2;
+    if (newCapacity < minCapacity)
+    {
+        newCapacity = minCapacity;
+    }
+
+    if (newCapacity > SIZE_MAX / handle->elementSize)
+    {
+        LogError("capacity overflow - capacity(%zu), elementSize(%zu).", newCapacity, handle->elementSize);
+        result = __FAILURE__;
+    }
+    else
+    {
+        void* temp = realloc(handle->storage, newCapacity * handle->elementSize);
+        if (temp == NULL)
+        {
+            LogError("realloc failed.");
+            result = __FAILURE__;
+        }
+        else
+        {
+            handle->storage = temp;
+            handle->capacity = newCapacity;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+/*index of the first element that is not less than value, or count if there is none*/
+static size_t lower_bound_index(VECTOR_HANDLE handle, const void* value)
+{
+    size_t first = 0;
+    size_t last = handle->count;
+    while (first < last)
+    {
+        size_t middle = first + (last - first) / 2;
+        if (handle->compare((unsigned char*)handle->storage + (handle->elementSize * middle), value) < 0)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+/*index after the last element that is not greater than value, so equal elements stay in the order they were inserted*/
+static size_t upper_bound_index(VECTOR_HANDLE handle, const void* value)
+{
+    size_t first = 0;
+    size_t last = handle->count;
+    while (first < last)
+    {
+        size_t middle = first + (last - first) / 2;
+        if (handle->compare((unsigned char*)handle->storage + (handle->elementSize * middle), value) <= 0)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+static int insert_elements(VECTOR_HANDLE handle, size_t index, const void* elements, size_t numElements)
+{
+    int result;
+    if (numElements > SIZE_MAX - handle->count)
+    {
+        LogError("too many elements - count(%zu), numElements(%zu).", handle->count, numElements);
+        result = __FAILURE__;
+    }
+    else if (
+        (handle->count + numElements > handle->capacity) &&
+        (grow_storage(handle, handle->count + numElements) != 0)
+        )
+    {
+        LogError("failure growing the vector.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        unsigned char* position = (unsigned char*)handle->storage + (handle->elementSize * index);
+        (void)memmove(position + (handle->elementSize * numElements), position, handle->elementSize * (handle->count - index));
+        (void)memcpy(position, elements, handle->elementSize * numElements);
+        handle->count += numElements;
+        result = 0;
+    }
+    return result;
+}
+
 VECTOR_HANDLE VECTOR_create(size_t elementSize)
 {
     VECTOR_HANDLE result;
@@ -32,7 +133,36 @@ VECTOR_HANDLE VECTOR_create(size_t elementSize)
             /* Codes_SRS_VECTOR_10_001: [VECTOR_create shall allocate a VECTOR_HANDLE that will contain an empty vector.The size of each element is given with the parameter elementSize.] */
             result->storage = NULL;
             result->count = 0;
+            result->capacity = 0;
             result->elementSize = elementSize;
+            result->compare = NULL;
+        }
+    }
+    return result;
+}
+
+VECTOR_HANDLE VECTOR_create_sorted(size_t elementSize, VECTOR_COMPARE_FUNCTION compare)
+{
+    VECTOR_HANDLE result;
+
+    if (elementSize == 0 || compare == NULL)
+    {
+        /* Codes_SRS_VECTOR_11_001: [VECTOR_create_sorted shall fail and return NULL if elementSize is 0 or compare is NULL.] */
+        LogError("invalid argument - elementSize(%zu), compare(%p).", elementSize, compare);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_VECTOR_11_002: [VECTOR_create_sorted shall create an empty vector that keeps its elements in the order given by compare.] */
+        result = VECTOR_create(elementSize);
+        if (result == NULL)
+        {
+            /* Codes_SRS_VECTOR_11_003: [VECTOR_create_sorted shall fail and return NULL if malloc fails.] */
+            LogError("VECTOR_create failed.");
+        }
+        else
+        {
+            result->compare = compare;
         }
     }
     return result;
@@ -74,11 +204,14 @@ VECTOR_HANDLE VECTOR_move(VECTOR_HANDLE handle)
         {
             /* Codes_SRS_VECTOR_10_004: [VECTOR_move shall allocate a VECTOR_HANDLE and move the data to it from the given handle.] */
             result->count = handle->count;
+            result->capacity = handle->capacity;
             result->elementSize = handle->elementSize;
             result->storage = handle->storage;
+            result->compare = handle->compare;
 
             handle->storage = NULL;
             handle->count = 0;
+            handle->capacity = 0;
         }
     }
     return result;
@@ -97,26 +230,88 @@ int VECTOR_push_back(VECTOR_HANDLE handle, const void* elements, size_t numEleme
         LogError("invalid argument - handle(%p), elements(%p), numElements(%zd).", handle, elements, numElements);
         result = __FAILURE__;
     }
+    else if (handle->compare != NULL)
+    {
+        /* Codes_SRS_VECTOR_11_004: [VECTOR_push_back shall fail and return non-zero if the vector is sorted.] */
+        LogError("cannot push_back in a sorted vector, use VECTOR_insert_sorted.");
+        result = __FAILURE__;
+    }
+    /* Codes_SRS_VECTOR_11_005: [If the vector cannot hold the new elements, VECTOR_push_back shall grow its capacity to the bigger of twice the capacity and the new number of elements.] */
+    else if (insert_elements(handle, handle->count, elements, numElements) != 0)
+    {
+        /* Codes_SRS_VECTOR_10_012: [VECTOR_push_back shall fail and return non-zero if memory allocation fails.] */
+        LogError("failure appending the elements.");
+        result = __FAILURE__;
+    }
     else
     {
-        size_t curSize = handle->elementSize * handle->count;
-        size_t appendSize = handle->elementSize * numElements;
+        /* Codes_SRS_VECTOR_10_013: [VECTOR_push_back shall append the given elements and return 0 indicating success.] */
+        result = 0;
+    }
+    return result;
+}
 
-        void* temp = realloc(handle->storage, curSize + appendSize);
-        if (temp == NULL)
-        {
-           /* Codes_SRS_VECTOR_10_012: [VECTOR_push_back shall fail and return non-zero if memory allocation fails.] */
-            LogError("realloc failed.");
-            result = __FAILURE__;
-        }
-        else
-        {
-            /* Codes_SRS_VECTOR_10_013: [VECTOR_push_back shall append the given elements and return 0 indicating success.] */
-            (void)memcpy((unsigned char*)temp + curSize, elements, appendSize);
-            handle->storage = temp;
-            handle->count += numElements;
-            result = 0;
-        }
+int VECTOR_insert(VECTOR_HANDLE handle, size_t index, const void* elements, size_t numElements)
+{
+    int result;
+    if (handle == NULL || elements == NULL || numElements == 0)
+    {
+        /* Codes_SRS_VECTOR_11_006: [VECTOR_insert shall fail and return non-zero if handle or elements is NULL or numElements is 0.] */
+        LogError("invalid argument - handle(%p), elements(%p), numElements(%zu).", handle, elements, numElements);
+        result = __FAILURE__;
+    }
+    else if (index > handle->count)
+    {
+        /* Codes_SRS_VECTOR_11_007: [VECTOR_insert shall fail and return non-zero if index is greater than the number of elements.] */
+        LogError("invalid argument - index(%zu) should be <= %zu.", index, handle->count);
+        result = __FAILURE__;
+    }
+    else if (handle->compare != NULL)
+    {
+        /* Codes_SRS_VECTOR_11_008: [VECTOR_insert shall fail and return non-zero if the vector is sorted.] */
+        LogError("cannot insert at an index in a sorted vector, use VECTOR_insert_sorted.");
+        result = __FAILURE__;
+    }
+    /* Codes_SRS_VECTOR_11_009: [If the vector cannot hold the new elements, VECTOR_insert shall grow its capacity like VECTOR_push_back.] */
+    else if (insert_elements(handle, index, elements, numElements) != 0)
+    {
+        /* Codes_SRS_VECTOR_11_010: [VECTOR_insert shall fail and return non-zero if memory allocation fails.] */
+        LogError("failure inserting the elements.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_VECTOR_11_011: [VECTOR_insert shall move the elements from index on after the new elements, copy the new elements at index and return 0.] */
+        result = 0;
+    }
+    return result;
+}
+
+int VECTOR_insert_sorted(VECTOR_HANDLE handle, const void* element)
+{
+    int result;
+    if (handle == NULL || element == NULL)
+    {
+        /* Codes_SRS_VECTOR_11_012: [VECTOR_insert_sorted shall fail and return non-zero if handle or element is NULL.] */
+        LogError("invalid argument - handle(%p), element(%p).", handle, element);
+        result = __FAILURE__;
+    }
+    else if (handle->compare == NULL)
+    {
+        /* Codes_SRS_VECTOR_11_013: [VECTOR_insert_sorted shall fail and return non-zero if the vector was not created with VECTOR_create_sorted.] */
+        LogError("vector is not sorted.");
+        result = __FAILURE__;
+    }
+    /* Codes_SRS_VECTOR_11_014: [VECTOR_insert_sorted shall insert element after all the elements that are not greater than it and return 0.] */
+    else if (insert_elements(handle, upper_bound_index(handle, element), element, 1) != 0)
+    {
+        /* Codes_SRS_VECTOR_11_015: [VECTOR_insert_sorted shall fail and return non-zero if memory allocation fails.] */
+        LogError("failure inserting the element.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
     }
     return result;
 }
@@ -159,27 +354,10 @@ void VECTOR_erase(VECTOR_HANDLE handle, void* elements, size_t numElements)
                 }
                 else
                 {
-                    /* Codes_SRS_VECTOR_10_014: [VECTOR_erase shall remove the 'numElements' starting at 'elements' and reduce its internal storage.] */
+                    /* Codes_SRS_VECTOR_10_014: [VECTOR_erase shall remove the 'numElements' starting at 'elements'.] */
+                    /* Codes_SRS_VECTOR_11_016: [VECTOR_erase shall keep the capacity of the vector.] */
+                    (void)memmove(elements, src, srcEnd - src);
                     handle->count -= numElements;
-                    if (handle->count == 0)
-                    {
-                        free(handle->storage);
-                        handle->storage = NULL;
-                    }
-                    else
-                    {
-                        void* tmp;
-                        (void)memmove(elements, src, srcEnd - src);
-                        tmp = realloc(handle->storage, (handle->elementSize * handle->count));
-                        if (tmp == NULL)
-                        {
-                            LogInfo("realloc failed. Keeping original internal storage pointer.");
-                        }
-                        else
-                        {
-                            handle->storage = tmp;
-                        }
-                    }
                 }
             }
         }
@@ -199,6 +377,26 @@ void VECTOR_clear(VECTOR_HANDLE handle)
         free(handle->storage);
         handle->storage = NULL;
         handle->count = 0;
+        handle->capacity = 0;
+    }
+}
+
+void VECTOR_pop_back(VECTOR_HANDLE handle)
+{
+    if (handle == NULL)
+    {
+        /* Codes_SRS_VECTOR_11_017: [VECTOR_pop_back shall return if handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+    }
+    else if (handle->count == 0)
+    {
+        /* Codes_SRS_VECTOR_11_018: [VECTOR_pop_back shall return if the vector is empty.] */
+        LogError("vector is empty.");
+    }
+    else
+    {
+        /* Codes_SRS_VECTOR_11_019: [VECTOR_pop_back shall remove the last element and keep the capacity of the vector.] */
+        handle->count--;
     }
 }
 
@@ -318,6 +516,38 @@ void* VECTOR_find_if(VECTOR_HANDLE handle, PREDICATE_FUNCTION pred, const void*
     return result;
 }
 
+void* VECTOR_lower_bound(VECTOR_HANDLE handle, const void* value)
+{
+    void* result;
+    if (handle == NULL || value == NULL)
+    {
+        /* Codes_SRS_VECTOR_11_020: [VECTOR_lower_bound shall fail and return NULL if handle or value is NULL.] */
+        LogError("invalid argument - handle(%p), value(%p).", handle, value);
+        result = NULL;
+    }
+    else if (handle->compare == NULL)
+    {
+        /* Codes_SRS_VECTOR_11_021: [VECTOR_lower_bound shall fail and return NULL if the vector was not created with VECTOR_create_sorted.] */
+        LogError("vector is not sorted.");
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_VECTOR_11_022: [VECTOR_lower_bound shall use a binary search to return the first element that is not less than value.] */
+        size_t index = lower_bound_index(handle, value);
+        if (index == handle->count)
+        {
+            /* Codes_SRS_VECTOR_11_023: [VECTOR_lower_bound shall return NULL if all the elements are less than value.] */
+            result = NULL;
+        }
+        else
+        {
+            result = (unsigned char*)handle->storage + (handle->elementSize * index);
+        }
+    }
+    return result;
+}
+
 /* capacity */
 
 size_t VECTOR_size(VECTOR_HANDLE handle)
@@ -336,3 +566,95 @@ size_t VECTOR_size(VECTOR_HANDLE handle)
     }
     return result;
 }
+
+size_t VECTOR_capacity(VECTOR_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_VECTOR_11_024: [VECTOR_capacity shall return 0 if the given handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_VECTOR_11_025: [VECTOR_capacity shall return the number of elements the vector can hold without allocating memory.] */
+        result = handle->capacity;
+    }
+    return result;
+}
+
+int VECTOR_reserve(VECTOR_HANDLE handle, size_t numElements)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_VECTOR_11_026: [VECTOR_reserve shall fail and return non-zero if handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+        result = __FAILURE__;
+    }
+    else if (numElements <= handle->capacity)
+    {
+        /* Codes_SRS_VECTOR_11_027: [If the vector can already hold numElements elements, VECTOR_reserve shall return 0.] */
+        result = 0;
+    }
+    else if (numElements > SIZE_MAX / handle->elementSize)
+    {
+        /* Codes_SRS_VECTOR_11_029: [VECTOR_reserve shall fail and return non-zero if memory allocation fails.] */
+        LogError("capacity overflow - numElements(%zu), elementSize(%zu).", numElements, handle->elementSize);
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_VECTOR_11_028: [Otherwise VECTOR_reserve shall reallocate the storage of the vector to hold exactly numElements elements and return 0.] */
+        void* temp = realloc(handle->storage, numElements * handle->elementSize);
+        if (temp == NULL)
+        {
+            /* Codes_SRS_VECTOR_11_029: [VECTOR_reserve shall fail and return non-zero if memory allocation fails.] */
+            LogError("realloc failed.");
+            result = __FAILURE__;
+        }
+        else
+        {
+            handle->storage = temp;
+            handle->capacity = numElements;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+void VECTOR_shrink_to_fit(VECTOR_HANDLE handle)
+{
+    if (handle == NULL)
+    {
+        /* Codes_SRS_VECTOR_11_030: [VECTOR_shrink_to_fit shall return if handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+    }
+    /* Codes_SRS_VECTOR_11_031: [VECTOR_shrink_to_fit shall return if the capacity of the vector is its number of elements.] */
+    else if (handle->count < handle->capacity)
+    {
+        if (handle->count == 0)
+        {
+            /* Codes_SRS_VECTOR_11_032: [If the vector is empty, VECTOR_shrink_to_fit shall release its internal storage.] */
+            free(handle->storage);
+            handle->storage = NULL;
+            handle->capacity = 0;
+        }
+        else
+        {
+            /* Codes_SRS_VECTOR_11_033: [Otherwise VECTOR_shrink_to_fit shall reallocate the storage of the vector to hold exactly its elements.] */
+            void* temp = realloc(handle->storage, handle->count * handle->elementSize);
+            if (temp == NULL)
+            {
+                /* Codes_SRS_VECTOR_11_034: [If realloc fails, VECTOR_shrink_to_fit shall keep the storage it has.] */
+                LogInfo("realloc failed. Keeping original internal storage pointer.");
+            }
+            else
+            {
+                handle->storage = temp;
+                handle->capacity = handle->count;
+            }
+        }
+    }
+}
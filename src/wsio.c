@@ -817,7 +817,8 @@ static const IO_INTERFACE_DESCRIPTION ws_io_interface_description =
     wsio_close,
     wsio_send,
     wsio_dowork,
-    wsio_setoption
+    wsio_setoption,
+    NULL
 };
 
 const IO_INTERFACE_DESCRIPTION* wsio_get_interface_description(void)
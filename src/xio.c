@@ -3,6 +3,7 @@
 
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xio.h"
@@ -21,7 +22,7 @@ XIO_HANDLE xio_create(const IO_INTERFACE_DESCRIPTION* io_interface_description,
     XIO_INSTANCE* xio_instance;
     /* Codes_SRS_XIO_01_003: [If the argument io_interface_description is NULL, xio_create shall return NULL.] */
     if ((io_interface_description == NULL) ||
-        /* Codes_SRS_XIO_01_004: [If any io_interface_description member is NULL, xio_create shall return NULL.] */
+        /* Codes_SRS_XIO_01_004: [If any io_interface_description member other than concrete_io_send_vectored is NULL, xio_create shall return NULL.] */
         (io_interface_description->concrete_io_retrieveoptions == NULL) ||
         (io_interface_description->concrete_io_create == NULL) ||
         (io_interface_description->concrete_io_destroy == NULL) ||
@@ -154,6 +155,104 @@ int xio_send(XIO_HANDLE xio, const void* buffer, size_t size, ON_SEND_COMPLETE o
     return result;
 }
 
+int xio_send_vectored(XIO_HANDLE xio, CONSTBUFFER_ARRAY_HANDLE buffers, ON_SEND_COMPLETE on_send_complete, void* callback_context)
+{
+    int result;
+
+    if ((xio == NULL) || (buffers == NULL))
+    {
+        /* Codes_SRS_XIO_11_001: [ If xio or buffers is NULL, xio_send_vectored shall fail and return a non-zero value. ]*/
+        LogError("Invalid arguments: XIO_HANDLE xio=%p, CONSTBUFFER_ARRAY_HANDLE buffers=%p", xio, buffers);
+        result = __FAILURE__;
+    }
+    else
+    {
+        XIO_INSTANCE* xio_instance = (XIO_INSTANCE*)xio;
+        uint32_t buffer_count;
+        uint32_t all_buffers_size;
+
+        if (xio_instance->io_interface_description->concrete_io_send_vectored != NULL)
+        {
+            /* Codes_SRS_XIO_11_002: [ If the concrete IO has a concrete_io_send_vectored function, xio_send_vectored shall pass buffers, on_send_complete and callback_context to it and return its result. ]*/
+            result = xio_instance->io_interface_description->concrete_io_send_vectored(xio_instance->concrete_xio_handle, buffers, on_send_complete, callback_context);
+        }
+        else if (
+            (constbuffer_array_get_buffer_count(buffers, &buffer_count) != 0) ||
+            (constbuffer_array_get_all_buffers_size(buffers, &all_buffers_size) != 0)
+            )
+        {
+            /* Codes_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+            LogError("failure getting the size of the buffers");
+            result = __FAILURE__;
+        }
+        else if (buffer_count == 0)
+        {
+            /* Codes_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+            LogError("buffers holds no buffer");
+            result = __FAILURE__;
+        }
+        else if (buffer_count == 1)
+        {
+            /* Codes_SRS_XIO_11_003: [ Otherwise, if buffers holds one buffer, xio_send_vectored shall send its content with concrete_io_send. ]*/
+            const CONSTBUFFER* content = constbuffer_array_get_buffer_content(buffers, 0);
+            if (content == NULL)
+            {
+                /* Codes_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+                LogError("failure getting the content of the buffer");
+                result = __FAILURE__;
+            }
+            else
+            {
+                result = xio_instance->io_interface_description->concrete_io_send(xio_instance->concrete_xio_handle, content->buffer, content->size, on_send_complete, callback_context);
+            }
+        }
+        else
+        {
+            /* Codes_SRS_XIO_11_004: [ Otherwise, xio_send_vectored shall copy the content of all the buffers, in order, in one block of memory, send it with concrete_io_send, free it and return the result of concrete_io_send. ]*/
+            unsigned char* flat = (unsigned char*)malloc((all_buffers_size == 0) ? 1 : all_buffers_size);
+            if (flat == NULL)
+            {
+                /* Codes_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+                LogError("failure allocating %lu bytes", (unsigned long)all_buffers_size);
+                result = __FAILURE__;
+            }
+            else
+            {
+                uint32_t i;
+                size_t offset = 0;
+                for (i = 0; i < buffer_count; i++)
+                {
+                    const CONSTBUFFER* content = constbuffer_array_get_buffer_content(buffers, i);
+                    if (content == NULL)
+                    {
+                        break;
+                    }
+                    else if (content->size > 0)
+                    {
+                        (void)memcpy(flat + offset, content->buffer, content->size);
+                        offset += content->size;
+                    }
+                }
+
+                if (i < buffer_count)
+                {
+                    /* Codes_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+                    LogError("failure getting the content of buffer %lu", (unsigned long)i);
+                    result = __FAILURE__;
+                }
+                else
+                {
+                    result = xio_instance->io_interface_description->concrete_io_send(xio_instance->concrete_xio_handle, flat, offset, on_send_complete, callback_context);
+                }
+
+                free(flat);
+            }
+        }
+    }
+
+    return result;
+}
+
 void xio_dowork(XIO_HANDLE xio)
 {
     /* Codes_SRS_XIO_01_018: [When the handle argument is NULL, xio_dowork shall do nothing.] */
@@ -0,0 +1,443 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+#include "macro_utils.h"
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+#include "umocktypes_stdint.h"
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/gballoc.h"
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/arena.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+#define TEST_BLOCK_SIZE 64
+#define TEST_BIGGER_THAN_MAX_BLOCK_SIZE (1024 * 1024 + 1)
+
+BEGIN_TEST_SUITE(arena_unittests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types");
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+/* arena_create */
+
+/* Tests_SRS_ARENA_11_001: [ If block_size is 0, arena_create shall fail and return NULL. ]*/
+TEST_FUNCTION(arena_create_with_block_size_0_fails)
+{
+    ///arrange
+    ARENA_HANDLE arena;
+
+    ///act
+    arena = arena_create(0);
+
+    ///assert
+    ASSERT_IS_NULL(arena);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_ARENA_11_002: [ arena_create shall allocate memory for a new ARENA_HANDLE and return it. The blocks are only allocated when needed. ]*/
+TEST_FUNCTION(arena_create_succeeds)
+{
+    ///arrange
+    ARENA_HANDLE arena;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    arena = arena_create(TEST_BLOCK_SIZE);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(arena);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, arena_get_peak_size(arena));
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* Tests_SRS_ARENA_11_003: [ If any error occurs, arena_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_gballoc_malloc_fails_arena_create_fails)
+{
+    ///arrange
+    ARENA_HANDLE arena;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    arena = arena_create(TEST_BLOCK_SIZE);
+
+    ///assert
+    ASSERT_IS_NULL(arena);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* arena_destroy */
+
+/* Tests_SRS_ARENA_11_004: [ If arena is NULL, arena_destroy shall return. ]*/
+TEST_FUNCTION(arena_destroy_with_NULL_arena_returns)
+{
+    ///act
+    arena_destroy(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_ARENA_11_005: [ arena_destroy shall free all the blocks of arena and arena itself. ]*/
+TEST_FUNCTION(arena_destroy_frees_the_blocks_and_the_arena)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, TEST_BLOCK_SIZE));
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, TEST_BLOCK_SIZE));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(arena));
+
+    ///act
+    arena_destroy(arena);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* arena_alloc */
+
+/* Tests_SRS_ARENA_11_006: [ If arena is NULL or size is 0, arena_alloc shall fail and return NULL. ]*/
+TEST_FUNCTION(arena_alloc_with_NULL_arena_fails)
+{
+    ///act
+    void* result = arena_alloc(NULL, 1);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_ARENA_11_006: [ If arena is NULL or size is 0, arena_alloc shall fail and return NULL. ]*/
+TEST_FUNCTION(arena_alloc_with_size_0_fails)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    void* result;
+    umock_c_reset_all_calls();
+
+    ///act
+    result = arena_alloc(arena, 0);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* Tests_SRS_ARENA_11_007: [ arena_alloc shall return the next size bytes (rounded up to the alignment of malloc) of the newest block. ]*/
+TEST_FUNCTION(arena_alloc_bumps_in_the_same_block)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    unsigned char* first;
+    unsigned char* second;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    first = (unsigned char*)arena_alloc(arena, 3);
+    second = (unsigned char*)arena_alloc(arena, 5);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(first);
+    ASSERT_IS_NOT_NULL(second);
+    ASSERT_IS_TRUE(second > first);
+    ASSERT_IS_TRUE(second - first < TEST_BLOCK_SIZE);
+    ASSERT_ARE_EQUAL(size_t, 0, (size_t)((uintptr_t)second % sizeof(void*)));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* Tests_SRS_ARENA_11_008: [ If the newest block does not have size bytes left, arena_alloc shall allocate a new block twice as big as the previous one (block_size for the first one, at most 1MB, and at least size). ]*/
+TEST_FUNCTION(arena_alloc_adds_a_block_twice_as_big_when_the_block_is_full)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    size_t first_block_bytes;
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, TEST_BLOCK_SIZE));
+    first_block_bytes = arena_get_peak_size(arena);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, 1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, TEST_BLOCK_SIZE, first_block_bytes);
+    ASSERT_ARE_EQUAL(size_t, 3 * TEST_BLOCK_SIZE, arena_get_peak_size(arena));
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* Tests_SRS_ARENA_11_008: [ If the newest block does not have size bytes left, arena_alloc shall allocate a new block twice as big as the previous one (block_size for the first one, at most 1MB, and at least size). ]*/
+TEST_FUNCTION(arena_alloc_bigger_than_the_block_size_gets_a_block_of_its_own_size)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    unsigned char* result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    result = (unsigned char*)arena_alloc(arena, 10 * TEST_BLOCK_SIZE);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 10 * TEST_BLOCK_SIZE, arena_get_peak_size(arena));
+    (void)memset(result, 0, 10 * TEST_BLOCK_SIZE);
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* Tests_SRS_ARENA_11_009: [ If allocating the block fails, arena_alloc shall fail and return NULL. ]*/
+TEST_FUNCTION(when_gballoc_malloc_fails_arena_alloc_fails)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    void* result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    result = arena_alloc(arena, 1);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, arena_get_peak_size(arena));
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* arena_strdup */
+
+/* Tests_SRS_ARENA_11_010: [ If arena or source is NULL, arena_strdup shall fail and return NULL. ]*/
+TEST_FUNCTION(arena_strdup_with_NULL_source_fails)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    char* result;
+    umock_c_reset_all_calls();
+
+    ///act
+    result = arena_strdup(arena, NULL);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* Tests_SRS_ARENA_11_011: [ arena_strdup shall copy source in strlen(source) + 1 bytes obtained like arena_alloc and return them, or NULL if that fails. ]*/
+TEST_FUNCTION(arena_strdup_copies_the_string)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    char* result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    result = arena_strdup(arena, "sr=myhub.azure-devices.net");
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, "sr=myhub.azure-devices.net", result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* arena_reset */
+
+/* Tests_SRS_ARENA_11_012: [ If arena is NULL, arena_reset shall return. ]*/
+TEST_FUNCTION(arena_reset_with_NULL_arena_returns)
+{
+    ///act
+    arena_reset(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_ARENA_11_013: [ arena_reset shall free all the blocks of arena except the newest one, which becomes empty, unless the newest one is bigger than 1MB, then it shall free it too. ]*/
+TEST_FUNCTION(arena_reset_keeps_the_newest_block)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    void* newest;
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, TEST_BLOCK_SIZE));
+    newest = arena_alloc(arena, TEST_BLOCK_SIZE);
+    ASSERT_IS_NOT_NULL(newest);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    arena_reset(arena);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    umock_c_reset_all_calls();
+    ASSERT_ARE_EQUAL(void_ptr, newest, arena_alloc(arena, TEST_BLOCK_SIZE));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* Tests_SRS_ARENA_11_013: [ arena_reset shall free all the blocks of arena except the newest one, which becomes empty, unless the newest one is bigger than 1MB, then it shall free it too. ]*/
+TEST_FUNCTION(arena_reset_frees_a_newest_block_bigger_than_1MB)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, TEST_BLOCK_SIZE));
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, TEST_BIGGER_THAN_MAX_BLOCK_SIZE));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    arena_reset(arena);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    umock_c_reset_all_calls();
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, 1));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* arena_get_peak_size */
+
+/* Tests_SRS_ARENA_11_014: [ arena_get_peak_size shall return the largest number of bytes that the blocks of arena held at any time since arena_create. ]*/
+TEST_FUNCTION(arena_get_peak_size_is_kept_across_resets)
+{
+    ///arrange
+    ARENA_HANDLE arena = arena_create(TEST_BLOCK_SIZE);
+    size_t result;
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, TEST_BLOCK_SIZE));
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, TEST_BLOCK_SIZE));
+    arena_reset(arena);
+    ASSERT_IS_NOT_NULL(arena_alloc(arena, 1));
+
+    ///act
+    result = arena_get_peak_size(arena);
+
+    ///assert
+    ASSERT_ARE_EQUAL(size_t, 3 * TEST_BLOCK_SIZE, result);
+
+    ///cleanup
+    arena_destroy(arena);
+}
+
+/* Tests_SRS_ARENA_11_015: [ If arena is NULL, arena_get_peak_size shall return 0. ]*/
+TEST_FUNCTION(arena_get_peak_size_with_NULL_arena_returns_0)
+{
+    ///act
+    size_t result = arena_get_peak_size(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(size_t, 0, result);
+}
+
+END_TEST_SUITE(arena_unittests)
@@ -0,0 +1,545 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#endif
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_gballoc_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+#include "macro_utils.h"
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+#include "umocktypes_stdint.h"
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/gballoc.h"
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/buffer_.h"
+#include "azure_c_shared_utility/buffer_pool.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+#define TEST_MAX_CACHED_BYTES (1024 * 1024)
+
+/*creates a pool whose calling thread already has its free lists*/
+static BUFFER_POOL_HANDLE create_pool(size_t max_cached_bytes)
+{
+    BUFFER_POOL_HANDLE pool = BUFFER_POOL_create(max_cached_bytes);
+    BUFFER_delete(BUFFER_POOL_get(pool, 1));
+    umock_c_reset_all_calls();
+    return pool;
+}
+
+BEGIN_TEST_SUITE(buffer_pool_unittests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types");
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_realloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+/* BUFFER_POOL_create */
+
+/* Tests_SRS_BUFFER_POOL_11_001: [ BUFFER_POOL_create shall allocate a new pool that keeps at most max_cached_bytes of capacity in the lists it shares between threads and return it. ]*/
+TEST_FUNCTION(BUFFER_POOL_create_succeeds)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool;
+    BUFFER_POOL_STATISTICS statistics;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    pool = BUFFER_POOL_create(TEST_MAX_CACHED_BYTES);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(pool);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_POOL_get_statistics(pool, &statistics));
+    ASSERT_ARE_EQUAL(size_t, 0, statistics.hits);
+    ASSERT_ARE_EQUAL(size_t, 0, statistics.misses);
+    ASSERT_ARE_EQUAL(size_t, 0, statistics.cached_bytes);
+
+    ///cleanup
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_002: [ If any error occurs, BUFFER_POOL_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_gballoc_malloc_fails_BUFFER_POOL_create_fails)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    pool = BUFFER_POOL_create(TEST_MAX_CACHED_BYTES);
+
+    ///assert
+    ASSERT_IS_NULL(pool);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* BUFFER_POOL_destroy */
+
+/* Tests_SRS_BUFFER_POOL_11_003: [ If pool is NULL, BUFFER_POOL_destroy shall return. ]*/
+TEST_FUNCTION(BUFFER_POOL_destroy_with_NULL_pool_returns)
+{
+    ///act
+    BUFFER_POOL_destroy(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_BUFFER_POOL_11_004: [ BUFFER_POOL_destroy shall free the buffers in the free lists of all the threads, the free lists of the calling thread and the pool. ]*/
+TEST_FUNCTION(BUFFER_POOL_destroy_frees_the_cached_buffers)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    BUFFER_POOL_destroy(pool);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* BUFFER_POOL_get */
+
+/* Tests_SRS_BUFFER_POOL_11_005: [ If pool is NULL, BUFFER_POOL_get shall fail and return NULL. ]*/
+TEST_FUNCTION(BUFFER_POOL_get_with_NULL_pool_fails)
+{
+    ///arrange
+    BUFFER_HANDLE buffer;
+
+    ///act
+    buffer = BUFFER_POOL_get(NULL, 100);
+
+    ///assert
+    ASSERT_IS_NULL(buffer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_BUFFER_POOL_11_006: [ The first time a thread uses a pool, BUFFER_POOL_get and BUFFER_delete shall allocate the free lists of that thread for that pool. ]*/
+/* Tests_SRS_BUFFER_POOL_11_009: [ If there is no buffer in the free lists, BUFFER_POOL_get shall allocate a new buffer with that power of 2 as capacity. ]*/
+TEST_FUNCTION(BUFFER_POOL_get_allocates_the_free_lists_of_the_thread_and_a_buffer)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = BUFFER_POOL_create(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer;
+    BUFFER_POOL_STATISTICS statistics;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(128));
+
+    ///act
+    buffer = BUFFER_POOL_get(pool, 100);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(buffer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, BUFFER_length(buffer));
+    ASSERT_ARE_EQUAL(size_t, 128, BUFFER_capacity(buffer));
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_POOL_get_statistics(pool, &statistics));
+    ASSERT_ARE_EQUAL(size_t, 0, statistics.hits);
+    ASSERT_ARE_EQUAL(size_t, 1, statistics.misses);
+
+    ///cleanup
+    BUFFER_delete(buffer);
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_007: [ BUFFER_POOL_get shall return a buffer of length 0 from the free list of the calling thread for the smallest power of 2 (at least 64) that is not smaller than capacity. ]*/
+TEST_FUNCTION(BUFFER_POOL_get_rounds_small_capacities_up_to_64)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = BUFFER_POOL_create(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(64));
+
+    ///act
+    buffer = BUFFER_POOL_get(pool, 0);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(buffer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 64, BUFFER_capacity(buffer));
+
+    ///cleanup
+    BUFFER_delete(buffer);
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_007: [ BUFFER_POOL_get shall return a buffer of length 0 from the free list of the calling thread for the smallest power of 2 (at least 64) that is not smaller than capacity. ]*/
+/* Tests_SRS_BUFFER_POOL_11_012: [ BUFFER_delete shall turn the headroom of a buffer of the pool back into capacity and put the buffer in the free list of the calling thread for the largest power of 2 that is not bigger than its capacity. ]*/
+TEST_FUNCTION(BUFFER_POOL_get_returns_a_deleted_buffer_without_allocating)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer;
+    BUFFER_HANDLE deleted_buffer = BUFFER_POOL_get(pool, 1000);
+    BUFFER_POOL_STATISTICS statistics;
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_enlarge(deleted_buffer, 1000));
+    BUFFER_delete(deleted_buffer);
+    umock_c_reset_all_calls();
+
+    ///act
+    buffer = BUFFER_POOL_get(pool, 1000);
+
+    ///assert
+    ASSERT_ARE_EQUAL(void_ptr, deleted_buffer, buffer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, BUFFER_length(buffer));
+    ASSERT_ARE_EQUAL(size_t, 1024, BUFFER_capacity(buffer));
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_POOL_get_statistics(pool, &statistics));
+    ASSERT_ARE_EQUAL(size_t, 1, statistics.hits);
+    ASSERT_ARE_EQUAL(size_t, 2, statistics.misses);
+    ASSERT_ARE_EQUAL(size_t, 2, statistics.recycled);
+    ASSERT_ARE_EQUAL(size_t, 0, statistics.discarded);
+    ASSERT_ARE_EQUAL(size_t, 1, statistics.cached_buffers);
+
+    ///cleanup
+    BUFFER_delete(buffer);
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_012: [ BUFFER_delete shall turn the headroom of a buffer of the pool back into capacity and put the buffer in the free list of the calling thread for the largest power of 2 that is not bigger than its capacity. ]*/
+TEST_FUNCTION(BUFFER_delete_gives_the_headroom_back_to_the_capacity)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer;
+    BUFFER_HANDLE deleted_buffer = BUFFER_POOL_get(pool, 64);
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_enlarge(deleted_buffer, 10));
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_pull_front(deleted_buffer, 4));
+    BUFFER_delete(deleted_buffer);
+    umock_c_reset_all_calls();
+
+    ///act
+    buffer = BUFFER_POOL_get(pool, 64);
+
+    ///assert
+    ASSERT_ARE_EQUAL(void_ptr, deleted_buffer, buffer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 64, BUFFER_capacity(buffer));
+
+    ///cleanup
+    BUFFER_delete(buffer);
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_010: [ If any error occurs, BUFFER_POOL_get shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_the_BUFFER_fails_BUFFER_POOL_get_fails)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    buffer = BUFFER_POOL_get(pool, 100);
+
+    ///assert
+    ASSERT_IS_NULL(buffer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_010: [ If any error occurs, BUFFER_POOL_get shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_the_memory_of_the_buffer_fails_BUFFER_POOL_get_fails)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(128))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    buffer = BUFFER_POOL_get(pool, 100);
+
+    ///assert
+    ASSERT_IS_NULL(buffer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_011: [ If capacity is more than 64KB, BUFFER_POOL_get shall return a new buffer that does not belong to the pool. ]*/
+TEST_FUNCTION(BUFFER_POOL_get_of_more_than_64KB_returns_a_buffer_that_is_not_kept)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_realloc(NULL, 70000));
+
+    ///act
+    buffer = BUFFER_POOL_get(pool, 70000);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(buffer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 70000, BUFFER_capacity(buffer));
+
+    umock_c_reset_all_calls();
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    BUFFER_delete(buffer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_008: [ If the free list of the calling thread is empty, BUFFER_POOL_get shall first move up to half a thread free list of buffers from the shared list of the pool to it. ]*/
+/* Tests_SRS_BUFFER_POOL_11_015: [ If the free list of the calling thread is full, BUFFER_delete shall first move half of it to the shared list of the pool. ]*/
+TEST_FUNCTION(BUFFER_POOL_get_takes_buffers_from_the_shared_list)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer1 = BUFFER_POOL_get(pool, 65536);
+    BUFFER_HANDLE buffer2 = BUFFER_POOL_get(pool, 65536);
+    BUFFER_HANDLE buffer3;
+    BUFFER_HANDLE buffer4;
+    BUFFER_POOL_STATISTICS statistics;
+    BUFFER_delete(buffer1);
+    BUFFER_delete(buffer2);
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_POOL_get_statistics(pool, &statistics));
+    ASSERT_ARE_EQUAL(size_t, 3, statistics.cached_buffers);
+    ASSERT_ARE_EQUAL(size_t, 64 + 2 * 65536, statistics.cached_bytes);
+    umock_c_reset_all_calls();
+
+    ///act
+    buffer3 = BUFFER_POOL_get(pool, 65536);
+    buffer4 = BUFFER_POOL_get(pool, 65536);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, buffer2, buffer3);
+    ASSERT_ARE_EQUAL(void_ptr, buffer1, buffer4);
+
+    ///cleanup
+    BUFFER_delete(buffer3);
+    BUFFER_delete(buffer4);
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_014: [ Buffers that do not fit in the max_cached_bytes of the shared lists shall be freed. ]*/
+TEST_FUNCTION(BUFFER_delete_frees_the_buffers_that_do_not_fit_in_the_shared_list)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(0);
+    BUFFER_HANDLE buffer1 = BUFFER_POOL_get(pool, 65536);
+    BUFFER_HANDLE buffer2 = BUFFER_POOL_get(pool, 65536);
+    BUFFER_POOL_STATISTICS statistics;
+    BUFFER_delete(buffer1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    BUFFER_delete(buffer2);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_POOL_get_statistics(pool, &statistics));
+    ASSERT_ARE_EQUAL(size_t, 3, statistics.recycled);
+    ASSERT_ARE_EQUAL(size_t, 1, statistics.discarded);
+    ASSERT_ARE_EQUAL(size_t, 2, statistics.cached_buffers);
+
+    ///cleanup
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_013: [ If the buffer has no memory, less than 64 bytes or at least 128KB of capacity, the pool shall not keep it and BUFFER_delete shall free it. ]*/
+TEST_FUNCTION(BUFFER_delete_frees_a_buffer_that_grew_to_128KB)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer = BUFFER_POOL_get(pool, 65536);
+    BUFFER_POOL_STATISTICS statistics;
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_enlarge(buffer, 131072));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    BUFFER_delete(buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_POOL_get_statistics(pool, &statistics));
+    ASSERT_ARE_EQUAL(size_t, 1, statistics.discarded);
+
+    ///cleanup
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_013: [ If the buffer has no memory, less than 64 bytes or at least 128KB of capacity, the pool shall not keep it and BUFFER_delete shall free it. ]*/
+TEST_FUNCTION(BUFFER_delete_frees_a_buffer_emptied_by_BUFFER_unbuild)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer = BUFFER_POOL_get(pool, 100);
+    ASSERT_ARE_EQUAL(int, 0, BUFFER_unbuild(buffer));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    BUFFER_delete(buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    BUFFER_POOL_destroy(pool);
+}
+
+/* BUFFER_POOL_get_statistics */
+
+/* Tests_SRS_BUFFER_POOL_11_017: [ If pool or statistics is NULL, BUFFER_POOL_get_statistics shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(BUFFER_POOL_get_statistics_with_NULL_pool_fails)
+{
+    ///arrange
+    BUFFER_POOL_STATISTICS statistics;
+
+    ///act
+    int result = BUFFER_POOL_get_statistics(NULL, &statistics);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_017: [ If pool or statistics is NULL, BUFFER_POOL_get_statistics shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(BUFFER_POOL_get_statistics_with_NULL_statistics_fails)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+
+    ///act
+    int result = BUFFER_POOL_get_statistics(pool, NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    ///cleanup
+    BUFFER_POOL_destroy(pool);
+}
+
+/* Tests_SRS_BUFFER_POOL_11_018: [ BUFFER_POOL_get_statistics shall add up the counters and the free lists of the pool and of all the threads that use it, and return 0. The numbers of the other threads can be a few calls behind. ]*/
+TEST_FUNCTION(BUFFER_POOL_get_statistics_counts_the_buffers_of_the_thread)
+{
+    ///arrange
+    BUFFER_POOL_HANDLE pool = create_pool(TEST_MAX_CACHED_BYTES);
+    BUFFER_HANDLE buffer1 = BUFFER_POOL_get(pool, 1);
+    BUFFER_HANDLE buffer2 = BUFFER_POOL_get(pool, 300);
+    BUFFER_POOL_STATISTICS statistics;
+    BUFFER_delete(buffer1);
+    BUFFER_delete(buffer2);
+    umock_c_reset_all_calls();
+
+    ///act
+    int result = BUFFER_POOL_get_statistics(pool, &statistics);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 1, statistics.hits);
+    ASSERT_ARE_EQUAL(size_t, 2, statistics.misses);
+    ASSERT_ARE_EQUAL(size_t, 3, statistics.recycled);
+    ASSERT_ARE_EQUAL(size_t, 0, statistics.discarded);
+    ASSERT_ARE_EQUAL(size_t, 2, statistics.cached_buffers);
+    ASSERT_ARE_EQUAL(size_t, 64 + 512, statistics.cached_bytes);
+
+    ///cleanup
+    BUFFER_POOL_destroy(pool);
+}
+
+END_TEST_SUITE(buffer_pool_unittests)
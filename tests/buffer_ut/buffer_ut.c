@@ -11,6 +11,7 @@
 
 #include "umock_c.h"
 #include "azure_c_shared_utility/buffer_.h"
+#include "azure_c_shared_utility/buffer_types_internal.h"
 #include "testrunnerswitcher.h"
 
 static size_t currentmalloc_call = 0;
@@ -86,6 +87,19 @@ static const unsigned char TOTAL_BUFFER[] = {0x01,0x02,0x03,0x04,0x05,0x06,0x07,
 
 static TEST_MUTEX_HANDLE g_testByTest;
 
+static size_t g_recycle_calls;
+static int g_recycle_result;
+
+static int test_recycle(BUFFER_RECYCLER* recycler, BUFFER* buffer)
+{
+    (void)recycler;
+    (void)buffer;
+    g_recycle_calls++;
+    return g_recycle_result;
+}
+
+static BUFFER_RECYCLER test_recycler = { test_recycle };
+
 DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
 
 static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
@@ -210,6 +224,76 @@ BEGIN_TEST_SUITE(Buffer_UnitTests)
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     }
 
+    /* Tests_SRS_BUFFER_11_017: [ If the buffer came from a BUFFER_POOL, BUFFER_delete shall give it back to the pool, and only free it if the pool does not keep it. ]*/
+    TEST_FUNCTION(BUFFER_delete_gives_a_pooled_buffer_back_to_its_pool)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        g_hBuffer->recycler = &test_recycler;
+        g_recycle_calls = 0;
+        g_recycle_result = 0;
+        umock_c_reset_all_calls();
+
+        ///act
+        BUFFER_delete(g_hBuffer);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, g_recycle_calls);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        g_hBuffer->recycler = NULL;
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_017: [ If the buffer came from a BUFFER_POOL, BUFFER_delete shall give it back to the pool, and only free it if the pool does not keep it. ]*/
+    TEST_FUNCTION(BUFFER_delete_frees_a_pooled_buffer_the_pool_does_not_keep)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        g_hBuffer->recycler = &test_recycler;
+        g_recycle_calls = 0;
+        g_recycle_result = 1;
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+        ///act
+        BUFFER_delete(g_hBuffer);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, g_recycle_calls);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_11_017: [ If the buffer came from a BUFFER_POOL, BUFFER_delete shall give it back to the pool, and only free it if the pool does not keep it. ]*/
+    TEST_FUNCTION(BUFFER_delete_gives_a_pooled_buffer_back_to_its_pool_after_unbuild_and_append_build)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        g_hBuffer->recycler = &test_recycler;
+        g_recycle_calls = 0;
+        g_recycle_result = 0;
+        ASSERT_ARE_EQUAL(int, 0, BUFFER_unbuild(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, BUFFER_append_build(g_hBuffer, BUFFER_Test1, BUFFER_TEST1_SIZE));
+        umock_c_reset_all_calls();
+
+        ///act
+        BUFFER_delete(g_hBuffer);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, g_recycle_calls);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        g_hBuffer->recycler = NULL;
+        BUFFER_delete(g_hBuffer);
+    }
+
     /* BUFFER_pre_Build Tests BEGIN */
     /* Tests_SRS_BUFFER_07_005: [BUFFER_pre_build allocates size_t bytes of BUFFER_HANDLE and returns zero on success.] */
     TEST_FUNCTION(BUFFER_pre_build_Succeed)
@@ -1712,4 +1796,393 @@ BEGIN_TEST_SUITE(Buffer_UnitTests)
         BUFFER_delete(buffer);
     }
 
+    /* Tests_SRS_BUFFER_11_001: [ When the buffer needs more memory, BUFFER_append_build, BUFFER_enlarge and BUFFER_append shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+    TEST_FUNCTION(BUFFER_enlarge_doubles_the_capacity)
+    {
+        ///arrange
+        int nResult;
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_new();
+        nResult = BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        nResult = BUFFER_enlarge(g_hBuffer, 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE + 1, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, 2 * ALLOCATION_SIZE, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_001: [ When the buffer needs more memory, BUFFER_append_build, BUFFER_enlarge and BUFFER_append shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+    TEST_FUNCTION(BUFFER_append_build_within_the_capacity_does_not_allocate)
+    {
+        ///arrange
+        int nResult;
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        nResult = BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = BUFFER_append_build(g_hBuffer, ADDITIONAL_BUFFER, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_001: [ When the buffer needs more memory, BUFFER_append_build, BUFFER_enlarge and BUFFER_append shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+    TEST_FUNCTION(BUFFER_append_build_many_times_reallocates_logarithmically)
+    {
+        ///arrange
+        int nResult = 0;
+        size_t i;
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_create(BUFFER_Test1, 1);
+        umock_c_reset_all_calls();
+
+        /*capacity goes 1 => 2 => 4 => ... => 1024*/
+        for (i = 0; i < 10; i++)
+        {
+            STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, (size_t)2 << i))
+                .IgnoreArgument(1);
+        }
+
+        ///act
+        for (i = 1; i < 1024; i++)
+        {
+            nResult |= BUFFER_append_build(g_hBuffer, BUFFER_Test1, 1);
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, 1024, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, 1024, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_002: [ If handle is NULL, BUFFER_reserve shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(BUFFER_reserve_with_NULL_handle_fails)
+    {
+        ///arrange
+        int nResult;
+
+        ///act
+        nResult = BUFFER_reserve(NULL, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_11_003: [ BUFFER_reserve shall grow the memory of the buffer to capacity bytes, keeping its content and its length, and return 0. ]*/
+    TEST_FUNCTION(BUFFER_reserve_succeeds)
+    {
+        ///arrange
+        int nResult;
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 100))
+            .IgnoreArgument(1);
+
+        ///act
+        nResult = BUFFER_reserve(g_hBuffer, 100);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, 100, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_004: [ If the buffer can already hold capacity bytes, BUFFER_reserve shall do nothing and return 0. ]*/
+    TEST_FUNCTION(BUFFER_reserve_less_than_the_capacity_does_nothing)
+    {
+        ///arrange
+        int nResult;
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = BUFFER_reserve(g_hBuffer, ALLOCATION_SIZE - 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_005: [ If any error occurs, BUFFER_reserve shall fail, leave the buffer unchanged and return a non-zero value. ]*/
+    TEST_FUNCTION(when_realloc_fails_BUFFER_reserve_fails)
+    {
+        ///arrange
+        int nResult;
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 100))
+            .IgnoreArgument(1)
+            .SetReturn(NULL);
+
+        ///act
+        nResult = BUFFER_reserve(g_hBuffer, 100);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_006: [ If handle is NULL, BUFFER_capacity shall return 0. ]*/
+    TEST_FUNCTION(BUFFER_capacity_with_NULL_handle_returns_0)
+    {
+        ///arrange
+        size_t capacity;
+
+        ///act
+        capacity = BUFFER_capacity(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, capacity);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_11_007: [ BUFFER_capacity shall return the number of bytes the buffer can hold without allocating memory. ]*/
+    TEST_FUNCTION(BUFFER_capacity_of_a_new_buffer_is_0)
+    {
+        ///arrange
+        size_t capacity;
+        BUFFER_HANDLE g_hBuffer = BUFFER_new();
+        umock_c_reset_all_calls();
+
+        ///act
+        capacity = BUFFER_capacity(g_hBuffer);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, capacity);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_008: [ If source is NULL, BUFFER_create_with_headroom shall fail and return NULL. ]*/
+    TEST_FUNCTION(BUFFER_create_with_headroom_with_NULL_source_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer;
+
+        ///act
+        g_hBuffer = BUFFER_create_with_headroom(NULL, ALLOCATION_SIZE, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(g_hBuffer);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_11_009: [ BUFFER_create_with_headroom shall allocate headroom + size bytes in one block, copy size bytes from source after the first headroom bytes and return a non-NULL handle. ]*/
+    TEST_FUNCTION(BUFFER_create_with_headroom_succeeds)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer;
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(gballoc_malloc(BUFFER_TEST1_SIZE + ALLOCATION_SIZE));
+
+        ///act
+        g_hBuffer = BUFFER_create_with_headroom(BUFFER_TEST_VALUE, ALLOCATION_SIZE, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(g_hBuffer);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_010: [ If any error occurs, BUFFER_create_with_headroom shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_malloc_fails_BUFFER_create_with_headroom_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer;
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(gballoc_malloc(BUFFER_TEST1_SIZE + ALLOCATION_SIZE))
+            .SetReturn(NULL);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+        ///act
+        g_hBuffer = BUFFER_create_with_headroom(BUFFER_TEST_VALUE, ALLOCATION_SIZE, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(g_hBuffer);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_11_011: [ If handle is NULL or size is 0, BUFFER_push_front shall fail and return NULL. ]*/
+    TEST_FUNCTION(BUFFER_push_front_with_NULL_handle_fails)
+    {
+        ///arrange
+        unsigned char* front;
+
+        ///act
+        front = BUFFER_push_front(NULL, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(front);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_11_013: [ BUFFER_push_front shall add size bytes taken from the headroom in front of the content, without moving it, and return a pointer to them so the caller can fill them. ]*/
+    TEST_FUNCTION(BUFFER_push_front_fills_the_headroom_without_allocating)
+    {
+        ///arrange
+        unsigned char* front;
+        unsigned char* content;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create_with_headroom(BUFFER_Test2, BUFFER_TEST2_SIZE, BUFFER_TEST1_SIZE);
+        content = BUFFER_u_char(g_hBuffer);
+        umock_c_reset_all_calls();
+
+        ///act
+        front = BUFFER_push_front(g_hBuffer, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(front);
+        (void)memcpy(front, BUFFER_Test1, BUFFER_TEST1_SIZE);
+        ASSERT_ARE_EQUAL(void_ptr, front, BUFFER_u_char(g_hBuffer));
+        ASSERT_ARE_EQUAL(void_ptr, content, front + BUFFER_TEST1_SIZE);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_012: [ If the buffer has less than size bytes of headroom, BUFFER_push_front shall fail and return NULL. ]*/
+    TEST_FUNCTION(BUFFER_push_front_more_than_the_headroom_fails)
+    {
+        ///arrange
+        unsigned char* front;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create_with_headroom(BUFFER_Test2, BUFFER_TEST2_SIZE, BUFFER_TEST1_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        front = BUFFER_push_front(g_hBuffer, BUFFER_TEST1_SIZE + 1);
+
+        ///assert
+        ASSERT_IS_NULL(front);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST2_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test2, BUFFER_TEST2_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_014: [ If handle is NULL, size is 0 or size is bigger than the length of the buffer, BUFFER_pull_front shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(BUFFER_pull_front_more_than_the_length_fails)
+    {
+        ///arrange
+        int nResult;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = BUFFER_pull_front(g_hBuffer, BUFFER_TEST1_SIZE + 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_015: [ BUFFER_pull_front shall remove the first size bytes of the buffer by turning them into headroom, without moving the rest of the content, and return 0. ]*/
+    TEST_FUNCTION(BUFFER_pull_front_then_push_front_reuses_the_memory)
+    {
+        ///arrange
+        int nResult;
+        unsigned char* front;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE);
+        unsigned char* content = BUFFER_u_char(g_hBuffer);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = BUFFER_pull_front(g_hBuffer, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST2_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(void_ptr, content + BUFFER_TEST1_SIZE, BUFFER_u_char(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test2, BUFFER_TEST2_SIZE));
+        front = BUFFER_push_front(g_hBuffer, BUFFER_TEST1_SIZE);
+        ASSERT_ARE_EQUAL(void_ptr, content, front);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_11_016: [ If handle1 has at least as much headroom as the size of handle2, BUFFER_prepend shall copy handle2 into the headroom without moving the content of handle1. ]*/
+    TEST_FUNCTION(BUFFER_prepend_into_the_headroom_does_not_allocate)
+    {
+        ///arrange
+        int nResult;
+        BUFFER_HANDLE hPrepend = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        BUFFER_HANDLE g_hBuffer = BUFFER_create_with_headroom(BUFFER_Test2, BUFFER_TEST2_SIZE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = BUFFER_prepend(g_hBuffer, hPrepend);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(hPrepend);
+        BUFFER_delete(g_hBuffer);
+    }
+
 END_TEST_SUITE(Buffer_UnitTests)
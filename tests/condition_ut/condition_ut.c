@@ -180,6 +180,43 @@ TEST_FUNCTION(Condition_Post_Handle_Succeed)
     Condition_Deinit(handle);
 }
 
+// Tests_SRS_CONDITION_11_001: [ Condition_Broadcast shall return COND_INVALID_ARG if handle is NULL ]
+TEST_FUNCTION(Condition_Broadcast_Handle_NULL_Failure)
+{
+    //arrange
+    COND_RESULT result;
+
+    //act
+    result = Condition_Broadcast(NULL);
+
+    //assert
+    ASSERT_ARE_EQUAL(COND_RESULT, COND_INVALID_ARG, result);
+
+    //free
+}
+
+// Tests_SRS_CONDITION_11_003: [ Condition_Broadcast shall return COND_OK if it succcessfully broadcasts the condition, also when no thread is waiting ]
+TEST_FUNCTION(Condition_Broadcast_Handle_Succeed)
+{
+    //arrange
+    COND_HANDLE handle = NULL;
+    COND_RESULT result;
+
+    EXPECTED_CALL(gballoc_malloc(4));
+    EXPECTED_CALL(gballoc_free(0));
+
+    handle = Condition_Init();
+
+    //act
+    result = Condition_Broadcast(handle);
+
+    //assert
+    ASSERT_ARE_EQUAL(COND_RESULT, COND_OK, result);
+
+    //free
+    Condition_Deinit(handle);
+}
+
 // Tests_SRS_CONDITION_18_004: [ Condition_Wait shall return COND_INVALID_ARG if handle is NULL ]
 TEST_FUNCTION(Condition_Wait_Handle_NULL_Fail)
 {
@@ -383,6 +420,60 @@ TEST_FUNCTION(Condition_Wait_ok_on_trigger_with_timeout)
     umock_c_reset_all_calls();
 }
 
+typedef struct WAITER_TAG
+{
+    LockAndCondition* lock_and_condition;
+    COND_RESULT result;
+} WAITER;
+
+static int waiter_thread_proc(void *h)
+{
+    WAITER* waiter = (WAITER*)h;
+
+    Lock(waiter->lock_and_condition->lock);
+    waiter->result = Condition_Wait(waiter->lock_and_condition->condition, waiter->lock_and_condition->lock, CONDITION_WAIT_MS);
+    Unlock(waiter->lock_and_condition->lock);
+    return 0;
+}
+
+// Tests_SRS_CONDITION_11_002: [ Condition_Broadcast shall unblock all the threads waiting on the condition ]
+TEST_FUNCTION(Condition_Broadcast_unblocks_all_the_waiters)
+{
+    // arrange
+    LockAndCondition m;
+    WAITER waiters[2];
+    THREAD_HANDLE threads[2];
+    COND_RESULT result;
+    size_t i;
+    m.condition = Condition_Init();
+    m.lock = Lock_Init();
+    for (i = 0; i < 2; i++)
+    {
+        waiters[i].lock_and_condition = &m;
+        waiters[i].result = COND_ERROR;
+        (void)ThreadAPI_Create(&threads[i], waiter_thread_proc, &waiters[i]);
+    }
+
+    // act
+    /*both waiters are waiting long before the broadcast, a waiter that is late would time out*/
+    ThreadAPI_Sleep(200);
+    Lock(m.lock);
+    result = Condition_Broadcast(m.condition);
+    Unlock(m.lock);
+    for (i = 0; i < 2; i++)
+    {
+        ThreadAPI_Join(threads[i], NULL);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(COND_RESULT, COND_OK, result);
+    ASSERT_ARE_EQUAL(COND_RESULT, COND_OK, waiters[0].result);
+    ASSERT_ARE_EQUAL(COND_RESULT, COND_OK, waiters[1].result);
+    Lock_Deinit(m.lock);
+    Condition_Deinit(m.condition);
+    umock_c_reset_all_calls();
+}
+
 END_TEST_SUITE(Condition_UnitTests);
 
 /*if malloc is defined as gballoc_malloc at this moment, there'd be serious trouble*/
@@ -155,7 +155,8 @@ TEST_FUNCTION(connectionstringparser_parse_with_an_empty_string_yields_an_empty_
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(connectionString)).SetReturn(tokens);
     STRICT_EXPECTED_CALL(STRING_new()).SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new()).SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL));
+    STRICT_EXPECTED_CALL(STRING_c_str(connectionString));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 0));
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
     STRICT_EXPECTED_CALL(STRING_delete(value));
     STRICT_EXPECTED_CALL(STRING_delete(key));
@@ -262,7 +263,8 @@ TEST_FUNCTION(when_allocating_the_result_map_fails_then_connectionstringparser_f
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR)).SetReturn(tokens);
     STRICT_EXPECTED_CALL(STRING_new()).SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new()).SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn((MAP_HANDLE)NULL);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 1)).SetReturn((MAP_HANDLE)NULL);
     STRICT_EXPECTED_CALL(STRING_delete(value));
     STRICT_EXPECTED_CALL(STRING_delete(key));
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
@@ -302,7 +304,8 @@ TEST_FUNCTION(connectionstringparser_parse_with_a_key_value_pair_adds_it_to_the_
         .SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new())
         .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 1));
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
     STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
@@ -345,7 +348,8 @@ TEST_FUNCTION(when_getting_the_value_token_fails_then_connectionstringparser_par
         .SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new())
         .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_KEY));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 1)).SetReturn(map);
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
     STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_KEY, 4));
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
@@ -377,7 +381,8 @@ TEST_FUNCTION(when_the_key_is_zero_length_then_connectionstringparser_parse_fail
     STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)).IgnoreAllArguments();
     STRICT_EXPECTED_CALL(STRING_new()).SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new()).SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 1)).SetReturn(map);
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(IGNORED_PTR_ARG, key, "=")).IgnoreArgument(1);
     STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(IGNORED_PTR_ARG, value, ";")).IgnoreArgument(1);
@@ -412,7 +417,8 @@ TEST_FUNCTION(when_adding_the_key_value_pair_to_the_map_fails_then_connectionstr
         .SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new())
         .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 1)).SetReturn(map);
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
     STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
@@ -448,7 +454,8 @@ TEST_FUNCTION(when_getting_the_C_string_for_the_key_fails_then_connectionstringp
     STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)).IgnoreAllArguments();
     STRICT_EXPECTED_CALL(STRING_new()).SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new()).SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 1)).SetReturn(map);
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(IGNORED_PTR_ARG, key, "=")).IgnoreArgument(1);
     STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(IGNORED_PTR_ARG, value, ";")).IgnoreArgument(1);
@@ -483,7 +490,8 @@ TEST_FUNCTION(when_getting_the_C_string_for_the_value_fails_then_connectionstrin
         .SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new())
         .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 1)).SetReturn(map);
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
     STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
@@ -529,7 +537,8 @@ TEST_FUNCTION(connectionstringparser_parse_with_2_key_value_pairs_adds_them_to_t
         .SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new())
         .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_2_PAIR));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 2)).SetReturn(map);
 
     // 1st kvp
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
@@ -598,7 +607,8 @@ TEST_FUNCTION(connectionstringparser_parse_with_2_key_value_pairs_ended_with_sem
         .SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new())
         .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_2_PAIR_SEMICOLON));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 2)).SetReturn(map);
 
     // 1st kvp
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
@@ -658,7 +668,8 @@ TEST_FUNCTION(connectionstringparser_parse_from_char_with_2_key_value_pairs_ende
         .SetReturn(key);
     STRICT_EXPECTED_CALL(STRING_new())
         .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(test_string_val));
+    STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 2)).SetReturn(map);
 
     // 1st kvp
     STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
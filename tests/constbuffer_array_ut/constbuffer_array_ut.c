@@ -16,6 +16,11 @@ static void* my_gballoc_malloc(size_t size)
     return malloc(size);
 }
 
+static void* my_gballoc_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
 static void my_gballoc_free(void* s)
 {
     free(s);
@@ -91,6 +96,9 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
 
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_realloc, NULL);
+
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
 }
 
@@ -149,6 +157,7 @@ static void constbuffer_array_create_empty_inert_path(void)
 
 /* constbuffer_array_create */
 
+/* Tests_SRS_CONSTBUFFER_ARRAY_11_001: [ constbuffer_array_create shall add up the sizes of the buffers in buffers. ]*/
 /* Tests_SRS_CONSTBUFFER_ARRAY_01_009: [ constbuffer_array_create shall allocate memory for a new CONSTBUFFER_ARRAY_HANDLE that can hold buffer_count buffers. ]*/
 /* Tests_SRS_CONSTBUFFER_ARRAY_01_010: [ constbuffer_array_create shall clone the buffers in buffers and store them. ]*/
 /* Tests_SRS_CONSTBUFFER_ARRAY_01_011: [ On success constbuffer_array_create shall return a non-NULL handle. ]*/
@@ -161,6 +170,8 @@ TEST_FUNCTION(constbuffer_array_create_succeeds)
     test_buffers[0] = TEST_CONSTBUFFER_HANDLE_1;
     test_buffers[1] = TEST_CONSTBUFFER_HANDLE_2;
 
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_2));
     STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
     STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_1));
     STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_2));
@@ -228,6 +239,8 @@ TEST_FUNCTION(when_underlying_calls_fail_constbuffer_array_create_fails)
     test_buffers[0] = TEST_CONSTBUFFER_HANDLE_1;
     test_buffers[1] = TEST_CONSTBUFFER_HANDLE_2;
 
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_2));
     STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
     STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_1));
     STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_2));
@@ -329,6 +342,7 @@ static CONSTBUFFER_ARRAY_HANDLE TEST_constbuffer_array_add_front(CONSTBUFFER_ARR
     uint32_t i;
     CONSTBUFFER_ARRAY_HANDLE result;
 
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(constbuffer_handle));
     STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
     for (i = 0; i < nExistingBuffers; i++)
     {
@@ -347,6 +361,7 @@ static CONSTBUFFER_ARRAY_HANDLE TEST_constbuffer_array_remove_front(CONSTBUFFER_
     CONSTBUFFER_ARRAY_HANDLE result;
 
     ASSERT_IS_TRUE(nExistingBuffers > 0);
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
     for (i = 0; i < nExistingBuffers-1; i++)
     {
@@ -889,10 +904,12 @@ TEST_FUNCTION(constbuffer_array_add_front_with_constbuffer_handle_NULL_fails)
 
 static void constbuffer_array_add_front_inert_path(void)
 {
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1));
     STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
     STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_1));
 }
 
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_003: [ constbuffer_array_add_front shall add the size of constbuffer_handle to the size of constbuffer_array_handle. ]*/
 /*Tests_SRS_CONSTBUFFER_ARRAY_02_042: [ constbuffer_array_add_front shall allocate enough memory to hold all of constbuffer_array_handle existing CONSTBUFFER_HANDLE and constbuffer_handle. ]*/
 /*Tests_SRS_CONSTBUFFER_ARRAY_02_043: [ constbuffer_array_add_front shall copy constbuffer_handle and all of constbuffer_array_handle existing CONSTBUFFER_HANDLE. ]*/
 /*Tests_SRS_CONSTBUFFER_ARRAY_02_044: [ constbuffer_array_add_front shall inc_ref all the CONSTBUFFER_HANDLE it had copied. ]*/
@@ -948,6 +965,105 @@ TEST_FUNCTION(constbuffer_array_add_front_unhappy_paths)
     constbuffer_array_dec_ref(TEST_CONSTBUFFER_ARRAY_HANDLE);
 }
 
+/*constbuffer_array_add_back*/
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_004: [ If constbuffer_array_handle is NULL then constbuffer_array_add_back shall fail and return NULL. ]*/
+TEST_FUNCTION(constbuffer_array_add_back_with_constbuffer_array_handle_NULL_fails)
+{
+    ///arrange
+
+    ///act
+    CONSTBUFFER_ARRAY_HANDLE result = constbuffer_array_add_back(NULL, TEST_CONSTBUFFER_HANDLE_1);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_005: [ If constbuffer_handle is NULL then constbuffer_array_add_back shall fail and return NULL. ]*/
+TEST_FUNCTION(constbuffer_array_add_back_with_constbuffer_handle_NULL_fails)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_HANDLE TEST_CONSTBUFFER_ARRAY_HANDLE = TEST_constbuffer_array_create_empty();
+
+    ///act
+    CONSTBUFFER_ARRAY_HANDLE result = constbuffer_array_add_back(TEST_CONSTBUFFER_ARRAY_HANDLE, NULL);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///clean
+    constbuffer_array_dec_ref(TEST_CONSTBUFFER_ARRAY_HANDLE);
+}
+
+static void constbuffer_array_add_back_inert_path(void)
+{
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_2));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_1));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_2));
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_006: [ constbuffer_array_add_back shall add the size of constbuffer_handle to the size of constbuffer_array_handle. ]*/
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_007: [ constbuffer_array_add_back shall allocate enough memory to hold all of constbuffer_array_handle existing CONSTBUFFER_HANDLE and constbuffer_handle. ]*/
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_008: [ constbuffer_array_add_back shall copy all of constbuffer_array_handle existing CONSTBUFFER_HANDLE and then constbuffer_handle, and inc_ref all of them. ]*/
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_009: [ constbuffer_array_add_back shall succeed and return a non-NULL value. ]*/
+TEST_FUNCTION(constbuffer_array_add_back_succeeds)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_HANDLE TEST_CONSTBUFFER_ARRAY_HANDLE = TEST_constbuffer_array_create(1, 0);
+    CONSTBUFFER_ARRAY_HANDLE result;
+    uint32_t all_buffers_size;
+
+    constbuffer_array_add_back_inert_path();
+
+    ///act
+    result = constbuffer_array_add_back(TEST_CONSTBUFFER_ARRAY_HANDLE, TEST_CONSTBUFFER_HANDLE_2);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    validate_sorted_constbuffer_array(result, 2);
+    ASSERT_ARE_EQUAL(int, 0, constbuffer_array_get_all_buffers_size(result, &all_buffers_size));
+    ASSERT_ARE_EQUAL(uint32_t, 3, all_buffers_size);
+
+    ///clean
+    constbuffer_array_dec_ref(TEST_CONSTBUFFER_ARRAY_HANDLE);
+    constbuffer_array_dec_ref(result);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_010: [ If there any failures constbuffer_array_add_back shall fail and return NULL. ]*/
+TEST_FUNCTION(constbuffer_array_add_back_unhappy_paths)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_HANDLE TEST_CONSTBUFFER_ARRAY_HANDLE = TEST_constbuffer_array_create(1, 0);
+    size_t i;
+
+    constbuffer_array_add_back_inert_path();
+
+    umock_c_negative_tests_snapshot();
+    for (i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            CONSTBUFFER_ARRAY_HANDLE result;
+
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            ///act
+            result = constbuffer_array_add_back(TEST_CONSTBUFFER_ARRAY_HANDLE, TEST_CONSTBUFFER_HANDLE_2);
+
+            ///assert
+            ASSERT_IS_NULL(result);
+        }
+    }
+
+    ///clean
+    constbuffer_array_dec_ref(TEST_CONSTBUFFER_ARRAY_HANDLE);
+}
+
 /*Tests_SRS_CONSTBUFFER_ARRAY_02_012: [ If constbuffer_array_handle is NULL then constbuffer_array_remove_front shall fail and return NULL. ]*/
 TEST_FUNCTION(constbuffer_array_remove_front_with_constbuffer_array_handle_NULL_fails)
 {
@@ -1025,6 +1141,7 @@ TEST_FUNCTION(constbuffer_array_remove_front_with_constbuffer_array_handle_empty
 
 static void constbuffer_array_remove_front_inert_path(uint32_t nExistingItems)
 {
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
     // clone front buffer
     STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(IGNORED_PTR_ARG));
@@ -1038,6 +1155,7 @@ static void constbuffer_array_remove_front_inert_path(uint32_t nExistingItems)
     }
 }
 
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_011: [ constbuffer_array_remove_front shall subtract the size of the front CONSTBUFFER_HANDLE from the size of constbuffer_array_handle, or add up the sizes of the other CONSTBUFFER_HANDLEs if that size does not fit in an uint32_t. ]*/
 /*Tests_SRS_CONSTBUFFER_ARRAY_02_046: [ constbuffer_array_remove_front shall allocate memory to hold all of constbuffer_array_handle CONSTBUFFER_HANDLEs except the front one. ]*/
 /*Tests_SRS_CONSTBUFFER_ARRAY_02_047: [ constbuffer_array_remove_front shall copy all of constbuffer_array_handle CONSTBUFFER_HANDLEs except the front one. ]*/
 /*Tests_SRS_CONSTBUFFER_ARRAY_02_048: [ constbuffer_array_remove_front shall inc_ref all the copied CONSTBUFFER_HANDLEs. ]*/
@@ -1140,6 +1258,53 @@ TEST_FUNCTION(constbuffer_array_remove_front_unhappy_paths)
     constbuffer_array_dec_ref(afterAdd);
 }
 
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_011: [ constbuffer_array_remove_front shall subtract the size of the front CONSTBUFFER_HANDLE from the size of constbuffer_array_handle, or add up the sizes of the other CONSTBUFFER_HANDLEs if that size does not fit in an uint32_t. ]*/
+TEST_FUNCTION(constbuffer_array_remove_front_of_a_too_big_array_adds_up_the_remaining_sizes)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_HANDLE TEST_CONSTBUFFER_ARRAY_HANDLE = TEST_constbuffer_array_create_empty();
+    CONSTBUFFER_ARRAY_HANDLE afterAdd1;
+    CONSTBUFFER_ARRAY_HANDLE afterAdd2;
+    CONSTBUFFER_ARRAY_HANDLE afterRemove;
+    CONSTBUFFER_HANDLE removed;
+    uint32_t all_buffers_size;
+    const CONSTBUFFER fake_const_buffer_1 = { (const unsigned char*)0x4242, 1 };
+    const CONSTBUFFER fake_const_buffer_2 = { (const unsigned char*)0x4242, UINT32_MAX };
+
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1))
+        .SetReturn(&fake_const_buffer_1);
+    afterAdd1 = constbuffer_array_add_front(TEST_CONSTBUFFER_ARRAY_HANDLE, TEST_CONSTBUFFER_HANDLE_1);
+    ASSERT_IS_NOT_NULL(afterAdd1);
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_2))
+        .SetReturn(&fake_const_buffer_2);
+    afterAdd2 = constbuffer_array_add_front(afterAdd1, TEST_CONSTBUFFER_HANDLE_2);
+    ASSERT_IS_NOT_NULL(afterAdd2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1))
+        .SetReturn(&fake_const_buffer_1);
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_2));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_1));
+
+    ///act
+    afterRemove = constbuffer_array_remove_front(afterAdd2, &removed);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(afterRemove);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, TEST_CONSTBUFFER_HANDLE_2, removed);
+    ASSERT_ARE_EQUAL(int, 0, constbuffer_array_get_all_buffers_size(afterRemove, &all_buffers_size));
+    ASSERT_ARE_EQUAL(uint32_t, 1, all_buffers_size);
+
+    ///clean
+    CONSTBUFFER_DecRef(removed);
+    constbuffer_array_dec_ref(TEST_CONSTBUFFER_ARRAY_HANDLE);
+    constbuffer_array_dec_ref(afterAdd1);
+    constbuffer_array_dec_ref(afterAdd2);
+    constbuffer_array_dec_ref(afterRemove);
+}
+
 /* constbuffer_array_get_buffer_count */
 
 /* Tests_SRS_CONSTBUFFER_ARRAY_01_002: [ On success, constbuffer_array_get_buffer_count shall return 0 and write the buffer count in buffer_count. ]*/
@@ -1663,17 +1828,22 @@ TEST_FUNCTION(constbuffer_array_get_all_buffers_size_when_overflow_happens_fails
 {
     ///arrange
     CONSTBUFFER_ARRAY_HANDLE TEST_CONSTBUFFER_ARRAY_HANDLE = TEST_constbuffer_array_create_empty();
-    CONSTBUFFER_ARRAY_HANDLE afterAdd1 = TEST_constbuffer_array_add_front(TEST_CONSTBUFFER_ARRAY_HANDLE, 0, TEST_CONSTBUFFER_HANDLE_1);
-    CONSTBUFFER_ARRAY_HANDLE afterAdd2 = TEST_constbuffer_array_add_front(afterAdd1, 1, TEST_CONSTBUFFER_HANDLE_2);
+    CONSTBUFFER_ARRAY_HANDLE afterAdd1;
+    CONSTBUFFER_ARRAY_HANDLE afterAdd2;
     uint32_t all_buffers_size;
     int result;
     const CONSTBUFFER fake_const_buffer_1 = { (const unsigned char*)0x4242, UINT32_MAX };
     const CONSTBUFFER fake_const_buffer_2 = { (const unsigned char*)0x4242, 1 };
 
-    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_2))
-        .SetReturn(&fake_const_buffer_2);
     STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1))
         .SetReturn(&fake_const_buffer_1);
+    afterAdd1 = constbuffer_array_add_front(TEST_CONSTBUFFER_ARRAY_HANDLE, TEST_CONSTBUFFER_HANDLE_1);
+    ASSERT_IS_NOT_NULL(afterAdd1);
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_2))
+        .SetReturn(&fake_const_buffer_2);
+    afterAdd2 = constbuffer_array_add_front(afterAdd1, TEST_CONSTBUFFER_HANDLE_2);
+    ASSERT_IS_NOT_NULL(afterAdd2);
+    umock_c_reset_all_calls();
 
     ///act
     result = constbuffer_array_get_all_buffers_size(afterAdd2, &all_buffers_size);
@@ -1693,17 +1863,22 @@ TEST_FUNCTION(constbuffer_array_get_all_buffers_size_max_all_size_succeeds)
 {
     ///arrange
     CONSTBUFFER_ARRAY_HANDLE TEST_CONSTBUFFER_ARRAY_HANDLE = TEST_constbuffer_array_create_empty();
-    CONSTBUFFER_ARRAY_HANDLE afterAdd1 = TEST_constbuffer_array_add_front(TEST_CONSTBUFFER_ARRAY_HANDLE, 0, TEST_CONSTBUFFER_HANDLE_1);
-    CONSTBUFFER_ARRAY_HANDLE afterAdd2 = TEST_constbuffer_array_add_front(afterAdd1, 1, TEST_CONSTBUFFER_HANDLE_2);
+    CONSTBUFFER_ARRAY_HANDLE afterAdd1;
+    CONSTBUFFER_ARRAY_HANDLE afterAdd2;
     uint32_t all_buffers_size;
     int result;
     const CONSTBUFFER fake_const_buffer_1 = { (const unsigned char*)0x4242, UINT32_MAX - 1 };
     const CONSTBUFFER fake_const_buffer_2 = { (const unsigned char*)0x4242, 1 };
 
-    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_2))
-        .SetReturn(&fake_const_buffer_2);
     STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1))
         .SetReturn(&fake_const_buffer_1);
+    afterAdd1 = constbuffer_array_add_front(TEST_CONSTBUFFER_ARRAY_HANDLE, TEST_CONSTBUFFER_HANDLE_1);
+    ASSERT_IS_NOT_NULL(afterAdd1);
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_2))
+        .SetReturn(&fake_const_buffer_2);
+    afterAdd2 = constbuffer_array_add_front(afterAdd1, TEST_CONSTBUFFER_HANDLE_2);
+    ASSERT_IS_NOT_NULL(afterAdd2);
+    umock_c_reset_all_calls();
 
     ///act
     result = constbuffer_array_get_all_buffers_size(afterAdd2, &all_buffers_size);
@@ -1725,13 +1900,16 @@ TEST_FUNCTION(constbuffer_array_get_all_buffers_size_when_buffer_size_bigger_tha
 {
     ///arrange
     CONSTBUFFER_ARRAY_HANDLE TEST_CONSTBUFFER_ARRAY_HANDLE = TEST_constbuffer_array_create_empty();
-    CONSTBUFFER_ARRAY_HANDLE afterAdd1 = TEST_constbuffer_array_add_front(TEST_CONSTBUFFER_ARRAY_HANDLE, 0, TEST_CONSTBUFFER_HANDLE_1);
+    CONSTBUFFER_ARRAY_HANDLE afterAdd1;
     uint32_t all_buffers_size;
     int result;
     const CONSTBUFFER fake_const_buffer_1 = { (const unsigned char*)0x4242, (size_t)UINT32_MAX + 1 };
 
     STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1))
         .SetReturn(&fake_const_buffer_1);
+    afterAdd1 = constbuffer_array_add_front(TEST_CONSTBUFFER_ARRAY_HANDLE, TEST_CONSTBUFFER_HANDLE_1);
+    ASSERT_IS_NOT_NULL(afterAdd1);
+    umock_c_reset_all_calls();
 
     ///act
     result = constbuffer_array_get_all_buffers_size(afterAdd1, &all_buffers_size);
@@ -1767,6 +1945,7 @@ TEST_FUNCTION(constbuffer_array_get_all_buffers_on_empty_const_buffer_array_succ
 }
 
 /* Tests_SRS_CONSTBUFFER_ARRAY_01_022: [ Otherwise constbuffer_array_get_all_buffers_size shall write in all_buffers_size the total size of all buffers in the array and return 0. ]*/
+/* Tests_SRS_CONSTBUFFER_ARRAY_11_012: [ constbuffer_array_get_all_buffers_size shall return the size computed when the array was created, without calling CONSTBUFFER_GetContent. ]*/
 TEST_FUNCTION(constbuffer_array_get_all_buffers_size_with_1_buffer_succeeds)
 {
     ///arrange
@@ -1775,8 +1954,6 @@ TEST_FUNCTION(constbuffer_array_get_all_buffers_size_with_1_buffer_succeeds)
     uint32_t all_buffers_size;
     int result;
 
-    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1));
-
     ///act
     result = constbuffer_array_get_all_buffers_size(afterAdd1, &all_buffers_size);
 
@@ -1791,6 +1968,7 @@ TEST_FUNCTION(constbuffer_array_get_all_buffers_size_with_1_buffer_succeeds)
 }
 
 /* Tests_SRS_CONSTBUFFER_ARRAY_01_022: [ Otherwise constbuffer_array_get_all_buffers_size shall write in all_buffers_size the total size of all buffers in the array and return 0. ]*/
+/* Tests_SRS_CONSTBUFFER_ARRAY_11_012: [ constbuffer_array_get_all_buffers_size shall return the size computed when the array was created, without calling CONSTBUFFER_GetContent. ]*/
 TEST_FUNCTION(constbuffer_array_get_all_buffers_size_with_2_buffers_succeeds)
 {
     ///arrange
@@ -1800,9 +1978,6 @@ TEST_FUNCTION(constbuffer_array_get_all_buffers_size_with_2_buffers_succeeds)
     uint32_t all_buffers_size;
     int result;
 
-    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_2));
-    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1));
-
     ///act
     result = constbuffer_array_get_all_buffers_size(afterAdd2, &all_buffers_size);
 
@@ -1817,6 +1992,34 @@ TEST_FUNCTION(constbuffer_array_get_all_buffers_size_with_2_buffers_succeeds)
     constbuffer_array_dec_ref(afterAdd2);
 }
 
+/* Tests_SRS_CONSTBUFFER_ARRAY_11_002: [ constbuffer_array_create_from_array_array shall add up the sizes of all the const buffer arrays in buffer_arrays. ]*/
+TEST_FUNCTION(constbuffer_array_get_all_buffers_size_after_create_from_array_array_succeeds)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_HANDLE buffer_array[2];
+    CONSTBUFFER_ARRAY_HANDLE merged;
+    uint32_t all_buffers_size;
+    int result;
+    buffer_array[0] = TEST_constbuffer_array_create(2, 0);
+    buffer_array[1] = TEST_constbuffer_array_create(1, 2);
+    merged = constbuffer_array_create_from_array_array(buffer_array, 2);
+    ASSERT_IS_NOT_NULL(merged);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = constbuffer_array_get_all_buffers_size(merged, &all_buffers_size);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint32_t, 1 + 2 + 3, all_buffers_size);
+
+    // cleanup
+    constbuffer_array_dec_ref(merged);
+    constbuffer_array_dec_ref(buffer_array[0]);
+    constbuffer_array_dec_ref(buffer_array[1]);
+}
+
 /* constbuffer_array_get_const_buffer_handle_array */
 
 /* Tests_SRS_CONSTBUFFER_ARRAY_01_026: [ If `constbuffer_array_handle` is NULL, `constbuffer_array_get_const_buffer_handle_array` shall fail and return NULL. ]*/
@@ -1899,4 +2102,365 @@ TEST_FUNCTION(constbuffer_array_get_const_buffer_handle_array_with_array_with_2_
     constbuffer_array_dec_ref(afterAdd2);
 }
 
+/* constbuffer_array_builder_create */
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_013: [ constbuffer_array_builder_create shall allocate memory for a new empty CONSTBUFFER_ARRAY_BUILDER_HANDLE and return it. ]*/
+TEST_FUNCTION(constbuffer_array_builder_create_succeeds)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE result;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    result = constbuffer_array_builder_create();
+
+    ///assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///clean
+    constbuffer_array_builder_destroy(result);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_014: [ If there are any failures then constbuffer_array_builder_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_malloc_fails_constbuffer_array_builder_create_fails)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE result;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    result = constbuffer_array_builder_create();
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+static CONSTBUFFER_ARRAY_BUILDER_HANDLE TEST_constbuffer_array_builder_create(uint32_t size)
+{
+    static CONSTBUFFER_HANDLE all_buffers[6];
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE result;
+    uint32_t i;
+
+    all_buffers[0] = TEST_CONSTBUFFER_HANDLE_1;
+    all_buffers[1] = TEST_CONSTBUFFER_HANDLE_2;
+    all_buffers[2] = TEST_CONSTBUFFER_HANDLE_3;
+    all_buffers[3] = TEST_CONSTBUFFER_HANDLE_4;
+    all_buffers[4] = TEST_CONSTBUFFER_HANDLE_5;
+    all_buffers[5] = TEST_CONSTBUFFER_HANDLE_6;
+
+    ASSERT_IS_TRUE(size <= 6, "Invalid test, not enough test buffers defined");
+
+    result = constbuffer_array_builder_create();
+    ASSERT_IS_NOT_NULL(result);
+    for (i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, constbuffer_array_builder_append(result, all_buffers[i]));
+    }
+
+    umock_c_reset_all_calls();
+    return result;
+}
+
+/* constbuffer_array_builder_destroy */
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_015: [ If constbuffer_array_builder_handle is NULL then constbuffer_array_builder_destroy shall return. ]*/
+TEST_FUNCTION(constbuffer_array_builder_destroy_with_NULL_constbuffer_array_builder_handle_returns)
+{
+    ///arrange
+
+    ///act
+    constbuffer_array_builder_destroy(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_016: [ constbuffer_array_builder_destroy shall dec_ref all the CONSTBUFFER_HANDLEs that were appended and not sealed and free all used resources. ]*/
+TEST_FUNCTION(constbuffer_array_builder_destroy_frees_the_builder_and_dec_refs_the_appended_buffers)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(2);
+
+    STRICT_EXPECTED_CALL(CONSTBUFFER_DecRef(TEST_CONSTBUFFER_HANDLE_1));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_DecRef(TEST_CONSTBUFFER_HANDLE_2));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(builder));
+
+    ///act
+    constbuffer_array_builder_destroy(builder);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* constbuffer_array_builder_append */
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_017: [ If constbuffer_array_builder_handle is NULL then constbuffer_array_builder_append shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(constbuffer_array_builder_append_with_NULL_constbuffer_array_builder_handle_fails)
+{
+    ///arrange
+    int result;
+
+    ///act
+    result = constbuffer_array_builder_append(NULL, TEST_CONSTBUFFER_HANDLE_1);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_018: [ If constbuffer_handle is NULL then constbuffer_array_builder_append shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(constbuffer_array_builder_append_with_NULL_constbuffer_handle_fails)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(0);
+    int result;
+
+    ///act
+    result = constbuffer_array_builder_append(builder, NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///clean
+    constbuffer_array_builder_destroy(builder);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_019: [ If the builder is full, constbuffer_array_builder_append shall double the number of CONSTBUFFER_HANDLEs it can hold (starting at 4). ]*/
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_020: [ constbuffer_array_builder_append shall inc_ref constbuffer_handle, store it after the CONSTBUFFER_HANDLEs already appended and add its size to the size of the builder. ]*/
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_021: [ constbuffer_array_builder_append shall succeed and return 0. ]*/
+TEST_FUNCTION(constbuffer_array_builder_append_to_an_empty_builder_succeeds)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(0);
+    int result;
+
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1));
+    STRICT_EXPECTED_CALL(gballoc_realloc(NULL, 4 * sizeof(CONSTBUFFER_HANDLE)));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_1));
+
+    ///act
+    result = constbuffer_array_builder_append(builder, TEST_CONSTBUFFER_HANDLE_1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///clean
+    constbuffer_array_builder_destroy(builder);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_020: [ constbuffer_array_builder_append shall inc_ref constbuffer_handle, store it after the CONSTBUFFER_HANDLEs already appended and add its size to the size of the builder. ]*/
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_021: [ constbuffer_array_builder_append shall succeed and return 0. ]*/
+TEST_FUNCTION(constbuffer_array_builder_append_does_not_allocate_when_the_builder_is_not_full)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(3);
+    int result;
+
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_4));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_4));
+
+    ///act
+    result = constbuffer_array_builder_append(builder, TEST_CONSTBUFFER_HANDLE_4);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///clean
+    constbuffer_array_builder_destroy(builder);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_019: [ If the builder is full, constbuffer_array_builder_append shall double the number of CONSTBUFFER_HANDLEs it can hold (starting at 4). ]*/
+TEST_FUNCTION(constbuffer_array_builder_append_to_a_full_builder_doubles_its_capacity)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(4);
+    int result;
+
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_5));
+    STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 8 * sizeof(CONSTBUFFER_HANDLE)));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_5));
+
+    ///act
+    result = constbuffer_array_builder_append(builder, TEST_CONSTBUFFER_HANDLE_5);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///clean
+    constbuffer_array_builder_destroy(builder);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_022: [ If there are any failures then constbuffer_array_builder_append shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(constbuffer_array_builder_append_unhappy_paths)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(0);
+    size_t i;
+
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_1));
+    STRICT_EXPECTED_CALL(gballoc_realloc(NULL, 4 * sizeof(CONSTBUFFER_HANDLE)));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_1));
+
+    umock_c_negative_tests_snapshot();
+    for (i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            int result;
+
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            ///act
+            result = constbuffer_array_builder_append(builder, TEST_CONSTBUFFER_HANDLE_1);
+
+            ///assert
+            ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        }
+    }
+
+    ///clean
+    constbuffer_array_builder_destroy(builder);
+}
+
+/* constbuffer_array_builder_seal */
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_023: [ If constbuffer_array_builder_handle is NULL then constbuffer_array_builder_seal shall fail and return NULL. ]*/
+TEST_FUNCTION(constbuffer_array_builder_seal_with_NULL_constbuffer_array_builder_handle_fails)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_HANDLE result;
+
+    ///act
+    result = constbuffer_array_builder_seal(NULL);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_024: [ constbuffer_array_builder_seal shall allocate memory for a new CONSTBUFFER_ARRAY_HANDLE that holds the appended CONSTBUFFER_HANDLEs in the order they were appended. ]*/
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_025: [ The references to the CONSTBUFFER_HANDLEs held by the builder shall move to the new array, without inc_ref'ing them. ]*/
+TEST_FUNCTION(constbuffer_array_builder_seal_moves_the_appended_buffers_to_a_new_array)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(5);
+    CONSTBUFFER_ARRAY_HANDLE result;
+    uint32_t all_buffers_size;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    result = constbuffer_array_builder_seal(builder);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    validate_sorted_constbuffer_array(result, 5);
+    ASSERT_ARE_EQUAL(int, 0, constbuffer_array_get_all_buffers_size(result, &all_buffers_size));
+    ASSERT_ARE_EQUAL(uint32_t, 1 + 2 + 3 + 4 + 5, all_buffers_size);
+
+    ///clean
+    constbuffer_array_builder_destroy(builder);
+    constbuffer_array_dec_ref(result);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_024: [ constbuffer_array_builder_seal shall allocate memory for a new CONSTBUFFER_ARRAY_HANDLE that holds the appended CONSTBUFFER_HANDLEs in the order they were appended. ]*/
+TEST_FUNCTION(constbuffer_array_builder_seal_of_an_empty_builder_returns_an_empty_array)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(0);
+    CONSTBUFFER_ARRAY_HANDLE result;
+    uint32_t count;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    result = constbuffer_array_builder_seal(builder);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, constbuffer_array_get_buffer_count(result, &count));
+    ASSERT_ARE_EQUAL(uint32_t, 0, count);
+
+    ///clean
+    constbuffer_array_builder_destroy(builder);
+    constbuffer_array_dec_ref(result);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_026: [ constbuffer_array_builder_seal shall empty the builder, which keeps its memory so it can be used again, and return the new array. ]*/
+TEST_FUNCTION(constbuffer_array_builder_seal_empties_the_builder)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(2);
+    CONSTBUFFER_ARRAY_HANDLE sealed1;
+    CONSTBUFFER_ARRAY_HANDLE sealed2;
+    uint32_t count;
+    uint32_t all_buffers_size;
+
+    sealed1 = constbuffer_array_builder_seal(builder);
+    ASSERT_IS_NOT_NULL(sealed1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(TEST_CONSTBUFFER_HANDLE_3));
+    STRICT_EXPECTED_CALL(CONSTBUFFER_IncRef(TEST_CONSTBUFFER_HANDLE_3));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    ASSERT_ARE_EQUAL(int, 0, constbuffer_array_builder_append(builder, TEST_CONSTBUFFER_HANDLE_3));
+    sealed2 = constbuffer_array_builder_seal(builder);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(sealed2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, constbuffer_array_get_buffer_count(sealed2, &count));
+    ASSERT_ARE_EQUAL(uint32_t, 1, count);
+    ASSERT_ARE_EQUAL(int, 0, constbuffer_array_get_all_buffers_size(sealed2, &all_buffers_size));
+    ASSERT_ARE_EQUAL(uint32_t, 3, all_buffers_size);
+    validate_sorted_constbuffer_array(sealed1, 2);
+
+    ///clean
+    constbuffer_array_builder_destroy(builder);
+    constbuffer_array_dec_ref(sealed1);
+    constbuffer_array_dec_ref(sealed2);
+}
+
+/*Tests_SRS_CONSTBUFFER_ARRAY_11_027: [ If there are any failures then constbuffer_array_builder_seal shall fail, return NULL and keep the appended CONSTBUFFER_HANDLEs in the builder. ]*/
+TEST_FUNCTION(when_malloc_fails_constbuffer_array_builder_seal_fails_and_keeps_the_appended_buffers)
+{
+    ///arrange
+    CONSTBUFFER_ARRAY_BUILDER_HANDLE builder = TEST_constbuffer_array_builder_create(2);
+    CONSTBUFFER_ARRAY_HANDLE result;
+    CONSTBUFFER_ARRAY_HANDLE sealed;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    result = constbuffer_array_builder_seal(builder);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    sealed = constbuffer_array_builder_seal(builder);
+    ASSERT_IS_NOT_NULL(sealed);
+    validate_sorted_constbuffer_array(sealed, 2);
+
+    ///clean
+    constbuffer_array_builder_destroy(builder);
+    constbuffer_array_dec_ref(sealed);
+}
+
 END_TEST_SUITE(constbuffer_array_unittests)
@@ -4,9 +4,13 @@
 #ifdef __cplusplus
 #include <cstdlib>
 #include <cstddef>
+#include <cstdio>
+#include <cstring>
 #else
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdio.h>
+#include <string.h>
 #endif
 
 #include "testrunnerswitcher.h"
@@ -77,6 +81,19 @@ static size_t my_BUFFER_length(BUFFER_HANDLE handle)
     return result;
 }
 
+#define TEST_FILE_NAME "constbuffer_ut_test_file.bin"
+
+static void write_test_file(const char* content, size_t size)
+{
+    FILE* file = fopen(TEST_FILE_NAME, "wb");
+    ASSERT_IS_NOT_NULL(file);
+    if (size > 0)
+    {
+        ASSERT_ARE_EQUAL(size_t, size, fwrite(content, 1, size, file));
+    }
+    ASSERT_ARE_EQUAL(int, 0, fclose(file));
+}
+
 MOCK_FUNCTION_WITH_CODE(, void, test_free_func, void*, context)
 MOCK_FUNCTION_END()
 
@@ -604,6 +621,340 @@ BEGIN_TEST_SUITE(constbuffer_unittests)
         free(test_buffer);
     }
 
+    /* CONSTBUFFER_CreateFromOffsetAndSize */
+
+    /*Tests_SRS_CONSTBUFFER_11_001: [ If handle is NULL then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateFromOffsetAndSize(NULL, 0, 0);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_002: [ If offset is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_offset_past_the_end_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        CONSTBUFFER_HANDLE original = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        ///act
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(original, BUFFER1_length + 1, 0);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_DecRef(original);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_003: [ If offset + size is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_size_past_the_end_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        CONSTBUFFER_HANDLE original = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        ///act
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(original, 1, BUFFER1_length);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_DecRef(original);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_003: [ If offset + size is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_offset_plus_size_overflowing_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        CONSTBUFFER_HANDLE original = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        ///act
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(original, 2, (size_t)-1);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_DecRef(original);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_004: [ CONSTBUFFER_CreateFromOffsetAndSize shall return a non-NULL handle to a const buffer whose content is the size bytes of handle that start at offset, without copying them. ]*/
+    /*Tests_SRS_CONSTBUFFER_11_006: [ The non-NULL handle returned by CONSTBUFFER_CreateFromOffsetAndSize shall have its ref count set to 1. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_succeeds)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        const CONSTBUFFER* original_content;
+        const CONSTBUFFER* content;
+        CONSTBUFFER_HANDLE original = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(original, 3, 6);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        original_content = CONSTBUFFER_GetContent(original);
+        content = CONSTBUFFER_GetContent(handle);
+        ASSERT_ARE_EQUAL(size_t, 6, content->size);
+        ASSERT_ARE_EQUAL(void_ptr, original_content->buffer + 3, content->buffer);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(content->buffer, "buffer", 6));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_DecRef(handle);
+        CONSTBUFFER_DecRef(original);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_004: [ CONSTBUFFER_CreateFromOffsetAndSize shall return a non-NULL handle to a const buffer whose content is the size bytes of handle that start at offset, without copying them. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_0_size_at_the_end_succeeds)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        CONSTBUFFER_HANDLE original = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(original, BUFFER1_length, 0);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(size_t, 0, CONSTBUFFER_GetContent(handle)->size);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_DecRef(handle);
+        CONSTBUFFER_DecRef(original);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_005: [ CONSTBUFFER_CreateFromOffsetAndSize shall increment the reference count of the const buffer that owns the memory of handle, so that the memory lives as long as the new const buffer. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_keeps_the_original_alive)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        CONSTBUFFER_HANDLE original = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(original, 3, 6);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_DecRef(original);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(int, 0, memcmp(CONSTBUFFER_GetContent(handle)->buffer, "buffer", 6));
+
+        ///cleanup
+        CONSTBUFFER_DecRef(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_008: [ If the buffer was created by calling CONSTBUFFER_CreateFromOffsetAndSize, CONSTBUFFER_DecRef shall decrement the reference count of the const buffer that owns the memory. ]*/
+    TEST_FUNCTION(CONSTBUFFER_DecRef_of_the_last_reference_to_a_slice_frees_the_original)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        CONSTBUFFER_HANDLE original = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(original, 3, 6);
+        CONSTBUFFER_DecRef(original);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(original));
+        STRICT_EXPECTED_CALL(gballoc_free(handle));
+
+        ///act
+        CONSTBUFFER_DecRef(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_005: [ CONSTBUFFER_CreateFromOffsetAndSize shall increment the reference count of the const buffer that owns the memory of handle, so that the memory lives as long as the new const buffer. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_of_a_slice_refers_to_the_original)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        CONSTBUFFER_HANDLE original = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(original, 3, 9);
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(slice, 7, 2);
+        CONSTBUFFER_DecRef(original);
+        CONSTBUFFER_DecRef(slice);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(original));
+        STRICT_EXPECTED_CALL(gballoc_free(handle));
+
+        ///act
+        CONSTBUFFER_DecRef(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_007: [ If any error occurs, CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_malloc_fails_CONSTBUFFER_CreateFromOffsetAndSize_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        CONSTBUFFER_HANDLE original = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+        STRICT_EXPECTED_CALL(gballoc_free(original));
+
+        ///act
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(original, 3, 6);
+        CONSTBUFFER_DecRef(original);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* CONSTBUFFER_CreateFromFile */
+
+    /*Tests_SRS_CONSTBUFFER_11_009: [ If fileName is NULL then CONSTBUFFER_CreateFromFile shall fail and return NULL. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromFile_with_NULL_fileName_fails)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateFromFile(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_010: [ CONSTBUFFER_CreateFromFile shall map the content of the file read only in memory and return a non-NULL handle to a const buffer with that content and the size of the file. ]*/
+    /*Tests_SRS_CONSTBUFFER_11_011: [ The non-NULL handle returned by CONSTBUFFER_CreateFromFile shall have its ref count set to 1. ]*/
+    /*Tests_SRS_CONSTBUFFER_11_014: [ If the buffer was created by calling CONSTBUFFER_CreateFromFile, CONSTBUFFER_DecRef shall unmap the file. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromFile_succeeds)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        const CONSTBUFFER* content;
+        write_test_file(buffer1, strlen(buffer1));
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        handle = CONSTBUFFER_CreateFromFile(TEST_FILE_NAME);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        content = CONSTBUFFER_GetContent(handle);
+        ASSERT_ARE_EQUAL(size_t, strlen(buffer1), content->size);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(buffer1, content->buffer, strlen(buffer1)));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_DecRef(handle);
+        (void)remove(TEST_FILE_NAME);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_010: [ CONSTBUFFER_CreateFromFile shall map the content of the file read only in memory and return a non-NULL handle to a const buffer with that content and the size of the file. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromFile_with_an_empty_file_succeeds)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        write_test_file(NULL, 0);
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        handle = CONSTBUFFER_CreateFromFile(TEST_FILE_NAME);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(size_t, 0, CONSTBUFFER_GetContent(handle)->size);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_DecRef(handle);
+        (void)remove(TEST_FILE_NAME);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_012: [ If any error occurs, CONSTBUFFER_CreateFromFile shall fail and return NULL. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromFile_with_a_file_that_does_not_exist_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        (void)remove(TEST_FILE_NAME);
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+        ///act
+        handle = CONSTBUFFER_CreateFromFile(TEST_FILE_NAME);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_012: [ If any error occurs, CONSTBUFFER_CreateFromFile shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_malloc_fails_CONSTBUFFER_CreateFromFile_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        write_test_file(buffer1, strlen(buffer1));
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        handle = CONSTBUFFER_CreateFromFile(TEST_FILE_NAME);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        (void)remove(TEST_FILE_NAME);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_11_005: [ CONSTBUFFER_CreateFromOffsetAndSize shall increment the reference count of the const buffer that owns the memory of handle, so that the memory lives as long as the new const buffer. ]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_of_a_mapped_file_keeps_the_file_mapped)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle;
+        CONSTBUFFER_HANDLE file;
+        write_test_file(buffer1, strlen(buffer1));
+        file = CONSTBUFFER_CreateFromFile(TEST_FILE_NAME);
+        handle = CONSTBUFFER_CreateFromOffsetAndSize(file, 3, 6);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_DecRef(file);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(int, 0, memcmp(CONSTBUFFER_GetContent(handle)->buffer, "buffer", 6));
+
+        ///cleanup
+        CONSTBUFFER_DecRef(handle);
+        (void)remove(TEST_FILE_NAME);
+    }
+
     /* CONSTBUFFER_GetContent */
 
     /*Tests_SRS_CONSTBUFFER_02_011: [If constbufferHandle is NULL then CONSTBUFFER_GetContent shall return NULL.]*/
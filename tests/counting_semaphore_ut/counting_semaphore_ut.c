@@ -0,0 +1,697 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#endif
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+#include "macro_utils.h"
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+#include "umocktypes_stdint.h"
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/condition.h"
+#include "azure_c_shared_utility/tickcounter.h"
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/counting_semaphore.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+TEST_DEFINE_ENUM_TYPE(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(LOCK_RESULT, LOCK_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(COND_RESULT, COND_RESULT_VALUES);
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+/*locks, conditions and tickcounters are small allocations so that every one has its own handle*/
+static LOCK_HANDLE my_Lock_Init(void)
+{
+    return (LOCK_HANDLE)my_gballoc_malloc(1);
+}
+
+static LOCK_RESULT my_Lock_Deinit(LOCK_HANDLE handle)
+{
+    my_gballoc_free(handle);
+    return LOCK_OK;
+}
+
+static COND_HANDLE my_Condition_Init(void)
+{
+    return (COND_HANDLE)my_gballoc_malloc(1);
+}
+
+static void my_Condition_Deinit(COND_HANDLE handle)
+{
+    my_gballoc_free(handle);
+}
+
+static TICK_COUNTER_HANDLE my_tickcounter_create(void)
+{
+    return (TICK_COUNTER_HANDLE)my_gballoc_malloc(1);
+}
+
+static void my_tickcounter_destroy(TICK_COUNTER_HANDLE tick_counter)
+{
+    my_gballoc_free(tick_counter);
+}
+
+/*the clock only moves when Condition_Wait says so*/
+static tickcounter_ms_t now_ms;
+
+static int my_tickcounter_get_current_ms(TICK_COUNTER_HANDLE tick_counter, tickcounter_ms_t* current_ms)
+{
+    (void)tick_counter;
+    *current_ms = now_ms;
+    return 0;
+}
+
+/*Condition_Wait releases 1 unit of semaphore_to_release when it is set, the way another thread would while the
+caller waits. Otherwise it moves the clock by wakeup_after_ms and returns COND_OK, a wakeup that found no unit, or
+by the whole timeout and returns COND_TIMEOUT when that is shorter*/
+static COUNTING_SEMAPHORE_HANDLE semaphore_to_release;
+static int wakeup_after_ms;
+
+static COND_RESULT my_Condition_Wait(COND_HANDLE handle, LOCK_HANDLE lock, int timeout_milliseconds)
+{
+    COND_RESULT result;
+    (void)handle;
+    (void)lock;
+
+    if (semaphore_to_release != NULL)
+    {
+        COUNTING_SEMAPHORE_HANDLE semaphore = semaphore_to_release;
+        semaphore_to_release = NULL;
+        (void)counting_semaphore_release(semaphore, 1);
+        result = COND_OK;
+    }
+    else if (wakeup_after_ms < timeout_milliseconds)
+    {
+        now_ms += wakeup_after_ms;
+        result = COND_OK;
+    }
+    else
+    {
+        now_ms += timeout_milliseconds;
+        result = COND_TIMEOUT;
+    }
+
+    return result;
+}
+
+BEGIN_TEST_SUITE(counting_semaphore_unittests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types");
+
+    REGISTER_UMOCK_ALIAS_TYPE(LOCK_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(COND_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(TICK_COUNTER_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(tickcounter_ms_t*, void*);
+    REGISTER_TYPE(LOCK_RESULT, LOCK_RESULT);
+    REGISTER_TYPE(COND_RESULT, COND_RESULT);
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+
+    REGISTER_GLOBAL_MOCK_HOOK(Lock_Init, my_Lock_Init);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Lock_Init, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(Lock_Deinit, my_Lock_Deinit);
+    REGISTER_GLOBAL_MOCK_RETURN(Lock, LOCK_OK);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Lock, LOCK_ERROR);
+    REGISTER_GLOBAL_MOCK_RETURN(Unlock, LOCK_OK);
+
+    REGISTER_GLOBAL_MOCK_HOOK(Condition_Init, my_Condition_Init);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Condition_Init, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(Condition_Deinit, my_Condition_Deinit);
+    REGISTER_GLOBAL_MOCK_RETURN(Condition_Post, COND_OK);
+    REGISTER_GLOBAL_MOCK_RETURN(Condition_Broadcast, COND_OK);
+    REGISTER_GLOBAL_MOCK_HOOK(Condition_Wait, my_Condition_Wait);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Condition_Wait, COND_ERROR);
+
+    REGISTER_GLOBAL_MOCK_HOOK(tickcounter_create, my_tickcounter_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(tickcounter_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(tickcounter_destroy, my_tickcounter_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(tickcounter_get_current_ms, my_tickcounter_get_current_ms);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(tickcounter_get_current_ms, __LINE__);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    now_ms = 1000;
+    semaphore_to_release = NULL;
+    wakeup_after_ms = INT32_MAX;
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+
+/* counting_semaphore_create */
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_001: [ counting_semaphore_create shall allocate a semaphore with a lock, a condition, a tickcounter and a count of initial_count and return it. ]*/
+TEST_FUNCTION(counting_semaphore_create_succeeds)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_HANDLE semaphore;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init());
+    STRICT_EXPECTED_CALL(tickcounter_create());
+
+    ///act
+    semaphore = counting_semaphore_create(2);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(semaphore);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_002: [ If any error occurs, counting_semaphore_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_fails_counting_semaphore_create_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_HANDLE semaphore;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    semaphore = counting_semaphore_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(semaphore);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_002: [ If any error occurs, counting_semaphore_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_Lock_Init_fails_counting_semaphore_create_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_HANDLE semaphore;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init())
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    semaphore = counting_semaphore_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(semaphore);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_002: [ If any error occurs, counting_semaphore_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_Condition_Init_fails_counting_semaphore_create_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_HANDLE semaphore;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init())
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    semaphore = counting_semaphore_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(semaphore);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_002: [ If any error occurs, counting_semaphore_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_tickcounter_create_fails_counting_semaphore_create_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_HANDLE semaphore;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init());
+    STRICT_EXPECTED_CALL(tickcounter_create())
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(Condition_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    semaphore = counting_semaphore_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(semaphore);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* counting_semaphore_destroy */
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_003: [ If semaphore is NULL, counting_semaphore_destroy shall return. ]*/
+TEST_FUNCTION(counting_semaphore_destroy_with_NULL_returns)
+{
+    ///act
+    counting_semaphore_destroy(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_004: [ counting_semaphore_destroy shall free the tickcounter, the condition, the lock and the semaphore. ]*/
+TEST_FUNCTION(counting_semaphore_destroy_frees_the_semaphore)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(tickcounter_destroy(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    counting_semaphore_destroy(semaphore);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* counting_semaphore_acquire */
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_005: [ If semaphore is NULL or timeout_milliseconds is negative, counting_semaphore_acquire shall fail and return COUNTING_SEMAPHORE_INVALID_ARG. ]*/
+TEST_FUNCTION(counting_semaphore_acquire_with_NULL_fails)
+{
+    ///act
+    COUNTING_SEMAPHORE_RESULT result = counting_semaphore_acquire(NULL, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_005: [ If semaphore is NULL or timeout_milliseconds is negative, counting_semaphore_acquire shall fail and return COUNTING_SEMAPHORE_INVALID_ARG. ]*/
+TEST_FUNCTION(counting_semaphore_acquire_with_negative_timeout_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(1);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = counting_semaphore_acquire(semaphore, -1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_006: [ counting_semaphore_acquire shall decrement the count of semaphore under its lock and return COUNTING_SEMAPHORE_OK. ]*/
+TEST_FUNCTION(counting_semaphore_acquire_takes_a_unit_without_waiting)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_acquire(semaphore, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_TIMEOUT, counting_semaphore_acquire(semaphore, 100));
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_006: [ counting_semaphore_acquire shall decrement the count of semaphore under its lock and return COUNTING_SEMAPHORE_OK. ]*/
+/* Tests_SRS_COUNTING_SEMAPHORE_11_007: [ While the count of semaphore is 0, counting_semaphore_acquire shall wait on the condition of semaphore. ]*/
+TEST_FUNCTION(counting_semaphore_acquire_waits_for_a_release)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(0);
+    umock_c_reset_all_calls();
+
+    semaphore_to_release = semaphore;
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 0));
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Post(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_acquire(semaphore, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_TIMEOUT, counting_semaphore_acquire(semaphore, 100));
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_008: [ If timeout_milliseconds is not 0, counting_semaphore_acquire shall read the tickcounter of semaphore before it waits and after every wakeup, and return COUNTING_SEMAPHORE_TIMEOUT once timeout_milliseconds went by with the count at 0. ]*/
+TEST_FUNCTION(counting_semaphore_acquire_times_out)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 100));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_acquire(semaphore, 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_TIMEOUT, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_008: [ If timeout_milliseconds is not 0, counting_semaphore_acquire shall read the tickcounter of semaphore before it waits and after every wakeup, and return COUNTING_SEMAPHORE_TIMEOUT once timeout_milliseconds went by with the count at 0. ]*/
+TEST_FUNCTION(counting_semaphore_acquire_after_a_wakeup_waits_for_the_rest_of_the_timeout)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(0);
+    umock_c_reset_all_calls();
+
+    wakeup_after_ms = 60;
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 100));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 40));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_acquire(semaphore, 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_TIMEOUT, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_009: [ If any error occurs, counting_semaphore_acquire shall fail, leave the count as it was and return COUNTING_SEMAPHORE_ERROR. ]*/
+TEST_FUNCTION(when_Lock_fails_counting_semaphore_acquire_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG))
+        .SetReturn(LOCK_ERROR);
+
+    ///act
+    result = counting_semaphore_acquire(semaphore, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_OK, counting_semaphore_acquire(semaphore, 100));
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_009: [ If any error occurs, counting_semaphore_acquire shall fail, leave the count as it was and return COUNTING_SEMAPHORE_ERROR. ]*/
+TEST_FUNCTION(when_tickcounter_get_current_ms_fails_counting_semaphore_acquire_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG))
+        .SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_acquire(semaphore, 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_OK, counting_semaphore_acquire(semaphore, 100));
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_009: [ If any error occurs, counting_semaphore_acquire shall fail, leave the count as it was and return COUNTING_SEMAPHORE_ERROR. ]*/
+TEST_FUNCTION(when_Condition_Wait_fails_counting_semaphore_acquire_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 0))
+        .SetReturn(COND_ERROR);
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_acquire(semaphore, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* counting_semaphore_release */
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_010: [ If semaphore is NULL or count is 0, counting_semaphore_release shall fail and return COUNTING_SEMAPHORE_INVALID_ARG. ]*/
+TEST_FUNCTION(counting_semaphore_release_with_NULL_fails)
+{
+    ///act
+    COUNTING_SEMAPHORE_RESULT result = counting_semaphore_release(NULL, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_010: [ If semaphore is NULL or count is 0, counting_semaphore_release shall fail and return COUNTING_SEMAPHORE_INVALID_ARG. ]*/
+TEST_FUNCTION(counting_semaphore_release_of_0_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(0);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = counting_semaphore_release(semaphore, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_012: [ counting_semaphore_release shall add count to the count of semaphore under its lock and return COUNTING_SEMAPHORE_OK. ]*/
+/* Tests_SRS_COUNTING_SEMAPHORE_11_013: [ counting_semaphore_release shall post the condition of semaphore when count is 1 and broadcast it otherwise. ]*/
+TEST_FUNCTION(counting_semaphore_release_of_1_posts)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Post(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_release(semaphore, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_OK, counting_semaphore_acquire(semaphore, 100));
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_TIMEOUT, counting_semaphore_acquire(semaphore, 100));
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_012: [ counting_semaphore_release shall add count to the count of semaphore under its lock and return COUNTING_SEMAPHORE_OK. ]*/
+/* Tests_SRS_COUNTING_SEMAPHORE_11_013: [ counting_semaphore_release shall post the condition of semaphore when count is 1 and broadcast it otherwise. ]*/
+TEST_FUNCTION(counting_semaphore_release_of_more_than_1_broadcasts)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Broadcast(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_release(semaphore, 2);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_OK, counting_semaphore_acquire(semaphore, 100));
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_OK, counting_semaphore_acquire(semaphore, 100));
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_TIMEOUT, counting_semaphore_acquire(semaphore, 100));
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_011: [ If adding count would overflow the count of semaphore, counting_semaphore_release shall fail, leave the count as it was and return COUNTING_SEMAPHORE_ERROR. ]*/
+TEST_FUNCTION(counting_semaphore_release_that_overflows_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(SIZE_MAX);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_release(semaphore, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_014: [ If any other error occurs, counting_semaphore_release shall fail and return COUNTING_SEMAPHORE_ERROR. ]*/
+TEST_FUNCTION(when_Lock_fails_counting_semaphore_release_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG))
+        .SetReturn(LOCK_ERROR);
+
+    ///act
+    result = counting_semaphore_release(semaphore, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+/* Tests_SRS_COUNTING_SEMAPHORE_11_014: [ If any other error occurs, counting_semaphore_release shall fail and return COUNTING_SEMAPHORE_ERROR. ]*/
+TEST_FUNCTION(when_Condition_Post_fails_counting_semaphore_release_fails)
+{
+    ///arrange
+    COUNTING_SEMAPHORE_RESULT result;
+    COUNTING_SEMAPHORE_HANDLE semaphore = counting_semaphore_create(0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Post(IGNORED_PTR_ARG))
+        .SetReturn(COND_ERROR);
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = counting_semaphore_release(semaphore, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(COUNTING_SEMAPHORE_RESULT, COUNTING_SEMAPHORE_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    counting_semaphore_destroy(semaphore);
+}
+
+END_TEST_SUITE(counting_semaphore_unittests)
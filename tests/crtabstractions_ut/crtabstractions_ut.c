@@ -2620,6 +2620,34 @@ TEST_FUNCTION(size_tToString_fails_when_destination_is_not_sufficient_for_more_t
     }
 }
 
+/*Tests_SRS_CRT_ABSTRACTIONS_11_001: [ If the conversion fails, unsignedIntToString and size_tToString shall not change destination. ]*/
+TEST_FUNCTION(unsignedIntToString_fails_without_changing_destination)
+{
+    // arrange
+    char destination[4] = "abc";
+
+    ///act
+    int result = unsignedIntToString(destination, sizeof(destination), 1234);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, "abc", destination);
+}
+
+/*Tests_SRS_CRT_ABSTRACTIONS_11_001: [ If the conversion fails, unsignedIntToString and size_tToString shall not change destination. ]*/
+TEST_FUNCTION(size_tToString_fails_without_changing_destination)
+{
+    // arrange
+    char destination[4] = "abc";
+
+    ///act
+    int result = size_tToString(destination, sizeof(destination), 1234);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, "abc", destination);
+}
+
 /*Tests_SRS_CRT_ABSTRACTIONS_02_001: [size_tToString shall convert the parameter value to its decimal representation as a string in the buffer indicated by parameter destination having the size indicated by parameter destinationSize.] */
 TEST_FUNCTION(size_tToString_succeeds_1_digit)
 {
@@ -0,0 +1,155 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/*the system allocator is captured before gballoc.h turns malloc into gballoc_malloc*/
+static void* system_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void system_free(void* ptr)
+{
+    free(ptr);
+}
+
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/threadapi.h"
+#include "perf_timer.h"
+
+/*malloc/free throughput of the pool heap against the system allocator, with the small sizes the library uses the most*/
+
+#define SLOTS_PER_THREAD 256
+#define OPERATIONS_PER_THREAD 2000000
+#define MAX_THREADS 16
+
+static const size_t thread_counts[] = { 1, 4, 16 };
+static const size_t allocation_sizes[] = { 16, 24, 40, 48, 64, 96, 128, 256 };
+
+typedef struct ALLOCATOR_TAG
+{
+    const char* name;
+    void* (*allocate)(size_t size);
+    void (*deallocate)(void* ptr);
+} ALLOCATOR;
+
+static const ALLOCATOR allocators[] =
+{
+    { "system malloc", system_malloc, system_free },
+    { "gballoc pool", gballoc_malloc, gballoc_free }
+};
+
+typedef struct WORKER_CONTEXT_TAG
+{
+    const ALLOCATOR* allocator;
+    unsigned int seed;
+    size_t failures;
+} WORKER_CONTEXT;
+
+static int worker(void* arg)
+{
+    WORKER_CONTEXT* context = (WORKER_CONTEXT*)arg;
+    void* slots[SLOTS_PER_THREAD];
+    unsigned int random = context->seed;
+    size_t i;
+
+    (void)memset(slots, 0, sizeof(slots));
+    for (i = 0; i < OPERATIONS_PER_THREAD; i++)
+    {
+        size_t slot;
+        size_t size;
+
+        random = random * 1103515245 + 12345;
+        slot = (random >> 8) % SLOTS_PER_THREAD;
+        size = allocation_sizes[(random >> 20) % (sizeof(allocation_sizes) / sizeof(allocation_sizes[0]))];
+
+        context->allocator->deallocate(slots[slot]);
+        slots[slot] = context->allocator->allocate(size);
+        if (slots[slot] == NULL)
+        {
+            context->failures++;
+        }
+        else
+        {
+            *(unsigned char*)slots[slot] = (unsigned char)i;
+        }
+    }
+
+    for (i = 0; i < SLOTS_PER_THREAD; i++)
+    {
+        context->allocator->deallocate(slots[i]);
+    }
+
+    return 0;
+}
+
+/*returns the nanoseconds per malloc/free pair seen by one thread, or a negative value on failure*/
+static double run_test(const ALLOCATOR* allocator, size_t thread_count)
+{
+    double result;
+    THREAD_HANDLE threads[MAX_THREADS];
+    WORKER_CONTEXT contexts[MAX_THREADS];
+    size_t started = 0;
+    size_t failures = 0;
+    double start;
+    double end;
+    size_t i;
+
+    start = perf_timer_get_seconds();
+    for (i = 0; i < thread_count; i++)
+    {
+        contexts[i].allocator = allocator;
+        contexts[i].seed = (unsigned int)(i + 1);
+        contexts[i].failures = 0;
+        if (ThreadAPI_Create(&threads[i], worker, &contexts[i]) != THREADAPI_OK)
+        {
+            break;
+        }
+        started++;
+    }
+    for (i = 0; i < started; i++)
+    {
+        int thread_result;
+        (void)ThreadAPI_Join(threads[i], &thread_result);
+        failures += contexts[i].failures;
+    }
+    end = perf_timer_get_seconds();
+
+    if ((started != thread_count) || (failures != 0))
+    {
+        result = -1.0;
+    }
+    else
+    {
+        result = PERF_NS_PER_OP(start, end, OPERATIONS_PER_THREAD);
+    }
+    return result;
+}
+
+int main(void)
+{
+    int result = 0;
+    size_t i;
+    for (i = 0; (i < sizeof(thread_counts) / sizeof(thread_counts[0])) && (result == 0); i++)
+    {
+        size_t j;
+        for (j = 0; (j < sizeof(allocators) / sizeof(allocators[0])) && (result == 0); j++)
+        {
+            double ns = run_test(&allocators[j], thread_counts[i]);
+            if (ns < 0)
+            {
+                (void)printf("%s with %u threads failed\r\n", allocators[j].name, (unsigned int)thread_counts[i]);
+                result = __LINE__;
+            }
+            else
+            {
+                (void)printf("%2u threads: %-14s %8.1f ns per malloc/free, %8.1f million malloc/free per second\r\n",
+                    (unsigned int)thread_counts[i], allocators[j].name, ns, (double)thread_counts[i] * 1000.0 / ns);
+            }
+        }
+    }
+    return result;
+}
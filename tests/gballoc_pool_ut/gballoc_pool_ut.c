@@ -0,0 +1,452 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+#include "testrunnerswitcher.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+/*gballoc.h only declares these with GB_USE_CUSTOM_HEAP, which would also turn malloc into gballoc_malloc in this file*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+    void* gballoc_malloc(size_t size);
+    void* gballoc_calloc(size_t nmemb, size_t size);
+    void* gballoc_realloc(void* ptr, size_t size);
+    void gballoc_free(void* ptr);
+#ifdef __cplusplus
+}
+#endif
+
+static TEST_MUTEX_HANDLE g_testByTest;
+
+/*the pool asks for slabs of 64KB*/
+#define SLAB_SIZE_MIN 60000
+
+#define ENABLE_MOCKS
+
+#include "umock_c.h"
+#include "umock_c_prod.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    MOCKABLE_FUNCTION(, void*, mock_malloc, size_t, size);
+    MOCKABLE_FUNCTION(, void*, mock_calloc, size_t, nmemb, size_t, size);
+    MOCKABLE_FUNCTION(, void*, mock_realloc, void*, ptr, size_t, size);
+    MOCKABLE_FUNCTION(, void, mock_free, void*, ptr);
+#ifdef __cplusplus
+}
+#endif
+
+#undef ENABLE_MOCKS
+
+static size_t slab_allocations;
+static int fail_slab_allocations;
+
+static void* my_mock_malloc(size_t size)
+{
+    void* result;
+    if (size >= SLAB_SIZE_MIN)
+    {
+        slab_allocations++;
+        result = fail_slab_allocations ? NULL : malloc(size);
+    }
+    else
+    {
+        result = malloc(size);
+    }
+    return result;
+}
+
+static void* my_mock_calloc(size_t nmemb, size_t size)
+{
+    return calloc(nmemb, size);
+}
+
+static void* my_mock_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_mock_free(void* ptr)
+{
+    free(ptr);
+}
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+BEGIN_TEST_SUITE(GBAllocPool_UnitTests)
+
+TEST_SUITE_INITIALIZE(TestClassInitialize)
+{
+    int result;
+
+    g_testByTest = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_testByTest);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mock_malloc, my_mock_malloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_calloc, my_mock_calloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_realloc, my_mock_realloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_free, my_mock_free);
+}
+
+TEST_SUITE_CLEANUP(TestClassCleanup)
+{
+    umock_c_deinit();
+    TEST_MUTEX_DESTROY(g_testByTest);
+}
+
+TEST_FUNCTION_INITIALIZE(TestMethodInitialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_testByTest))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    slab_allocations = 0;
+    fail_slab_allocations = 0;
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(TestMethodCleanup)
+{
+    TEST_MUTEX_RELEASE(g_testByTest);
+}
+
+/* the pool keeps its slabs and free lists between tests, so every test that looks at slabs uses a size class no other test uses */
+
+/* gballoc_malloc */
+
+/* Tests_SRS_GBALLOC_POOL_11_001: [ gballoc_malloc shall round a size of up to 1024 bytes up to its size class and take a block of that class from the free list of the calling thread. ]*/
+/* Tests_SRS_GBALLOC_POOL_11_002: [ When the free list of the calling thread is empty, gballoc_malloc shall move a batch of blocks from the global free list of the size class to it, and if that is empty too, carve a new 64KB slab. ]*/
+TEST_FUNCTION(gballoc_malloc_carves_small_blocks_out_of_slabs)
+{
+    // arrange
+    void* blocks[100];
+    size_t i;
+
+    // act
+    for (i = 0; i < 100; i++)
+    {
+        blocks[i] = gballoc_malloc(700);
+        ASSERT_IS_NOT_NULL(blocks[i]);
+        ASSERT_ARE_EQUAL(size_t, 0, (size_t)((uintptr_t)blocks[i] % sizeof(void*)));
+        (void)memset(blocks[i], (int)i, 700);
+    }
+
+    // assert
+    /*a 64KB slab holds 83 blocks of the 768 bytes class*/
+    ASSERT_ARE_EQUAL(size_t, 2, slab_allocations);
+    for (i = 0; i < 100; i++)
+    {
+        ASSERT_ARE_EQUAL(int, (int)(unsigned char)i, (int)((unsigned char*)blocks[i])[699]);
+    }
+
+    // cleanup
+    for (i = 0; i < 100; i++)
+    {
+        gballoc_free(blocks[i]);
+    }
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_013: [ gballoc_free shall put small blocks on the free list of the calling thread and move a batch of them to the global free list when it holds more than 128 blocks. ]*/
+TEST_FUNCTION(gballoc_malloc_reuses_the_block_freed_last)
+{
+    // arrange
+    void* block = gballoc_malloc(20);
+    void* result;
+    gballoc_free(block);
+    umock_c_reset_all_calls();
+
+    // act
+    result = gballoc_malloc(30);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, block, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_003: [ If allocating the slab fails, gballoc_malloc shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_the_slab_fails_gballoc_malloc_fails)
+{
+    // arrange
+    void* result;
+    fail_slab_allocations = 1;
+
+    // act
+    result = gballoc_malloc(500);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, slab_allocations);
+
+    // cleanup
+    fail_slab_allocations = 0;
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_004: [ gballoc_malloc shall allocate blocks bigger than 1024 bytes with malloc and return NULL if malloc fails. ]*/
+TEST_FUNCTION(gballoc_malloc_allocates_big_blocks_with_malloc)
+{
+    // arrange
+    void* result;
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG));
+
+    // act
+    result = gballoc_malloc(2000);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_004: [ gballoc_malloc shall allocate blocks bigger than 1024 bytes with malloc and return NULL if malloc fails. ]*/
+TEST_FUNCTION(when_malloc_fails_gballoc_malloc_of_a_big_block_fails)
+{
+    // arrange
+    void* result;
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = gballoc_malloc(2000);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(gballoc_malloc_with_SIZE_MAX_fails)
+{
+    // act
+    void* result = gballoc_malloc(SIZE_MAX);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* gballoc_calloc */
+
+/* Tests_SRS_GBALLOC_POOL_11_006: [ Otherwise gballoc_calloc shall allocate nmemb * size bytes like gballoc_malloc and set them to 0. ]*/
+TEST_FUNCTION(gballoc_calloc_returns_zeroed_memory)
+{
+    // arrange
+    unsigned char* block = (unsigned char*)gballoc_malloc(40);
+    unsigned char* result;
+    size_t i;
+    (void)memset(block, 0xAA, 40);
+    gballoc_free(block);
+
+    // act
+    result = (unsigned char*)gballoc_calloc(10, 4);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    for (i = 0; i < 40; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, (int)result[i]);
+    }
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_005: [ If nmemb * size overflows, gballoc_calloc shall fail and return NULL. ]*/
+TEST_FUNCTION(gballoc_calloc_with_overflowing_size_fails)
+{
+    // act
+    void* result = gballoc_calloc(SIZE_MAX / 2, 4);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* gballoc_realloc */
+
+/* Tests_SRS_GBALLOC_POOL_11_007: [ If ptr is NULL, gballoc_realloc shall behave like gballoc_malloc. ]*/
+TEST_FUNCTION(gballoc_realloc_with_NULL_allocates)
+{
+    // act
+    void* result = gballoc_realloc(NULL, 10);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_008: [ If the new size still fits the size class of ptr, gballoc_realloc shall return ptr. ]*/
+TEST_FUNCTION(gballoc_realloc_within_the_size_class_returns_the_same_block)
+{
+    // arrange
+    void* block = gballoc_malloc(33);
+    void* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = gballoc_realloc(block, 48);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, block, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_009: [ Otherwise gballoc_realloc shall allocate a new block, copy the contents of ptr to it, free ptr and return the new block. ]*/
+TEST_FUNCTION(gballoc_realloc_to_a_bigger_block_copies_the_contents)
+{
+    // arrange
+    char* block = (char*)gballoc_malloc(6);
+    char* result;
+    (void)memcpy(block, "hello", 6);
+
+    // act
+    result = (char*)gballoc_realloc(block, 1500);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, "hello", result);
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_009: [ Otherwise gballoc_realloc shall allocate a new block, copy the contents of ptr to it, free ptr and return the new block. ]*/
+TEST_FUNCTION(gballoc_realloc_of_a_big_block_calls_realloc)
+{
+    // arrange
+    void* block = gballoc_malloc(2000);
+    void* result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+
+    // act
+    result = gballoc_realloc(block, 4000);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_010: [ If allocating the new block fails, gballoc_realloc shall return NULL and leave ptr untouched. ]*/
+TEST_FUNCTION(when_malloc_fails_gballoc_realloc_fails_and_keeps_the_block)
+{
+    // arrange
+    char* block = (char*)gballoc_malloc(6);
+    void* result;
+    (void)memcpy(block, "hello", 6);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = gballoc_realloc(block, 3000);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "hello", block);
+
+    // cleanup
+    gballoc_free(block);
+}
+
+/* gballoc_free */
+
+/* Tests_SRS_GBALLOC_POOL_11_011: [ If ptr is NULL, gballoc_free shall do nothing. ]*/
+TEST_FUNCTION(gballoc_free_with_NULL_does_nothing)
+{
+    // act
+    gballoc_free(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_012: [ gballoc_free shall give blocks bigger than 1024 bytes back with free. ]*/
+TEST_FUNCTION(gballoc_free_of_a_big_block_calls_free)
+{
+    // arrange
+    void* block = gballoc_malloc(2000);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_free(IGNORED_PTR_ARG));
+
+    // act
+    gballoc_free(block);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_POOL_11_013: [ gballoc_free shall put small blocks on the free list of the calling thread and move a batch of them to the global free list when it holds more than 128 blocks. ]*/
+TEST_FUNCTION(gballoc_free_keeps_small_blocks_for_reuse)
+{
+    // arrange
+    void* blocks[200];
+    size_t i;
+    for (i = 0; i < 200; i++)
+    {
+        blocks[i] = gballoc_malloc(1000);
+        ASSERT_IS_NOT_NULL(blocks[i]);
+    }
+    for (i = 0; i < 200; i++)
+    {
+        gballoc_free(blocks[i]);
+    }
+    slab_allocations = 0;
+    umock_c_reset_all_calls();
+
+    // act
+    for (i = 0; i < 200; i++)
+    {
+        blocks[i] = gballoc_malloc(1000);
+        ASSERT_IS_NOT_NULL(blocks[i]);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, slab_allocations);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    for (i = 0; i < 200; i++)
+    {
+        gballoc_free(blocks[i]);
+    }
+}
+
+END_TEST_SUITE(GBAllocPool_UnitTests)
@@ -0,0 +1,582 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#if defined(GB_MEASURE_MEMORY_FOR_THIS)
+#undef GB_MEASURE_MEMORY_FOR_THIS
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#endif
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/gballoc.h"
+#include "testrunnerswitcher.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+static TEST_MUTEX_HANDLE g_testByTest;
+
+#define ENABLE_MOCKS
+
+#include "umock_c.h"
+#include "umock_c_prod.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    MOCKABLE_FUNCTION(, void*, mock_malloc, size_t, size);
+    MOCKABLE_FUNCTION(, void*, mock_calloc, size_t, nmemb, size_t, size);
+    MOCKABLE_FUNCTION(, void*, mock_realloc, void*, ptr, size_t, size);
+    MOCKABLE_FUNCTION(, void, mock_free, void*, ptr);
+#ifdef __cplusplus
+}
+#endif
+
+#undef ENABLE_MOCKS
+
+static void* my_mock_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_mock_calloc(size_t nmemb, size_t size)
+{
+    return calloc(nmemb, size);
+}
+
+static void* my_mock_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_mock_free(void* ptr)
+{
+    free(ptr);
+}
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+BEGIN_TEST_SUITE(GBAllocSharded_UnitTests)
+
+TEST_SUITE_INITIALIZE(TestClassInitialize)
+{
+    int result;
+
+    g_testByTest = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_testByTest);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mock_malloc, my_mock_malloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_calloc, my_mock_calloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_realloc, my_mock_realloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_free, my_mock_free);
+}
+
+TEST_SUITE_CLEANUP(TestClassCleanup)
+{
+    umock_c_deinit();
+    TEST_MUTEX_DESTROY(g_testByTest);
+}
+
+TEST_FUNCTION_INITIALIZE(TestMethodInitialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_testByTest))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(TestMethodCleanup)
+{
+    gballoc_deinit();
+
+    TEST_MUTEX_RELEASE(g_testByTest);
+}
+
+/* gballoc_init */
+
+/* Tests_SRS_GBALLOC_01_024: [gballoc_init shall initialize the gballoc module and return 0 upon success.] */
+/* Tests_SRS_GBALLOC_11_001: [ With GB_SHARDED_TRACKING, gballoc shall not create a lock; every block shall carry a header with its size and the counters shall be kept in shards that are added up when the metrics are read. ]*/
+TEST_FUNCTION(gballoc_init_succeeds)
+{
+    // arrange
+    int result;
+
+    // act
+    result = gballoc_init();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getMaximumMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getAllocationCount());
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_01_025: [Init after Init shall fail and return a non-zero value.] */
+TEST_FUNCTION(gballoc_init_after_gballoc_init_fails)
+{
+    // arrange
+    int result;
+    (void)gballoc_init();
+
+    // act
+    result = gballoc_init();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_GBALLOC_01_002: [Upon initialization the total memory used and maximum total memory used tracked by the module shall be set to 0.] */
+TEST_FUNCTION(gballoc_init_resets_memory_used)
+{
+    // arrange
+    (void)gballoc_init();
+    gballoc_free(gballoc_malloc(1));
+    gballoc_deinit();
+
+    // act
+    (void)gballoc_init();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getMaximumMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+}
+
+/* gballoc_malloc */
+
+/* Tests_SRS_GBALLOC_01_003: [gb_malloc shall call the C99 malloc function and return its result.] */
+/* Tests_SRS_GBALLOC_01_004: [If the underlying malloc call is successful, gb_malloc shall increment the total memory used with the amount indicated by size.] */
+TEST_FUNCTION(gballoc_malloc_counts_the_requested_size)
+{
+    // arrange
+    void* result;
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG));
+
+    // act
+    result = gballoc_malloc(42);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 42, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 42, gballoc_getMaximumMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getAllocationCount());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_01_012: [When the underlying malloc call fails, gballoc_malloc shall return NULL and size should not be counted towards total memory used.] */
+TEST_FUNCTION(when_malloc_fails_gballoc_malloc_fails)
+{
+    // arrange
+    void* result;
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = gballoc_malloc(42);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getAllocationCount());
+}
+
+/* Tests_SRS_GBALLOC_11_002: [ If size is too big to fit the size header, gballoc_malloc, gballoc_calloc and gballoc_realloc shall fail and return NULL. ]*/
+TEST_FUNCTION(gballoc_malloc_with_SIZE_MAX_fails)
+{
+    // arrange
+    void* result;
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    result = gballoc_malloc(SIZE_MAX);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_01_039: [If gballoc was not initialized gballoc_malloc shall simply call malloc without any memory tracking being performed.] */
+TEST_FUNCTION(gballoc_malloc_without_init_is_not_counted_after_init)
+{
+    // arrange
+    void* result;
+
+    // act
+    result = gballoc_malloc(42);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    (void)gballoc_init();
+    gballoc_free(result);
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getAllocationCount());
+}
+
+/* gballoc_calloc */
+
+/* Tests_SRS_GBALLOC_01_020: [gballoc_calloc shall call the C99 calloc function and return its result.] */
+/* Tests_SRS_GBALLOC_01_021: [If the underlying calloc call is successful, gballoc_calloc shall increment the total memory used with nmemb*size.] */
+TEST_FUNCTION(gballoc_calloc_counts_nmemb_times_size)
+{
+    // arrange
+    unsigned char* result;
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_calloc(1, IGNORED_NUM_ARG));
+
+    // act
+    result = (unsigned char*)gballoc_calloc(3, 4);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, (int)result[11]);
+    ASSERT_ARE_EQUAL(size_t, 12, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_11_002: [ If size is too big to fit the size header, gballoc_malloc, gballoc_calloc and gballoc_realloc shall fail and return NULL. ]*/
+TEST_FUNCTION(gballoc_calloc_with_overflowing_size_fails)
+{
+    // arrange
+    void* result;
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    result = gballoc_calloc(SIZE_MAX / 2, 4);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_01_022: [When the underlying calloc call fails, gballoc_calloc shall return NULL and size should not be counted towards total memory used.] */
+TEST_FUNCTION(when_calloc_fails_gballoc_calloc_fails)
+{
+    // arrange
+    void* result;
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_calloc(1, IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = gballoc_calloc(3, 4);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+}
+
+/* gballoc_realloc */
+
+/* Tests_SRS_GBALLOC_01_005: [gballoc_realloc shall call the C99 realloc function and return its result.] */
+/* Tests_SRS_GBALLOC_01_006: [If the underlying realloc call is successful, gballoc_realloc shall look up the size associated with the pointer ptr and decrease the total memory used with that size.] */
+/* Tests_SRS_GBALLOC_01_007: [If realloc is successful, gballoc_realloc shall also increment the total memory used value tracked by this module.] */
+TEST_FUNCTION(gballoc_realloc_replaces_the_counted_size)
+{
+    // arrange
+    void* block;
+    void* result;
+    (void)gballoc_init();
+    block = gballoc_malloc(10);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+
+    // act
+    result = gballoc_realloc(block, 100);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 100, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 100, gballoc_getMaximumMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_01_017: [When ptr is NULL, gballoc_realloc shall call the underlying realloc with ptr being NULL and the realloc result shall be tracked by gballoc.] */
+TEST_FUNCTION(gballoc_realloc_with_NULL_counts_the_new_block)
+{
+    // arrange
+    void* result;
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_realloc(NULL, IGNORED_NUM_ARG));
+
+    // act
+    result = gballoc_realloc(NULL, 7);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 7, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_01_014: [When the underlying realloc call fails, gballoc_realloc shall return NULL and no change should be made to the counted total memory usage.] */
+TEST_FUNCTION(when_realloc_fails_gballoc_realloc_does_not_change_the_counters)
+{
+    // arrange
+    void* block;
+    void* result;
+    (void)gballoc_init();
+    block = gballoc_malloc(10);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = gballoc_realloc(block, 100);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 10, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 10, gballoc_getMaximumMemoryUsed());
+
+    // cleanup
+    gballoc_free(block);
+}
+
+/* Tests_SRS_GBALLOC_11_003: [ Blocks that were not counted in the current metrics (allocated before gballoc_init or gballoc_resetMetrics) shall not decrease the total memory used when they are reallocated or freed. ]*/
+TEST_FUNCTION(gballoc_realloc_of_a_block_allocated_before_init_counts_only_the_new_size)
+{
+    // arrange
+    void* block = gballoc_malloc(10);
+    void* result;
+    (void)gballoc_init();
+
+    // act
+    result = gballoc_realloc(block, 20);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 20, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+}
+
+/* gballoc_free */
+
+/* Tests_SRS_GBALLOC_01_008: [gballoc_free shall call the C99 free function.] */
+/* Tests_SRS_GBALLOC_01_009: [gballoc_free shall also look up the size associated with the ptr pointer and decrease the total memory used with the associated size amount.] */
+TEST_FUNCTION(gballoc_free_decreases_the_memory_used)
+{
+    // arrange
+    void* block;
+    (void)gballoc_init();
+    block = gballoc_malloc(10);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_free(IGNORED_PTR_ARG));
+
+    // act
+    gballoc_free(block);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 10, gballoc_getMaximumMemoryUsed());
+}
+
+TEST_FUNCTION(gballoc_free_with_NULL_does_nothing)
+{
+    // arrange
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    gballoc_free(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* gballoc_getMaximumMemoryUsed */
+
+/* Tests_SRS_GBALLOC_01_010: [gballoc_getMaximumMemoryUsed shall return the maximum amount of total memory used recorded since the module initialization.] */
+/* Tests_SRS_GBALLOC_01_011: [The maximum total memory used shall be the maximum of the total memory used at any point.] */
+TEST_FUNCTION(gballoc_getMaximumMemoryUsed_returns_the_peak_across_shard_flushes)
+{
+    // arrange
+    void* blocks[4];
+    size_t i;
+    size_t result;
+    (void)gballoc_init();
+    for (i = 0; i < 4; i++)
+    {
+        blocks[i] = gballoc_malloc(10000);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        gballoc_free(blocks[i]);
+    }
+    blocks[0] = gballoc_malloc(5);
+
+    // act
+    result = gballoc_getMaximumMemoryUsed();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 40000, result);
+    ASSERT_ARE_EQUAL(size_t, 5, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 5, gballoc_getAllocationCount());
+
+    // cleanup
+    gballoc_free(blocks[0]);
+}
+
+/* Tests_SRS_GBALLOC_01_038: [If gballoc was not initialized gballoc_getMaximumMemoryUsed shall return MAX_INT_SIZE.] */
+TEST_FUNCTION(gballoc_getMaximumMemoryUsed_without_init_returns_SIZE_MAX)
+{
+    // act
+    size_t result = gballoc_getMaximumMemoryUsed();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, SIZE_MAX, result);
+}
+
+/* gballoc_getCurrentMemoryUsed */
+
+/* Tests_SRS_GBALLOC_01_044: [If gballoc was not initialized gballoc_getCurrentMemoryUsed shall return SIZE_MAX.] */
+TEST_FUNCTION(gballoc_getCurrentMemoryUsed_without_init_returns_SIZE_MAX)
+{
+    // act
+    size_t result = gballoc_getCurrentMemoryUsed();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, SIZE_MAX, result);
+}
+
+/* gballoc_getAllocationCount */
+
+/* Tests_SRS_GBALLOC_07_001: [ If gballoc was not initialized gballoc_getAllocationCount shall return 0. ] */
+TEST_FUNCTION(gballoc_getAllocationCount_without_init_returns_0)
+{
+    // act
+    size_t result = gballoc_getAllocationCount();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, result);
+}
+
+/* gballoc_resetMetrics */
+
+/* Tests_SRS_GBALLOC_07_008: [ gballoc_resetMetrics shall reset the total allocation size, max allocation size and number of allocation to zero. ] */
+/* Tests_SRS_GBALLOC_11_004: [ With GB_SHARDED_TRACKING, gballoc_resetMetrics shall start a new metrics generation so that blocks allocated before it are not counted when freed. ]*/
+TEST_FUNCTION(gballoc_resetMetrics_forgets_the_blocks_allocated_before)
+{
+    // arrange
+    void* block;
+    (void)gballoc_init();
+    block = gballoc_malloc(10);
+
+    // act
+    gballoc_resetMetrics();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getMaximumMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getAllocationCount());
+    gballoc_free(block);
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+}
+
+/* Tests_SRS_GBALLOC_07_005: [ If gballoc was not initialized gballoc_reset Metrics shall do nothing.] */
+TEST_FUNCTION(gballoc_resetMetrics_without_init_does_nothing)
+{
+    // act
+    gballoc_resetMetrics();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, SIZE_MAX, gballoc_getCurrentMemoryUsed());
+}
+
+/* gballoc_malloc_at */
+
+/* Tests_SRS_GBALLOC_11_015: [ With GB_SHARDED_TRACKING, gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc and not record the site. ]*/
+TEST_FUNCTION(gballoc_malloc_at_counts_like_gballoc_malloc)
+{
+    // arrange
+    void* block;
+    (void)gballoc_init();
+
+    // act
+    block = gballoc_malloc_at(10, "some_file.c", 42);
+
+    // assert
+    ASSERT_IS_NOT_NULL(block);
+    ASSERT_ARE_EQUAL(size_t, 10, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(block);
+}
+
+/* Tests_SRS_GBALLOC_11_016: [ With GB_SHARDED_TRACKING, gballoc_setSiteSamplingRate and gballoc_dumpSites shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(gballoc_setSiteSamplingRate_fails)
+{
+    // arrange
+    int result;
+    (void)gballoc_init();
+
+    // act
+    result = gballoc_setSiteSamplingRate(10);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_GBALLOC_11_016: [ With GB_SHARDED_TRACKING, gballoc_setSiteSamplingRate and gballoc_dumpSites shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(gballoc_dumpSites_fails)
+{
+    // arrange
+    int result;
+    (void)gballoc_init();
+
+    // act
+    result = gballoc_dumpSites("gballoc_sharded_ut_sites.txt", GBALLOC_DUMP_TEXT);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+END_TEST_SUITE(GBAllocSharded_UnitTests)
@@ -7,8 +7,12 @@
 
 #ifdef __cplusplus
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
 #else
 #include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
 #endif
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/gballoc.h"
@@ -1744,4 +1748,294 @@ TEST_FUNCTION(gballoc_resetMetrics_success)
     free(allocation);
 }
 
+/* gballoc_malloc_at */
+
+/* Tests_SRS_GBALLOC_11_005: [ gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc and also add the allocation to the count, bytes, live count and live bytes of the file and line they were called from. ]*/
+TEST_FUNCTION(gballoc_malloc_at_records_the_site)
+{
+    // arrange
+    void* result;
+    void* allocation;
+    void* site;
+    gballoc_init();
+    umock_c_reset_all_calls();
+    allocation = malloc(OVERHEAD_SIZE);
+    site = malloc(OVERHEAD_SIZE);
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation);
+    STRICT_EXPECTED_CALL(mock_malloc(1));
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(site);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    result = gballoc_malloc_at(1, "some_file.c", 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ALLOC_PTR1, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+    gballoc_deinit();
+    free(site);
+    free(allocation);
+}
+
+/* Tests_SRS_GBALLOC_11_005: [ gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc and also add the allocation to the count, bytes, live count and live bytes of the file and line they were called from. ]*/
+TEST_FUNCTION(gballoc_malloc_at_the_same_site_twice_reuses_the_site_record)
+{
+    // arrange
+    void* result1;
+    void* result2;
+    void* allocation1;
+    void* allocation2;
+    void* site;
+    gballoc_init();
+    allocation1 = malloc(OVERHEAD_SIZE);
+    allocation2 = malloc(OVERHEAD_SIZE);
+    site = malloc(OVERHEAD_SIZE);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation1);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(TEST_ALLOC_PTR1);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(site);
+    result1 = gballoc_malloc_at(1, "some_file.c", 42);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation2);
+    STRICT_EXPECTED_CALL(mock_malloc(2))
+        .SetReturn(TEST_ALLOC_PTR2);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    result2 = gballoc_malloc_at(2, "some_file.c", 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ALLOC_PTR2, result2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    gballoc_free(result1);
+    gballoc_free(result2);
+    gballoc_deinit();
+    free(site);
+    free(allocation2);
+    free(allocation1);
+}
+
+/* gballoc_setSiteSamplingRate */
+
+/* Tests_SRS_GBALLOC_11_008: [ If gballoc was not initialized gballoc_setSiteSamplingRate shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(gballoc_setSiteSamplingRate_without_init_fails)
+{
+    // act
+    int result = gballoc_setSiteSamplingRate(10);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_11_006: [ Only 1 in every rate allocations made through gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall be recorded, and their counts and bytes shall be multiplied by rate. ]*/
+/* Tests_SRS_GBALLOC_11_009: [ gballoc_setSiteSamplingRate shall record 1 in every rate allocations from then on, and none if rate is 0. ]*/
+TEST_FUNCTION(gballoc_setSiteSamplingRate_2_records_every_other_allocation)
+{
+    // arrange
+    void* result1;
+    void* result2;
+    void* allocation1;
+    void* allocation2;
+    void* site;
+    int result;
+    gballoc_init();
+    umock_c_reset_all_calls();
+    allocation1 = malloc(OVERHEAD_SIZE);
+    allocation2 = malloc(OVERHEAD_SIZE);
+    site = malloc(OVERHEAD_SIZE);
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation1);
+    STRICT_EXPECTED_CALL(mock_malloc(1));
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation2);
+    STRICT_EXPECTED_CALL(mock_malloc(1))
+        .SetReturn(TEST_ALLOC_PTR2);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(site);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    result = gballoc_setSiteSamplingRate(2);
+    result1 = gballoc_malloc_at(1, "some_file.c", 42);
+    result2 = gballoc_malloc_at(1, "some_file.c", 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    gballoc_free(result1);
+    gballoc_free(result2);
+    gballoc_deinit();
+    free(site);
+    free(allocation2);
+    free(allocation1);
+}
+
+/* Tests_SRS_GBALLOC_11_009: [ gballoc_setSiteSamplingRate shall record 1 in every rate allocations from then on, and none if rate is 0. ]*/
+TEST_FUNCTION(gballoc_setSiteSamplingRate_0_records_no_allocation)
+{
+    // arrange
+    void* result;
+    void* allocation;
+    gballoc_init();
+    (void)gballoc_setSiteSamplingRate(0);
+    umock_c_reset_all_calls();
+    allocation = malloc(OVERHEAD_SIZE);
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation);
+    STRICT_EXPECTED_CALL(mock_malloc(1));
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    result = gballoc_malloc_at(1, "some_file.c", 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    gballoc_free(result);
+    free(allocation);
+}
+
+/* gballoc_dumpSites */
+
+/* Tests_SRS_GBALLOC_11_010: [ If fileName is NULL or format is not GBALLOC_DUMP_TEXT or GBALLOC_DUMP_PPROF, gballoc_dumpSites shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(gballoc_dumpSites_with_NULL_fileName_fails)
+{
+    // arrange
+    int result;
+    gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    result = gballoc_dumpSites(NULL, GBALLOC_DUMP_TEXT);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_11_011: [ If gballoc was not initialized gballoc_dumpSites shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(gballoc_dumpSites_without_init_fails)
+{
+    // act
+    int result = gballoc_dumpSites("gballoc_ut_sites.txt", GBALLOC_DUMP_TEXT);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_11_014: [ If any error occurs, gballoc_dumpSites shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_malloc_fails_gballoc_dumpSites_fails)
+{
+    // arrange
+    int result;
+    gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    result = gballoc_dumpSites("gballoc_ut_sites.txt", GBALLOC_DUMP_TEXT);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_11_007: [ When a recorded allocation is freed or reallocated, its live count and live bytes shall be taken out of the file and line it was allocated from. ]*/
+/* Tests_SRS_GBALLOC_11_012: [ With GBALLOC_DUMP_TEXT, gballoc_dumpSites shall write to fileName one line per file and line with its live bytes, live count, bytes and count, sorted by live bytes and then by bytes, biggest first. ]*/
+TEST_FUNCTION(gballoc_dumpSites_writes_the_sites_sorted_by_live_bytes)
+{
+    // arrange
+    void* allocation1 = malloc(OVERHEAD_SIZE);
+    void* allocation2 = malloc(OVERHEAD_SIZE);
+    void* site1 = malloc(OVERHEAD_SIZE);
+    void* site2 = malloc(OVERHEAD_SIZE);
+    void* sites = malloc(OVERHEAD_SIZE);
+    void* freed;
+    void* kept;
+    char report[512];
+    size_t reportLength;
+    FILE* file;
+    int result;
+    gballoc_init();
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation1);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(TEST_ALLOC_PTR1);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(site1);
+    freed = gballoc_malloc_at(1000, "freed.c", 1);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation2);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(TEST_ALLOC_PTR2);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(site2);
+    kept = gballoc_malloc_at(10, "kept.c", 2);
+    gballoc_free(freed);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(sites);
+    STRICT_EXPECTED_CALL(mock_free(sites));
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    result = gballoc_dumpSites("gballoc_ut_sites.txt", GBALLOC_DUMP_TEXT);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    file = fopen("gballoc_ut_sites.txt", "r");
+    ASSERT_IS_NOT_NULL(file);
+    reportLength = fread(report, 1, sizeof(report) - 1, file);
+    report[reportLength] = '\0';
+    (void)fclose(file);
+    (void)remove("gballoc_ut_sites.txt");
+    ASSERT_IS_NOT_NULL(strstr(report, "          10          1             10            1  kept.c:2\n"));
+    ASSERT_IS_NOT_NULL(strstr(report, "           0          0           1000            1  freed.c:1\n"));
+    ASSERT_IS_TRUE(strstr(report, "kept.c:2") < strstr(report, "freed.c:1"));
+
+    // cleanup
+    gballoc_free(kept);
+    gballoc_deinit();
+    free(sites);
+    free(site2);
+    free(site1);
+    free(allocation2);
+    free(allocation1);
+}
+
 END_TEST_SUITE(GBAlloc_UnitTests)
@@ -441,7 +441,7 @@ HTTP_HEADERS_RESULT my_HTTPHeaders_GetHeader(HTTP_HEADERS_HANDLE handle, size_t
     return result;
 }
 
-static const IO_INTERFACE_DESCRIPTION default_tlsio = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+static const IO_INTERFACE_DESCRIPTION default_tlsio = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
 const IO_INTERFACE_DESCRIPTION* my_platform_get_default_tlsio(void)
 {
     return &default_tlsio;
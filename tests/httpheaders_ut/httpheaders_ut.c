@@ -73,9 +73,10 @@ void my_gballoc_free(void* ptr)
 
 #include "azure_c_shared_utility/map.h"
 
-MAP_HANDLE my_Map_Create(MAP_FILTER_CALLBACK mapFilterFunc)
+MAP_HANDLE my_Map_CreateWithCapacity(MAP_FILTER_CALLBACK mapFilterFunc, size_t capacity)
 {
     (void)mapFilterFunc;
+    (void)capacity;
     return (MAP_HANDLE)malloc(1);
 }
 
@@ -148,7 +149,7 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         REGISTER_UMOCK_ALIAS_TYPE(MAP_FILTER_CALLBACK, void*);
         REGISTER_UMOCK_ALIAS_TYPE(MAP_HANDLE, void*);
 
-        REGISTER_GLOBAL_MOCK_HOOK(Map_Create, my_Map_Create);
+        REGISTER_GLOBAL_MOCK_HOOK(Map_CreateWithCapacity, my_Map_CreateWithCapacity);
         REGISTER_GLOBAL_MOCK_HOOK(Map_Clone, my_Map_Clone);
         REGISTER_GLOBAL_MOCK_HOOK(Map_Destroy, my_Map_Destroy);
         REGISTER_GLOBAL_MOCK_RETURN(Map_AddOrUpdate, MAP_OK);
@@ -190,6 +191,7 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
 
 
     /*Tests_SRS_HTTP_HEADERS_99_002:[ This API shall produce a HTTP_HANDLE that can later be used in subsequent calls to the module.]*/
+    /*Tests_SRS_HTTP_HEADERS_11_001: [ HTTPHeaders_Alloc shall create the map holding the headers by calling Map_CreateWithCapacity with room for 8 headers. ]*/
     TEST_FUNCTION(HTTPHeaders_Alloc_happy_path_succeeds)
     {
         ///arrange
@@ -197,7 +199,7 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
 
-        STRICT_EXPECTED_CALL(Map_Create(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 8));
 
         ///act
         handle = HTTPHeaders_Alloc();
@@ -262,13 +264,13 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
 
 
     /*Tests_SRS_HTTP_HEADERS_99_003:[ The function shall return NULL when the function cannot execute properly]*/
-    TEST_FUNCTION(HTTPHeaders_Alloc_fails_when_Map_Create_fails)
+    TEST_FUNCTION(HTTPHeaders_Alloc_fails_when_Map_CreateWithCapacity_fails)
     {
         ///arrange
         HTTP_HEADERS_HANDLE httpHandle;
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(Map_Create(IGNORED_PTR_ARG))
+        STRICT_EXPECTED_CALL(Map_CreateWithCapacity(NULL, 8))
             .SetReturn(NULL);
 
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
@@ -0,0 +1,695 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#endif
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+#include "macro_utils.h"
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+#include "umocktypes_stdint.h"
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/condition.h"
+#include "azure_c_shared_utility/tickcounter.h"
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/latch.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+TEST_DEFINE_ENUM_TYPE(LATCH_RESULT, LATCH_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(LOCK_RESULT, LOCK_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(COND_RESULT, COND_RESULT_VALUES);
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+/*locks, conditions and tickcounters are small allocations so that every one has its own handle*/
+static LOCK_HANDLE my_Lock_Init(void)
+{
+    return (LOCK_HANDLE)my_gballoc_malloc(1);
+}
+
+static LOCK_RESULT my_Lock_Deinit(LOCK_HANDLE handle)
+{
+    my_gballoc_free(handle);
+    return LOCK_OK;
+}
+
+static COND_HANDLE my_Condition_Init(void)
+{
+    return (COND_HANDLE)my_gballoc_malloc(1);
+}
+
+static void my_Condition_Deinit(COND_HANDLE handle)
+{
+    my_gballoc_free(handle);
+}
+
+static TICK_COUNTER_HANDLE my_tickcounter_create(void)
+{
+    return (TICK_COUNTER_HANDLE)my_gballoc_malloc(1);
+}
+
+static void my_tickcounter_destroy(TICK_COUNTER_HANDLE tick_counter)
+{
+    my_gballoc_free(tick_counter);
+}
+
+/*the clock only moves when Condition_Wait says so*/
+static tickcounter_ms_t now_ms;
+
+static int my_tickcounter_get_current_ms(TICK_COUNTER_HANDLE tick_counter, tickcounter_ms_t* current_ms)
+{
+    (void)tick_counter;
+    *current_ms = now_ms;
+    return 0;
+}
+
+/*Condition_Wait counts down latch_to_count_down when it is set, the way another thread would while the caller waits.
+Otherwise it moves the clock by wakeup_after_ms and returns COND_OK, a wakeup that is not a count down, or by the
+whole timeout and returns COND_TIMEOUT when that is shorter*/
+static LATCH_HANDLE latch_to_count_down;
+static int wakeup_after_ms;
+
+static COND_RESULT my_Condition_Wait(COND_HANDLE handle, LOCK_HANDLE lock, int timeout_milliseconds)
+{
+    COND_RESULT result;
+    (void)handle;
+    (void)lock;
+
+    if (latch_to_count_down != NULL)
+    {
+        LATCH_HANDLE latch = latch_to_count_down;
+        latch_to_count_down = NULL;
+        (void)latch_count_down(latch);
+        result = COND_OK;
+    }
+    else if (wakeup_after_ms < timeout_milliseconds)
+    {
+        now_ms += wakeup_after_ms;
+        result = COND_OK;
+    }
+    else
+    {
+        now_ms += timeout_milliseconds;
+        result = COND_TIMEOUT;
+    }
+
+    return result;
+}
+
+BEGIN_TEST_SUITE(latch_unittests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types");
+
+    REGISTER_UMOCK_ALIAS_TYPE(LOCK_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(COND_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(TICK_COUNTER_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(tickcounter_ms_t*, void*);
+    REGISTER_TYPE(LOCK_RESULT, LOCK_RESULT);
+    REGISTER_TYPE(COND_RESULT, COND_RESULT);
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+
+    REGISTER_GLOBAL_MOCK_HOOK(Lock_Init, my_Lock_Init);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Lock_Init, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(Lock_Deinit, my_Lock_Deinit);
+    REGISTER_GLOBAL_MOCK_RETURN(Lock, LOCK_OK);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Lock, LOCK_ERROR);
+    REGISTER_GLOBAL_MOCK_RETURN(Unlock, LOCK_OK);
+
+    REGISTER_GLOBAL_MOCK_HOOK(Condition_Init, my_Condition_Init);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Condition_Init, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(Condition_Deinit, my_Condition_Deinit);
+    REGISTER_GLOBAL_MOCK_RETURN(Condition_Broadcast, COND_OK);
+    REGISTER_GLOBAL_MOCK_HOOK(Condition_Wait, my_Condition_Wait);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Condition_Wait, COND_ERROR);
+
+    REGISTER_GLOBAL_MOCK_HOOK(tickcounter_create, my_tickcounter_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(tickcounter_create, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(tickcounter_destroy, my_tickcounter_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(tickcounter_get_current_ms, my_tickcounter_get_current_ms);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(tickcounter_get_current_ms, __LINE__);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    now_ms = 1000;
+    latch_to_count_down = NULL;
+    wakeup_after_ms = INT32_MAX;
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+/* latch_create */
+
+/* Tests_SRS_LATCH_11_001: [ latch_create shall allocate a latch with a lock, a condition, a tickcounter and a count of count and return it. ]*/
+TEST_FUNCTION(latch_create_succeeds)
+{
+    ///arrange
+    LATCH_HANDLE latch;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init());
+    STRICT_EXPECTED_CALL(tickcounter_create());
+
+    ///act
+    latch = latch_create(2);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(latch);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_002: [ If any error occurs, latch_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_fails_latch_create_fails)
+{
+    ///arrange
+    LATCH_HANDLE latch;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    latch = latch_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(latch);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LATCH_11_002: [ If any error occurs, latch_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_Lock_Init_fails_latch_create_fails)
+{
+    ///arrange
+    LATCH_HANDLE latch;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init())
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    latch = latch_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(latch);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LATCH_11_002: [ If any error occurs, latch_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_Condition_Init_fails_latch_create_fails)
+{
+    ///arrange
+    LATCH_HANDLE latch;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init())
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    latch = latch_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(latch);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LATCH_11_002: [ If any error occurs, latch_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_tickcounter_create_fails_latch_create_fails)
+{
+    ///arrange
+    LATCH_HANDLE latch;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init());
+    STRICT_EXPECTED_CALL(tickcounter_create())
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(Condition_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    latch = latch_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(latch);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* latch_destroy */
+
+/* Tests_SRS_LATCH_11_003: [ If latch is NULL, latch_destroy shall return. ]*/
+TEST_FUNCTION(latch_destroy_with_NULL_returns)
+{
+    ///act
+    latch_destroy(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LATCH_11_004: [ latch_destroy shall free the tickcounter, the condition, the lock and the latch. ]*/
+TEST_FUNCTION(latch_destroy_frees_the_latch)
+{
+    ///arrange
+    LATCH_HANDLE latch = latch_create(2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(tickcounter_destroy(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    latch_destroy(latch);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* latch_count_down */
+
+/* Tests_SRS_LATCH_11_005: [ If latch is NULL, latch_count_down shall fail and return LATCH_INVALID_ARG. ]*/
+TEST_FUNCTION(latch_count_down_with_NULL_fails)
+{
+    ///act
+    LATCH_RESULT result = latch_count_down(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LATCH_11_007: [ latch_count_down shall decrement the count of latch under its lock and return LATCH_OK. ]*/
+TEST_FUNCTION(latch_count_down_that_does_not_get_to_0_does_not_broadcast)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_count_down(latch);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_007: [ latch_count_down shall decrement the count of latch under its lock and return LATCH_OK. ]*/
+/* Tests_SRS_LATCH_11_008: [ When the count gets to 0, latch_count_down shall broadcast the condition of latch. ]*/
+TEST_FUNCTION(latch_count_down_that_gets_to_0_broadcasts)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(2);
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_OK, latch_count_down(latch));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Broadcast(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_count_down(latch);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_006: [ If the count of latch is already 0, latch_count_down shall fail and return LATCH_ERROR. ]*/
+TEST_FUNCTION(latch_count_down_of_a_latch_at_0_fails)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_count_down(latch);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_009: [ If any other error occurs, latch_count_down shall fail and return LATCH_ERROR. ]*/
+TEST_FUNCTION(when_Lock_fails_latch_count_down_fails)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG))
+        .SetReturn(LOCK_ERROR);
+
+    ///act
+    result = latch_count_down(latch);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_009: [ If any other error occurs, latch_count_down shall fail and return LATCH_ERROR. ]*/
+TEST_FUNCTION(when_Condition_Broadcast_fails_latch_count_down_fails)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Broadcast(IGNORED_PTR_ARG))
+        .SetReturn(COND_ERROR);
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_count_down(latch);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* latch_wait */
+
+/* Tests_SRS_LATCH_11_010: [ If latch is NULL or timeout_milliseconds is negative, latch_wait shall fail and return LATCH_INVALID_ARG. ]*/
+TEST_FUNCTION(latch_wait_with_NULL_fails)
+{
+    ///act
+    LATCH_RESULT result = latch_wait(NULL, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LATCH_11_010: [ If latch is NULL or timeout_milliseconds is negative, latch_wait shall fail and return LATCH_INVALID_ARG. ]*/
+TEST_FUNCTION(latch_wait_with_negative_timeout_fails)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = latch_wait(latch, -1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_011: [ latch_wait shall return LATCH_OK when the count of latch is 0. ]*/
+TEST_FUNCTION(latch_wait_on_a_latch_at_0_returns)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(0);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_wait(latch, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_011: [ latch_wait shall return LATCH_OK when the count of latch is 0. ]*/
+/* Tests_SRS_LATCH_11_012: [ Otherwise latch_wait shall wait on the condition of latch until the count is 0. ]*/
+TEST_FUNCTION(latch_wait_waits_until_the_count_is_0)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    latch_to_count_down = latch;
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 0));
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Broadcast(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_wait(latch, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_013: [ If timeout_milliseconds is not 0, latch_wait shall read the tickcounter of latch before it waits and after every wakeup, and return LATCH_TIMEOUT once timeout_milliseconds went by with the count not at 0. ]*/
+TEST_FUNCTION(latch_wait_times_out)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 100));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_wait(latch, 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_TIMEOUT, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_013: [ If timeout_milliseconds is not 0, latch_wait shall read the tickcounter of latch before it waits and after every wakeup, and return LATCH_TIMEOUT once timeout_milliseconds went by with the count not at 0. ]*/
+TEST_FUNCTION(latch_wait_after_a_wakeup_waits_for_the_rest_of_the_timeout)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    wakeup_after_ms = 60;
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 100));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 40));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_wait(latch, 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_TIMEOUT, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_011: [ latch_wait shall return LATCH_OK when the count of latch is 0. ]*/
+TEST_FUNCTION(latch_wait_with_timeout_returns_when_the_count_gets_to_0)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    latch_to_count_down = latch;
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 100));
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Broadcast(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_wait(latch, 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_014: [ If any error occurs, latch_wait shall fail and return LATCH_ERROR. ]*/
+TEST_FUNCTION(when_Lock_fails_latch_wait_fails)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG))
+        .SetReturn(LOCK_ERROR);
+
+    ///act
+    result = latch_wait(latch, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_014: [ If any error occurs, latch_wait shall fail and return LATCH_ERROR. ]*/
+TEST_FUNCTION(when_tickcounter_get_current_ms_fails_latch_wait_fails)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(tickcounter_get_current_ms(IGNORED_PTR_ARG, IGNORED_PTR_ARG))
+        .SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_wait(latch, 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+/* Tests_SRS_LATCH_11_014: [ If any error occurs, latch_wait shall fail and return LATCH_ERROR. ]*/
+TEST_FUNCTION(when_Condition_Wait_fails_latch_wait_fails)
+{
+    ///arrange
+    LATCH_RESULT result;
+    LATCH_HANDLE latch = latch_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 0))
+        .SetReturn(COND_ERROR);
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = latch_wait(latch, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(LATCH_RESULT, LATCH_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    latch_destroy(latch);
+}
+
+END_TEST_SUITE(latch_unittests)
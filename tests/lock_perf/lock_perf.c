@@ -0,0 +1,261 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/threadapi.h"
+#include "perf_timer.h"
+
+/*threads look up and update a small table under one lock, the way option tables and the OpenSSL locks are used.
+Compares Lock with AdaptiveLock and RWLock when every operation writes, and when one operation in 100 writes*/
+
+#define OPERATIONS_PER_THREAD 500000
+#define MAX_THREADS 8
+#define TABLE_SIZE 16
+
+static const size_t thread_counts[] = { 1, 2, 4, 8 };
+static const unsigned int write_every[] = { 1, 100 };
+
+typedef struct LOCK_TYPE_TAG
+{
+    const char* name;
+    void* (*create)(void);
+    void (*destroy)(void* lock);
+    int (*read_lock)(void* lock);
+    int (*read_unlock)(void* lock);
+    int (*write_lock)(void* lock);
+    int (*write_unlock)(void* lock);
+} LOCK_TYPE;
+
+static void* lock_create(void)
+{
+    return Lock_Init();
+}
+
+static void lock_destroy(void* lock)
+{
+    (void)Lock_Deinit((LOCK_HANDLE)lock);
+}
+
+static int lock_lock(void* lock)
+{
+    return (Lock((LOCK_HANDLE)lock) == LOCK_OK) ? 0 : 1;
+}
+
+static int lock_unlock(void* lock)
+{
+    return (Unlock((LOCK_HANDLE)lock) == LOCK_OK) ? 0 : 1;
+}
+
+static void* adaptive_create(void)
+{
+    return AdaptiveLock_Init(0);
+}
+
+static void adaptive_destroy(void* lock)
+{
+    (void)AdaptiveLock_Deinit((ADAPTIVELOCK_HANDLE)lock);
+}
+
+static int adaptive_lock(void* lock)
+{
+    return (AdaptiveLock((ADAPTIVELOCK_HANDLE)lock) == LOCK_OK) ? 0 : 1;
+}
+
+static int adaptive_unlock(void* lock)
+{
+    return (AdaptiveUnlock((ADAPTIVELOCK_HANDLE)lock) == LOCK_OK) ? 0 : 1;
+}
+
+static void* rwlock_create(void)
+{
+    return RWLock_Init();
+}
+
+static void rwlock_destroy(void* lock)
+{
+    (void)RWLock_Deinit((RWLOCK_HANDLE)lock);
+}
+
+static int rwlock_read_lock(void* lock)
+{
+    return (ReadLock((RWLOCK_HANDLE)lock) == LOCK_OK) ? 0 : 1;
+}
+
+static int rwlock_read_unlock(void* lock)
+{
+    return (ReadUnlock((RWLOCK_HANDLE)lock) == LOCK_OK) ? 0 : 1;
+}
+
+static int rwlock_write_lock(void* lock)
+{
+    return (WriteLock((RWLOCK_HANDLE)lock) == LOCK_OK) ? 0 : 1;
+}
+
+static int rwlock_write_unlock(void* lock)
+{
+    return (WriteUnlock((RWLOCK_HANDLE)lock) == LOCK_OK) ? 0 : 1;
+}
+
+static const LOCK_TYPE lock_types[] =
+{
+    { "Lock", lock_create, lock_destroy, lock_lock, lock_unlock, lock_lock, lock_unlock },
+    { "AdaptiveLock", adaptive_create, adaptive_destroy, adaptive_lock, adaptive_unlock, adaptive_lock, adaptive_unlock },
+    { "RWLock", rwlock_create, rwlock_destroy, rwlock_read_lock, rwlock_read_unlock, rwlock_write_lock, rwlock_write_unlock }
+};
+
+typedef struct WORKER_CONTEXT_TAG
+{
+    const LOCK_TYPE* lock_type;
+    void* lock;
+    volatile size_t* table;
+    unsigned int write_every;
+    size_t failures;
+    size_t writes;
+    size_t sum;
+} WORKER_CONTEXT;
+
+static int worker(void* arg)
+{
+    WORKER_CONTEXT* context = (WORKER_CONTEXT*)arg;
+    size_t i;
+
+    for (i = 0; i < OPERATIONS_PER_THREAD; i++)
+    {
+        if ((i % context->write_every) == 0)
+        {
+            if (context->lock_type->write_lock(context->lock) != 0)
+            {
+                context->failures++;
+            }
+            else
+            {
+                context->table[i % TABLE_SIZE]++;
+                context->writes++;
+                if (context->lock_type->write_unlock(context->lock) != 0)
+                {
+                    context->failures++;
+                }
+            }
+        }
+        else
+        {
+            if (context->lock_type->read_lock(context->lock) != 0)
+            {
+                context->failures++;
+            }
+            else
+            {
+                size_t j;
+                for (j = 0; j < TABLE_SIZE; j++)
+                {
+                    context->sum += context->table[j];
+                }
+                if (context->lock_type->read_unlock(context->lock) != 0)
+                {
+                    context->failures++;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int run_test(const LOCK_TYPE* lock_type, size_t thread_count, unsigned int writes_every)
+{
+    int result;
+    void* lock = lock_type->create();
+
+    if (lock == NULL)
+    {
+        (void)printf("failed creating %s\r\n", lock_type->name);
+        result = __LINE__;
+    }
+    else
+    {
+        THREAD_HANDLE threads[MAX_THREADS];
+        WORKER_CONTEXT contexts[MAX_THREADS];
+        size_t table[TABLE_SIZE] = { 0 };
+        size_t started = 0;
+        size_t failures = 0;
+        size_t writes = 0;
+        size_t table_total = 0;
+        double start;
+        double end;
+        size_t i;
+
+        start = perf_timer_get_seconds();
+        for (i = 0; i < thread_count; i++)
+        {
+            contexts[i].lock_type = lock_type;
+            contexts[i].lock = lock;
+            contexts[i].table = table;
+            contexts[i].write_every = writes_every;
+            contexts[i].failures = 0;
+            contexts[i].writes = 0;
+            contexts[i].sum = 0;
+            if (ThreadAPI_Create(&threads[i], worker, &contexts[i]) != THREADAPI_OK)
+            {
+                break;
+            }
+            started++;
+        }
+
+        for (i = 0; i < started; i++)
+        {
+            int thread_result;
+            (void)ThreadAPI_Join(threads[i], &thread_result);
+            failures += contexts[i].failures;
+            writes += contexts[i].writes;
+        }
+        end = perf_timer_get_seconds();
+
+        for (i = 0; i < TABLE_SIZE; i++)
+        {
+            table_total += table[i];
+        }
+
+        if ((started != thread_count) || (failures != 0))
+        {
+            (void)printf("%s failed with %u threads\r\n", lock_type->name, (unsigned int)thread_count);
+            result = __LINE__;
+        }
+        else if (table_total != writes)
+        {
+            (void)printf("%s lost writes\r\n", lock_type->name);
+            result = __LINE__;
+        }
+        else
+        {
+            (void)printf("%-12s 1 write in %3u, %u threads: %8.2f ns per operation\r\n",
+                lock_type->name, writes_every, (unsigned int)thread_count, PERF_NS_PER_OP(start, end, thread_count * OPERATIONS_PER_THREAD));
+            result = 0;
+        }
+
+        lock_type->destroy(lock);
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int result = 0;
+    size_t i;
+    for (i = 0; (i < sizeof(write_every) / sizeof(write_every[0])) && (result == 0); i++)
+    {
+        size_t j;
+        for (j = 0; (j < sizeof(thread_counts) / sizeof(thread_counts[0])) && (result == 0); j++)
+        {
+            size_t k;
+            for (k = 0; (k < sizeof(lock_types) / sizeof(lock_types[0])) && (result == 0); k++)
+            {
+                result = run_test(&lock_types[k], thread_counts[j], write_every[i]);
+            }
+        }
+    }
+    return result;
+}
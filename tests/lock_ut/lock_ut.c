@@ -179,6 +179,198 @@ TEST_FUNCTION(LOCK_DeInit_NULL_fails)
     ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_ERROR, result);
 }
 
+/* Tests_SRS_LOCK_11_001: [RWLock_Init on success shall return a valid reader-writer lock handle which should be a non NULL value] */
+TEST_FUNCTION(RWLock_Init_succeeds)
+{
+    //arrange
+#ifdef WIN32
+    STRICT_EXPECTED_CALL(malloc(IGNORED_NUM_ARG));
+#endif
+
+    //act
+    RWLOCK_HANDLE handle = RWLock_Init();
+
+    //assert
+    ASSERT_IS_NOT_NULL(handle);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+    (void)RWLock_Deinit(handle);
+}
+
+/* Tests_SRS_LOCK_11_003: [ReadLock shall acquire the lock shared with other readers, waiting while a writer holds it, and return LOCK_OK] */
+/* Tests_SRS_LOCK_11_004: [ReadUnlock shall release the lock acquired with ReadLock and return LOCK_OK] */
+TEST_FUNCTION(ReadLock_ReadUnlock_succeed)
+{
+    //arrange
+    RWLOCK_HANDLE handle = RWLock_Init();
+    LOCK_RESULT lock_result;
+    LOCK_RESULT unlock_result;
+
+    //act
+    lock_result = ReadLock(handle);
+    unlock_result = ReadUnlock(handle);
+
+    //assert
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_OK, lock_result);
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_OK, unlock_result);
+
+    //cleanup
+    (void)RWLock_Deinit(handle);
+}
+
+/* Tests_SRS_LOCK_11_005: [WriteLock shall acquire the lock exclusively, waiting while readers or a writer hold it, and return LOCK_OK] */
+/* Tests_SRS_LOCK_11_006: [WriteUnlock shall release the lock acquired with WriteLock and return LOCK_OK] */
+TEST_FUNCTION(WriteLock_WriteUnlock_succeed)
+{
+    //arrange
+    RWLOCK_HANDLE handle = RWLock_Init();
+    LOCK_RESULT lock_result;
+    LOCK_RESULT unlock_result;
+
+    //act
+    lock_result = WriteLock(handle);
+    unlock_result = WriteUnlock(handle);
+
+    //assert
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_OK, lock_result);
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_OK, unlock_result);
+
+    //cleanup
+    (void)RWLock_Deinit(handle);
+}
+
+/* Tests_SRS_LOCK_11_009: [RWLock_Deinit shall free all resources associated with handle and return LOCK_OK] */
+TEST_FUNCTION(RWLock_Deinit_succeeds)
+{
+    //arrange
+    RWLOCK_HANDLE handle = RWLock_Init();
+
+    umock_c_reset_all_calls();
+
+#ifdef WIN32
+    STRICT_EXPECTED_CALL(free(IGNORED_PTR_ARG));
+#endif
+
+    //act
+    LOCK_RESULT result = RWLock_Deinit(handle);
+
+    //assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_OK, result);
+}
+
+/* Tests_SRS_LOCK_11_007: [ReadLock, ReadUnlock, WriteLock, WriteUnlock and RWLock_Deinit on NULL handle passed return LOCK_ERROR] */
+TEST_FUNCTION(RWLock_functions_with_NULL_handle_fail)
+{
+    //arrange
+
+    //act
+    LOCK_RESULT read_lock_result = ReadLock(NULL);
+    LOCK_RESULT read_unlock_result = ReadUnlock(NULL);
+    LOCK_RESULT write_lock_result = WriteLock(NULL);
+    LOCK_RESULT write_unlock_result = WriteUnlock(NULL);
+    LOCK_RESULT deinit_result = RWLock_Deinit(NULL);
+
+    //assert
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_ERROR, read_lock_result);
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_ERROR, read_unlock_result);
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_ERROR, write_lock_result);
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_ERROR, write_unlock_result);
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_ERROR, deinit_result);
+}
+
+/* Tests_SRS_LOCK_11_020: [AdaptiveLock_Init on success shall return a valid adaptive lock handle which should be a non NULL value] */
+TEST_FUNCTION(AdaptiveLock_Init_succeeds)
+{
+    //arrange
+#ifdef WIN32
+    STRICT_EXPECTED_CALL(malloc(IGNORED_NUM_ARG));
+#endif
+
+    //act
+    ADAPTIVELOCK_HANDLE handle = AdaptiveLock_Init(100);
+
+    //assert
+    ASSERT_IS_NOT_NULL(handle);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+    (void)AdaptiveLock_Deinit(handle);
+}
+
+/* Tests_SRS_LOCK_11_022: [If spin_count is 0 AdaptiveLock_Init shall use ADAPTIVELOCK_DEFAULT_SPIN_COUNT] */
+TEST_FUNCTION(AdaptiveLock_Init_with_0_spin_count_succeeds)
+{
+    //arrange
+
+    //act
+    ADAPTIVELOCK_HANDLE handle = AdaptiveLock_Init(0);
+
+    //assert
+    ASSERT_IS_NOT_NULL(handle);
+
+    //cleanup
+    (void)AdaptiveLock_Deinit(handle);
+}
+
+/* Tests_SRS_LOCK_11_023: [AdaptiveLock shall try to acquire the lock up to spin_count times before it waits for the lock to be released, and return LOCK_OK] */
+/* Tests_SRS_LOCK_11_025: [AdaptiveUnlock shall release the lock acquired with AdaptiveLock and return LOCK_OK] */
+TEST_FUNCTION(AdaptiveLock_AdaptiveUnlock_succeed)
+{
+    //arrange
+    ADAPTIVELOCK_HANDLE handle = AdaptiveLock_Init(0);
+    LOCK_RESULT lock_result;
+    LOCK_RESULT unlock_result;
+
+    //act
+    lock_result = AdaptiveLock(handle);
+    unlock_result = AdaptiveUnlock(handle);
+
+    //assert
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_OK, lock_result);
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_OK, unlock_result);
+
+    //cleanup
+    (void)AdaptiveLock_Deinit(handle);
+}
+
+/* Tests_SRS_LOCK_11_028: [AdaptiveLock_Deinit shall free all resources associated with handle and return LOCK_OK] */
+TEST_FUNCTION(AdaptiveLock_Deinit_succeeds)
+{
+    //arrange
+    ADAPTIVELOCK_HANDLE handle = AdaptiveLock_Init(0);
+
+    umock_c_reset_all_calls();
+
+#ifdef WIN32
+    STRICT_EXPECTED_CALL(free(IGNORED_PTR_ARG));
+#endif
+
+    //act
+    LOCK_RESULT result = AdaptiveLock_Deinit(handle);
+
+    //assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_OK, result);
+}
+
+/* Tests_SRS_LOCK_11_026: [AdaptiveLock, AdaptiveUnlock and AdaptiveLock_Deinit on NULL handle passed return LOCK_ERROR] */
+TEST_FUNCTION(AdaptiveLock_functions_with_NULL_handle_fail)
+{
+    //arrange
+
+    //act
+    LOCK_RESULT lock_result = AdaptiveLock(NULL);
+    LOCK_RESULT unlock_result = AdaptiveUnlock(NULL);
+    LOCK_RESULT deinit_result = AdaptiveLock_Deinit(NULL);
+
+    //assert
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_ERROR, lock_result);
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_ERROR, unlock_result);
+    ASSERT_ARE_EQUAL(LOCK_RESULT, LOCK_ERROR, deinit_result);
+}
+
 /* Extra negative tests - only supported on Win32. */
 #ifdef WIN32
 TEST_FUNCTION(LOCK_Lock_Init_fails_if_malloc_fails)
@@ -197,6 +389,34 @@ TEST_FUNCTION(LOCK_Lock_Init_fails_if_malloc_fails)
     //cleanup
     (void)Lock_Deinit(handle);
 }
+
+TEST_FUNCTION(RWLock_Init_fails_if_malloc_fails)
+{
+    //arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    //act
+    RWLOCK_HANDLE handle = RWLock_Init();
+
+    //assert
+    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(AdaptiveLock_Init_fails_if_malloc_fails)
+{
+    //arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    //act
+    ADAPTIVELOCK_HANDLE handle = AdaptiveLock_Init(0);
+
+    //assert
+    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
 #endif
 
 END_TEST_SUITE(LOCK_UnitTests);
@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "azure_c_shared_utility/map.h"
+#include "perf_timer.h"
+
+/*compares key lookups through the map's hash index with the linear strcmp scan the map used to do,
+and the cost of building a map with the different ways of creating it*/
+
+#define KEY_LENGTH_MAX 32
+#define LOOKUPS_PER_TEST 1000000
+#define ADDS_PER_BUILD_TEST 2000000
+#define ARENA_BLOCK_SIZE 4096
+
+static const size_t key_counts[] = { 10, 100, 10000 };
+
+/*this is how Map_GetValueFromKey searched before the map had an index*/
+static const char* linear_find(const char*const* keys, const char*const* values, size_t count, const char* key)
+{
+    const char* result = NULL;
+    size_t i;
+    for (i = 0; i < count; i++)
+    {
+        if (strcmp(keys[i], key) == 0)
+        {
+            result = values[i];
+            break;
+        }
+    }
+    return result;
+}
+
+static int run_test(size_t key_count)
+{
+    int result;
+    char* key_names = (char*)malloc(key_count * KEY_LENGTH_MAX);
+    MAP_HANDLE map = Map_Create(NULL);
+    if ((key_names == NULL) || (map == NULL))
+    {
+        (void)printf("failed allocating test data\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t i;
+        size_t found = 0;
+        double start;
+        double end;
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
+        size_t lookups = LOOKUPS_PER_TEST;
+
+        start = perf_timer_get_seconds();
+        for (i = 0; i < key_count; i++)
+        {
+            char* key = key_names + i * KEY_LENGTH_MAX;
+            (void)sprintf(key, "header-name-%u", (unsigned int)i);
+            if (Map_Add(map, key, "value") != MAP_OK)
+            {
+                break;
+            }
+        }
+        end = perf_timer_get_seconds();
+
+        if ((i != key_count) || (Map_GetInternals(map, &keys, &values, &count) != MAP_OK))
+        {
+            (void)printf("failed building the map\r\n");
+            result = __LINE__;
+        }
+        else
+        {
+            double indexed_ns;
+            double linear_ns;
+
+            (void)printf("%6u keys: Map_Add %10.1f ns/op\r\n", (unsigned int)key_count, PERF_NS_PER_OP(start, end, key_count));
+
+            if (key_count >= 1000)
+            {
+                /*keeps the linear scan of the big map from running for minutes*/
+                lookups /= 100;
+            }
+
+            start = perf_timer_get_seconds();
+            for (i = 0; i < lookups; i++)
+            {
+                found += (Map_GetValueFromKey(map, key_names + (i % key_count) * KEY_LENGTH_MAX) != NULL);
+            }
+            end = perf_timer_get_seconds();
+            indexed_ns = PERF_NS_PER_OP(start, end, lookups);
+
+            start = perf_timer_get_seconds();
+            for (i = 0; i < lookups; i++)
+            {
+                found += (linear_find(keys, values, count, key_names + (i % key_count) * KEY_LENGTH_MAX) != NULL);
+            }
+            end = perf_timer_get_seconds();
+            linear_ns = PERF_NS_PER_OP(start, end, lookups);
+
+            (void)printf("%6u keys: Map_GetValueFromKey %10.1f ns/op, linear scan %10.1f ns/op\r\n", (unsigned int)key_count, indexed_ns, linear_ns);
+
+            if (found != 2 * lookups)
+            {
+                (void)printf("lookups failed\r\n");
+                result = __LINE__;
+            }
+            else
+            {
+                result = 0;
+            }
+        }
+    }
+
+    Map_Destroy(map);
+    free(key_names);
+    return result;
+}
+
+typedef enum MAP_CREATION_TAG
+{
+    MAP_CREATION_DEFAULT,
+    MAP_CREATION_WITH_CAPACITY,
+    MAP_CREATION_WITH_STRING_ARENA
+} MAP_CREATION;
+
+static MAP_HANDLE create_map(MAP_CREATION creation, size_t key_count)
+{
+    MAP_HANDLE result;
+    switch (creation)
+    {
+        case MAP_CREATION_WITH_CAPACITY:
+            result = Map_CreateWithCapacity(NULL, key_count);
+            break;
+        case MAP_CREATION_WITH_STRING_ARENA:
+            result = Map_CreateWithStringArena(NULL, key_count, ARENA_BLOCK_SIZE);
+            break;
+        default:
+            result = Map_Create(NULL);
+            break;
+    }
+    return result;
+}
+
+/*builds and destroys the same map over and over, returns the average ns per Map_Add (create and destroy included) or a negative value on failure*/
+static double build_maps(MAP_CREATION creation, const char* key_names, size_t key_count)
+{
+    double result = 0;
+    size_t builds = ADDS_PER_BUILD_TEST / key_count;
+    double start = perf_timer_get_seconds();
+    size_t build;
+    for (build = 0; (build < builds) && (result == 0); build++)
+    {
+        MAP_HANDLE map = create_map(creation, key_count);
+        if (map == NULL)
+        {
+            result = -1;
+        }
+        else
+        {
+            size_t i;
+            for (i = 0; i < key_count; i++)
+            {
+                if (Map_Add(map, key_names + i * KEY_LENGTH_MAX, "value") != MAP_OK)
+                {
+                    result = -1;
+                    break;
+                }
+            }
+            Map_Destroy(map);
+        }
+    }
+
+    if (result == 0)
+    {
+        result = PERF_NS_PER_OP(start, perf_timer_get_seconds(), builds * key_count);
+    }
+    return result;
+}
+
+static int run_build_test(size_t key_count)
+{
+    int result;
+    char* key_names = (char*)malloc(key_count * KEY_LENGTH_MAX);
+    if (key_names == NULL)
+    {
+        (void)printf("failed allocating test data\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t i;
+        double default_ns;
+        double capacity_ns;
+        double arena_ns;
+        for (i = 0; i < key_count; i++)
+        {
+            (void)sprintf(key_names + i * KEY_LENGTH_MAX, "header-name-%u", (unsigned int)i);
+        }
+
+        default_ns = build_maps(MAP_CREATION_DEFAULT, key_names, key_count);
+        capacity_ns = build_maps(MAP_CREATION_WITH_CAPACITY, key_names, key_count);
+        arena_ns = build_maps(MAP_CREATION_WITH_STRING_ARENA, key_names, key_count);
+        if ((default_ns < 0) || (capacity_ns < 0) || (arena_ns < 0))
+        {
+            (void)printf("failed building the maps\r\n");
+            result = __LINE__;
+        }
+        else
+        {
+            (void)printf("%6u keys: Map_Add after Map_Create %10.1f ns/op, Map_CreateWithCapacity %10.1f ns/op, Map_CreateWithStringArena %10.1f ns/op\r\n",
+                (unsigned int)key_count, default_ns, capacity_ns, arena_ns);
+            result = 0;
+        }
+        free(key_names);
+    }
+    return result;
+}
+
+int main(void)
+{
+    int result = 0;
+    size_t i;
+    for (i = 0; (i < sizeof(key_counts) / sizeof(key_counts[0])) && (result == 0); i++)
+    {
+        result = run_test(key_counts[i]);
+    }
+    for (i = 0; (i < sizeof(key_counts) / sizeof(key_counts[0])) && (result == 0); i++)
+    {
+        result = run_build_test(key_counts[i]);
+    }
+    return result;
+}
@@ -3,8 +3,10 @@
 
 #ifdef __cplusplus
 #include <cstdlib>
+#include <cstdio>
 #else
 #include <stdlib.h>
+#include <stdio.h>
 #endif
 
 #include "azure_c_shared_utility/optimize_size.h"
@@ -146,6 +148,28 @@ static const char* TEST_BLUEVALUE = "cyan";
 static const char* TEST_GREENKEY = "testgreenkey";
 static const char* TEST_GREENVALUE = "green";
 
+static void add_numbered_keys(MAP_HANDLE handle, size_t first, size_t last)
+{
+    size_t i;
+    for (i = first; i < last; i++)
+    {
+        char key[32];
+        char value[32];
+        (void)sprintf(key, "key%u", (unsigned int)i);
+        (void)sprintf(value, "value%u", (unsigned int)i);
+        (void)Map_Add(handle, key, value);
+    }
+}
+
+static void assert_numbered_key_value(MAP_HANDLE handle, size_t i)
+{
+    char key[32];
+    char value[32];
+    (void)sprintf(key, "key%u", (unsigned int)i);
+    (void)sprintf(value, "value%u", (unsigned int)i);
+    ASSERT_ARE_EQUAL(char_ptr, value, Map_GetValueFromKey(handle, key));
+}
+
 DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
 
 static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
@@ -544,10 +568,6 @@ BEGIN_TEST_SUITE(map_unittests)
         /*below are undo actions*/
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*undo copy of blue key*/
             .ValidateArgumentBuffer(1, TEST_BLUEKEY, strlen(TEST_BLUEKEY) + 1);
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing keys*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing values*/
-            .IgnoreArgument(1);
 
 
         ///act
@@ -599,12 +619,7 @@ BEGIN_TEST_SUITE(map_unittests)
         whenShallmalloc_fail = currentmalloc_call + 3;
         STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1)); /*copy of blue key*/
 
-        /*below are undo actions*/
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing keys*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing values*/
-            .IgnoreArgument(1);
-
+        /*below are undo actions*/ /*none*/
 
         ///act
         result1 = Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
@@ -653,9 +668,7 @@ BEGIN_TEST_SUITE(map_unittests)
         STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(const char*))) /*growing values*/
             .IgnoreArgument(1);
 
-        /*below are undo actions*/
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing keys*/
-            .IgnoreArgument(1);
+        /*below are undo actions*/ /*none*/
 
         ///act
         result1 = Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
@@ -701,7 +714,7 @@ BEGIN_TEST_SUITE(map_unittests)
         STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(const char*))) /*growing keys*/
             .IgnoreArgument(1);
 
-        /*below are undo actions*/
+        /*below are undo actions*/ /*none*/
 
         ///act
         result1 = Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
@@ -1104,10 +1117,6 @@ BEGIN_TEST_SUITE(map_unittests)
         /*below are undo actions*/
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*undo blue key value*/
             .ValidateArgumentBuffer(1, TEST_BLUEKEY, strlen(TEST_BLUEKEY) + 1);
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing keys*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing values*/
-            .IgnoreArgument(1);
 
         ///act
         result1 = Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
@@ -1152,11 +1161,7 @@ BEGIN_TEST_SUITE(map_unittests)
         whenShallmalloc_fail = currentmalloc_call + 3;
         STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1)); /*copy of red key*/
 
-        /*below are undo actions*/
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing keys*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing values*/
-            .IgnoreArgument(1);
+        /*below are undo actions*/ /*none*/
 
         ///act
         result1 = Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
@@ -1200,9 +1205,7 @@ BEGIN_TEST_SUITE(map_unittests)
         STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(const char*))) /*growing values*/
             .IgnoreArgument(1);
 
-        /*below are undo actions*/
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing keys*/
-            .IgnoreArgument(1);
+        /*below are undo actions*/ /*none*/
 
         ///act
         result1 = Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
@@ -1391,7 +1394,7 @@ BEGIN_TEST_SUITE(map_unittests)
         whenShallrealloc_fail = currentrealloc_call + 1;
         STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(const char*))); /*growing keys*/
 
-        /*below are undo actions*/
+        /*below are undo actions*/ /*none*/
 
         ///act
         result1 = Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
@@ -1687,12 +1690,6 @@ BEGIN_TEST_SUITE(map_unittests)
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*freeing yellow value*/
             .ValidateArgumentBuffer(1, TEST_YELLOWVALUE, strlen(TEST_YELLOWVALUE) + 1);
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1* sizeof(const char*))) /*ungrowing values*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*ungrowing keys*/
-            .IgnoreArgument(1);
-
         ///act
         result1 = Map_Delete(handle, TEST_YELLOWKEY);
         result3 = Map_GetInternals(handle, &keys, &values, &count);
@@ -1730,12 +1727,6 @@ BEGIN_TEST_SUITE(map_unittests)
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*freeing yellow value*/
             .ValidateArgumentBuffer(1, TEST_REDVALUE, strlen(TEST_REDVALUE) + 1);
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*ungrowing values*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*ungrowing keys*/
-            .IgnoreArgument(1);
-
         ///act
         result1 = Map_Delete(handle, TEST_REDKEY);
         result3 = Map_GetInternals(handle, &keys, &values, &count);
@@ -3848,5 +3839,823 @@ BEGIN_TEST_SUITE(map_unittests)
         Map_Destroy(handle);
     }
 
+    /*Tests_SRS_MAP_11_001: [ When the map holds more than 8 keys, Map_Add and Map_AddOrUpdate shall maintain a hash index of the keys. ]*/
+    TEST_FUNCTION(Map_Add_the_9th_key_builds_the_index)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        size_t i;
+        add_numbered_keys(handle, 0, 8);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 16 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 16 * sizeof(const char*))) /*growing values*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("key8") + 1)); /*copy of the key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("value8") + 1)); /*copy of the value*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*the index*/
+            .IgnoreArgument(1);
+
+        ///act
+        result = Map_Add(handle, "key8", "value8");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        for (i = 0; i < 9; i++)
+        {
+            assert_numbered_key_value(handle, i);
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_002: [ If building the hash index fails, the map shall keep operating by searching the keys linearly. ]*/
+    TEST_FUNCTION(Map_Add_the_9th_key_succeeds_when_building_the_index_fails)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        bool exists;
+        size_t i;
+        add_numbered_keys(handle, 0, 8);
+        umock_c_reset_all_calls();
+
+        whenShallmalloc_fail = currentmalloc_call + 3;
+
+        ///act
+        result = Map_Add(handle, "key8", "value8");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        for (i = 0; i < 9; i++)
+        {
+            assert_numbered_key_value(handle, i);
+        }
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_KEYEXISTS, Map_Add(handle, "key8", "value8"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_ContainsKey(handle, "key9", &exists));
+        ASSERT_IS_FALSE(exists);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_001: [ When the map holds more than 8 keys, Map_Add and Map_AddOrUpdate shall maintain a hash index of the keys. ]*/
+    TEST_FUNCTION(Map_with_index_finds_all_keys_after_growing)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
+        bool exists;
+        size_t i;
+
+        ///act
+        add_numbered_keys(handle, 0, 100);
+        (void)Map_AddOrUpdate(handle, "key42", "newvalue42");
+        (void)Map_AddOrUpdate(handle, "key100", "value100");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_GetInternals(handle, &keys, &values, &count));
+        ASSERT_ARE_EQUAL(size_t, 101, count);
+        ASSERT_ARE_EQUAL(char_ptr, "key0", keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, "key100", keys[100]);
+        ASSERT_ARE_EQUAL(char_ptr, "newvalue42", Map_GetValueFromKey(handle, "key42"));
+        for (i = 0; i < 101; i++)
+        {
+            if (i != 42)
+            {
+                assert_numbered_key_value(handle, i);
+            }
+        }
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_ContainsKey(handle, "key101", &exists));
+        ASSERT_IS_FALSE(exists);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_003: [ Map_Delete shall remove the key from the hash index and preserve the order of the remaining keys. ]*/
+    TEST_FUNCTION(Map_Delete_with_index_keeps_the_other_keys)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
+        bool exists;
+        size_t i;
+        add_numbered_keys(handle, 0, 50);
+
+        ///act
+        for (i = 0; i < 50; i += 3)
+        {
+            char key[32];
+            (void)sprintf(key, "key%u", (unsigned int)i);
+            ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Delete(handle, key));
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_GetInternals(handle, &keys, &values, &count));
+        ASSERT_ARE_EQUAL(size_t, 33, count);
+        ASSERT_ARE_EQUAL(char_ptr, "key1", keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, "key2", keys[1]);
+        ASSERT_ARE_EQUAL(char_ptr, "key4", keys[2]);
+        for (i = 0; i < 50; i++)
+        {
+            if (i % 3 == 0)
+            {
+                char key[32];
+                (void)sprintf(key, "key%u", (unsigned int)i);
+                ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_ContainsKey(handle, key, &exists));
+                ASSERT_IS_FALSE(exists);
+            }
+            else
+            {
+                assert_numbered_key_value(handle, i);
+            }
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_004: [ Map_Clone shall build a hash index for the clone when it holds more than 8 keys. ]*/
+    TEST_FUNCTION(Map_Clone_with_index_succeeds)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_HANDLE clone;
+        size_t i;
+        add_numbered_keys(handle, 0, 20);
+        umock_c_reset_all_calls();
+
+        ///act
+        clone = Map_Clone(handle);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(clone);
+        for (i = 0; i < 20; i++)
+        {
+            assert_numbered_key_value(clone, i);
+        }
+
+        ///cleanup
+        Map_Destroy(clone);
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_02_004: [Map_Destroy shall release all resources associated with the map.] */
+    TEST_FUNCTION(Map_Destroy_with_index_frees_the_index)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        size_t i;
+        add_numbered_keys(handle, 0, 9);
+        umock_c_reset_all_calls();
+
+        for (i = 0; i < 9; i++)
+        {
+            STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*key*/
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*value*/
+                .IgnoreArgument(1);
+        }
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*keys array*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*values array*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*index*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*handle*/
+            .IgnoreArgument(1);
+
+        ///act
+        Map_Destroy(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_MAP_02_010: [Otherwise, Map_Add shall add the pair <key,value> to the map.] */
+    TEST_FUNCTION(Map_Add_doubles_the_storage_when_full)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        add_numbered_keys(handle, 0, 2);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 4 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 4 * sizeof(const char*))) /*growing values*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("key2") + 1)); /*copy of the key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("value2") + 1)); /*copy of the value*/
+
+        ///act
+        result = Map_Add(handle, "key2", "value2");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_02_010: [Otherwise, Map_Add shall add the pair <key,value> to the map.] */
+    TEST_FUNCTION(Map_Add_does_not_grow_the_storage_when_not_full)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        add_numbered_keys(handle, 0, 3);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("key3") + 1)); /*copy of the key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("value3") + 1)); /*copy of the value*/
+
+        ///act
+        result = Map_Add(handle, "key3", "value3");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_numbered_key_value(handle, 3);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_02_023: [Otherwise, Map_Delete shall remove the key and its associated value from the map and return MAP_OK.]*/
+    TEST_FUNCTION(Map_Delete_shrinks_the_storage_when_a_quarter_full)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        add_numbered_keys(handle, 0, 5); /*capacity is 8*/
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Delete(handle, "key4"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Delete(handle, "key3"));
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*key*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*value*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 4 * sizeof(const char*))) /*shrinking keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 4 * sizeof(const char*))) /*shrinking values*/
+            .IgnoreArgument(1);
+
+        ///act
+        result = Map_Delete(handle, "key2");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_numbered_key_value(handle, 0);
+        assert_numbered_key_value(handle, 1);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_005: [ Map_CreateWithCapacity shall create a new, empty map that can hold capacity keys and values without reallocating its storage. ]*/
+    TEST_FUNCTION(Map_CreateWithCapacity_succeeds)
+    {
+        ///arrange
+        MAP_HANDLE handle;
+        size_t i;
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*handle*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(10 * sizeof(const char*))); /*keys*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(10 * sizeof(const char*))); /*values*/
+
+        ///act
+        handle = Map_CreateWithCapacity(NULL, 10);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        umock_c_reset_all_calls();
+        for (i = 0; i < 10; i++)
+        {
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*copy of the key*/
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*copy of the value*/
+                .IgnoreArgument(1);
+        }
+        add_numbered_keys(handle, 0, 10);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        for (i = 0; i < 10; i++)
+        {
+            assert_numbered_key_value(handle, i);
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_005: [ Map_CreateWithCapacity shall create a new, empty map that can hold capacity keys and values without reallocating its storage. ]*/
+    TEST_FUNCTION(Map_CreateWithCapacity_0_does_not_allocate_the_storage)
+    {
+        ///arrange
+        MAP_HANDLE handle;
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*handle*/
+            .IgnoreArgument(1);
+
+        ///act
+        handle = Map_CreateWithCapacity(NULL, 0);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_006: [ If any error occurs, Map_CreateWithCapacity shall return NULL. ]*/
+    TEST_FUNCTION(Map_CreateWithCapacity_fails_when_gballoc_fails_1)
+    {
+        ///arrange
+        MAP_HANDLE handle;
+
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*handle*/
+            .IgnoreArgument(1);
+
+        ///act
+        handle = Map_CreateWithCapacity(NULL, 10);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_MAP_11_006: [ If any error occurs, Map_CreateWithCapacity shall return NULL. ]*/
+    TEST_FUNCTION(Map_CreateWithCapacity_fails_when_gballoc_fails_2)
+    {
+        ///arrange
+        MAP_HANDLE handle;
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*handle*/
+            .IgnoreArgument(1);
+        whenShallmalloc_fail = 2;
+        STRICT_EXPECTED_CALL(gballoc_malloc(10 * sizeof(const char*))); /*keys*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*handle*/
+            .IgnoreArgument(1);
+
+        ///act
+        handle = Map_CreateWithCapacity(NULL, 10);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_MAP_11_006: [ If any error occurs, Map_CreateWithCapacity shall return NULL. ]*/
+    TEST_FUNCTION(Map_CreateWithCapacity_fails_when_gballoc_fails_3)
+    {
+        ///arrange
+        MAP_HANDLE handle;
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*handle*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(10 * sizeof(const char*))); /*keys*/
+        whenShallmalloc_fail = 3;
+        STRICT_EXPECTED_CALL(gballoc_malloc(10 * sizeof(const char*))); /*values*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*handle*/
+            .IgnoreArgument(1);
+
+        ///act
+        handle = Map_CreateWithCapacity(NULL, 10);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_MAP_11_012: [ If parameter handle is NULL then Map_Reserve shall return MAP_INVALIDARG. ]*/
+    TEST_FUNCTION(Map_Reserve_with_NULL_handle_fails)
+    {
+        ///arrange
+        MAP_RESULT result;
+
+        ///act
+        result = Map_Reserve(NULL, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_INVALIDARG, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_MAP_11_014: [ Otherwise, Map_Reserve shall grow the storage of the map so that it can hold capacity keys and values without reallocating it. ]*/
+    /*Tests_SRS_MAP_11_017: [ Otherwise Map_Reserve shall return MAP_OK. ]*/
+    TEST_FUNCTION(Map_Reserve_grows_the_storage)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        add_numbered_keys(handle, 0, 2);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 10 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 10 * sizeof(const char*))) /*growing values*/
+            .IgnoreArgument(1);
+
+        ///act
+        result = Map_Reserve(handle, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_numbered_key_value(handle, 0);
+        assert_numbered_key_value(handle, 1);
+
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("key2") + 1)); /*copy of the key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("value2") + 1)); /*copy of the value*/
+        add_numbered_keys(handle, 2, 3);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_013: [ If the map can already hold capacity keys, Map_Reserve shall not reallocate the storage, it shall only keep Map_Delete from shrinking it below capacity keys, and return MAP_OK. ]*/
+    TEST_FUNCTION(Map_Reserve_with_smaller_capacity_does_nothing)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithCapacity(NULL, 10);
+        MAP_RESULT result;
+        umock_c_reset_all_calls();
+
+        ///act
+        result = Map_Reserve(handle, 5);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_015: [ If growing the storage fails, Map_Reserve shall return MAP_ERROR and leave the map unchanged. ]*/
+    TEST_FUNCTION(Map_Reserve_fails_when_gballoc_fails)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
+        add_numbered_keys(handle, 0, 2);
+        umock_c_reset_all_calls();
+
+        whenShallrealloc_fail = currentrealloc_call + 1;
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 10 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+
+        ///act
+        result = Map_Reserve(handle, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_ERROR, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_GetInternals(handle, &keys, &values, &count));
+        ASSERT_ARE_EQUAL(size_t, 2, count);
+        assert_numbered_key_value(handle, 0);
+        assert_numbered_key_value(handle, 1);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_016: [ If the map has a hash index, Map_Reserve shall also size the index for capacity keys. ]*/
+    TEST_FUNCTION(Map_Reserve_with_index_grows_the_index)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        size_t i;
+        add_numbered_keys(handle, 0, 9);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 100 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 100 * sizeof(const char*))) /*growing values*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*old index*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*new index*/
+            .IgnoreArgument(1);
+
+        ///act
+        result = Map_Reserve(handle, 100);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        add_numbered_keys(handle, 9, 100);
+        for (i = 0; i < 100; i++)
+        {
+            assert_numbered_key_value(handle, i);
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_018: [ Map_Delete shall not shrink the storage of the map below the capacity given to Map_CreateWithCapacity, Map_CreateWithStringArena or Map_Reserve, not even when it deletes the last key. ]*/
+    TEST_FUNCTION(Map_Delete_of_the_last_key_keeps_the_storage_of_Map_CreateWithCapacity)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithCapacity(NULL, 10);
+        MAP_RESULT result;
+        size_t i;
+        add_numbered_keys(handle, 0, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*key*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*value*/
+            .IgnoreArgument(1);
+
+        ///act
+        result = Map_Delete(handle, "key0");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        umock_c_reset_all_calls();
+        for (i = 0; i < 10; i++)
+        {
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*copy of the key*/
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*copy of the value*/
+                .IgnoreArgument(1);
+        }
+        add_numbered_keys(handle, 0, 10);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        for (i = 0; i < 10; i++)
+        {
+            assert_numbered_key_value(handle, i);
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_018: [ Map_Delete shall not shrink the storage of the map below the capacity given to Map_CreateWithCapacity, Map_CreateWithStringArena or Map_Reserve, not even when it deletes the last key. ]*/
+    TEST_FUNCTION(Map_Delete_of_the_last_key_keeps_the_storage_of_Map_Reserve)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Reserve(handle, 16));
+        add_numbered_keys(handle, 0, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*key*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*value*/
+            .IgnoreArgument(1);
+
+        ///act
+        result = Map_Delete(handle, "key0");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_013: [ If the map can already hold capacity keys, Map_Reserve shall not reallocate the storage, it shall only keep Map_Delete from shrinking it below capacity keys, and return MAP_OK. ]*/
+    /*Tests_SRS_MAP_11_018: [ Map_Delete shall not shrink the storage of the map below the capacity given to Map_CreateWithCapacity, Map_CreateWithStringArena or Map_Reserve, not even when it deletes the last key. ]*/
+    TEST_FUNCTION(Map_Delete_does_not_shrink_the_storage_below_the_reserved_capacity)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        add_numbered_keys(handle, 0, 5); /*capacity is 8*/
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Reserve(handle, 8));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Delete(handle, "key4"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Delete(handle, "key3"));
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*key*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*value*/
+            .IgnoreArgument(1);
+
+        ///act
+        result = Map_Delete(handle, "key2");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_numbered_key_value(handle, 0);
+        assert_numbered_key_value(handle, 1);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_008: [ If arenaBlockSize is 0 then Map_CreateWithStringArena shall fail and return NULL. ]*/
+    TEST_FUNCTION(Map_CreateWithStringArena_with_0_arenaBlockSize_fails)
+    {
+        ///arrange
+        MAP_HANDLE handle;
+
+        ///act
+        handle = Map_CreateWithStringArena(NULL, 4, 0);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_MAP_11_009: [ If any other error occurs, Map_CreateWithStringArena shall return NULL. ]*/
+    TEST_FUNCTION(Map_CreateWithStringArena_fails_when_gballoc_fails)
+    {
+        ///arrange
+        MAP_HANDLE handle;
+
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*handle*/
+            .IgnoreArgument(1);
+
+        ///act
+        handle = Map_CreateWithStringArena(NULL, 4, 256);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_MAP_11_007: [ Map_CreateWithStringArena shall create a new, empty map with room for capacity keys and values that copies keys and values into shared blocks of at least arenaBlockSize characters instead of allocating each of them. ]*/
+    TEST_FUNCTION(Map_CreateWithStringArena_copies_the_strings_in_one_block)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithStringArena(NULL, 4, 256);
+        size_t i;
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*the first block of strings*/
+            .IgnoreArgument(1);
+
+        ///act
+        add_numbered_keys(handle, 0, 4);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        for (i = 0; i < 4; i++)
+        {
+            assert_numbered_key_value(handle, i);
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_007: [ Map_CreateWithStringArena shall create a new, empty map with room for capacity keys and values that copies keys and values into shared blocks of at least arenaBlockSize characters instead of allocating each of them. ]*/
+    TEST_FUNCTION(Map_CreateWithStringArena_Add_fails_when_gballoc_fails)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithStringArena(NULL, 4, 256);
+        MAP_RESULT result;
+        bool exists;
+        umock_c_reset_all_calls();
+
+        whenShallmalloc_fail = currentmalloc_call + 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*the first block of strings*/
+            .IgnoreArgument(1);
+        /*below are undo actions*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*values*/
+            .IgnoreArgument(1);
+
+        ///act
+        result = Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_ERROR, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_ContainsKey(handle, TEST_REDKEY, &exists));
+        ASSERT_IS_FALSE(exists);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_011: [ When the map stores its strings in an arena, Map_AddOrUpdate shall overwrite the old value in place if the new value fits in it, otherwise it shall copy the new value into the arena. ]*/
+    TEST_FUNCTION(Map_CreateWithStringArena_AddOrUpdate_and_Delete_succeed)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithStringArena(NULL, 4, 8);
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
+        size_t i;
+        add_numbered_keys(handle, 0, 20);
+        umock_c_reset_all_calls();
+
+        ///act
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_AddOrUpdate(handle, "key3", "v"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_AddOrUpdate(handle, "key4", "a value that does not fit in place"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Delete(handle, "key5"));
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, "v", Map_GetValueFromKey(handle, "key3"));
+        ASSERT_ARE_EQUAL(char_ptr, "a value that does not fit in place", Map_GetValueFromKey(handle, "key4"));
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, "key5"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_GetInternals(handle, &keys, &values, &count));
+        ASSERT_ARE_EQUAL(size_t, 19, count);
+        for (i = 6; i < 20; i++)
+        {
+            assert_numbered_key_value(handle, i);
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_11_010: [ Map_Clone of a map created by Map_CreateWithStringArena shall produce a map that also stores its keys and values in a string arena. ]*/
+    TEST_FUNCTION(Map_Clone_with_string_arena_succeeds)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithStringArena(NULL, 4, 1024);
+        MAP_HANDLE clone;
+        size_t i;
+        add_numbered_keys(handle, 0, 10);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*handle*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(10 * sizeof(const char*))); /*keys*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(10 * sizeof(const char*))); /*values*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*the first block of strings*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*the index*/
+            .IgnoreArgument(1);
+
+        ///act
+        clone = Map_Clone(handle);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(clone);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        for (i = 0; i < 10; i++)
+        {
+            assert_numbered_key_value(clone, i);
+        }
+
+        ///cleanup
+        Map_Destroy(clone);
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_02_004: [Map_Destroy shall release all resources associated with the map.] */
+    TEST_FUNCTION(Map_Destroy_with_string_arena_frees_the_blocks)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithStringArena(NULL, 2, 16);
+        add_numbered_keys(handle, 0, 2); /*"key0value0key1value1" does not fit in 16 characters*/
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*keys array*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*values array*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*second block*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*first block*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*handle*/
+            .IgnoreArgument(1);
+
+        ///act
+        Map_Destroy(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
 
 END_TEST_SUITE(map_unittests)
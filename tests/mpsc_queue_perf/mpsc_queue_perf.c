@@ -0,0 +1,259 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/singlylinkedlist.h"
+#include "azure_c_shared_utility/mpsc_queue.h"
+#include "azure_c_shared_utility/threadapi.h"
+#include "perf_timer.h"
+
+/*producer threads push to one consumer, the main thread, the way application threads hand work to the thread
+that runs xio_dowork. Compares a LOCK_HANDLE around a singlylinkedlist with the unbounded and the bounded mpsc_queue*/
+
+#define ITEMS_PER_PRODUCER 200000
+#define MAX_PRODUCERS 8
+#define BOUNDED_CAPACITY 1024
+
+static const size_t producer_counts[] = { 1, 2, 4, 8 };
+
+typedef struct QUEUE_TAG
+{
+    const char* name;
+    void* (*create)(void);
+    void (*destroy)(void* queue);
+    int (*push)(void* queue, void* item); /*0 when pushed, 1 when full, anything else on error*/
+    void* (*pop)(void* queue);
+} QUEUE;
+
+typedef struct LOCKED_LIST_TAG
+{
+    LOCK_HANDLE lock;
+    SINGLYLINKEDLIST_HANDLE list;
+} LOCKED_LIST;
+
+static void locked_list_destroy(void* queue)
+{
+    LOCKED_LIST* locked_list = (LOCKED_LIST*)queue;
+    if (locked_list->lock != NULL)
+    {
+        (void)Lock_Deinit(locked_list->lock);
+    }
+    singlylinkedlist_destroy(locked_list->list);
+    free(locked_list);
+}
+
+static void* locked_list_create(void)
+{
+    LOCKED_LIST* result = (LOCKED_LIST*)malloc(sizeof(LOCKED_LIST));
+    if (result != NULL)
+    {
+        result->lock = Lock_Init();
+        result->list = singlylinkedlist_create();
+        if ((result->lock == NULL) || (result->list == NULL))
+        {
+            locked_list_destroy(result);
+            result = NULL;
+        }
+    }
+    return result;
+}
+
+static int locked_list_push(void* queue, void* item)
+{
+    int result;
+    LOCKED_LIST* locked_list = (LOCKED_LIST*)queue;
+    if (Lock(locked_list->lock) != LOCK_OK)
+    {
+        result = 2;
+    }
+    else
+    {
+        result = (singlylinkedlist_add(locked_list->list, item) == NULL) ? 2 : 0;
+        (void)Unlock(locked_list->lock);
+    }
+    return result;
+}
+
+static void* locked_list_pop(void* queue)
+{
+    void* result = NULL;
+    LOCKED_LIST* locked_list = (LOCKED_LIST*)queue;
+    if (Lock(locked_list->lock) == LOCK_OK)
+    {
+        LIST_ITEM_HANDLE head = singlylinkedlist_get_head_item(locked_list->list);
+        if (head != NULL)
+        {
+            result = (void*)singlylinkedlist_item_get_value(head);
+            (void)singlylinkedlist_remove(locked_list->list, head);
+        }
+        (void)Unlock(locked_list->lock);
+    }
+    return result;
+}
+
+static void* unbounded_create(void)
+{
+    return mpsc_queue_create();
+}
+
+static void* bounded_create(void)
+{
+    return mpsc_queue_create_bounded(BOUNDED_CAPACITY);
+}
+
+static void mpsc_destroy(void* queue)
+{
+    mpsc_queue_destroy((MPSC_QUEUE_HANDLE)queue);
+}
+
+static int mpsc_push(void* queue, void* item)
+{
+    MPSC_QUEUE_RESULT result = mpsc_queue_push((MPSC_QUEUE_HANDLE)queue, item);
+    return (result == MPSC_QUEUE_OK) ? 0 : (result == MPSC_QUEUE_FULL) ? 1 : 2;
+}
+
+static void* mpsc_pop(void* queue)
+{
+    return mpsc_queue_pop((MPSC_QUEUE_HANDLE)queue);
+}
+
+static const QUEUE queues[] =
+{
+    { "Lock + singlylinkedlist", locked_list_create, locked_list_destroy, locked_list_push, locked_list_pop },
+    { "mpsc_queue unbounded", unbounded_create, mpsc_destroy, mpsc_push, mpsc_pop },
+    { "mpsc_queue bounded", bounded_create, mpsc_destroy, mpsc_push, mpsc_pop }
+};
+
+typedef struct PRODUCER_CONTEXT_TAG
+{
+    const QUEUE* queue_type;
+    void* queue;
+    size_t failures;
+    size_t full_count;
+} PRODUCER_CONTEXT;
+
+static int producer(void* arg)
+{
+    PRODUCER_CONTEXT* context = (PRODUCER_CONTEXT*)arg;
+    uintptr_t i;
+
+    for (i = 1; i <= ITEMS_PER_PRODUCER; i++)
+    {
+        int push_result;
+        while ((push_result = context->queue_type->push(context->queue, (void*)i)) == 1)
+        {
+            /*full, give the consumer a chance to run*/
+            context->full_count++;
+            ThreadAPI_Sleep(0);
+        }
+        if (push_result != 0)
+        {
+            context->failures++;
+        }
+    }
+
+    return 0;
+}
+
+static int run_test(const QUEUE* queue_type, size_t producer_count)
+{
+    int result;
+    void* queue = queue_type->create();
+
+    if (queue == NULL)
+    {
+        (void)printf("failed creating %s\r\n", queue_type->name);
+        result = __LINE__;
+    }
+    else
+    {
+        THREAD_HANDLE threads[MAX_PRODUCERS];
+        PRODUCER_CONTEXT contexts[MAX_PRODUCERS];
+        size_t started = 0;
+        size_t failures = 0;
+        size_t full_count = 0;
+        size_t expected_items = producer_count * ITEMS_PER_PRODUCER;
+        size_t popped = 0;
+        size_t total = 0;
+        double start;
+        double end;
+        size_t i;
+
+        start = perf_timer_get_seconds();
+        for (i = 0; i < producer_count; i++)
+        {
+            contexts[i].queue_type = queue_type;
+            contexts[i].queue = queue;
+            contexts[i].failures = 0;
+            contexts[i].full_count = 0;
+            if (ThreadAPI_Create(&threads[i], producer, &contexts[i]) != THREADAPI_OK)
+            {
+                break;
+            }
+            started++;
+        }
+
+        while (popped < started * ITEMS_PER_PRODUCER)
+        {
+            void* item = queue_type->pop(queue);
+            if (item == NULL)
+            {
+                ThreadAPI_Sleep(0);
+            }
+            else
+            {
+                total += (size_t)(uintptr_t)item;
+                popped++;
+            }
+        }
+        end = perf_timer_get_seconds();
+
+        for (i = 0; i < started; i++)
+        {
+            int thread_result;
+            (void)ThreadAPI_Join(threads[i], &thread_result);
+            failures += contexts[i].failures;
+            full_count += contexts[i].full_count;
+        }
+
+        if ((started != producer_count) || (failures != 0))
+        {
+            (void)printf("%s failed with %u producers\r\n", queue_type->name, (unsigned int)producer_count);
+            result = __LINE__;
+        }
+        else if (total != producer_count * ((size_t)ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2))
+        {
+            (void)printf("%s lost items\r\n", queue_type->name);
+            result = __LINE__;
+        }
+        else
+        {
+            (void)printf("%-24s %u producers: %8.2f ns per item, pushes that found it full: %u\r\n",
+                queue_type->name, (unsigned int)producer_count, PERF_NS_PER_OP(start, end, expected_items), (unsigned int)full_count);
+            result = 0;
+        }
+
+        queue_type->destroy(queue);
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int result = 0;
+    size_t i;
+    for (i = 0; (i < sizeof(producer_counts) / sizeof(producer_counts[0])) && (result == 0); i++)
+    {
+        size_t j;
+        for (j = 0; (j < sizeof(queues) / sizeof(queues[0])) && (result == 0); j++)
+        {
+            result = run_test(&queues[j], producer_counts[i]);
+        }
+    }
+    return result;
+}
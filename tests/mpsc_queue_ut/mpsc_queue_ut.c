@@ -0,0 +1,550 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#endif
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+#include "macro_utils.h"
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+#include "umocktypes_stdint.h"
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/gballoc.h"
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/mpsc_queue.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+TEST_DEFINE_ENUM_TYPE(MPSC_QUEUE_RESULT, MPSC_QUEUE_RESULT_VALUES);
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+#define TEST_ITEM_1 ((void*)0x4201)
+#define TEST_ITEM_2 ((void*)0x4202)
+#define TEST_ITEM_3 ((void*)0x4203)
+#define TEST_ITEM_4 ((void*)0x4204)
+#define TEST_ITEM_5 ((void*)0x4205)
+
+BEGIN_TEST_SUITE(mpsc_queue_unittests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types");
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+/* mpsc_queue_create */
+
+/* Tests_SRS_MPSC_QUEUE_11_001: [ mpsc_queue_create shall allocate an unbounded queue with an empty stub node as head and tail and return it. ]*/
+TEST_FUNCTION(mpsc_queue_create_succeeds)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    queue = mpsc_queue_create();
+
+    ///assert
+    ASSERT_IS_NOT_NULL(queue);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(mpsc_queue_pop(queue));
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_002: [ If any error occurs, mpsc_queue_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_the_queue_fails_mpsc_queue_create_fails)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    queue = mpsc_queue_create();
+
+    ///assert
+    ASSERT_IS_NULL(queue);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_002: [ If any error occurs, mpsc_queue_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_the_stub_node_fails_mpsc_queue_create_fails)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    queue = mpsc_queue_create();
+
+    ///assert
+    ASSERT_IS_NULL(queue);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* mpsc_queue_create_bounded */
+
+/* Tests_SRS_MPSC_QUEUE_11_003: [ If capacity is 0, or too big to be rounded up to a power of 2 and allocated, mpsc_queue_create_bounded shall fail and return NULL. ]*/
+TEST_FUNCTION(mpsc_queue_create_bounded_with_capacity_0_fails)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue;
+
+    ///act
+    queue = mpsc_queue_create_bounded(0);
+
+    ///assert
+    ASSERT_IS_NULL(queue);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_003: [ If capacity is 0, or too big to be rounded up to a power of 2 and allocated, mpsc_queue_create_bounded shall fail and return NULL. ]*/
+TEST_FUNCTION(mpsc_queue_create_bounded_with_SIZE_MAX_capacity_fails)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue;
+
+    ///act
+    queue = mpsc_queue_create_bounded(SIZE_MAX);
+
+    ///assert
+    ASSERT_IS_NULL(queue);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_004: [ mpsc_queue_create_bounded shall allocate a queue that holds capacity items, rounded up to a power of 2, in a ring of at least 2 cells, set the sequence of every cell to its index and return it. ]*/
+TEST_FUNCTION(mpsc_queue_create_bounded_succeeds)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    queue = mpsc_queue_create_bounded(4);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(queue);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(mpsc_queue_pop(queue));
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_004: [ mpsc_queue_create_bounded shall allocate a queue that holds capacity items, rounded up to a power of 2, in a ring of at least 2 cells, set the sequence of every cell to its index and return it. ]*/
+TEST_FUNCTION(mpsc_queue_create_bounded_rounds_the_capacity_up_to_a_power_of_2)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create_bounded(3);
+    umock_c_reset_all_calls();
+
+    ///act
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_OK, mpsc_queue_push(queue, TEST_ITEM_1));
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_OK, mpsc_queue_push(queue, TEST_ITEM_2));
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_OK, mpsc_queue_push(queue, TEST_ITEM_3));
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_OK, mpsc_queue_push(queue, TEST_ITEM_4));
+
+    ///assert
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_FULL, mpsc_queue_push(queue, TEST_ITEM_5));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_004: [ mpsc_queue_create_bounded shall allocate a queue that holds capacity items, rounded up to a power of 2, in a ring of at least 2 cells, set the sequence of every cell to its index and return it. ]*/
+/* Tests_SRS_MPSC_QUEUE_11_012: [ If the queue already holds capacity items (rounded up to a power of 2), mpsc_queue_push shall return MPSC_QUEUE_FULL. ]*/
+TEST_FUNCTION(mpsc_queue_create_bounded_with_capacity_1_holds_1_item)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create_bounded(1);
+    ASSERT_IS_NOT_NULL(queue);
+    umock_c_reset_all_calls();
+
+    ///act
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_OK, mpsc_queue_push(queue, TEST_ITEM_1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_FULL, mpsc_queue_push(queue, TEST_ITEM_2));
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_1, mpsc_queue_pop(queue));
+    ASSERT_IS_NULL(mpsc_queue_pop(queue));
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_OK, mpsc_queue_push(queue, TEST_ITEM_2));
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_FULL, mpsc_queue_push(queue, TEST_ITEM_3));
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_2, mpsc_queue_pop(queue));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_005: [ If any error occurs, mpsc_queue_create_bounded shall fail and return NULL. ]*/
+TEST_FUNCTION(when_gballoc_malloc_fails_mpsc_queue_create_bounded_fails)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    queue = mpsc_queue_create_bounded(4);
+
+    ///assert
+    ASSERT_IS_NULL(queue);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* mpsc_queue_destroy */
+
+/* Tests_SRS_MPSC_QUEUE_11_006: [ If queue is NULL, mpsc_queue_destroy shall return. ]*/
+TEST_FUNCTION(mpsc_queue_destroy_with_NULL_queue_returns)
+{
+    ///arrange
+
+    ///act
+    mpsc_queue_destroy(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_007: [ mpsc_queue_destroy shall free the nodes of an unbounded queue and the queue. The items left in the queue are not freed. ]*/
+TEST_FUNCTION(mpsc_queue_destroy_frees_the_nodes_of_an_unbounded_queue)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create();
+    (void)mpsc_queue_push(queue, TEST_ITEM_1);
+    (void)mpsc_queue_push(queue, TEST_ITEM_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(queue));
+
+    ///act
+    mpsc_queue_destroy(queue);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_007: [ mpsc_queue_destroy shall free the nodes of an unbounded queue and the queue. The items left in the queue are not freed. ]*/
+TEST_FUNCTION(mpsc_queue_destroy_frees_a_bounded_queue)
+{
+    ///arrange
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create_bounded(4);
+    (void)mpsc_queue_push(queue, TEST_ITEM_1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(queue));
+
+    ///act
+    mpsc_queue_destroy(queue);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* mpsc_queue_push */
+
+/* Tests_SRS_MPSC_QUEUE_11_008: [ If queue or item is NULL, mpsc_queue_push shall fail and return MPSC_QUEUE_ERROR. ]*/
+TEST_FUNCTION(mpsc_queue_push_with_NULL_queue_fails)
+{
+    ///arrange
+    MPSC_QUEUE_RESULT result;
+
+    ///act
+    result = mpsc_queue_push(NULL, TEST_ITEM_1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_008: [ If queue or item is NULL, mpsc_queue_push shall fail and return MPSC_QUEUE_ERROR. ]*/
+TEST_FUNCTION(mpsc_queue_push_with_NULL_item_fails)
+{
+    ///arrange
+    MPSC_QUEUE_RESULT result;
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create();
+    umock_c_reset_all_calls();
+
+    ///act
+    result = mpsc_queue_push(queue, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_009: [ For an unbounded queue, mpsc_queue_push shall allocate a node for item, swap it into the head of the queue with an atomic exchange, link the previous head to it and return MPSC_QUEUE_OK. ]*/
+TEST_FUNCTION(mpsc_queue_push_on_an_unbounded_queue_succeeds)
+{
+    ///arrange
+    MPSC_QUEUE_RESULT result;
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    ///act
+    result = mpsc_queue_push(queue, TEST_ITEM_1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_1, mpsc_queue_pop(queue));
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_010: [ If allocating the node fails, mpsc_queue_push shall fail and return MPSC_QUEUE_ERROR. ]*/
+TEST_FUNCTION(when_gballoc_malloc_fails_mpsc_queue_push_fails)
+{
+    ///arrange
+    MPSC_QUEUE_RESULT result;
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    result = mpsc_queue_push(queue, TEST_ITEM_1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(mpsc_queue_pop(queue));
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_011: [ For a bounded queue, mpsc_queue_push shall claim the cell at the enqueue position by moving the position with a compare and swap, store item in it, publish it by setting its sequence to the position plus 1 and return MPSC_QUEUE_OK. ]*/
+TEST_FUNCTION(mpsc_queue_push_on_a_bounded_queue_does_not_allocate)
+{
+    ///arrange
+    MPSC_QUEUE_RESULT result;
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create_bounded(4);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = mpsc_queue_push(queue, TEST_ITEM_1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_1, mpsc_queue_pop(queue));
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_012: [ If the queue already holds capacity items (rounded up to a power of 2), mpsc_queue_push shall return MPSC_QUEUE_FULL. ]*/
+TEST_FUNCTION(mpsc_queue_push_on_a_full_bounded_queue_returns_MPSC_QUEUE_FULL)
+{
+    ///arrange
+    MPSC_QUEUE_RESULT result;
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create_bounded(2);
+    (void)mpsc_queue_push(queue, TEST_ITEM_1);
+    (void)mpsc_queue_push(queue, TEST_ITEM_2);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = mpsc_queue_push(queue, TEST_ITEM_3);
+
+    ///assert
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_FULL, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_1, mpsc_queue_pop(queue));
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_2, mpsc_queue_pop(queue));
+    ASSERT_IS_NULL(mpsc_queue_pop(queue));
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* mpsc_queue_pop */
+
+/* Tests_SRS_MPSC_QUEUE_11_013: [ If queue is NULL, mpsc_queue_pop shall return NULL. ]*/
+TEST_FUNCTION(mpsc_queue_pop_with_NULL_queue_returns_NULL)
+{
+    ///arrange
+    void* result;
+
+    ///act
+    result = mpsc_queue_pop(NULL);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_014: [ For an unbounded queue, if the tail node has a next node, mpsc_queue_pop shall return the item of the next node, make the next node the tail and free the old tail. ]*/
+TEST_FUNCTION(mpsc_queue_pop_on_an_unbounded_queue_returns_the_items_in_order)
+{
+    ///arrange
+    void* result1;
+    void* result2;
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create();
+    (void)mpsc_queue_push(queue, TEST_ITEM_1);
+    (void)mpsc_queue_push(queue, TEST_ITEM_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    result1 = mpsc_queue_pop(queue);
+    result2 = mpsc_queue_pop(queue);
+
+    ///assert
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_1, result1);
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_2, result2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_015: [ For a bounded queue, if the cell at the dequeue position was published, mpsc_queue_pop shall return its item and set the sequence of the cell one lap ahead so producers can reuse it. ]*/
+TEST_FUNCTION(mpsc_queue_pop_on_a_bounded_queue_gives_the_cell_back_to_the_producers)
+{
+    ///arrange
+    void* result;
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create_bounded(2);
+    (void)mpsc_queue_push(queue, TEST_ITEM_1);
+    (void)mpsc_queue_push(queue, TEST_ITEM_2);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = mpsc_queue_pop(queue);
+
+    ///assert
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_1, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(MPSC_QUEUE_RESULT, MPSC_QUEUE_OK, mpsc_queue_push(queue, TEST_ITEM_3));
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_2, mpsc_queue_pop(queue));
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_3, mpsc_queue_pop(queue));
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_016: [ Otherwise mpsc_queue_pop shall return NULL. A push that has not linked its node or published its cell yet is not seen. ]*/
+TEST_FUNCTION(mpsc_queue_pop_on_an_empty_unbounded_queue_returns_NULL)
+{
+    ///arrange
+    void* result;
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create();
+    (void)mpsc_queue_push(queue, TEST_ITEM_1);
+    (void)mpsc_queue_pop(queue);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = mpsc_queue_pop(queue);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+/* Tests_SRS_MPSC_QUEUE_11_016: [ Otherwise mpsc_queue_pop shall return NULL. A push that has not linked its node or published its cell yet is not seen. ]*/
+TEST_FUNCTION(mpsc_queue_pop_on_an_empty_bounded_queue_returns_NULL)
+{
+    ///arrange
+    void* result;
+    MPSC_QUEUE_HANDLE queue = mpsc_queue_create_bounded(2);
+    (void)mpsc_queue_push(queue, TEST_ITEM_1);
+    (void)mpsc_queue_pop(queue);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = mpsc_queue_pop(queue);
+
+    ///assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    mpsc_queue_destroy(queue);
+}
+
+END_TEST_SUITE(mpsc_queue_unittests)
@@ -43,6 +43,14 @@ static void my_gballoc_free(void* s)
 #define VECTOR_back real_VECTOR_back
 #define VECTOR_find_if real_VECTOR_find_if
 #define VECTOR_size real_VECTOR_size
+#define VECTOR_create_sorted real_VECTOR_create_sorted
+#define VECTOR_insert real_VECTOR_insert
+#define VECTOR_insert_sorted real_VECTOR_insert_sorted
+#define VECTOR_pop_back real_VECTOR_pop_back
+#define VECTOR_lower_bound real_VECTOR_lower_bound
+#define VECTOR_capacity real_VECTOR_capacity
+#define VECTOR_reserve real_VECTOR_reserve
+#define VECTOR_shrink_to_fit real_VECTOR_shrink_to_fit
 #include "../src/vector.c"
 #undef VECTOR_create
 #undef VECTOR_move
@@ -55,6 +63,14 @@ static void my_gballoc_free(void* s)
 #undef VECTOR_back
 #undef VECTOR_find_if
 #undef VECTOR_size
+#undef VECTOR_create_sorted
+#undef VECTOR_insert
+#undef VECTOR_insert_sorted
+#undef VECTOR_pop_back
+#undef VECTOR_lower_bound
+#undef VECTOR_capacity
+#undef VECTOR_reserve
+#undef VECTOR_shrink_to_fit
 #undef VECTOR_H
 #undef GBALLOC_H
 #undef CRT_ABSTRACTIONS_H
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef PERF_TIMER_H
+#define PERF_TIMER_H
+
+/*high resolution wall clock used by the performance tests. Not part of the library.*/
+
+#ifdef _WIN32
+#include <windows.h>
+
+static double perf_timer_get_seconds(void)
+{
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    (void)QueryPerformanceFrequency(&frequency);
+    (void)QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
+#else
+#include <time.h>
+
+static double perf_timer_get_seconds(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+#endif
+
+/*nanoseconds per operation, given a start/end time in seconds and the number of operations*/
+#define PERF_NS_PER_OP(start, end, operations) (((end) - (start)) * 1000000000.0 / (double)(operations))
+
+#endif /* PERF_TIMER_H */
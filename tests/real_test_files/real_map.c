@@ -4,11 +4,14 @@
 #define GBALLOC_H
 
 #define Map_Create          real_Map_Create
+#define Map_CreateWithCapacity real_Map_CreateWithCapacity
+#define Map_CreateWithStringArena real_Map_CreateWithStringArena
 #define Map_Destroy         real_Map_Destroy
 #define Map_Clone           real_Map_Clone
 #define Map_Add             real_Map_Add
 #define Map_AddOrUpdate     real_Map_AddOrUpdate
 #define Map_Delete          real_Map_Delete
+#define Map_Reserve         real_Map_Reserve
 #define Map_ContainsKey     real_Map_ContainsKey
 #define Map_ContainsValue   real_Map_ContainsValue
 #define Map_GetValueFromKey real_Map_GetValueFromKey
@@ -6,11 +6,14 @@
 
 #define REGISTER_MAP_GLOBAL_MOCK_HOOK \
     REGISTER_GLOBAL_MOCK_HOOK(Map_Create, real_Map_Create); \
+    REGISTER_GLOBAL_MOCK_HOOK(Map_CreateWithCapacity, real_Map_CreateWithCapacity); \
+    REGISTER_GLOBAL_MOCK_HOOK(Map_CreateWithStringArena, real_Map_CreateWithStringArena); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_Destroy, real_Map_Destroy); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_Clone, real_Map_Clone); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_Add, real_Map_Add); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_AddOrUpdate, real_Map_AddOrUpdate); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_Delete, real_Map_Delete); \
+    REGISTER_GLOBAL_MOCK_HOOK(Map_Reserve, real_Map_Reserve); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_ContainsKey, real_Map_ContainsKey); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_ContainsValue, real_Map_ContainsValue); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_GetValueFromKey, real_Map_GetValueFromKey); \
@@ -25,11 +28,14 @@ extern "C"
 #include <stddef.h>
 #endif
     extern MAP_HANDLE real_Map_Create(MAP_FILTER_CALLBACK mapFilterFunc);
+    extern MAP_HANDLE real_Map_CreateWithCapacity(MAP_FILTER_CALLBACK mapFilterFunc, size_t capacity);
+    extern MAP_HANDLE real_Map_CreateWithStringArena(MAP_FILTER_CALLBACK mapFilterFunc, size_t capacity, size_t arenaBlockSize);
     extern void real_Map_Destroy(MAP_HANDLE handle);
     extern MAP_HANDLE real_Map_Clone(MAP_HANDLE handle);
     extern MAP_RESULT real_Map_Add(MAP_HANDLE handle, const char* key, const char* value);
     extern MAP_RESULT real_Map_AddOrUpdate(MAP_HANDLE handle, const char* key, const char* value);
     extern MAP_RESULT real_Map_Delete(MAP_HANDLE handle, const char* key);
+    extern MAP_RESULT real_Map_Reserve(MAP_HANDLE handle, size_t capacity);
     extern MAP_RESULT real_Map_ContainsKey(MAP_HANDLE handle, const char* key, bool* keyExists);
     extern MAP_RESULT real_Map_ContainsValue(MAP_HANDLE handle, const char* value, bool* valueExists);
     extern const char* real_Map_GetValueFromKey(MAP_HANDLE handle, const char* key);
@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #define singlylinkedlist_create real_singlylinkedlist_create
+#define singlylinkedlist_create_with_node_pool real_singlylinkedlist_create_with_node_pool
 #define singlylinkedlist_destroy real_singlylinkedlist_destroy
 #define singlylinkedlist_add real_singlylinkedlist_add
 #define singlylinkedlist_add_head real_singlylinkedlist_add_head
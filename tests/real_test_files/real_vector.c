@@ -12,6 +12,14 @@
 #define VECTOR_back real_VECTOR_back
 #define VECTOR_find_if real_VECTOR_find_if
 #define VECTOR_size real_VECTOR_size
+#define VECTOR_create_sorted real_VECTOR_create_sorted
+#define VECTOR_insert real_VECTOR_insert
+#define VECTOR_insert_sorted real_VECTOR_insert_sorted
+#define VECTOR_pop_back real_VECTOR_pop_back
+#define VECTOR_lower_bound real_VECTOR_lower_bound
+#define VECTOR_capacity real_VECTOR_capacity
+#define VECTOR_reserve real_VECTOR_reserve
+#define VECTOR_shrink_to_fit real_VECTOR_shrink_to_fit
 
 #define GBALLOC_H
 
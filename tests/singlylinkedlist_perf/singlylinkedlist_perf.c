@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/singlylinkedlist.h"
+#include "perf_timer.h"
+
+/*uses a list as a queue the way the pending sends of uws_client and wsio do: add at the tail, remove the head.
+Compares a list from singlylinkedlist_create, that allocates and frees a node for every item, with a list from
+singlylinkedlist_create_with_node_pool. The allocations are counted when the library is built with memory_trace*/
+
+#define OPERATIONS_PER_TEST 2000000
+
+static const size_t queue_depths[] = { 1, 16, 256 };
+
+/*keeps the compiler from dropping the loops*/
+static volatile size_t sink;
+
+static int run_rounds(SINGLYLINKEDLIST_HANDLE list, const size_t* values, size_t depth, size_t rounds)
+{
+    int result = 0;
+    size_t round;
+
+    for (round = 0; (round < rounds) && (result == 0); round++)
+    {
+        size_t i;
+        for (i = 0; i < depth; i++)
+        {
+            if (singlylinkedlist_add(list, &values[i]) == NULL)
+            {
+                (void)printf("singlylinkedlist_add failed\r\n");
+                result = __LINE__;
+                break;
+            }
+        }
+
+        for (i = 0; (i < depth) && (result == 0); i++)
+        {
+            LIST_ITEM_HANDLE head = singlylinkedlist_get_head_item(list);
+            if (head == NULL)
+            {
+                (void)printf("the list is empty too early\r\n");
+                result = __LINE__;
+            }
+            else
+            {
+                sink += *(const size_t*)singlylinkedlist_item_get_value(head);
+                if (singlylinkedlist_remove(list, head) != 0)
+                {
+                    (void)printf("singlylinkedlist_remove failed\r\n");
+                    result = __LINE__;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+static int run_queue_test(const char* name, SINGLYLINKEDLIST_HANDLE list, size_t depth, double* ns_per_item, size_t* allocations)
+{
+    int result;
+    size_t* values = (size_t*)malloc(depth * sizeof(size_t));
+
+    if ((values == NULL) || (list == NULL))
+    {
+        (void)printf("failed allocating test data for %s\r\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        size_t rounds = OPERATIONS_PER_TEST / depth;
+        size_t i;
+
+        for (i = 0; i < depth; i++)
+        {
+            values[i] = i;
+        }
+
+        /*one round first, so that a pooled list has its nodes before the measurement starts*/
+        result = run_rounds(list, values, depth, 1);
+        if (result == 0)
+        {
+            size_t allocations_before = gballoc_getAllocationCount();
+            double start = perf_timer_get_seconds();
+            double end;
+
+            result = run_rounds(list, values, depth, rounds);
+            end = perf_timer_get_seconds();
+
+            *ns_per_item = PERF_NS_PER_OP(start, end, rounds * depth);
+            *allocations = (allocations_before == SIZE_MAX) ? SIZE_MAX : gballoc_getAllocationCount() - allocations_before;
+        }
+    }
+
+    singlylinkedlist_destroy(list);
+    free(values);
+    return result;
+}
+
+static int run_depth_test(size_t depth)
+{
+    int result;
+    double plain_ns = 0;
+    double pooled_ns = 0;
+    size_t plain_allocations = 0;
+    size_t pooled_allocations = 0;
+
+    result = run_queue_test("singlylinkedlist_create", singlylinkedlist_create(), depth, &plain_ns, &plain_allocations);
+    if (result == 0)
+    {
+        result = run_queue_test("singlylinkedlist_create_with_node_pool", singlylinkedlist_create_with_node_pool(depth), depth, &pooled_ns, &pooled_allocations);
+    }
+
+    if (result == 0)
+    {
+        if (plain_allocations == SIZE_MAX)
+        {
+            (void)printf("queue depth %3u: add+remove %8.2f ns, with node pool %8.2f ns (build with memory_trace to count allocations)\r\n",
+                (unsigned int)depth, plain_ns, pooled_ns);
+        }
+        else if (pooled_allocations != 0)
+        {
+            (void)printf("queue depth %3u: the list with a node pool allocated %u times\r\n",
+                (unsigned int)depth, (unsigned int)pooled_allocations);
+            result = __LINE__;
+        }
+        else
+        {
+            (void)printf("queue depth %3u: add+remove %8.2f ns, %8u allocations, with node pool %8.2f ns, %u allocations\r\n",
+                (unsigned int)depth, plain_ns, (unsigned int)plain_allocations, pooled_ns, (unsigned int)pooled_allocations);
+        }
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int result;
+
+    if (gballoc_init() != 0)
+    {
+        (void)printf("gballoc_init failed\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t i;
+
+        result = 0;
+        for (i = 0; (i < sizeof(queue_depths) / sizeof(queue_depths[0])) && (result == 0); i++)
+        {
+            result = run_depth_test(queue_depths[i]);
+        }
+
+        gballoc_deinit();
+    }
+
+    return result;
+}
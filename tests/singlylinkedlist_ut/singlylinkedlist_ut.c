@@ -1345,4 +1345,241 @@ TEST_FUNCTION(singlylinkedlist_add_head_fails_when_malloc_fails)
     singlylinkedlist_destroy(list);
 }
 
+/* singlylinkedlist_create_with_node_pool */
+
+/* Tests_SRS_LIST_11_001: [ singlylinkedlist_create_with_node_pool shall create a new list that keeps up to max_pooled_nodes removed nodes for reuse and return a non-NULL handle on success. ] */
+TEST_FUNCTION(singlylinkedlist_create_with_node_pool_succeeds)
+{
+    // arrange
+    SINGLYLINKEDLIST_HANDLE result;
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    // act
+    result = singlylinkedlist_create_with_node_pool(4);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(singlylinkedlist_get_head_item(result));
+
+    // cleanup
+    singlylinkedlist_destroy(result);
+}
+
+/* Tests_SRS_LIST_11_002: [ If any error occurs, singlylinkedlist_create_with_node_pool shall return NULL. ] */
+TEST_FUNCTION(when_underlying_malloc_fails_singlylinkedlist_create_with_node_pool_fails)
+{
+    // arrange
+    SINGLYLINKEDLIST_HANDLE result;
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn((void*)NULL);
+
+    // act
+    result = singlylinkedlist_create_with_node_pool(4);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LIST_11_006: [ singlylinkedlist_remove and singlylinkedlist_remove_if shall keep the removed node for reuse when the list keeps fewer than max_pooled_nodes nodes. ] */
+TEST_FUNCTION(singlylinkedlist_remove_keeps_the_node_of_a_list_with_a_node_pool)
+{
+    // arrange
+    int result;
+    int x = 42;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create_with_node_pool(4);
+    LIST_ITEM_HANDLE item = singlylinkedlist_add(list, &x);
+    umock_c_reset_all_calls();
+
+    // act
+    result = singlylinkedlist_remove(list, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(singlylinkedlist_get_head_item(list));
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_11_004: [ singlylinkedlist_add and singlylinkedlist_add_head shall take the node from the nodes kept by the list when there is one. ] */
+TEST_FUNCTION(singlylinkedlist_add_reuses_a_removed_node)
+{
+    // arrange
+    int x1 = 42;
+    int x2 = 43;
+    LIST_ITEM_HANDLE result;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create_with_node_pool(4);
+    LIST_ITEM_HANDLE item = singlylinkedlist_add(list, &x1);
+    (void)singlylinkedlist_remove(list, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = singlylinkedlist_add(list, &x2);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, item, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, result, singlylinkedlist_get_head_item(list));
+    ASSERT_ARE_EQUAL(int, x2, *(const int*)singlylinkedlist_item_get_value(result));
+    ASSERT_IS_NULL(singlylinkedlist_get_next_item(result));
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_11_004: [ singlylinkedlist_add and singlylinkedlist_add_head shall take the node from the nodes kept by the list when there is one. ] */
+TEST_FUNCTION(singlylinkedlist_add_head_reuses_a_removed_node)
+{
+    // arrange
+    int x1 = 42;
+    int x2 = 43;
+    LIST_ITEM_HANDLE result;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create_with_node_pool(4);
+    LIST_ITEM_HANDLE item = singlylinkedlist_add(list, &x1);
+    (void)singlylinkedlist_add(list, &x1);
+    (void)singlylinkedlist_remove(list, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = singlylinkedlist_add_head(list, &x2);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, item, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, result, singlylinkedlist_get_head_item(list));
+    ASSERT_ARE_EQUAL(int, x2, *(const int*)singlylinkedlist_item_get_value(result));
+    ASSERT_IS_NOT_NULL(singlylinkedlist_get_next_item(result));
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_11_005: [ Otherwise singlylinkedlist_add and singlylinkedlist_add_head shall allocate a new node. ] */
+TEST_FUNCTION(singlylinkedlist_add_allocates_when_no_node_is_kept)
+{
+    // arrange
+    int x = 42;
+    LIST_ITEM_HANDLE result;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create_with_node_pool(4);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    // act
+    result = singlylinkedlist_add(list, &x);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_11_007: [ Otherwise singlylinkedlist_remove and singlylinkedlist_remove_if shall free the removed node. ] */
+TEST_FUNCTION(singlylinkedlist_remove_frees_the_node_when_the_node_pool_is_full)
+{
+    // arrange
+    int x = 42;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create_with_node_pool(1);
+    LIST_ITEM_HANDLE item1 = singlylinkedlist_add(list, &x);
+    LIST_ITEM_HANDLE item2 = singlylinkedlist_add(list, &x);
+    (void)singlylinkedlist_remove(list, item1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(item2));
+
+    // act
+    (void)singlylinkedlist_remove(list, item2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_11_003: [ singlylinkedlist_create shall create a list that does not keep removed nodes, as singlylinkedlist_create_with_node_pool with max_pooled_nodes 0 does. ] */
+TEST_FUNCTION(singlylinkedlist_remove_frees_the_node_of_a_list_without_a_node_pool)
+{
+    // arrange
+    int x = 42;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+    LIST_ITEM_HANDLE item = singlylinkedlist_add(list, &x);
+    (void)singlylinkedlist_remove(list, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    // act
+    (void)singlylinkedlist_add(list, &x);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_11_006: [ singlylinkedlist_remove and singlylinkedlist_remove_if shall keep the removed node for reuse when the list keeps fewer than max_pooled_nodes nodes. ] */
+/* Tests_SRS_LIST_11_007: [ Otherwise singlylinkedlist_remove and singlylinkedlist_remove_if shall free the removed node. ] */
+TEST_FUNCTION(singlylinkedlist_remove_if_keeps_the_nodes_that_fit_in_the_node_pool)
+{
+    // arrange
+    int result;
+    int values[3] = { 3, 5, 7 };
+    REMOVE_IF_PROFILE profile;
+    SINGLYLINKEDLIST_HANDLE list;
+
+    profile.count = 3;
+    profile.items_to_remove[0] = values[0];
+    profile.items_to_remove[1] = values[1];
+    profile.items_to_remove[2] = values[2];
+    profile.stop_at_item_value = 1000000;
+
+    list = singlylinkedlist_create_with_node_pool(2);
+    (void)singlylinkedlist_add(list, &values[0]);
+    (void)singlylinkedlist_add(list, &values[1]);
+    (void)singlylinkedlist_add(list, &values[2]);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    // act
+    result = singlylinkedlist_remove_if(list, removeif_condition_function, &profile);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(singlylinkedlist_get_head_item(list));
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_11_008: [ singlylinkedlist_destroy shall also free the nodes kept by the list for reuse. ] */
+TEST_FUNCTION(singlylinkedlist_destroy_frees_the_nodes_of_the_node_pool)
+{
+    // arrange
+    int x = 42;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create_with_node_pool(4);
+    LIST_ITEM_HANDLE item1 = singlylinkedlist_add(list, &x);
+    LIST_ITEM_HANDLE item2 = singlylinkedlist_add(list, &x);
+    (void)singlylinkedlist_remove(list, item1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(item2));
+    STRICT_EXPECTED_CALL(gballoc_free(item1));
+    STRICT_EXPECTED_CALL(gballoc_free(list));
+
+    // act
+    singlylinkedlist_destroy(list);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
 END_TEST_SUITE(singlylinkedlist_unittests)
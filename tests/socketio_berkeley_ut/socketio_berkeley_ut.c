@@ -2,29 +2,275 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #ifdef __cplusplus
+#include <cstdlib>
 #include <cstdint>
+#include <cstring>
+#include <cerrno>
 #else
+#include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
+#include <errno.h>
 #endif
 
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netdb.h>
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+#include "macro_utils.h"
 #include "testrunnerswitcher.h"
+#include "umock_c.h"
+#include "umocktypes_stdint.h"
 
 #define ENABLE_MOCKS
 
 #include "azure_c_shared_utility/singlylinkedlist.h"
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/optionhandler.h"
+#include "azure_c_shared_utility/constbuffer_array.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    MOCKABLE_FUNCTION(, ssize_t, writev, int, fd, const struct iovec*, iov, int, iovcnt);
+    MOCKABLE_FUNCTION(, ssize_t, send, int, sockfd, const void*, buf, size_t, len, int, flags);
+    MOCKABLE_FUNCTION(, ssize_t, recv, int, sockfd, void*, buf, size_t, len, int, flags);
+    MOCKABLE_FUNCTION(, int, close, int, fd);
+#ifdef __cplusplus
+}
+#endif
 
 #undef ENABLE_MOCKS
 
 #include "azure_c_shared_utility/socketio.h"
 
-#include <sys/types.h>
-#include <sys/socket.h>
-#include <netdb.h>
-
 TEST_MUTEX_HANDLE test_serialize_mutex;
 
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+#define TEST_PORT 443
+#define TEST_MANY_BUFFER_COUNT 1100
+
+static int test_socket = 42;
+static const SINGLYLINKEDLIST_HANDLE TEST_SINGLYLINKEDLIST_HANDLE = (SINGLYLINKEDLIST_HANDLE)0x4242;
+static const CONSTBUFFER_ARRAY_HANDLE TEST_CONSTBUFFER_ARRAY_HANDLE = (CONSTBUFFER_ARRAY_HANDLE)0x4243;
+
+/*the pending list is an array, a LIST_ITEM_HANDLE points at the slot of its item*/
+static const void* test_list_items[4];
+static size_t test_list_item_count;
+
+static SINGLYLINKEDLIST_HANDLE my_singlylinkedlist_create(void)
+{
+    test_list_item_count = 0;
+    return TEST_SINGLYLINKEDLIST_HANDLE;
+}
+
+static LIST_ITEM_HANDLE my_singlylinkedlist_add(SINGLYLINKEDLIST_HANDLE list, const void* item)
+{
+    LIST_ITEM_HANDLE result;
+    (void)list;
+    if (test_list_item_count == sizeof(test_list_items) / sizeof(test_list_items[0]))
+    {
+        result = NULL;
+    }
+    else
+    {
+        test_list_items[test_list_item_count] = item;
+        result = (LIST_ITEM_HANDLE)&test_list_items[test_list_item_count];
+        test_list_item_count++;
+    }
+    return result;
+}
+
+static LIST_ITEM_HANDLE my_singlylinkedlist_get_head_item(SINGLYLINKEDLIST_HANDLE list)
+{
+    (void)list;
+    return (test_list_item_count == 0) ? NULL : (LIST_ITEM_HANDLE)&test_list_items[0];
+}
+
+static const void* my_singlylinkedlist_item_get_value(LIST_ITEM_HANDLE item_handle)
+{
+    return *(const void**)item_handle;
+}
+
+static int my_singlylinkedlist_remove(SINGLYLINKEDLIST_HANDLE list, LIST_ITEM_HANDLE item_handle)
+{
+    size_t index = (const void**)item_handle - test_list_items;
+    (void)list;
+    (void)memmove(&test_list_items[index], &test_list_items[index + 1], (test_list_item_count - index - 1) * sizeof(test_list_items[0]));
+    test_list_item_count--;
+    return 0;
+}
+
+/*the array is "abc", "defg", "hi" unless a test points test_buffers somewhere else*/
+static const unsigned char test_bytes[] = "abcdefghi";
+static CONSTBUFFER three_buffers[3];
+static CONSTBUFFER many_buffers[TEST_MANY_BUFFER_COUNT];
+static unsigned char many_bytes[TEST_MANY_BUFFER_COUNT];
+static const CONSTBUFFER* test_buffers;
+static uint32_t test_buffer_count;
+
+static int my_constbuffer_array_get_buffer_count(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle, uint32_t* buffer_count)
+{
+    (void)constbuffer_array_handle;
+    *buffer_count = test_buffer_count;
+    return 0;
+}
+
+static int my_constbuffer_array_get_all_buffers_size(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle, uint32_t* all_buffers_size)
+{
+    uint32_t i;
+    (void)constbuffer_array_handle;
+    *all_buffers_size = 0;
+    for (i = 0; i < test_buffer_count; i++)
+    {
+        *all_buffers_size += (uint32_t)test_buffers[i].size;
+    }
+    return 0;
+}
+
+static const CONSTBUFFER* my_constbuffer_array_get_buffer_content(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle, uint32_t buffer_index)
+{
+    (void)constbuffer_array_handle;
+    return &test_buffers[buffer_index];
+}
+
+/*writev fails with writev_errno when it is not 0, takes writev_result bytes when it is not negative and all of them
+otherwise*/
+static int writev_errno;
+static ssize_t writev_result;
+static int writev_iovcnt;
+
+static ssize_t my_writev(int fd, const struct iovec* iov, int iovcnt)
+{
+    ssize_t result;
+    (void)fd;
+    writev_iovcnt = iovcnt;
+    if (writev_errno != 0)
+    {
+        errno = writev_errno;
+        result = -1;
+    }
+    else if (writev_result >= 0)
+    {
+        result = writev_result;
+    }
+    else
+    {
+        int i;
+        result = 0;
+        for (i = 0; i < iovcnt; i++)
+        {
+            result += (ssize_t)iov[i].iov_len;
+        }
+    }
+    return result;
+}
+
+/*send takes everything and keeps a copy of what it took*/
+static unsigned char sent_bytes[TEST_MANY_BUFFER_COUNT];
+static size_t sent_size;
+
+static ssize_t my_send(int sockfd, const void* buf, size_t len, int flags)
+{
+    (void)sockfd;
+    (void)flags;
+    (void)memcpy(sent_bytes + sent_size, buf, len);
+    sent_size += len;
+    return (ssize_t)len;
+}
+
+static ssize_t my_recv(int sockfd, void* buf, size_t len, int flags)
+{
+    (void)sockfd;
+    (void)buf;
+    (void)len;
+    (void)flags;
+    errno = EAGAIN;
+    return -1;
+}
+
+static size_t on_send_complete_call_count;
+static IO_SEND_RESULT on_send_complete_result;
+
+static void test_on_send_complete(void* context, IO_SEND_RESULT send_result)
+{
+    (void)context;
+    on_send_complete_call_count++;
+    on_send_complete_result = send_result;
+}
+
+static CONCRETE_IO_HANDLE create_open_socketio(void)
+{
+    SOCKETIO_CONFIG config;
+    CONCRETE_IO_HANDLE result;
+    config.hostname = NULL;
+    config.port = TEST_PORT;
+    config.accepted_socket = &test_socket;
+
+    result = socketio_create(&config);
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(int, 0, socketio_open(result, NULL, NULL, NULL, NULL, NULL, NULL));
+    umock_c_reset_all_calls();
+    return result;
+}
+
+static int send_vectored(CONCRETE_IO_HANDLE socket_io)
+{
+    return socketio_get_interface_description()->concrete_io_send_vectored(socket_io, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, NULL);
+}
+
+static void setup_send_vectored_up_to_writev(uint32_t buffer_count)
+{
+    uint32_t i;
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(singlylinkedlist_get_head_item(TEST_SINGLYLINKEDLIST_HANDLE));
+    for (i = 0; i < buffer_count; i++)
+    {
+        STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, i));
+    }
+    STRICT_EXPECTED_CALL(writev(test_socket, IGNORED_PTR_ARG, (int)buffer_count));
+}
+
+static void setup_queue_bytes(size_t size, uint32_t buffer_count)
+{
+    uint32_t i;
+    STRICT_EXPECTED_CALL(gballoc_malloc(size));
+    for (i = 0; i < buffer_count; i++)
+    {
+        STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, i));
+    }
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(singlylinkedlist_add(TEST_SINGLYLINKEDLIST_HANDLE, IGNORED_PTR_ARG));
+}
+
+/*sends the pending IOs with socketio_dowork and checks they were the expected bytes*/
+static void assert_dowork_sends(CONCRETE_IO_HANDLE socket_io, const unsigned char* expected_bytes, size_t expected_size)
+{
+    sent_size = 0;
+    socketio_dowork(socket_io);
+    ASSERT_ARE_EQUAL(size_t, expected_size, sent_size);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(expected_bytes, sent_bytes, expected_size));
+    ASSERT_ARE_EQUAL(size_t, 0, test_list_item_count);
+}
+
 BEGIN_TEST_SUITE(socketio_berkeley_unittests)
 
 #if 0
@@ -662,5 +908,434 @@ TEST_FUNCTION(socketio_dowork_socket_io_NULL_fails)
 
 #endif
 
-END_TEST_SUITE(socketio_berkeley_unittests)
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+    size_t type_size;
+
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types");
+
+    // Unnatural type_size variable exists to avoid "conditional expression is constant" warning
+    type_size = sizeof(ssize_t);
+    if (type_size == sizeof(int32_t))
+    {
+        REGISTER_UMOCK_ALIAS_TYPE(ssize_t, int32_t);
+    }
+    else
+    {
+        REGISTER_UMOCK_ALIAS_TYPE(ssize_t, int64_t);
+    }
+
+    REGISTER_UMOCK_ALIAS_TYPE(SINGLYLINKEDLIST_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(LIST_ITEM_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CONSTBUFFER_ARRAY_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const CONSTBUFFER*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const struct iovec*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(uint32_t*, void*);
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+
+    REGISTER_GLOBAL_MOCK_HOOK(singlylinkedlist_create, my_singlylinkedlist_create);
+    REGISTER_GLOBAL_MOCK_HOOK(singlylinkedlist_add, my_singlylinkedlist_add);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(singlylinkedlist_add, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(singlylinkedlist_get_head_item, my_singlylinkedlist_get_head_item);
+    REGISTER_GLOBAL_MOCK_HOOK(singlylinkedlist_item_get_value, my_singlylinkedlist_item_get_value);
+    REGISTER_GLOBAL_MOCK_HOOK(singlylinkedlist_remove, my_singlylinkedlist_remove);
+
+    REGISTER_GLOBAL_MOCK_HOOK(constbuffer_array_get_buffer_count, my_constbuffer_array_get_buffer_count);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(constbuffer_array_get_buffer_count, 1);
+    REGISTER_GLOBAL_MOCK_HOOK(constbuffer_array_get_all_buffers_size, my_constbuffer_array_get_all_buffers_size);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(constbuffer_array_get_all_buffers_size, 1);
+    REGISTER_GLOBAL_MOCK_HOOK(constbuffer_array_get_buffer_content, my_constbuffer_array_get_buffer_content);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(constbuffer_array_get_buffer_content, NULL);
+
+    REGISTER_GLOBAL_MOCK_HOOK(writev, my_writev);
+    REGISTER_GLOBAL_MOCK_HOOK(send, my_send);
+    REGISTER_GLOBAL_MOCK_HOOK(recv, my_recv);
+    REGISTER_GLOBAL_MOCK_RETURN(close, 0);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
 
+    three_buffers[0].buffer = test_bytes;
+    three_buffers[0].size = 3;
+    three_buffers[1].buffer = test_bytes + 3;
+    three_buffers[1].size = 4;
+    three_buffers[2].buffer = test_bytes + 7;
+    three_buffers[2].size = 2;
+    test_buffers = three_buffers;
+    test_buffer_count = 3;
+
+    writev_errno = 0;
+    writev_result = -1;
+    writev_iovcnt = 0;
+    sent_size = 0;
+    on_send_complete_call_count = 0;
+    on_send_complete_result = IO_SEND_CANCELLED;
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+/* socketio_send_vectored */
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_001: [ If socket_io or buffers is NULL, or buffers holds no bytes, socketio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(socketio_send_vectored_with_NULL_socket_io_fails)
+{
+    ///arrange
+    int result;
+
+    ///act
+    result = send_vectored(NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, on_send_complete_call_count);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_001: [ If socket_io or buffers is NULL, or buffers holds no bytes, socketio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(socketio_send_vectored_with_NULL_buffers_fails)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    ///act
+    result = socketio_get_interface_description()->concrete_io_send_vectored(socket_io, NULL, test_on_send_complete, NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_002: [ If constbuffer_array_get_buffer_count or constbuffer_array_get_all_buffers_size fails, socketio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_constbuffer_array_get_buffer_count_fails_socketio_send_vectored_fails)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG))
+        .SetReturn(1);
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, test_list_item_count);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_002: [ If constbuffer_array_get_buffer_count or constbuffer_array_get_all_buffers_size fails, socketio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_constbuffer_array_get_all_buffers_size_fails_socketio_send_vectored_fails)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG))
+        .SetReturn(1);
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, test_list_item_count);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_005: [ Otherwise socketio_send_vectored shall send the content of the first IOV_MAX buffers with one writev. ]*/
+/* Tests_SRS_SOCKETIO_BERKELEY_11_006: [ If writev takes all the bytes of buffers, socketio_send_vectored shall call on_send_complete with IO_SEND_OK and return 0. ]*/
+TEST_FUNCTION(socketio_send_vectored_sends_all_the_buffers_with_one_writev)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    setup_send_vectored_up_to_writev(3);
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 3, writev_iovcnt);
+    ASSERT_ARE_EQUAL(size_t, 1, on_send_complete_call_count);
+    ASSERT_ARE_EQUAL(int, (int)IO_SEND_OK, (int)on_send_complete_result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_list_item_count);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_005: [ Otherwise socketio_send_vectored shall send the content of the first IOV_MAX buffers with one writev. ]*/
+/* Tests_SRS_SOCKETIO_BERKELEY_11_007: [ If writev takes only part of the bytes of buffers, which it does when there are more than IOV_MAX buffers, or fails with EAGAIN, socketio_send_vectored shall copy the bytes it did not take in one block, queue it and return 0. ]*/
+TEST_FUNCTION(socketio_send_vectored_with_more_than_IOV_MAX_buffers_queues_the_rest)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+    uint32_t i;
+
+    for (i = 0; i < TEST_MANY_BUFFER_COUNT; i++)
+    {
+        many_bytes[i] = (unsigned char)i;
+        many_buffers[i].buffer = &many_bytes[i];
+        many_buffers[i].size = 1;
+    }
+    test_buffers = many_buffers;
+    test_buffer_count = TEST_MANY_BUFFER_COUNT;
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_TRUE(writev_iovcnt > 0);
+    ASSERT_IS_TRUE(writev_iovcnt < TEST_MANY_BUFFER_COUNT);
+    ASSERT_ARE_EQUAL(size_t, 0, on_send_complete_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, test_list_item_count);
+
+    assert_dowork_sends(socket_io, many_bytes + writev_iovcnt, TEST_MANY_BUFFER_COUNT - writev_iovcnt);
+    ASSERT_ARE_EQUAL(size_t, 1, on_send_complete_call_count);
+    ASSERT_ARE_EQUAL(int, (int)IO_SEND_OK, (int)on_send_complete_result);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_007: [ If writev takes only part of the bytes of buffers, which it does when there are more than IOV_MAX buffers, or fails with EAGAIN, socketio_send_vectored shall copy the bytes it did not take in one block, queue it and return 0. ]*/
+TEST_FUNCTION(when_writev_takes_part_of_the_bytes_socketio_send_vectored_queues_the_rest)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    writev_result = 4;
+    setup_send_vectored_up_to_writev(3);
+    setup_queue_bytes(5, 3);
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, on_send_complete_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, test_list_item_count);
+
+    assert_dowork_sends(socket_io, (const unsigned char*)"efghi", 5);
+    ASSERT_ARE_EQUAL(size_t, 1, on_send_complete_call_count);
+    ASSERT_ARE_EQUAL(int, (int)IO_SEND_OK, (int)on_send_complete_result);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_007: [ If writev takes only part of the bytes of buffers, which it does when there are more than IOV_MAX buffers, or fails with EAGAIN, socketio_send_vectored shall copy the bytes it did not take in one block, queue it and return 0. ]*/
+TEST_FUNCTION(when_writev_fails_with_EAGAIN_socketio_send_vectored_queues_all_the_bytes)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    writev_errno = EAGAIN;
+    setup_send_vectored_up_to_writev(3);
+    setup_queue_bytes(9, 3);
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, on_send_complete_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, test_list_item_count);
+
+    assert_dowork_sends(socket_io, test_bytes, 9);
+    ASSERT_ARE_EQUAL(size_t, 1, on_send_complete_call_count);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_004: [ If IOs are pending already, socketio_send_vectored shall copy the content of all the buffers in one block, queue it behind them without calling writev and return 0. ]*/
+TEST_FUNCTION(when_IOs_are_pending_socketio_send_vectored_queues_the_buffers_without_writev)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    writev_result = 4;
+    ASSERT_ARE_EQUAL(int, 0, send_vectored(socket_io));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(singlylinkedlist_get_head_item(TEST_SINGLYLINKEDLIST_HANDLE));
+    setup_queue_bytes(9, 3);
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 2, test_list_item_count);
+
+    assert_dowork_sends(socket_io, (const unsigned char*)"efghiabcdefghi", 14);
+    ASSERT_ARE_EQUAL(size_t, 2, on_send_complete_call_count);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_008: [ If writev fails with any other error, socketio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_writev_fails_socketio_send_vectored_fails)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    writev_errno = ECONNRESET;
+    setup_send_vectored_up_to_writev(3);
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, on_send_complete_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, test_list_item_count);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_009: [ If any other error occurs, socketio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_constbuffer_array_get_buffer_content_fails_socketio_send_vectored_fails_without_writev)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(singlylinkedlist_get_head_item(TEST_SINGLYLINKEDLIST_HANDLE));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 0));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 1))
+        .SetReturn(NULL);
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, on_send_complete_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, test_list_item_count);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_009: [ If any other error occurs, socketio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_constbuffer_array_get_buffer_content_fails_while_queuing_socketio_send_vectored_fails)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    writev_result = 4;
+    setup_send_vectored_up_to_writev(3);
+    STRICT_EXPECTED_CALL(gballoc_malloc(5));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 0));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 1))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, on_send_complete_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, test_list_item_count);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+/* Tests_SRS_SOCKETIO_BERKELEY_11_009: [ If any other error occurs, socketio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_singlylinkedlist_add_fails_socketio_send_vectored_fails)
+{
+    ///arrange
+    CONCRETE_IO_HANDLE socket_io = create_open_socketio();
+    int result;
+
+    writev_result = 4;
+    setup_send_vectored_up_to_writev(3);
+    STRICT_EXPECTED_CALL(gballoc_malloc(5));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 0));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 1));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 2));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(singlylinkedlist_add(TEST_SINGLYLINKEDLIST_HANDLE, IGNORED_PTR_ARG))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    result = send_vectored(socket_io);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, test_list_item_count);
+
+    ///cleanup
+    socketio_destroy(socket_io);
+}
+
+END_TEST_SUITE(socketio_berkeley_unittests)
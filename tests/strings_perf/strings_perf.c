@@ -0,0 +1,218 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/crt_abstractions.h"
+#include "perf_timer.h"
+
+/*compares STRING_length, which returns the length kept by the STRING, with the strlen scan it used to do,
+the cost of appending to a string that keeps growing and the cost of formatting into it*/
+
+#define LENGTH_CALLS_PER_TEST 10000000
+#define CONCATS_PER_TEST 100000
+#define FORMATS_PER_TEST 1000000
+
+static const size_t string_lengths[] = { 16, 1024, 4096, 16384 };
+
+/*keeps the compiler from dropping the loops*/
+static volatile size_t sink;
+
+static int run_length_test(size_t string_length)
+{
+    int result;
+    char* content = (char*)malloc(string_length + 1);
+    STRING_HANDLE str = NULL;
+
+    if (content != NULL)
+    {
+        (void)memset(content, 'a', string_length);
+        content[string_length] = '\0';
+        str = STRING_construct(content);
+    }
+
+    if (str == NULL)
+    {
+        (void)printf("failed allocating test data\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t total = 0;
+        size_t i;
+        double start;
+        double end;
+        double cached_ns;
+        double scan_ns;
+        size_t calls = (string_length > 1024) ? LENGTH_CALLS_PER_TEST / 100 : LENGTH_CALLS_PER_TEST;
+
+        start = perf_timer_get_seconds();
+        for (i = 0; i < calls; i++)
+        {
+            total += STRING_length(str);
+            sink = total;
+        }
+        end = perf_timer_get_seconds();
+        cached_ns = PERF_NS_PER_OP(start, end, calls);
+
+        /*this is what STRING_length did before the STRING kept its length*/
+        start = perf_timer_get_seconds();
+        for (i = 0; i < calls; i++)
+        {
+            total += strlen(STRING_c_str(str));
+            sink = total;
+        }
+        end = perf_timer_get_seconds();
+        scan_ns = PERF_NS_PER_OP(start, end, calls);
+
+        if (total != 2 * calls * string_length)
+        {
+            (void)printf("unexpected length\r\n");
+            result = __LINE__;
+        }
+        else
+        {
+            (void)printf("STRING_length of %5u chars: %8.2f ns, strlen: %10.2f ns\r\n",
+                (unsigned int)string_length, cached_ns, scan_ns);
+            result = 0;
+        }
+    }
+
+    STRING_delete(str);
+    free(content);
+    return result;
+}
+
+static int run_concat_test(void)
+{
+    int result;
+    STRING_HANDLE str = STRING_new();
+
+    if (str == NULL)
+    {
+        (void)printf("failed allocating test data\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t i;
+        double start;
+        double end;
+
+        result = 0;
+        start = perf_timer_get_seconds();
+        for (i = 0; (i < CONCATS_PER_TEST) && (result == 0); i++)
+        {
+            if (STRING_concat(str, "fragment") != 0)
+            {
+                (void)printf("STRING_concat failed\r\n");
+                result = __LINE__;
+            }
+        }
+        end = perf_timer_get_seconds();
+
+        if ((result == 0) && (STRING_length(str) != CONCATS_PER_TEST * strlen("fragment")))
+        {
+            (void)printf("unexpected length\r\n");
+            result = __LINE__;
+        }
+        else if (result == 0)
+        {
+            (void)printf("STRING_concat up to %u chars: %8.2f ns per call\r\n",
+                (unsigned int)STRING_length(str), PERF_NS_PER_OP(start, end, CONCATS_PER_TEST));
+        }
+        STRING_delete(str);
+    }
+
+    return result;
+}
+
+static int run_format_test(void)
+{
+    int result;
+    STRING_HANDLE str = STRING_new();
+
+    if (str == NULL)
+    {
+        (void)printf("failed allocating test data\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        char number[32];
+        size_t i;
+        double start;
+        double end;
+        double sprintf_ns;
+        double to_string_ns;
+        double snprintf_ns;
+
+        result = 0;
+
+        /*the STRING is emptied every time, so after the first round every format lands in the memory it already has*/
+        start = perf_timer_get_seconds();
+        for (i = 0; (i < FORMATS_PER_TEST) && (result == 0); i++)
+        {
+            STRING_empty(str);
+            if (STRING_sprintf(str, "se=%lu&skn=%s", (unsigned long)i, "key") != 0)
+            {
+                (void)printf("STRING_sprintf failed\r\n");
+                result = __LINE__;
+            }
+        }
+        end = perf_timer_get_seconds();
+        sprintf_ns = PERF_NS_PER_OP(start, end, FORMATS_PER_TEST);
+
+        start = perf_timer_get_seconds();
+        for (i = 0; (i < FORMATS_PER_TEST) && (result == 0); i++)
+        {
+            if (size_tToString(number, sizeof(number), i * 2654435761u) != 0)
+            {
+                (void)printf("size_tToString failed\r\n");
+                result = __LINE__;
+            }
+            sink = (size_t)number[0];
+        }
+        end = perf_timer_get_seconds();
+        to_string_ns = PERF_NS_PER_OP(start, end, FORMATS_PER_TEST);
+
+        start = perf_timer_get_seconds();
+        for (i = 0; (i < FORMATS_PER_TEST) && (result == 0); i++)
+        {
+            (void)snprintf(number, sizeof(number), "%lu", (unsigned long)(i * 2654435761u));
+            sink = (size_t)number[0];
+        }
+        end = perf_timer_get_seconds();
+        snprintf_ns = PERF_NS_PER_OP(start, end, FORMATS_PER_TEST);
+
+        if (result == 0)
+        {
+            (void)printf("STRING_sprintf: %8.2f ns, size_tToString: %8.2f ns, snprintf(\"%%lu\"): %8.2f ns\r\n",
+                sprintf_ns, to_string_ns, snprintf_ns);
+        }
+        STRING_delete(str);
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int result = 0;
+    size_t i;
+    for (i = 0; (i < sizeof(string_lengths) / sizeof(string_lengths[0])) && (result == 0); i++)
+    {
+        result = run_length_test(string_lengths[i]);
+    }
+    if (result == 0)
+    {
+        result = run_concat_test();
+    }
+    if (result == 0)
+    {
+        result = run_format_test();
+    }
+    return result;
+}
@@ -40,6 +40,7 @@ void my_gballoc_free(void* ptr)
 static const char TEST_STRING_VALUE []= "DataValueTest";
 static const char INITIAL_STRING_VALUE []= "Initial_";
 static const char MULTIPLE_TEST_STRING_VALUE[] = "DataValueTestDataValueTest";
+static const char LONG_TEST_STRING_VALUE[] = "DataValueTestDataValueTestDataValueTest";
 static const char* COMBINED_STRING_VALUE = "Initial_DataValueTest";
 static const char* QUOTED_TEST_STRING_VALUE = "\"DataValueTest\"";
 static const char* FORMAT_STRING = "test_format_%s";
@@ -54,6 +55,8 @@ static const char* MODIFIED_STRING_VALUE2 = "*nitial_";
 
 #define NUMBER_OF_CHAR_TOCOPY           8
 #define TEST_INTEGER_VALUE              1234
+/*the default STRINGS_C_INLINE_BUFFER_SIZE, strings up to this size (including the '\0') do not need a second allocation*/
+#define TEST_INLINE_BUFFER_SIZE         24
 
 static TEST_MUTEX_HANDLE g_testByTest;
 
@@ -127,6 +130,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
     /* STRING_Tests BEGIN */
     /* Tests_SRS_STRING_07_001: [STRING_new shall allocate a new STRING_HANDLE pointing to an empty string.] */
+    /* Tests_SRS_STRING_11_013: [ Strings that fit in STRINGS_C_INLINE_BUFFER_SIZE bytes (24 by default) including the '\0' shall be kept in the STRING itself, so that creating them takes a single allocation. ]*/
     TEST_FUNCTION(STRING_new_Succeed)
     {
         ///arrange
@@ -134,7 +138,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(1));
 
         ///act
         g_hString = STRING_new();
@@ -158,7 +161,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(1));
 
         umock_c_negative_tests_snapshot();
 
@@ -229,7 +231,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_STRING_VALUE) + 1));
 
         ///act
         g_hString = STRING_construct(TEST_STRING_VALUE);
@@ -242,6 +243,27 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(g_hString);
     }
 
+    /* Tests_SRS_STRING_07_003: [STRING_construct shall allocate a new string with the value of the specified const char*.] */
+    TEST_FUNCTION(STRING_construct_long_string_Succeed)
+    {
+        ///arrange
+        STRING_HANDLE g_hString;
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(LONG_TEST_STRING_VALUE) + 1));
+
+        ///act
+        g_hString = STRING_construct(LONG_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, LONG_TEST_STRING_VALUE, STRING_c_str(g_hString) );
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
     /* Tests_SRS_STRING_07_003: [STRING_construct shall allocate a new string with the value of the specified const char*.] */
     TEST_FUNCTION(STRING_construct_Fail)
     {
@@ -254,7 +276,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_STRING_VALUE) + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(LONG_TEST_STRING_VALUE) + 1));
 
         umock_c_negative_tests_snapshot();
 
@@ -267,7 +289,7 @@ BEGIN_TEST_SUITE(strings_unittests)
             umock_c_negative_tests_reset();
             umock_c_negative_tests_fail_call(index);
 
-            str_handle = STRING_construct(TEST_STRING_VALUE);
+            str_handle = STRING_construct(LONG_TEST_STRING_VALUE);
 
             sprintf(tmp_msg, "STRING_construct failure in test %lu/%lu", (unsigned long)index+1, (unsigned long)count);
 
@@ -301,7 +323,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 + strlen(TEST_STRING_VALUE) + 1));
 
         ///act
         g_hString = STRING_new_quoted(TEST_STRING_VALUE);
@@ -372,7 +393,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         ///arrange
         STRING_HANDLE str_handle;
 
-        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
         EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         ///act
@@ -387,6 +407,27 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(str_handle);
     }
 
+    /* Tests_SRS_STRING_11_015: [ STRING_construct_sprintf and STRING_sprintf shall format directly into the memory the STRING already has and only when the result does not fit there grow it and format again. ]*/
+    TEST_FUNCTION(STRING_construct_sprintf_short_result_takes_a_single_allocation)
+    {
+        ///arrange
+        STRING_HANDLE str_handle;
+
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        str_handle = STRING_construct_sprintf(FORMAT_INTEGER, TEST_INTEGER_VALUE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(str_handle);
+        ASSERT_ARE_EQUAL(char_ptr, FORMAT_INTEGER_RESULT, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(size_t, strlen(FORMAT_INTEGER_RESULT), STRING_length(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
     /* Tests_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
     TEST_FUNCTION(STRING_construct_sprintf_fail)
     {
@@ -432,9 +473,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(INITIAL_STRING_VALUE) + strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
-
         ///act
         nResult = STRING_concat(g_hString, TEST_STRING_VALUE);
 
@@ -511,9 +549,7 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_copy(g_hString, TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(TEST_STRING_VALUE) + strlen(TEST_STRING_VALUE)+1))
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
+        STRICT_EXPECTED_CALL(gballoc_malloc(2 * TEST_INLINE_BUFFER_SIZE));
 
         ///act
         STRING_concat(g_hString, TEST_STRING_VALUE);
@@ -535,9 +571,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_HANDLE hAppend = STRING_construct(TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(INITIAL_STRING_VALUE) + strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
-
         ///act
         nResult = STRING_concat_with_STRING(g_hString, hAppend);
 
@@ -612,14 +645,13 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(LONG_TEST_STRING_VALUE) + 1));
 
         ///act
-        nResult = STRING_copy(g_hString, TEST_STRING_VALUE);
+        nResult = STRING_copy(g_hString, LONG_TEST_STRING_VALUE);
 
         ///assert
-        ASSERT_ARE_EQUAL(char_ptr, TEST_STRING_VALUE, STRING_c_str(g_hString) );
+        ASSERT_ARE_EQUAL(char_ptr, LONG_TEST_STRING_VALUE, STRING_c_str(g_hString) );
         ASSERT_ARE_EQUAL(int, nResult, 0);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
@@ -648,6 +680,7 @@ BEGIN_TEST_SUITE(strings_unittests)
     }
 
     /* Tests_SRS_STRING_07_018: [STRING_copy_n shall copy the number of characters defined in size_t.] */
+    /* Tests_SRS_STRING_11_002: [ STRING_copy, STRING_copy_n and STRING_empty shall keep the memory of the string when it is big enough and otherwise grow it to the needed size. ]*/
     TEST_FUNCTION(STRING_Copy_n_Succeed)
     {
         ///arrange
@@ -656,9 +689,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, NUMBER_OF_CHAR_TOCOPY + 1))
-            .IgnoreArgument(1);
-
         ///act
         nResult = STRING_copy_n(g_hString, COMBINED_STRING_VALUE, NUMBER_OF_CHAR_TOCOPY);
 
@@ -713,9 +743,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1))
-            .IgnoreArgument(1);
-
         ///act
         nResult = STRING_copy_n(g_hString, COMBINED_STRING_VALUE, 0);
 
@@ -729,22 +756,23 @@ BEGIN_TEST_SUITE(strings_unittests)
     }
 
     /* Tests_SRS_STRING_07_014: [STRING_quote shall "quote" the supplied STRING_HANDLE and return 0 on success.] */
+    /* Tests_SRS_STRING_11_001: [ When the string needs more memory, STRING_concat, STRING_concat_with_STRING, STRING_quote and STRING_sprintf shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
     TEST_FUNCTION(STRING_quote_Succeed)
     {
         ///arrange
         int nResult;
         STRING_HANDLE g_hString;
-        g_hString = STRING_construct(TEST_STRING_VALUE);
+        g_hString = STRING_construct(LONG_TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 + strlen(TEST_STRING_VALUE) + 1))
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * (strlen(LONG_TEST_STRING_VALUE) + 1)))
             .IgnoreArgument(1);
 
         ///act
         nResult = STRING_quote(g_hString);
 
         ///assert
-        ASSERT_ARE_EQUAL(char_ptr, QUOTED_TEST_STRING_VALUE, STRING_c_str(g_hString) );
+        ASSERT_ARE_EQUAL(char_ptr, "\"" "DataValueTestDataValueTestDataValueTest" "\"", STRING_c_str(g_hString) );
         ASSERT_ARE_EQUAL(int, nResult, 0);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
@@ -761,10 +789,10 @@ BEGIN_TEST_SUITE(strings_unittests)
         int negativeTestsInitResult = umock_c_negative_tests_init();
         ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
-        str_handle = STRING_construct(TEST_STRING_VALUE);
+        str_handle = STRING_construct(LONG_TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 + strlen(TEST_STRING_VALUE) + 1))
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * (strlen(LONG_TEST_STRING_VALUE) + 1)))
             .IgnoreArgument(1);
 
         umock_c_negative_tests_snapshot();
@@ -827,7 +855,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_STRING_VALUE) + 1));
 
         ///act
         g_hString = STRING_construct(TEST_STRING_VALUE);
@@ -842,6 +869,7 @@ BEGIN_TEST_SUITE(strings_unittests)
     }
 
     /* Tests_SRS_STRING_07_022: [STRING_empty shall revert the STRING_HANDLE to an empty state.] */
+    /* Tests_SRS_STRING_11_002: [ STRING_copy, STRING_copy_n and STRING_empty shall keep the memory of the string when it is big enough and otherwise grow it to the needed size. ]*/
     TEST_FUNCTION(STRING_empty_Succeed)
     {
         ///arrange
@@ -850,9 +878,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1))
-            .IgnoreArgument(1);
-
         ///act
         nResult = STRING_empty(g_hString);
 
@@ -964,7 +989,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof("aa")));
 
         ///act
         result = STRING_clone(hSource);
@@ -990,12 +1014,12 @@ BEGIN_TEST_SUITE(strings_unittests)
         int negativeTestsInitResult = umock_c_negative_tests_init();
         ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
-        str_handle = STRING_construct("aa");
+        str_handle = STRING_construct(LONG_TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof("aa")));
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(LONG_TEST_STRING_VALUE)));
 
         umock_c_negative_tests_snapshot();
 
@@ -1056,8 +1080,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(3))
-            .IgnoreArgument(1);
 
         ///act
         result = STRING_construct_n("qq", 2);
@@ -1078,8 +1100,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_HANDLE result;
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(4))
-            .IgnoreArgument(1);
 
         ///act
         result = STRING_construct_n("12345", 3);
@@ -1103,8 +1123,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(3))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(LONG_TEST_STRING_VALUE) - 1 + 1));
 
         umock_c_negative_tests_snapshot();
 
@@ -1118,7 +1137,7 @@ BEGIN_TEST_SUITE(strings_unittests)
             umock_c_negative_tests_reset();
             umock_c_negative_tests_fail_call(index);
 
-            result = STRING_construct_n("qq", 2);
+            result = STRING_construct_n(LONG_TEST_STRING_VALUE, strlen(LONG_TEST_STRING_VALUE) - 1);
 
             sprintf(tmp_msg, "STRING_construct_n failure in test %lu/%lu", (unsigned long)index+1, (unsigned long)count);
 
@@ -1281,7 +1300,10 @@ BEGIN_TEST_SUITE(strings_unittests)
 
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(gballoc_malloc(strlen(JSONtests[i].expectedJSON) + 1));
+            if (strlen(JSONtests[i].expectedJSON) + 1 > TEST_INLINE_BUFFER_SIZE)
+            {
+                STRICT_EXPECTED_CALL(gballoc_malloc(strlen(JSONtests[i].expectedJSON) + 1));
+            }
 
             ///act
             result = STRING_new_JSON(JSONtests[i].source);
@@ -1305,7 +1327,7 @@ BEGIN_TEST_SUITE(strings_unittests)
         ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)).IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("ab") + 2+1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(LONG_TEST_STRING_VALUE) + 2+1));
 
         umock_c_negative_tests_snapshot();
 
@@ -1319,7 +1341,7 @@ BEGIN_TEST_SUITE(strings_unittests)
             umock_c_negative_tests_reset();
             umock_c_negative_tests_fail_call(index);
 
-            result = STRING_new_JSON("ab");
+            result = STRING_new_JSON(LONG_TEST_STRING_VALUE);
 
             sprintf(tmp_msg, "STRING_new_JSON failure in test %lu/%lu", (unsigned long)index+1, (unsigned long)count);
 
@@ -1369,8 +1391,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument_size();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(1 + 1));
-
         ///act
         result = STRING_from_byte_array((const unsigned char*)"a", 1);
 
@@ -1391,8 +1411,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument_size();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(1 + 0));
-
         ///act
         result = STRING_from_byte_array(NULL, 0);
 
@@ -1413,14 +1431,14 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument_size();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(1 + 1))
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(LONG_TEST_STRING_VALUE) + 1))
             .SetReturn(NULL);
 
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
             .IgnoreArgument_ptr();
 
         ///act
-        result = STRING_from_byte_array((const unsigned char*)"a", 1);
+        result = STRING_from_byte_array((const unsigned char*)LONG_TEST_STRING_VALUE, strlen(LONG_TEST_STRING_VALUE));
 
         ///assert
         ASSERT_IS_NULL(result);
@@ -1492,7 +1510,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         ///act
         str_result = STRING_sprintf(str_handle, FORMAT_STRING, TEST_STRING_VALUE);
@@ -1528,6 +1546,56 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(str_handle);
     }
 
+    /* Tests_SRS_STRING_11_015: [ STRING_construct_sprintf and STRING_sprintf shall format directly into the memory the STRING already has and only when the result does not fit there grow it and format again. ]*/
+    TEST_FUNCTION(STRING_sprintf_formats_into_spare_capacity_without_allocating)
+    {
+        ///arrange
+        int str_result;
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        ASSERT_IS_NOT_NULL(str_handle);
+        ASSERT_ARE_EQUAL(int, 0, STRING_reserve(str_handle, 100));
+
+        umock_c_reset_all_calls();
+
+        ///act
+        str_result = STRING_sprintf(str_handle, FORMAT_STRING, TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, str_result);
+        ASSERT_ARE_EQUAL(char_ptr, INIT_FORMAT_STRING_RESULT, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(size_t, strlen(INIT_FORMAT_STRING_RESULT), STRING_length(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_016: [ If STRING_sprintf fails, the content of the string shall be left unchanged. ]*/
+    TEST_FUNCTION(when_growing_fails_STRING_sprintf_leaves_the_string_unchanged)
+    {
+        ///arrange
+        int str_result;
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        ASSERT_IS_NOT_NULL(str_handle);
+
+        umock_c_reset_all_calls();
+
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        str_result = STRING_sprintf(str_handle, FORMAT_STRING, TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, str_result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(size_t, strlen(INITIAL_STRING_VALUE), STRING_length(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
     /* Tests_SRS_STRING_07_043: [If any error is encountered STRING_sprintf shall return a non zero value.] */
     TEST_FUNCTION(STRING_sprintf_format_fail)
     {
@@ -1543,7 +1611,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         umock_c_negative_tests_snapshot();
 
@@ -1695,4 +1763,350 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(str_handle);
     }
 
+    /* Tests_SRS_STRING_11_001: [ When the string needs more memory, STRING_concat, STRING_concat_with_STRING, STRING_quote and STRING_sprintf shall grow its capacity to twice the current capacity or to the needed size, whichever is bigger. ]*/
+    TEST_FUNCTION(STRING_concat_doubles_the_capacity)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(LONG_TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(LONG_TEST_STRING_VALUE)))
+            .IgnoreArgument(1);
+
+        ///act
+        nResult = STRING_concat(str_handle, "d");
+        nResult |= STRING_concat(str_handle, "e");
+        nResult |= STRING_concat(str_handle, "f");
+        nResult |= STRING_concat(str_handle, "g");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, "DataValueTestDataValueTestDataValueTest" "defg", STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_002: [ STRING_copy, STRING_copy_n and STRING_empty shall keep the memory of the string when it is big enough and otherwise grow it to the needed size. ]*/
+    TEST_FUNCTION(STRING_copy_of_a_shorter_string_does_not_reallocate)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = STRING_copy(str_handle, INITIAL_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_003: [ If handle is NULL, STRING_reserve shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_reserve_with_NULL_handle_fails)
+    {
+        ///act
+        int nResult = STRING_reserve(NULL, 10);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_11_004: [ STRING_reserve shall grow the memory of the string so that it can hold capacity characters without reallocating, and return 0. ]*/
+    TEST_FUNCTION(STRING_reserve_succeeds)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(100 + 1));
+
+        ///act
+        nResult = STRING_reserve(str_handle, 100);
+        nResult |= STRING_concat(str_handle, TEST_STRING_VALUE);
+        nResult |= STRING_sprintf(str_handle, FORMAT_INTEGER, TEST_INTEGER_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, "Initial_DataValueTesttest_format_1234", STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_005: [ If the string can already hold capacity characters, STRING_reserve shall do nothing and return 0. ]*/
+    TEST_FUNCTION(STRING_reserve_less_than_the_capacity_does_nothing)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = STRING_reserve(str_handle, strlen(INITIAL_STRING_VALUE));
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_006: [ If any error occurs, STRING_reserve shall fail, leave the string unchanged and return a non-zero value. ]*/
+    TEST_FUNCTION(when_allocating_fails_STRING_reserve_fails)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(100 + 1))
+            .SetReturn(NULL);
+
+        ///act
+        nResult = STRING_reserve(str_handle, 100);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_007: [ If handle is NULL, STRING_shrink_to_fit shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_shrink_to_fit_with_NULL_handle_fails)
+    {
+        ///act
+        int nResult = STRING_shrink_to_fit(NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_11_008: [ STRING_shrink_to_fit shall reallocate the memory of the string to the length of the string plus the '\0' and return 0. ]*/
+    TEST_FUNCTION(STRING_shrink_to_fit_succeeds)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(LONG_TEST_STRING_VALUE);
+        (void)STRING_copy(str_handle, MULTIPLE_TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(MULTIPLE_TEST_STRING_VALUE) + 1))
+            .IgnoreArgument(1);
+
+        ///act
+        nResult = STRING_shrink_to_fit(str_handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, MULTIPLE_TEST_STRING_VALUE, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_009: [ If the string has no spare memory, STRING_shrink_to_fit shall do nothing and return 0. ]*/
+    TEST_FUNCTION(STRING_shrink_to_fit_without_spare_memory_does_nothing)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(LONG_TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = STRING_shrink_to_fit(str_handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_010: [ If reallocating fails, STRING_shrink_to_fit shall leave the string unchanged and return a non-zero value. ]*/
+    TEST_FUNCTION(when_realloc_fails_STRING_shrink_to_fit_fails)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(LONG_TEST_STRING_VALUE);
+        (void)STRING_copy(str_handle, MULTIPLE_TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(MULTIPLE_TEST_STRING_VALUE) + 1))
+            .IgnoreArgument(1)
+            .SetReturn(NULL);
+
+        ///act
+        nResult = STRING_shrink_to_fit(str_handle);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, MULTIPLE_TEST_STRING_VALUE, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_014: [ When the string fits in the STRING again, STRING_shrink_to_fit shall move it there and free its memory. ]*/
+    TEST_FUNCTION(STRING_shrink_to_fit_moves_a_short_string_back_into_the_STRING)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(LONG_TEST_STRING_VALUE);
+        (void)STRING_copy(str_handle, INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+        ///act
+        nResult = STRING_shrink_to_fit(str_handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_013: [ Strings that fit in STRINGS_C_INLINE_BUFFER_SIZE bytes (24 by default) including the '\0' shall be kept in the STRING itself, so that creating them takes a single allocation. ]*/
+    TEST_FUNCTION(STRING_concat_moves_a_short_string_that_grows_to_the_heap)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(INITIAL_STRING_VALUE) + strlen(LONG_TEST_STRING_VALUE) + 1));
+
+        ///act
+        nResult = STRING_concat(str_handle, LONG_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, "Initial_DataValueTestDataValueTestDataValueTest", STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_013: [ Strings that fit in STRINGS_C_INLINE_BUFFER_SIZE bytes (24 by default) including the '\0' shall be kept in the STRING itself, so that creating them takes a single allocation. ]*/
+    TEST_FUNCTION(when_allocating_fails_STRING_concat_keeps_the_short_string)
+    {
+        ///arrange
+        int nResult;
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        const char* before = STRING_c_str(str_handle);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(INITIAL_STRING_VALUE) + strlen(LONG_TEST_STRING_VALUE) + 1))
+            .SetReturn(NULL);
+
+        ///act
+        nResult = STRING_concat(str_handle, LONG_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(void_ptr, before, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_011: [ STRING_length shall return the length kept by the string without scanning it. ]*/
+    TEST_FUNCTION(STRING_length_follows_every_change)
+    {
+        ///arrange
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        STRING_HANDLE append_handle = STRING_construct(TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, strlen(INITIAL_STRING_VALUE), STRING_length(str_handle));
+        (void)STRING_concat(str_handle, TEST_STRING_VALUE);
+        ASSERT_ARE_EQUAL(size_t, strlen(COMBINED_STRING_VALUE), STRING_length(str_handle));
+        (void)STRING_concat_with_STRING(str_handle, append_handle);
+        ASSERT_ARE_EQUAL(size_t, strlen(COMBINED_STRING_VALUE) + strlen(TEST_STRING_VALUE), STRING_length(str_handle));
+        (void)STRING_copy_n(str_handle, COMBINED_STRING_VALUE, NUMBER_OF_CHAR_TOCOPY);
+        ASSERT_ARE_EQUAL(size_t, NUMBER_OF_CHAR_TOCOPY, STRING_length(str_handle));
+        (void)STRING_quote(str_handle);
+        ASSERT_ARE_EQUAL(size_t, NUMBER_OF_CHAR_TOCOPY + 2, STRING_length(str_handle));
+        (void)STRING_sprintf(str_handle, FORMAT_INTEGER, TEST_INTEGER_VALUE);
+        ASSERT_ARE_EQUAL(size_t, NUMBER_OF_CHAR_TOCOPY + 2 + strlen(FORMAT_INTEGER_RESULT), STRING_length(str_handle));
+        (void)STRING_copy(str_handle, TEST_STRING_VALUE);
+        ASSERT_ARE_EQUAL(size_t, strlen(TEST_STRING_VALUE), STRING_length(str_handle));
+        (void)STRING_replace(str_handle, 'V', '\0');
+        ASSERT_ARE_EQUAL(size_t, strlen("Data"), STRING_length(str_handle));
+        (void)STRING_empty(str_handle);
+        ASSERT_ARE_EQUAL(size_t, 0, STRING_length(str_handle));
+
+        ///cleanup
+        STRING_delete(append_handle);
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_011: [ STRING_length shall return the length kept by the string without scanning it. ]*/
+    TEST_FUNCTION(STRING_length_of_a_byte_array_stops_at_the_first_zero)
+    {
+        ///arrange
+        static const unsigned char source[] = { 'a', 'b', '\0', 'c' };
+        size_t length;
+        STRING_HANDLE str_handle = STRING_from_byte_array(source, sizeof(source));
+        umock_c_reset_all_calls();
+
+        ///act
+        length = STRING_length(str_handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 2, length);
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_11_012: [ STRING_compare shall compare the strings with memcmp up to the '\0' of the shorter one, which gives the same result as strcmp without scanning for the lengths. ]*/
+    TEST_FUNCTION(STRING_compare_prefix_is_smaller)
+    {
+        ///arrange
+        int result;
+        STRING_HANDLE h1 = STRING_construct("a12");
+        STRING_HANDLE h2 = STRING_construct("a1234");
+        umock_c_reset_all_calls();
+
+        ///act
+        result = STRING_compare(h1, h2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, -1, result);
+        ASSERT_ARE_EQUAL(int, 1, STRING_compare(h2, h1));
+
+        ///cleanup
+        STRING_delete(h1);
+        STRING_delete(h2);
+    }
+
 END_TEST_SUITE(strings_unittests)
\ No newline at end of file
@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/buffer_.h"
+#include "azure_c_shared_utility/hmacsha256.h"
+#include "azure_c_shared_utility/threadpool.h"
+#include "perf_timer.h"
+
+/*how the threadpool scales from 1 to 8 workers. The CPU bound items compute an HMAC-SHA256 the way a
+SAS token is signed, the empty items show what submitting and running an item costs. The items are submitted from
+the main thread with a wait group, the one thread rows run the same items on the main thread without the pool*/
+
+#define HMAC_ITEMS 20000
+#define EMPTY_ITEMS 200000
+
+static const size_t worker_counts[] = { 1, 2, 4, 8 };
+
+static const unsigned char key[] = "0123456789abcdef0123456789abcdef";
+static unsigned char payload[256];
+static volatile size_t failures;
+static volatile size_t sink;
+
+static void hmac_work(void* context)
+{
+    BUFFER_HANDLE hash = BUFFER_new();
+    (void)context;
+    if ((hash == NULL) ||
+        (HMACSHA256_ComputeHash(key, sizeof(key) - 1, payload, sizeof(payload), hash) != HMACSHA256_OK))
+    {
+        failures++;
+    }
+    else
+    {
+        sink += BUFFER_u_char(hash)[0];
+    }
+    BUFFER_delete(hash);
+}
+
+static void empty_work(void* context)
+{
+    (void)context;
+}
+
+typedef struct WORKLOAD_TAG
+{
+    const char* name;
+    THREADPOOL_WORK_FUNCTION work_function;
+    size_t items;
+} WORKLOAD;
+
+static const WORKLOAD workloads[] =
+{
+    { "hmac-sha256 items", hmac_work, HMAC_ITEMS },
+    { "empty items", empty_work, EMPTY_ITEMS }
+};
+
+static int run_without_pool(const WORKLOAD* workload, double* ns_per_item)
+{
+    double start;
+    double end;
+    size_t i;
+
+    failures = 0;
+    start = perf_timer_get_seconds();
+    for (i = 0; i < workload->items; i++)
+    {
+        workload->work_function(NULL);
+    }
+    end = perf_timer_get_seconds();
+    *ns_per_item = PERF_NS_PER_OP(start, end, workload->items);
+
+    (void)printf("%-18s main thread only: %10.2f ns per item\r\n", workload->name, *ns_per_item);
+    return (failures == 0) ? 0 : __LINE__;
+}
+
+static int run_with_pool(const WORKLOAD* workload, size_t worker_count, double baseline_ns_per_item)
+{
+    int result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(worker_count);
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+
+    if ((threadpool == NULL) || (wait_group == NULL))
+    {
+        (void)printf("failed creating the threadpool with %u workers\r\n", (unsigned int)worker_count);
+        result = __LINE__;
+    }
+    else
+    {
+        double start;
+        double end;
+        size_t i;
+
+        failures = 0;
+        result = 0;
+        start = perf_timer_get_seconds();
+        for (i = 0; i < workload->items; i++)
+        {
+            if (threadpool_submit_to_group(threadpool, wait_group, workload->work_function, NULL) != THREADPOOL_OK)
+            {
+                (void)printf("threadpool_submit_to_group failed\r\n");
+                result = __LINE__;
+                break;
+            }
+        }
+        if (threadpool_wait_group_wait(wait_group) != THREADPOOL_OK)
+        {
+            (void)printf("threadpool_wait_group_wait failed\r\n");
+            result = __LINE__;
+        }
+        end = perf_timer_get_seconds();
+
+        if (failures != 0)
+        {
+            (void)printf("%s failed\r\n", workload->name);
+            result = __LINE__;
+        }
+        else if (result == 0)
+        {
+            double ns_per_item = PERF_NS_PER_OP(start, end, workload->items);
+            (void)printf("%-18s %u workers:        %10.2f ns per item, %5.2fx the main thread\r\n",
+                workload->name, (unsigned int)worker_count, ns_per_item, baseline_ns_per_item / ns_per_item);
+        }
+    }
+
+    if (wait_group != NULL)
+    {
+        threadpool_wait_group_destroy(wait_group);
+    }
+    if (threadpool != NULL)
+    {
+        threadpool_destroy(threadpool);
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int result = 0;
+    size_t i;
+
+    for (i = 0; i < sizeof(payload); i++)
+    {
+        payload[i] = (unsigned char)i;
+    }
+
+    for (i = 0; (i < sizeof(workloads) / sizeof(workloads[0])) && (result == 0); i++)
+    {
+        double baseline_ns_per_item;
+        result = run_without_pool(&workloads[i], &baseline_ns_per_item);
+        if (result == 0)
+        {
+            size_t j;
+            for (j = 0; (j < sizeof(worker_counts) / sizeof(worker_counts[0])) && (result == 0); j++)
+            {
+                result = run_with_pool(&workloads[i], worker_counts[j], baseline_ns_per_item);
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,930 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#endif
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+#include "macro_utils.h"
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+#include "umocktypes_stdint.h"
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/condition.h"
+#include "azure_c_shared_utility/threadapi.h"
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/threadpool.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+TEST_DEFINE_ENUM_TYPE(THREADPOOL_RESULT, THREADPOOL_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(LOCK_RESULT, LOCK_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(COND_RESULT, COND_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+/*locks and conditions are small allocations so that every one has its own handle*/
+static LOCK_HANDLE my_Lock_Init(void)
+{
+    return (LOCK_HANDLE)my_gballoc_malloc(1);
+}
+
+static LOCK_RESULT my_Lock_Deinit(LOCK_HANDLE handle)
+{
+    my_gballoc_free(handle);
+    return LOCK_OK;
+}
+
+static COND_HANDLE my_Condition_Init(void)
+{
+    return (COND_HANDLE)my_gballoc_malloc(1);
+}
+
+static void my_Condition_Deinit(COND_HANDLE handle)
+{
+    my_gballoc_free(handle);
+}
+
+/*the workers do not run on their own thread, ThreadAPI_Join runs them. threadpool_destroy has stopped the pool by
+then, so a worker runs the work it can find and returns*/
+#define MAX_TEST_THREADS 4
+
+static THREAD_START_FUNC thread_functions[MAX_TEST_THREADS];
+static void* thread_args[MAX_TEST_THREADS];
+static size_t thread_count;
+
+static THREADAPI_RESULT my_ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg)
+{
+    THREADAPI_RESULT result;
+    if (thread_count == MAX_TEST_THREADS)
+    {
+        result = THREADAPI_ERROR;
+    }
+    else
+    {
+        thread_functions[thread_count] = func;
+        thread_args[thread_count] = arg;
+        thread_count++;
+        *threadHandle = (THREAD_HANDLE)(uintptr_t)thread_count;
+        result = THREADAPI_OK;
+    }
+    return result;
+}
+
+static THREADAPI_RESULT my_ThreadAPI_Join(THREAD_HANDLE threadHandle, int* res)
+{
+    size_t index = (size_t)(uintptr_t)threadHandle - 1;
+    *res = thread_functions[index](thread_args[index]);
+    return THREADAPI_OK;
+}
+
+/*records the order the work runs in*/
+#define MAX_RUNS 64
+
+static uintptr_t runs[MAX_RUNS];
+static size_t run_count;
+
+static void test_work(void* context)
+{
+    if (run_count < MAX_RUNS)
+    {
+        runs[run_count] = (uintptr_t)context;
+    }
+    run_count++;
+}
+
+#define TEST_CONTEXT(n) ((void*)(uintptr_t)(n))
+
+BEGIN_TEST_SUITE(threadpool_unittests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types");
+
+    REGISTER_UMOCK_ALIAS_TYPE(LOCK_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(COND_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(THREAD_HANDLE*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(THREAD_START_FUNC, void*);
+    REGISTER_TYPE(LOCK_RESULT, LOCK_RESULT);
+    REGISTER_TYPE(COND_RESULT, COND_RESULT);
+    REGISTER_TYPE(THREADAPI_RESULT, THREADAPI_RESULT);
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+
+    REGISTER_GLOBAL_MOCK_HOOK(Lock_Init, my_Lock_Init);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Lock_Init, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(Lock_Deinit, my_Lock_Deinit);
+    REGISTER_GLOBAL_MOCK_RETURN(Lock, LOCK_OK);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Lock, LOCK_ERROR);
+    REGISTER_GLOBAL_MOCK_RETURN(Unlock, LOCK_OK);
+
+    REGISTER_GLOBAL_MOCK_HOOK(Condition_Init, my_Condition_Init);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Condition_Init, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(Condition_Deinit, my_Condition_Deinit);
+    REGISTER_GLOBAL_MOCK_RETURN(Condition_Post, COND_OK);
+    REGISTER_GLOBAL_MOCK_RETURN(Condition_Broadcast, COND_OK);
+    REGISTER_GLOBAL_MOCK_RETURN(Condition_Wait, COND_OK);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(Condition_Wait, COND_ERROR);
+
+    REGISTER_GLOBAL_MOCK_HOOK(ThreadAPI_Create, my_ThreadAPI_Create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(ThreadAPI_Create, THREADAPI_ERROR);
+    REGISTER_GLOBAL_MOCK_HOOK(ThreadAPI_Join, my_ThreadAPI_Join);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    thread_count = 0;
+    run_count = 0;
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+/* threadpool_create */
+
+/* Tests_SRS_THREADPOOL_11_001: [ If worker_count is 0 or too big to allocate, threadpool_create shall fail and return NULL. ]*/
+TEST_FUNCTION(threadpool_create_with_0_workers_fails)
+{
+    ///act
+    THREADPOOL_HANDLE threadpool = threadpool_create(0);
+
+    ///assert
+    ASSERT_IS_NULL(threadpool);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_001: [ If worker_count is 0 or too big to allocate, threadpool_create shall fail and return NULL. ]*/
+TEST_FUNCTION(threadpool_create_with_too_many_workers_fails)
+{
+    ///act
+    THREADPOOL_HANDLE threadpool = threadpool_create(SIZE_MAX);
+
+    ///assert
+    ASSERT_IS_NULL(threadpool);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_002: [ threadpool_create shall allocate worker_count workers, each with a lock and an empty queue, a lock and a condition the workers wait on when there is no work, start a thread for every worker with ThreadAPI_Create and return the pool. ]*/
+TEST_FUNCTION(threadpool_create_succeeds)
+{
+    ///arrange
+    THREADPOOL_HANDLE threadpool;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init());
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+
+    ///act
+    threadpool = threadpool_create(2);
+
+    ///assert
+    ASSERT_IS_NOT_NULL(threadpool);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 2, thread_count);
+
+    ///cleanup
+    threadpool_destroy(threadpool);
+}
+
+/* Tests_SRS_THREADPOOL_11_003: [ If any error occurs, threadpool_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_the_workers_fails_threadpool_create_fails)
+{
+    ///arrange
+    THREADPOOL_HANDLE threadpool;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    threadpool = threadpool_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(threadpool);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_003: [ If any error occurs, threadpool_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_Condition_Init_fails_threadpool_create_fails)
+{
+    ///arrange
+    THREADPOOL_HANDLE threadpool;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init())
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    threadpool = threadpool_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(threadpool);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_003: [ If any error occurs, threadpool_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_the_lock_of_the_second_worker_fails_threadpool_create_frees_the_first_worker_and_fails)
+{
+    ///arrange
+    THREADPOOL_HANDLE threadpool;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init());
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init())
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    threadpool = threadpool_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(threadpool);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, thread_count);
+}
+
+/* Tests_SRS_THREADPOOL_11_003: [ If any error occurs, threadpool_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_starting_the_second_worker_fails_threadpool_create_joins_the_first_and_fails)
+{
+    ///arrange
+    THREADPOOL_HANDLE threadpool;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init());
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG))
+        .SetReturn(THREADAPI_ERROR);
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Broadcast(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    threadpool = threadpool_create(2);
+
+    ///assert
+    ASSERT_IS_NULL(threadpool);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* threadpool_destroy */
+
+/* Tests_SRS_THREADPOOL_11_004: [ If threadpool is NULL, threadpool_destroy shall return. ]*/
+TEST_FUNCTION(threadpool_destroy_with_NULL_returns)
+{
+    ///act
+    threadpool_destroy(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_005: [ threadpool_destroy shall mark the pool as stopping, broadcast the condition of the pool, join the workers, which run all the submitted work before they return, and free the pool. ]*/
+/* Tests_SRS_THREADPOOL_11_016: [ When the pool is stopping and there is no work left, the worker shall return. ]*/
+TEST_FUNCTION(threadpool_destroy_joins_the_workers_and_frees_the_pool)
+{
+    ///arrange
+    THREADPOOL_HANDLE threadpool = threadpool_create(2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Broadcast(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    threadpool_destroy(threadpool);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_005: [ threadpool_destroy shall mark the pool as stopping, broadcast the condition of the pool, join the workers, which run all the submitted work before they return, and free the pool. ]*/
+/* Tests_SRS_THREADPOOL_11_012: [ A worker shall take the oldest work from its own queue and run it. ]*/
+TEST_FUNCTION(threadpool_destroy_runs_the_submitted_work_oldest_first)
+{
+    ///arrange
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, threadpool_submit(threadpool, test_work, TEST_CONTEXT(1)));
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, threadpool_submit(threadpool, test_work, TEST_CONTEXT(2)));
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, threadpool_submit(threadpool, test_work, TEST_CONTEXT(3)));
+
+    ///act
+    threadpool_destroy(threadpool);
+
+    ///assert
+    ASSERT_ARE_EQUAL(size_t, 3, run_count);
+    ASSERT_ARE_EQUAL(size_t, 1, (size_t)runs[0]);
+    ASSERT_ARE_EQUAL(size_t, 2, (size_t)runs[1]);
+    ASSERT_ARE_EQUAL(size_t, 3, (size_t)runs[2]);
+}
+
+/* threadpool_submit */
+
+/* Tests_SRS_THREADPOOL_11_006: [ If threadpool or work_function is NULL, threadpool_submit shall fail and return THREADPOOL_INVALID_ARG. ]*/
+TEST_FUNCTION(threadpool_submit_with_NULL_threadpool_fails)
+{
+    ///act
+    THREADPOOL_RESULT result = threadpool_submit(NULL, test_work, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_006: [ If threadpool or work_function is NULL, threadpool_submit shall fail and return THREADPOOL_INVALID_ARG. ]*/
+TEST_FUNCTION(threadpool_submit_with_NULL_work_function_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = threadpool_submit(threadpool, NULL, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_destroy(threadpool);
+}
+
+/* Tests_SRS_THREADPOOL_11_007: [ threadpool_submit shall add the work at the end of the queue of the next worker in turn. ]*/
+/* Tests_SRS_THREADPOOL_11_011: [ threadpool_submit shall return THREADPOOL_OK. ]*/
+TEST_FUNCTION(threadpool_submit_adds_the_work_to_a_queue)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = threadpool_submit(threadpool, test_work, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, run_count);
+
+    ///cleanup
+    threadpool_destroy(threadpool);
+    ASSERT_ARE_EQUAL(size_t, 1, run_count);
+}
+
+/* Tests_SRS_THREADPOOL_11_008: [ If the queue is full, threadpool_submit shall double its capacity. ]*/
+TEST_FUNCTION(threadpool_submit_grows_a_full_queue)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    size_t i;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    for (i = 0; i < 16; i++)
+    {
+        ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, threadpool_submit(threadpool, test_work, TEST_CONTEXT(i)));
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = threadpool_submit(threadpool, test_work, TEST_CONTEXT(16));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_destroy(threadpool);
+    ASSERT_ARE_EQUAL(size_t, 17, run_count);
+    for (i = 0; i < 17; i++)
+    {
+        ASSERT_ARE_EQUAL(size_t, i, (size_t)runs[i]);
+    }
+}
+
+/* Tests_SRS_THREADPOOL_11_009: [ If any error occurs, threadpool_submit shall fail and return THREADPOOL_ERROR. ]*/
+TEST_FUNCTION(when_growing_the_queue_fails_threadpool_submit_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    size_t i;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    for (i = 0; i < 16; i++)
+    {
+        ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, threadpool_submit(threadpool, test_work, TEST_CONTEXT(i)));
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = threadpool_submit(threadpool, test_work, TEST_CONTEXT(16));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_destroy(threadpool);
+    ASSERT_ARE_EQUAL(size_t, 16, run_count);
+}
+
+/* Tests_SRS_THREADPOOL_11_009: [ If any error occurs, threadpool_submit shall fail and return THREADPOOL_ERROR. ]*/
+TEST_FUNCTION(when_locking_the_queue_fails_threadpool_submit_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG))
+        .SetReturn(LOCK_ERROR);
+
+    ///act
+    result = threadpool_submit(threadpool, test_work, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_destroy(threadpool);
+    ASSERT_ARE_EQUAL(size_t, 0, run_count);
+}
+
+/* workers */
+
+/* Tests_SRS_THREADPOOL_11_013: [ When its own queue is empty, a worker shall look at the queues of the other workers, starting with the next one, steal half of the work at the end of the first queue that has any (at most THREADPOOL_MAX_STEAL items) and run it. ]*/
+TEST_FUNCTION(a_worker_with_an_empty_queue_steals_the_newest_half_of_another_queue)
+{
+    ///arrange
+    size_t i;
+    THREADPOOL_HANDLE threadpool = threadpool_create(2);
+
+    /*submissions alternate between the workers starting with the second one, so the first worker gets the even ones*/
+    for (i = 1; i <= 8; i++)
+    {
+        ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, threadpool_submit(threadpool, test_work, TEST_CONTEXT(i)));
+    }
+
+    ///act
+    threadpool_destroy(threadpool);
+
+    ///assert
+    /*the first worker is joined first: it runs its own work, then steals 2 of the 4 items of the second worker, then 1, then 1*/
+    ASSERT_ARE_EQUAL(size_t, 8, run_count);
+    ASSERT_ARE_EQUAL(size_t, 2, (size_t)runs[0]);
+    ASSERT_ARE_EQUAL(size_t, 4, (size_t)runs[1]);
+    ASSERT_ARE_EQUAL(size_t, 6, (size_t)runs[2]);
+    ASSERT_ARE_EQUAL(size_t, 8, (size_t)runs[3]);
+    ASSERT_ARE_EQUAL(size_t, 5, (size_t)runs[4]);
+    ASSERT_ARE_EQUAL(size_t, 7, (size_t)runs[5]);
+    ASSERT_ARE_EQUAL(size_t, 3, (size_t)runs[6]);
+    ASSERT_ARE_EQUAL(size_t, 1, (size_t)runs[7]);
+}
+
+/* threadpool_submit_to_group */
+
+/* Tests_SRS_THREADPOOL_11_017: [ If threadpool, wait_group or work_function is NULL, threadpool_submit_to_group shall fail and return THREADPOOL_INVALID_ARG. ]*/
+TEST_FUNCTION(threadpool_submit_to_group_with_NULL_threadpool_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+    umock_c_reset_all_calls();
+
+    ///act
+    result = threadpool_submit_to_group(NULL, wait_group, test_work, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_wait_group_destroy(wait_group);
+}
+
+/* Tests_SRS_THREADPOOL_11_017: [ If threadpool, wait_group or work_function is NULL, threadpool_submit_to_group shall fail and return THREADPOOL_INVALID_ARG. ]*/
+TEST_FUNCTION(threadpool_submit_to_group_with_NULL_wait_group_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    umock_c_reset_all_calls();
+
+    ///act
+    result = threadpool_submit_to_group(threadpool, NULL, test_work, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_destroy(threadpool);
+}
+
+/* Tests_SRS_THREADPOOL_11_017: [ If threadpool, wait_group or work_function is NULL, threadpool_submit_to_group shall fail and return THREADPOOL_INVALID_ARG. ]*/
+TEST_FUNCTION(threadpool_submit_to_group_with_NULL_work_function_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+    umock_c_reset_all_calls();
+
+    ///act
+    result = threadpool_submit_to_group(threadpool, wait_group, NULL, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_wait_group_destroy(wait_group);
+    threadpool_destroy(threadpool);
+}
+
+/* Tests_SRS_THREADPOOL_11_018: [ threadpool_submit_to_group shall increment the count of wait_group under its lock and submit the work like threadpool_submit. ]*/
+/* Tests_SRS_THREADPOOL_11_014: [ After running work submitted with a wait group, the worker shall decrement the count of the wait group under its lock and broadcast its condition when the count reaches 0. ]*/
+TEST_FUNCTION(threadpool_submit_to_group_counts_the_work_until_it_ran)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = threadpool_submit_to_group(threadpool, wait_group, test_work, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_destroy(threadpool);
+    ASSERT_ARE_EQUAL(size_t, 1, run_count);
+    umock_c_reset_all_calls();
+
+    /*the work ran, the wait does not block*/
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, threadpool_wait_group_wait(wait_group));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    threadpool_wait_group_destroy(wait_group);
+}
+
+/* Tests_SRS_THREADPOOL_11_019: [ If any error occurs, threadpool_submit_to_group shall fail, leave the count of wait_group as it was and return THREADPOOL_ERROR. ]*/
+TEST_FUNCTION(when_submitting_fails_threadpool_submit_to_group_restores_the_count_and_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG))
+        .SetReturn(LOCK_ERROR);
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Broadcast(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = threadpool_submit_to_group(threadpool, wait_group, test_work, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, threadpool_wait_group_wait(wait_group));
+
+    ///cleanup
+    threadpool_wait_group_destroy(wait_group);
+    threadpool_destroy(threadpool);
+    ASSERT_ARE_EQUAL(size_t, 0, run_count);
+}
+
+/* Tests_SRS_THREADPOOL_11_019: [ If any error occurs, threadpool_submit_to_group shall fail, leave the count of wait_group as it was and return THREADPOOL_ERROR. ]*/
+TEST_FUNCTION(when_locking_the_wait_group_fails_threadpool_submit_to_group_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG))
+        .SetReturn(LOCK_ERROR);
+
+    ///act
+    result = threadpool_submit_to_group(threadpool, wait_group, test_work, TEST_CONTEXT(1));
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_wait_group_destroy(wait_group);
+    threadpool_destroy(threadpool);
+    ASSERT_ARE_EQUAL(size_t, 0, run_count);
+}
+
+/* threadpool_wait_group_create */
+
+/* Tests_SRS_THREADPOOL_11_020: [ threadpool_wait_group_create shall allocate a wait group with a lock, a condition and a count of 0 and return it. ]*/
+TEST_FUNCTION(threadpool_wait_group_create_succeeds)
+{
+    ///arrange
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init());
+
+    ///act
+    wait_group = threadpool_wait_group_create();
+
+    ///assert
+    ASSERT_IS_NOT_NULL(wait_group);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_wait_group_destroy(wait_group);
+}
+
+/* Tests_SRS_THREADPOOL_11_021: [ If any error occurs, threadpool_wait_group_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_fails_threadpool_wait_group_create_fails)
+{
+    ///arrange
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    ///act
+    wait_group = threadpool_wait_group_create();
+
+    ///assert
+    ASSERT_IS_NULL(wait_group);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_021: [ If any error occurs, threadpool_wait_group_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_Condition_Init_fails_threadpool_wait_group_create_fails)
+{
+    ///arrange
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(Lock_Init());
+    STRICT_EXPECTED_CALL(Condition_Init())
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    wait_group = threadpool_wait_group_create();
+
+    ///assert
+    ASSERT_IS_NULL(wait_group);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* threadpool_wait_group_destroy */
+
+/* Tests_SRS_THREADPOOL_11_022: [ If wait_group is NULL, threadpool_wait_group_destroy shall return. ]*/
+TEST_FUNCTION(threadpool_wait_group_destroy_with_NULL_returns)
+{
+    ///act
+    threadpool_wait_group_destroy(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_023: [ threadpool_wait_group_destroy shall free the condition, the lock and the wait group. ]*/
+TEST_FUNCTION(threadpool_wait_group_destroy_frees_the_wait_group)
+{
+    ///arrange
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Condition_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Lock_Deinit(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    ///act
+    threadpool_wait_group_destroy(wait_group);
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* threadpool_wait_group_wait */
+
+/* Tests_SRS_THREADPOOL_11_024: [ If wait_group is NULL, threadpool_wait_group_wait shall fail and return THREADPOOL_INVALID_ARG. ]*/
+TEST_FUNCTION(threadpool_wait_group_wait_with_NULL_fails)
+{
+    ///act
+    THREADPOOL_RESULT result = threadpool_wait_group_wait(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_THREADPOOL_11_025: [ threadpool_wait_group_wait shall wait on the condition of wait_group until its count is 0 and return THREADPOOL_OK. ]*/
+TEST_FUNCTION(threadpool_wait_group_wait_with_nothing_submitted_returns)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = threadpool_wait_group_wait(wait_group);
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_wait_group_destroy(wait_group);
+}
+
+/* Tests_SRS_THREADPOOL_11_026: [ If any error occurs, threadpool_wait_group_wait shall fail and return THREADPOOL_ERROR. ]*/
+TEST_FUNCTION(when_Condition_Wait_fails_threadpool_wait_group_wait_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_HANDLE threadpool = threadpool_create(1);
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_OK, threadpool_submit_to_group(threadpool, wait_group, test_work, TEST_CONTEXT(1)));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Condition_Wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 0))
+        .SetReturn(COND_ERROR);
+    STRICT_EXPECTED_CALL(Unlock(IGNORED_PTR_ARG));
+
+    ///act
+    result = threadpool_wait_group_wait(wait_group);
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_destroy(threadpool);
+    threadpool_wait_group_destroy(wait_group);
+}
+
+/* Tests_SRS_THREADPOOL_11_026: [ If any error occurs, threadpool_wait_group_wait shall fail and return THREADPOOL_ERROR. ]*/
+TEST_FUNCTION(when_locking_fails_threadpool_wait_group_wait_fails)
+{
+    ///arrange
+    THREADPOOL_RESULT result;
+    THREADPOOL_WAIT_GROUP_HANDLE wait_group = threadpool_wait_group_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(IGNORED_PTR_ARG))
+        .SetReturn(LOCK_ERROR);
+
+    ///act
+    result = threadpool_wait_group_wait(wait_group);
+
+    ///assert
+    ASSERT_ARE_EQUAL(THREADPOOL_RESULT, THREADPOOL_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    ///cleanup
+    threadpool_wait_group_destroy(wait_group);
+}
+
+END_TEST_SUITE(threadpool_unittests)
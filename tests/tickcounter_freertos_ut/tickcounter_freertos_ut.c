@@ -258,4 +258,126 @@ TEST_FUNCTION(tickcounter_freertos_get_current_ms_succeed_despite_overflow)
     tickcounter_destroy(tickHandle);
 }
 
+/* Tests_SRS_TICKCOUNTER_FREERTOS_11_001: [ If the tick_counter or current_us parameter is NULL, tickcounter_get_current_us shall return a non-zero value to indicate error. ] */
+TEST_FUNCTION(tickcounter_freertos_get_current_us_tick_counter_NULL_fail)
+{
+    ///arrange
+    uint64_t current_us = 0;
+
+    ///act
+    int result = tickcounter_get_current_us(NULL, &current_us);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_TICKCOUNTER_FREERTOS_11_001: [ If the tick_counter or current_us parameter is NULL, tickcounter_get_current_us shall return a non-zero value to indicate error. ] */
+TEST_FUNCTION(tickcounter_freertos_get_current_us_current_us_NULL_fail)
+{
+    ///arrange
+    int result;
+    TICK_COUNTER_HANDLE tickHandle = tickcounter_create();
+    umock_c_reset_all_calls();
+
+    ///act
+    result = tickcounter_get_current_us(tickHandle, NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    /// cleanup
+    tickcounter_destroy(tickHandle);
+}
+
+/* Tests_SRS_TICKCOUNTER_FREERTOS_11_002: [ tickcounter_get_current_us shall set *current_us to the number of ticks elapsed since the tickcounter_create call, scaled to microseconds, and return 0. A single overflow of xTaskGetTickCount shall be handled like in tickcounter_get_current_ms. ] */
+TEST_FUNCTION(tickcounter_freertos_get_current_us_succeed_despite_overflow)
+{
+    ///arrange
+    TICK_COUNTER_HANDLE tickHandle;
+    uint64_t current_us = 0;
+    int result;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument(1);
+    STRICT_EXPECTED_CALL(xTaskGetTickCount())
+        .SetReturn(FAKE_TICK_BEFORE_OVERFLOW);
+    STRICT_EXPECTED_CALL(xTaskGetTickCount())
+        .SetReturn((FAKE_TICK_AFTER_OVERFLOW));
+
+    tickHandle = tickcounter_create();
+
+    ///act
+    result = tickcounter_get_current_us(tickHandle, &current_us);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, (uint64_t)FAKE_TICK_INTERVAL * 1000000 / CONFIG_FREERTOS_HZ, current_us);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    /// clean
+    tickcounter_destroy(tickHandle);
+}
+
+/* Tests_SRS_TICKCOUNTER_FREERTOS_11_003: [ If the tick_counter or current_ns parameter is NULL, tickcounter_get_current_ns shall return a non-zero value to indicate error. ] */
+TEST_FUNCTION(tickcounter_freertos_get_current_ns_tick_counter_NULL_fail)
+{
+    ///arrange
+    uint64_t current_ns = 0;
+
+    ///act
+    int result = tickcounter_get_current_ns(NULL, &current_ns);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_TICKCOUNTER_FREERTOS_11_003: [ If the tick_counter or current_ns parameter is NULL, tickcounter_get_current_ns shall return a non-zero value to indicate error. ] */
+TEST_FUNCTION(tickcounter_freertos_get_current_ns_current_ns_NULL_fail)
+{
+    ///arrange
+    int result;
+    TICK_COUNTER_HANDLE tickHandle = tickcounter_create();
+    umock_c_reset_all_calls();
+
+    ///act
+    result = tickcounter_get_current_ns(tickHandle, NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    /// cleanup
+    tickcounter_destroy(tickHandle);
+}
+
+/* Tests_SRS_TICKCOUNTER_FREERTOS_11_004: [ tickcounter_get_current_ns shall set *current_ns to the number of ticks elapsed since the tickcounter_create call, scaled to nanoseconds, and return 0. A single overflow of xTaskGetTickCount shall be handled like in tickcounter_get_current_ms. ] */
+TEST_FUNCTION(tickcounter_freertos_get_current_ns_succeed)
+{
+    ///arrange
+    uint64_t current_ns = 0;
+    int result;
+    TICK_COUNTER_HANDLE tickHandle;
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument(1);
+    STRICT_EXPECTED_CALL(xTaskGetTickCount())
+        .SetReturn(FAKE_TICK_NO_OVERFLOW);
+    STRICT_EXPECTED_CALL(xTaskGetTickCount())
+        .SetReturn((FAKE_TICK_NO_OVERFLOW + FAKE_TICK_INTERVAL));
+
+    ///act
+    tickHandle = tickcounter_create();
+    result = tickcounter_get_current_ns(tickHandle, &current_ns);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, (uint64_t)FAKE_TICK_INTERVAL * 1000000000 / CONFIG_FREERTOS_HZ, current_ns);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    /// clean
+    tickcounter_destroy(tickHandle);
+}
+
 END_TEST_SUITE(tickcounter_freertos_unittests)
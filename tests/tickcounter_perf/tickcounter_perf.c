@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "azure_c_shared_utility/tickcounter.h"
+#include "perf_timer.h"
+
+/*cost of one call and the smallest step seen for tickcounter_get_current_ms, _us and _ns, compared with time(NULL),
+which is what the tickcounter used to be built on on linux*/
+
+#define CALLS 1000000
+
+static volatile uint64_t sink;
+
+typedef struct CLOCK_TAG
+{
+    const char* name;
+    int (*get)(TICK_COUNTER_HANDLE tick_counter, uint64_t* value);
+} CLOCK;
+
+static int get_ms(TICK_COUNTER_HANDLE tick_counter, uint64_t* value)
+{
+    tickcounter_ms_t current_ms;
+    int result = tickcounter_get_current_ms(tick_counter, &current_ms);
+    *value = current_ms;
+    return result;
+}
+
+static int get_time(TICK_COUNTER_HANDLE tick_counter, uint64_t* value)
+{
+    (void)tick_counter;
+    *value = (uint64_t)time(NULL);
+    return 0;
+}
+
+static const CLOCK clocks[] =
+{
+    { "time(NULL) [s]", get_time },
+    { "tickcounter_get_current_ms", get_ms },
+    { "tickcounter_get_current_us", tickcounter_get_current_us },
+    { "tickcounter_get_current_ns", tickcounter_get_current_ns }
+};
+
+static int run_test(TICK_COUNTER_HANDLE tick_counter, const CLOCK* clock)
+{
+    int result = 0;
+    uint64_t previous;
+    uint64_t smallest_step = UINT64_MAX;
+    double start;
+    double end;
+    size_t i;
+
+    if (clock->get(tick_counter, &previous) != 0)
+    {
+        (void)printf("%s failed\r\n", clock->name);
+        result = __LINE__;
+    }
+    else
+    {
+        start = perf_timer_get_seconds();
+        for (i = 0; i < CALLS; i++)
+        {
+            uint64_t value;
+            if (clock->get(tick_counter, &value) != 0)
+            {
+                (void)printf("%s failed\r\n", clock->name);
+                result = __LINE__;
+                break;
+            }
+            if (value < previous)
+            {
+                (void)printf("%s went backwards\r\n", clock->name);
+                result = __LINE__;
+                break;
+            }
+            if ((value != previous) && (value - previous < smallest_step))
+            {
+                smallest_step = value - previous;
+            }
+            previous = value;
+        }
+        end = perf_timer_get_seconds();
+        sink = previous;
+
+        if (result == 0)
+        {
+            if (smallest_step == UINT64_MAX)
+            {
+                (void)printf("%-28s %8.2f ns per call, did not change in %.3f s\r\n", clock->name, PERF_NS_PER_OP(start, end, CALLS), end - start);
+            }
+            else
+            {
+                (void)printf("%-28s %8.2f ns per call, smallest step %llu\r\n", clock->name, PERF_NS_PER_OP(start, end, CALLS), (unsigned long long)smallest_step);
+            }
+        }
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int result = 0;
+    TICK_COUNTER_HANDLE tick_counter = tickcounter_create();
+    if (tick_counter == NULL)
+    {
+        (void)printf("tickcounter_create failed\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t i;
+        for (i = 0; (i < sizeof(clocks) / sizeof(clocks[0])) && (result == 0); i++)
+        {
+            result = run_test(tick_counter, &clocks[i]);
+        }
+        tickcounter_destroy(tick_counter);
+    }
+    return result;
+}
@@ -188,6 +188,95 @@ TEST_FUNCTION(tickcounter_get_current_ms_succeed)
     tickcounter_destroy(tickHandle);
 }
 
+TEST_FUNCTION(tickcounter_get_current_us_tick_counter_NULL_fail)
+{
+    ///arrange
+    uint64_t current_us = 0;
+
+    ///act
+    int result = tickcounter_get_current_us(NULL, &current_us);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(tickcounter_get_current_us_current_us_NULL_fail)
+{
+    ///arrange
+    int result;
+    TICK_COUNTER_HANDLE tickHandle = tickcounter_create();
+    umock_c_reset_all_calls();
+
+    ///act
+    result = tickcounter_get_current_us(tickHandle, NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    tickcounter_destroy(tickHandle);
+}
+
+TEST_FUNCTION(tickcounter_get_current_ns_tick_counter_NULL_fail)
+{
+    ///arrange
+    uint64_t current_ns = 0;
+
+    ///act
+    int result = tickcounter_get_current_ns(NULL, &current_ns);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(tickcounter_get_current_ns_current_ns_NULL_fail)
+{
+    ///arrange
+    int result;
+    TICK_COUNTER_HANDLE tickHandle = tickcounter_create();
+    umock_c_reset_all_calls();
+
+    ///act
+    result = tickcounter_get_current_ns(tickHandle, NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    tickcounter_destroy(tickHandle);
+}
+
+TEST_FUNCTION(tickcounter_get_current_us_and_ns_agree_with_ms)
+{
+    ///arrange
+    int result_ms;
+    int result_us;
+    int result_ns;
+    tickcounter_ms_t current_ms = 0;
+    uint64_t current_us = 0;
+    uint64_t current_ns = 0;
+    TICK_COUNTER_HANDLE tickHandle = tickcounter_create();
+    umock_c_reset_all_calls();
+
+    ///act
+    result_ns = tickcounter_get_current_ns(tickHandle, &current_ns);
+    result_us = tickcounter_get_current_us(tickHandle, &current_us);
+    result_ms = tickcounter_get_current_ms(tickHandle, &current_ms);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, result_ns);
+    ASSERT_ARE_EQUAL(int, 0, result_us);
+    ASSERT_ARE_EQUAL(int, 0, result_ms);
+    ASSERT_IS_TRUE(current_ns / 1000 <= current_us);
+    ASSERT_IS_TRUE(current_us / 1000 <= current_ms);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    /// clean
+    tickcounter_destroy(tickHandle);
+}
+
 //TEST_FUNCTION(tickcounter_get_current_ms_validate_tick_succeed)
 //{
 //    ///arrange
@@ -4,9 +4,11 @@
 #ifdef __cplusplus
 #include <cstdlib>
 #include <cstddef>
+#include <cstdint>
 #else
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdint.h>
 #endif
 
 static void* my_gballoc_malloc(size_t size)
@@ -56,6 +58,14 @@ static bool VECTOR_UNITTEST_isEqual(const void* left_hand_side, const void* righ
     return (rhs->nValue1 == lhs->nValue1 && rhs->lValue2 == lhs->lValue2);
 }
 
+static int VECTOR_UNITTEST_compare(const void* element, const void* value)
+{
+    const VECTOR_UNITTEST* lhs = (const VECTOR_UNITTEST*)element;
+    const VECTOR_UNITTEST* rhs = (const VECTOR_UNITTEST*)value;
+
+    return (lhs->nValue1 > rhs->nValue1) - (lhs->nValue1 < rhs->nValue1);
+}
+
 #define NUM_ITEM_PUSH_BACK      128
 
 BEGIN_TEST_SUITE(Vector_UnitTests)
@@ -769,7 +779,7 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_destroy(handle);
     }
 
-    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the numElements starting at elements and reduce its internal storage.] */
+    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the numElements starting at elements.] */
     TEST_FUNCTION(VECTOR_erase_succeeds_case_1)
     {
         ///arrange
@@ -782,8 +792,6 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         (void)VECTOR_push_back(handle, &sItem2, 1);
         pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem1);
         umock_c_reset_all_calls();
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, sizeof(VECTOR_UNITTEST)))
-            .IgnoreArgument_ptr();
 
         ///act
         VECTOR_erase(handle, pfindItem, 1);
@@ -799,7 +807,7 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_destroy(handle);
     }
 
-    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the numElements starting at elements and reduce its internal storage.] */
+    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the numElements starting at elements.] */
     TEST_FUNCTION(VECTOR_erase_succeeds_case_2)
     {
         ///arrange
@@ -812,8 +820,6 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         (void)VECTOR_push_back(handle, &sItem2, 1);
         pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem1);
         umock_c_reset_all_calls();
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument_ptr();
 
         ///act
         VECTOR_erase(handle, pfindItem, 2);
@@ -829,7 +835,8 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_destroy(handle);
     }
 
-    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the numElements starting at elements and reduce its internal storage.] */
+    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the numElements starting at elements.] */
+    /* Tests_SRS_VECTOR_11_016: [VECTOR_erase shall keep the capacity of the vector.] */
     TEST_FUNCTION(VECTOR_erase_succeeds_case_3)
     {
         ///arrange
@@ -842,10 +849,6 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         (void)VECTOR_push_back(handle, &sItem2, 1);
         pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem1);
         umock_c_reset_all_calls();
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
-            .IgnoreArgument_ptr()
-            .IgnoreArgument_size()
-            .SetReturn(NULL);
 
         ///act
         VECTOR_erase(handle, pfindItem, 1);
@@ -853,6 +856,7 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         ///assert
         num = VECTOR_size(handle);
         ASSERT_ARE_EQUAL(size_t, 1, num);
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_capacity(handle));
         pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem1);
         ASSERT_IS_NULL(pfindItem);
         pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem2);
@@ -991,6 +995,7 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_destroy(handle);
     }
 
+    /* Tests_SRS_VECTOR_11_005: [If the vector cannot hold the new elements, VECTOR_push_back shall grow its capacity to the bigger of twice the capacity and the new number of elements.] */
     TEST_FUNCTION(VECTOR_push_back_multiple_elements_succeeds)
     {
         ///arrange
@@ -1000,9 +1005,10 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_UNITTEST sItem1 = {1, 2};
         VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
         umock_c_reset_all_calls();
-        for (nIndex = 0; nIndex < NUM_ITEM_PUSH_BACK; nIndex++)
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(VECTOR_UNITTEST)));
+        for (nIndex = 1; nIndex < NUM_ITEM_PUSH_BACK; nIndex *= 2)
         {
-            STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, (nIndex + 1) * sizeof(VECTOR_UNITTEST)))
+            STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, (nIndex * 2) * sizeof(VECTOR_UNITTEST)))
                 .IgnoreArgument_ptr();
         }
 
@@ -1020,6 +1026,824 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         ASSERT_IS_NOT_NULL(pResult);
         ASSERT_ARE_EQUAL(size_t, sItem1.nValue1, pResult->nValue1);
         ASSERT_ARE_EQUAL(long, sItem1.lValue2, pResult->lValue2);
+        ASSERT_ARE_EQUAL(size_t, NUM_ITEM_PUSH_BACK, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_002: [VECTOR_create_sorted shall create an empty vector that keeps its elements in the order given by compare.] */
+    TEST_FUNCTION(VECTOR_create_sorted_succeeds)
+    {
+        ///arrange
+        VECTOR_HANDLE handle;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_001: [VECTOR_create_sorted shall fail and return NULL if elementSize is 0 or compare is NULL.] */
+    TEST_FUNCTION(VECTOR_create_sorted_fails_if_element_size_is_zero)
+    {
+        ///arrange
+        VECTOR_HANDLE handle;
+
+        ///act
+        handle = VECTOR_create_sorted(0, VECTOR_UNITTEST_compare);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_001: [VECTOR_create_sorted shall fail and return NULL if elementSize is 0 or compare is NULL.] */
+    TEST_FUNCTION(VECTOR_create_sorted_fails_if_compare_is_NULL)
+    {
+        ///arrange
+        VECTOR_HANDLE handle;
+
+        ///act
+        handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), NULL);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_003: [VECTOR_create_sorted shall fail and return NULL if malloc fails.] */
+    TEST_FUNCTION(VECTOR_create_sorted_returns_NULL_if_malloc_fails)
+    {
+        ///arrange
+        VECTOR_HANDLE handle;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_004: [VECTOR_push_back shall fail and return non-zero if the vector is sorted.] */
+    TEST_FUNCTION(VECTOR_push_back_fails_on_a_sorted_vector)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_HANDLE handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_push_back(handle, &sItem, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_005: [If the vector cannot hold the new elements, VECTOR_push_back shall grow its capacity to the bigger of twice the capacity and the new number of elements.] */
+    TEST_FUNCTION(VECTOR_push_back_does_not_allocate_when_the_vector_has_capacity)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItems[3] = { {1, 2}, {3, 4}, {5, 6} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_reserve(handle, 4);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_push_back(handle, sItems, 3);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 3, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(size_t, 4, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_005: [If the vector cannot hold the new elements, VECTOR_push_back shall grow its capacity to the bigger of twice the capacity and the new number of elements.] */
+    TEST_FUNCTION(VECTOR_push_back_grows_to_the_new_number_of_elements_when_it_is_more_than_twice_the_capacity)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItems[5] = { {1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 5 * sizeof(VECTOR_UNITTEST)));
+
+        ///act
+        result = VECTOR_push_back(handle, sItems + 1, 4);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 5, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_006: [VECTOR_insert shall fail and return non-zero if handle or elements is NULL or numElements is 0.] */
+    TEST_FUNCTION(VECTOR_insert_fails_if_handle_is_NULL)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem = {1, 2};
+
+        ///act
+        result = VECTOR_insert(NULL, 0, &sItem, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_006: [VECTOR_insert shall fail and return non-zero if handle or elements is NULL or numElements is 0.] */
+    TEST_FUNCTION(VECTOR_insert_fails_if_elements_is_NULL)
+    {
+        ///arrange
+        int result;
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_insert(handle, 0, NULL, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_006: [VECTOR_insert shall fail and return non-zero if handle or elements is NULL or numElements is 0.] */
+    TEST_FUNCTION(VECTOR_insert_fails_if_numElements_is_zero)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_insert(handle, 0, &sItem, 0);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_007: [VECTOR_insert shall fail and return non-zero if index is greater than the number of elements.] */
+    TEST_FUNCTION(VECTOR_insert_fails_if_index_is_out_of_range)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, &sItem, 1);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_insert(handle, 2, &sItem, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_008: [VECTOR_insert shall fail and return non-zero if the vector is sorted.] */
+    TEST_FUNCTION(VECTOR_insert_fails_on_a_sorted_vector)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_HANDLE handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_insert(handle, 0, &sItem, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_009: [If the vector cannot hold the new elements, VECTOR_insert shall grow its capacity like VECTOR_push_back.] */
+    /* Tests_SRS_VECTOR_11_011: [VECTOR_insert shall move the elements from index on after the new elements, copy the new elements at index and return 0.] */
+    TEST_FUNCTION(VECTOR_insert_at_the_front_succeeds)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem1 = {1, 2};
+        VECTOR_UNITTEST sItem2 = {3, 4};
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, &sItem1, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(VECTOR_UNITTEST)));
+
+        ///act
+        result = VECTOR_insert(handle, 0, &sItem2, 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(int, sItem2.nValue1, ((VECTOR_UNITTEST*)VECTOR_element(handle, 0))->nValue1);
+        ASSERT_ARE_EQUAL(int, sItem1.nValue1, ((VECTOR_UNITTEST*)VECTOR_element(handle, 1))->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_011: [VECTOR_insert shall move the elements from index on after the new elements, copy the new elements at index and return 0.] */
+    TEST_FUNCTION(VECTOR_insert_2_elements_in_the_middle_succeeds)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItems[2] = { {1, 2}, {7, 8} };
+        VECTOR_UNITTEST sInserted[2] = { {3, 4}, {5, 6} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_reserve(handle, 4);
+        (void)VECTOR_push_back(handle, sItems, 2);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_insert(handle, 1, sInserted, 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 4, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(int, 1, ((VECTOR_UNITTEST*)VECTOR_element(handle, 0))->nValue1);
+        ASSERT_ARE_EQUAL(int, 3, ((VECTOR_UNITTEST*)VECTOR_element(handle, 1))->nValue1);
+        ASSERT_ARE_EQUAL(int, 5, ((VECTOR_UNITTEST*)VECTOR_element(handle, 2))->nValue1);
+        ASSERT_ARE_EQUAL(int, 7, ((VECTOR_UNITTEST*)VECTOR_element(handle, 3))->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_010: [VECTOR_insert shall fail and return non-zero if memory allocation fails.] */
+    TEST_FUNCTION(VECTOR_insert_fails_if_realloc_fails)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem1 = {1, 2};
+        VECTOR_UNITTEST sItem2 = {3, 4};
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, &sItem1, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(VECTOR_UNITTEST)))
+            .SetReturn(NULL);
+
+        ///act
+        result = VECTOR_insert(handle, 0, &sItem2, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(int, sItem1.nValue1, ((VECTOR_UNITTEST*)VECTOR_front(handle))->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_012: [VECTOR_insert_sorted shall fail and return non-zero if handle or element is NULL.] */
+    TEST_FUNCTION(VECTOR_insert_sorted_fails_if_handle_is_NULL)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem = {1, 2};
+
+        ///act
+        result = VECTOR_insert_sorted(NULL, &sItem);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_012: [VECTOR_insert_sorted shall fail and return non-zero if handle or element is NULL.] */
+    TEST_FUNCTION(VECTOR_insert_sorted_fails_if_element_is_NULL)
+    {
+        ///arrange
+        int result;
+        VECTOR_HANDLE handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_insert_sorted(handle, NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_013: [VECTOR_insert_sorted shall fail and return non-zero if the vector was not created with VECTOR_create_sorted.] */
+    TEST_FUNCTION(VECTOR_insert_sorted_fails_if_the_vector_is_not_sorted)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_insert_sorted(handle, &sItem);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_014: [VECTOR_insert_sorted shall insert element after all the elements that are not greater than it and return 0.] */
+    TEST_FUNCTION(VECTOR_insert_sorted_keeps_the_elements_sorted)
+    {
+        ///arrange
+        int result = 0;
+        size_t i;
+        VECTOR_UNITTEST sItems[6] = { {5, 0}, {3, 1}, {9, 2}, {3, 3}, {1, 4}, {7, 5} };
+        VECTOR_HANDLE handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+
+        ///act
+        for (i = 0; (i < 6) && (result == 0); i++)
+        {
+            result = VECTOR_insert_sorted(handle, &sItems[i]);
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 6, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(int, 1, ((VECTOR_UNITTEST*)VECTOR_element(handle, 0))->nValue1);
+        ASSERT_ARE_EQUAL(int, 3, ((VECTOR_UNITTEST*)VECTOR_element(handle, 1))->nValue1);
+        ASSERT_ARE_EQUAL(long, 1, ((VECTOR_UNITTEST*)VECTOR_element(handle, 1))->lValue2);
+        ASSERT_ARE_EQUAL(int, 3, ((VECTOR_UNITTEST*)VECTOR_element(handle, 2))->nValue1);
+        ASSERT_ARE_EQUAL(long, 3, ((VECTOR_UNITTEST*)VECTOR_element(handle, 2))->lValue2);
+        ASSERT_ARE_EQUAL(int, 5, ((VECTOR_UNITTEST*)VECTOR_element(handle, 3))->nValue1);
+        ASSERT_ARE_EQUAL(int, 7, ((VECTOR_UNITTEST*)VECTOR_element(handle, 4))->nValue1);
+        ASSERT_ARE_EQUAL(int, 9, ((VECTOR_UNITTEST*)VECTOR_element(handle, 5))->nValue1);
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_015: [VECTOR_insert_sorted shall fail and return non-zero if memory allocation fails.] */
+    TEST_FUNCTION(VECTOR_insert_sorted_fails_if_realloc_fails)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_HANDLE handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(VECTOR_UNITTEST)))
+            .SetReturn(NULL);
+
+        ///act
+        result = VECTOR_insert_sorted(handle, &sItem);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_017: [VECTOR_pop_back shall return if handle is NULL.] */
+    TEST_FUNCTION(VECTOR_pop_back_if_handle_is_NULL)
+    {
+        ///arrange
+
+        ///act
+        VECTOR_pop_back(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_018: [VECTOR_pop_back shall return if the vector is empty.] */
+    TEST_FUNCTION(VECTOR_pop_back_on_an_empty_vector_returns)
+    {
+        ///arrange
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        VECTOR_pop_back(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_019: [VECTOR_pop_back shall remove the last element and keep the capacity of the vector.] */
+    TEST_FUNCTION(VECTOR_pop_back_succeeds)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 2);
+        umock_c_reset_all_calls();
+
+        ///act
+        VECTOR_pop_back(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(int, 1, ((VECTOR_UNITTEST*)VECTOR_back(handle))->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_020: [VECTOR_lower_bound shall fail and return NULL if handle or value is NULL.] */
+    TEST_FUNCTION(VECTOR_lower_bound_fails_if_handle_is_NULL)
+    {
+        ///arrange
+        void* result;
+        VECTOR_UNITTEST sItem = {1, 2};
+
+        ///act
+        result = VECTOR_lower_bound(NULL, &sItem);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_020: [VECTOR_lower_bound shall fail and return NULL if handle or value is NULL.] */
+    TEST_FUNCTION(VECTOR_lower_bound_fails_if_value_is_NULL)
+    {
+        ///arrange
+        void* result;
+        VECTOR_HANDLE handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_lower_bound(handle, NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_021: [VECTOR_lower_bound shall fail and return NULL if the vector was not created with VECTOR_create_sorted.] */
+    TEST_FUNCTION(VECTOR_lower_bound_fails_if_the_vector_is_not_sorted)
+    {
+        ///arrange
+        void* result;
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, &sItem, 1);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_lower_bound(handle, &sItem);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_022: [VECTOR_lower_bound shall use a binary search to return the first element that is not less than value.] */
+    TEST_FUNCTION(VECTOR_lower_bound_returns_the_first_element_not_less_than_value)
+    {
+        ///arrange
+        size_t i;
+        VECTOR_UNITTEST* result;
+        VECTOR_UNITTEST sItems[4] = { {2, 0}, {4, 1}, {4, 2}, {8, 3} };
+        VECTOR_UNITTEST sEqual = {4, 0};
+        VECTOR_UNITTEST sBetween = {5, 0};
+        VECTOR_UNITTEST sSmallest = {0, 0};
+        VECTOR_HANDLE handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+        for (i = 0; i < 4; i++)
+        {
+            (void)VECTOR_insert_sorted(handle, &sItems[i]);
+        }
+        umock_c_reset_all_calls();
+
+        ///act & assert
+        result = (VECTOR_UNITTEST*)VECTOR_lower_bound(handle, &sEqual);
+        ASSERT_ARE_EQUAL(void_ptr, VECTOR_element(handle, 1), result);
+        result = (VECTOR_UNITTEST*)VECTOR_lower_bound(handle, &sBetween);
+        ASSERT_ARE_EQUAL(void_ptr, VECTOR_element(handle, 3), result);
+        result = (VECTOR_UNITTEST*)VECTOR_lower_bound(handle, &sSmallest);
+        ASSERT_ARE_EQUAL(void_ptr, VECTOR_front(handle), result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_023: [VECTOR_lower_bound shall return NULL if all the elements are less than value.] */
+    TEST_FUNCTION(VECTOR_lower_bound_returns_NULL_if_all_elements_are_less_than_value)
+    {
+        ///arrange
+        void* result;
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_UNITTEST sValue = {2, 0};
+        VECTOR_HANDLE handle = VECTOR_create_sorted(sizeof(VECTOR_UNITTEST), VECTOR_UNITTEST_compare);
+        (void)VECTOR_insert_sorted(handle, &sItem);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_lower_bound(handle, &sValue);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_024: [VECTOR_capacity shall return 0 if the given handle is NULL.] */
+    TEST_FUNCTION(VECTOR_capacity_with_NULL_handle_returns_0)
+    {
+        ///arrange
+        size_t result;
+
+        ///act
+        result = VECTOR_capacity(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_025: [VECTOR_capacity shall return the number of elements the vector can hold without allocating memory.] */
+    TEST_FUNCTION(VECTOR_capacity_of_a_new_vector_is_0)
+    {
+        ///arrange
+        size_t result;
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_capacity(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_026: [VECTOR_reserve shall fail and return non-zero if handle is NULL.] */
+    TEST_FUNCTION(VECTOR_reserve_fails_if_handle_is_NULL)
+    {
+        ///arrange
+        int result;
+
+        ///act
+        result = VECTOR_reserve(NULL, 4);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_028: [Otherwise VECTOR_reserve shall reallocate the storage of the vector to hold exactly numElements elements and return 0.] */
+    TEST_FUNCTION(VECTOR_reserve_succeeds)
+    {
+        ///arrange
+        int result;
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, &sItem, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 10 * sizeof(VECTOR_UNITTEST)));
+
+        ///act
+        result = VECTOR_reserve(handle, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 10, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(int, sItem.nValue1, ((VECTOR_UNITTEST*)VECTOR_front(handle))->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_027: [If the vector can already hold numElements elements, VECTOR_reserve shall return 0.] */
+    TEST_FUNCTION(VECTOR_reserve_less_than_the_capacity_does_not_allocate)
+    {
+        ///arrange
+        int result;
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_reserve(handle, 10);
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_reserve(handle, 5);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 10, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_029: [VECTOR_reserve shall fail and return non-zero if memory allocation fails.] */
+    TEST_FUNCTION(VECTOR_reserve_fails_if_realloc_fails)
+    {
+        ///arrange
+        int result;
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, 10 * sizeof(VECTOR_UNITTEST)))
+            .SetReturn(NULL);
+
+        ///act
+        result = VECTOR_reserve(handle, 10);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_029: [VECTOR_reserve shall fail and return non-zero if memory allocation fails.] */
+    TEST_FUNCTION(VECTOR_reserve_fails_if_the_size_overflows)
+    {
+        ///arrange
+        int result;
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        result = VECTOR_reserve(handle, SIZE_MAX / sizeof(VECTOR_UNITTEST) + 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_030: [VECTOR_shrink_to_fit shall return if handle is NULL.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_if_handle_is_NULL)
+    {
+        ///arrange
+
+        ///act
+        VECTOR_shrink_to_fit(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_11_031: [VECTOR_shrink_to_fit shall return if the capacity of the vector is its number of elements.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_of_a_full_vector_does_nothing)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 2);
+        umock_c_reset_all_calls();
+
+        ///act
+        VECTOR_shrink_to_fit(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_032: [If the vector is empty, VECTOR_shrink_to_fit shall release its internal storage.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_of_an_empty_vector_frees_the_storage)
+    {
+        ///arrange
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_reserve(handle, 4);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+        ///act
+        VECTOR_shrink_to_fit(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_033: [Otherwise VECTOR_shrink_to_fit shall reallocate the storage of the vector to hold exactly its elements.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_succeeds)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[3] = { {1, 2}, {3, 4}, {5, 6} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 3);
+        VECTOR_pop_back(handle);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(VECTOR_UNITTEST)));
+
+        ///act
+        VECTOR_shrink_to_fit(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(int, 3, ((VECTOR_UNITTEST*)VECTOR_back(handle))->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_11_034: [If realloc fails, VECTOR_shrink_to_fit shall keep the storage it has.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_keeps_the_storage_if_realloc_fails)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[3] = { {1, 2}, {3, 4}, {5, 6} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 3);
+        VECTOR_pop_back(handle);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(VECTOR_UNITTEST)))
+            .SetReturn(NULL);
+
+        ///act
+        VECTOR_shrink_to_fit(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 3, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(int, 3, ((VECTOR_UNITTEST*)VECTOR_back(handle))->nValue1);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
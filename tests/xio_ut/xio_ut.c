@@ -29,10 +29,12 @@ static void my_gballoc_free(void* ptr)
 #include "umock_c.h"
 #include "umocktypes_charptr.h"
 #include "umock_c_negative_tests.h"
+#include "umocktypes_stdint.h"
 
 #define ENABLE_MOCKS
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/optionhandler.h"
+#include "azure_c_shared_utility/constbuffer_array.h"
 #undef ENABLE_MOCKS
 
 #include "azure_c_shared_utility/xio.h"
@@ -49,6 +51,8 @@ MOCK_FUNCTION_WITH_CODE(, int, test_xio_close, CONCRETE_IO_HANDLE, handle, ON_IO
 MOCK_FUNCTION_END(0)
 MOCK_FUNCTION_WITH_CODE(, int, test_xio_send, CONCRETE_IO_HANDLE, handle, const void*, buffer, size_t, size, ON_SEND_COMPLETE, on_send_complete, void*, callback_context)
 MOCK_FUNCTION_END(0)
+MOCK_FUNCTION_WITH_CODE(, int, test_xio_send_vectored, CONCRETE_IO_HANDLE, handle, CONSTBUFFER_ARRAY_HANDLE, buffers, ON_SEND_COMPLETE, on_send_complete, void*, callback_context)
+MOCK_FUNCTION_END(0)
 MOCK_FUNCTION_WITH_CODE(, void, test_xio_dowork, CONCRETE_IO_HANDLE, handle)
 MOCK_FUNCTION_END()
 MOCK_FUNCTION_WITH_CODE(, int, test_xio_setoption, CONCRETE_IO_HANDLE, handle, const char*, optionName, const void*, value)
@@ -110,9 +114,36 @@ const IO_INTERFACE_DESCRIPTION test_io_description =
     test_xio_close,
     test_xio_send,
     test_xio_dowork,
-    test_xio_setoption
+    test_xio_setoption,
+    NULL
 };
 
+const IO_INTERFACE_DESCRIPTION test_io_description_with_send_vectored =
+{
+    test_xio_retrieveoptions,
+    test_xio_create,
+    test_xio_destroy,
+    test_xio_open,
+    test_xio_close,
+    test_xio_send,
+    test_xio_dowork,
+    test_xio_setoption,
+    test_xio_send_vectored
+};
+
+static CONSTBUFFER_ARRAY_HANDLE TEST_CONSTBUFFER_ARRAY_HANDLE = (CONSTBUFFER_ARRAY_HANDLE)0x4244;
+static const unsigned char test_buffer_content_1[] = { 0x01, 0x02 };
+static const unsigned char test_buffer_content_2[] = { 0x03 };
+static const unsigned char test_buffer_content_3[] = { 0x04, 0x05, 0x06 };
+static const unsigned char test_flat_content[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+static const CONSTBUFFER test_buffers[] =
+{
+    { test_buffer_content_1, sizeof(test_buffer_content_1) },
+    { test_buffer_content_2, sizeof(test_buffer_content_2) },
+    { test_buffer_content_3, sizeof(test_buffer_content_3) }
+};
+static uint32_t g_test_buffer_count;
+
 static TEST_MUTEX_HANDLE g_testByTest;
 
 DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
@@ -147,6 +178,31 @@ static void my_OptionHandler_Destroy(OPTIONHANDLER_HANDLE handle)
     my_gballoc_free((void*)handle);
 }
 
+static int my_constbuffer_array_get_buffer_count(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle, uint32_t* buffer_count)
+{
+    (void)constbuffer_array_handle;
+    *buffer_count = g_test_buffer_count;
+    return 0;
+}
+
+static int my_constbuffer_array_get_all_buffers_size(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle, uint32_t* all_buffers_size)
+{
+    uint32_t i;
+    (void)constbuffer_array_handle;
+    *all_buffers_size = 0;
+    for (i = 0; i < g_test_buffer_count; i++)
+    {
+        *all_buffers_size += (uint32_t)test_buffers[i].size;
+    }
+    return 0;
+}
+
+static const CONSTBUFFER* my_constbuffer_array_get_buffer_content(CONSTBUFFER_ARRAY_HANDLE constbuffer_array_handle, uint32_t buffer_index)
+{
+    (void)constbuffer_array_handle;
+    return &test_buffers[buffer_index];
+}
+
 
 BEGIN_TEST_SUITE(xio_unittests)
 
@@ -161,6 +217,8 @@ TEST_SUITE_INITIALIZE(suite_init)
 
     result = umocktypes_charptr_register_types();
     ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
 
     REGISTER_UMOCK_ALIAS_TYPE(CONCRETE_IO_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(XIO_HANDLE, void*);
@@ -170,6 +228,8 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_UMOCK_ALIAS_TYPE(ON_IO_OPEN_COMPLETE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_BYTES_RECEIVED, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_IO_ERROR, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CONSTBUFFER_ARRAY_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(uint32_t*, void*);
 
     REGISTER_UMOCK_ALIAS_TYPE(pfCloneOption, void*);
     REGISTER_UMOCK_ALIAS_TYPE(pfDestroyOption, void*);
@@ -189,6 +249,12 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(OptionHandler_AddOption, OPTIONHANDLER_ERROR);
 
     REGISTER_GLOBAL_MOCK_HOOK(OptionHandler_Destroy, my_OptionHandler_Destroy);
+
+    REGISTER_GLOBAL_MOCK_HOOK(constbuffer_array_get_buffer_count, my_constbuffer_array_get_buffer_count);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(constbuffer_array_get_buffer_count, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(constbuffer_array_get_all_buffers_size, my_constbuffer_array_get_all_buffers_size);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(constbuffer_array_get_all_buffers_size, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(constbuffer_array_get_buffer_content, my_constbuffer_array_get_buffer_content);
 }
 
 TEST_SUITE_CLEANUP(suite_cleanup)
@@ -205,6 +271,7 @@ TEST_FUNCTION_INITIALIZE(method_init)
         ASSERT_FAIL("Could not acquire test serialization mutex.");
     }
     g_fail_alloc_calls = 0;
+    g_test_buffer_count = 3;
 
     umock_c_reset_all_calls();
 }
@@ -298,7 +365,8 @@ TEST_FUNCTION(when_concrete_xio_retrieveoptions_is_NULL_then_xio_create_fails)
         test_xio_close,
         test_xio_send,
         test_xio_dowork,
-        test_xio_setoption
+        test_xio_setoption,
+        NULL
     };
 
     // act
@@ -322,7 +390,8 @@ TEST_FUNCTION(when_concrete_xio_create_is_NULL_then_xio_create_fails)
         test_xio_close,
         test_xio_send,
         test_xio_dowork,
-        test_xio_setoption
+        test_xio_setoption,
+        NULL
     };
 
     // act
@@ -346,7 +415,8 @@ TEST_FUNCTION(when_concrete_xio_destroy_is_NULL_then_xio_create_fails)
         test_xio_close,
         test_xio_send,
         test_xio_dowork,
-        test_xio_setoption
+        test_xio_setoption,
+        NULL
     };
 
     // act
@@ -370,7 +440,8 @@ TEST_FUNCTION(when_concrete_xio_open_is_NULL_then_xio_create_fails)
         test_xio_close,
         test_xio_send,
         test_xio_dowork,
-        test_xio_setoption
+        test_xio_setoption,
+        NULL
     };
 
     // act
@@ -394,7 +465,8 @@ TEST_FUNCTION(when_concrete_xio_close_is_NULL_then_xio_create_fails)
         NULL,
         test_xio_send,
         test_xio_dowork,
-        test_xio_setoption
+        test_xio_setoption,
+        NULL
     };
 
     // act
@@ -418,7 +490,8 @@ TEST_FUNCTION(when_concrete_xio_send_is_NULL_then_xio_create_fails)
         test_xio_close,
         NULL,
         test_xio_dowork,
-        test_xio_setoption
+        test_xio_setoption,
+        NULL
     };
 
     // act
@@ -442,7 +515,8 @@ TEST_FUNCTION(when_concrete_xio_dowork_is_NULL_then_xio_create_fails)
         test_xio_close,
         test_xio_send,
         NULL,
-        test_xio_setoption
+        test_xio_setoption,
+        NULL
     };
 
     // act
@@ -466,6 +540,7 @@ TEST_FUNCTION(when_concrete_xio_setoption_is_NULL_then_xio_create_fails)
         test_xio_close,
         test_xio_send,
         test_xio_dowork,
+        NULL,
         NULL
     };
 
@@ -772,6 +847,288 @@ TEST_FUNCTION(xio_send_with_non_NULL_buffer_and_zero_length_passes_the_args_down
     xio_destroy(handle);
 }
 
+/* xio_send_vectored */
+
+/* Tests_SRS_XIO_11_001: [ If xio or buffers is NULL, xio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(xio_send_vectored_with_NULL_handle_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = xio_send_vectored(NULL, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_XIO_11_001: [ If xio or buffers is NULL, xio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(xio_send_vectored_with_NULL_buffers_fails)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = xio_send_vectored(handle, NULL, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_002: [ If the concrete IO has a concrete_io_send_vectored function, xio_send_vectored shall pass buffers, on_send_complete and callback_context to it and return its result. ]*/
+TEST_FUNCTION(xio_send_vectored_calls_the_concrete_send_vectored)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description_with_send_vectored, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_xio_send_vectored(TEST_CONCRETE_IO_HANDLE, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242));
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_002: [ If the concrete IO has a concrete_io_send_vectored function, xio_send_vectored shall pass buffers, on_send_complete and callback_context to it and return its result. ]*/
+TEST_FUNCTION(when_the_concrete_send_vectored_fails_then_xio_send_vectored_fails)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description_with_send_vectored, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_xio_send_vectored(TEST_CONCRETE_IO_HANDLE, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242))
+        .SetReturn(42);
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_003: [ Otherwise, if buffers holds one buffer, xio_send_vectored shall send its content with concrete_io_send. ]*/
+TEST_FUNCTION(xio_send_vectored_with_one_buffer_sends_it_without_copying)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description, NULL);
+    umock_c_reset_all_calls();
+    g_test_buffer_count = 1;
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 0));
+    STRICT_EXPECTED_CALL(test_xio_send(TEST_CONCRETE_IO_HANDLE, test_buffer_content_1, sizeof(test_buffer_content_1), test_on_send_complete, (void*)0x4242));
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_004: [ Otherwise, xio_send_vectored shall copy the content of all the buffers, in order, in one block of memory, send it with concrete_io_send, free it and return the result of concrete_io_send. ]*/
+TEST_FUNCTION(xio_send_vectored_with_several_buffers_sends_them_in_one_block)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(test_flat_content)));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 0));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 1));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 2));
+    STRICT_EXPECTED_CALL(test_xio_send(TEST_CONCRETE_IO_HANDLE, IGNORED_PTR_ARG, sizeof(test_flat_content), test_on_send_complete, (void*)0x4242))
+        .ValidateArgumentBuffer(2, test_flat_content, sizeof(test_flat_content));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_004: [ Otherwise, xio_send_vectored shall copy the content of all the buffers, in order, in one block of memory, send it with concrete_io_send, free it and return the result of concrete_io_send. ]*/
+TEST_FUNCTION(when_the_concrete_send_fails_then_xio_send_vectored_fails)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(test_flat_content)));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 0));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 1));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 2));
+    STRICT_EXPECTED_CALL(test_xio_send(TEST_CONCRETE_IO_HANDLE, IGNORED_PTR_ARG, sizeof(test_flat_content), test_on_send_complete, (void*)0x4242))
+        .SetReturn(42);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_block_fails_then_xio_send_vectored_fails)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(test_flat_content)))
+        .SetReturn(NULL);
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_getting_the_buffer_count_fails_then_xio_send_vectored_fails)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG))
+        .SetReturn(1);
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(xio_send_vectored_with_no_buffers_fails)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description, NULL);
+    umock_c_reset_all_calls();
+    g_test_buffer_count = 0;
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_getting_the_content_of_the_only_buffer_fails_then_xio_send_vectored_fails)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description, NULL);
+    umock_c_reset_all_calls();
+    g_test_buffer_count = 1;
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 0))
+        .SetReturn(NULL);
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
+/* Tests_SRS_XIO_11_005: [ If any error occurs, xio_send_vectored shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_getting_the_content_of_a_buffer_fails_then_xio_send_vectored_frees_the_block_and_fails)
+{
+    // arrange
+    int result;
+    XIO_HANDLE handle = xio_create(&test_io_description, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_count(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_all_buffers_size(TEST_CONSTBUFFER_ARRAY_HANDLE, IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(test_flat_content)));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 0));
+    STRICT_EXPECTED_CALL(constbuffer_array_get_buffer_content(TEST_CONSTBUFFER_ARRAY_HANDLE, 1))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    // act
+    result = xio_send_vectored(handle, TEST_CONSTBUFFER_ARRAY_HANDLE, test_on_send_complete, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    xio_destroy(handle);
+}
+
 /* xio_dowork */
 
 /* Tests_SRS_XIO_01_012: [xio_dowork shall call the concrete IO implementation specified in xio_create, by calling the concrete_xio_dowork function.] */